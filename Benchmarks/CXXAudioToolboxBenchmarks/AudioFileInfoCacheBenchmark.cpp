@@ -0,0 +1,62 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include <audio_toolbox/AudioFileInfoCache.hpp>
+#include <audio_toolbox/CAAudioFile.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::AudioFileInfoCache;
+using audio_toolbox::CAAudioFile;
+
+/// The number of queries made by each thread per run.
+constexpr auto kQueryCount = 100'000;
+
+/// Queries the cache from threadCount threads at once.
+void QueryConcurrently(unsigned threadCount) {
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back([] {
+            for (auto n = 0; n < kQueryCount; ++n) {
+                const auto types = AudioFileInfoCache::ReadableTypes();
+                benchmarks::DoNotOptimize(types.get());
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+} /* namespace */
+
+void benchmarks::AudioFileInfoCacheBenchmark() {
+    Measure("AudioFileInfoCache: uncached ReadableTypes", 1'000, "queries", [] {
+        for (auto n = 0; n < 1'000; ++n) {
+            const auto types = CAAudioFile::ReadableTypes();
+            DoNotOptimize(types.data());
+        }
+    });
+
+    const auto maximumThreadCount = std::max(std::thread::hardware_concurrency(), 1U);
+    for (auto threadCount = 1U;; threadCount = std::min(threadCount * 2, maximumThreadCount)) {
+        const auto name = "AudioFileInfoCache: cached ReadableTypes, " + std::to_string(threadCount) + " threads";
+        Measure(name.c_str(), static_cast<double>(kQueryCount) * threadCount, "queries",
+                [threadCount] { QueryConcurrently(threadCount); });
+        if (threadCount == maximumThreadCount) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include <audio_toolbox/BatchProbe.hpp>
+
+#include <test_support/Fixtures.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::BatchProbe;
+
+/// The number of files probed.
+constexpr auto kFileCount = 256;
+
+} /* namespace */
+
+void benchmarks::BatchProbeBenchmark() {
+    test_support::detail::TemporaryDirectory directory;
+
+    // Compressed and PCM files alternate so the cost of probing varies from file to file
+    std::vector<std::string> paths;
+    for (auto i = 0; i < kFileCount; ++i) {
+        const auto aac = i % 2 == 0;
+        const auto path = directory.Path((std::to_string(i) + (aac ? ".m4a" : ".caf")).c_str());
+        test_support::detail::WriteTestFile(
+                path, aac ? kAudioFileM4AType : kAudioFileCAFType,
+                aac ? test_support::detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, 2)
+                    : test_support::detail::MakeInt16Format(44'100, 2, false),
+                44'100);
+        paths.push_back(path);
+    }
+
+    const auto maximumThreadCount = std::max(std::thread::hardware_concurrency(), 1U);
+    for (auto threadCount = 1U;; threadCount = std::min(threadCount * 2, maximumThreadCount)) {
+        BatchProbe probe{threadCount};
+        const auto name = "BatchProbe: " + std::to_string(threadCount) + " threads";
+        Measure(name.c_str(), kFileCount, "files", [&] {
+            const auto results = probe.Probe(paths);
+            DoNotOptimize(results.data());
+        });
+        if (threadCount == maximumThreadCount) {
+            break;
+        }
+    }
+}
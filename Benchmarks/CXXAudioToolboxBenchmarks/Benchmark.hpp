@@ -0,0 +1,50 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace benchmarks {
+
+/// The number of timed runs of each measurement.
+constexpr int kRunCount = 7;
+
+/// Prevents the compiler from discarding a computed value.
+template <typename T> inline void DoNotOptimize(const T &value) noexcept {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// Times a measurement and prints its median duration and throughput.
+///
+/// body is run once untimed to warm caches and then kRunCount times.
+/// @param name The name of the measurement.
+/// @param items The number of items processed by one run of body.
+/// @param unit The name of the items, used to report throughput.
+/// @param body A callable performing one run.
+template <typename Body> void Measure(const char *name, double items, const char *unit, Body &&body) {
+    using Clock = std::chrono::steady_clock;
+
+    body();
+
+    std::vector<double> seconds;
+    seconds.reserve(kRunCount);
+    for (int i = 0; i < kRunCount; ++i) {
+        const auto start = Clock::now();
+        body();
+        seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    std::sort(seconds.begin(), seconds.end());
+    const auto median = seconds[kRunCount / 2];
+    std::printf("%-56s %12.3f ms %14.1f M%s/s\n", name, median * 1e3, items / median / 1e6, unit);
+}
+
+} /* namespace benchmarks */
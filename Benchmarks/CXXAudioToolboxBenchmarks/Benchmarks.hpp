@@ -0,0 +1,41 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace benchmarks {
+
+/// Compares cached and uncached AudioFile global information queries and measures how cached queries scale with the
+/// number of threads.
+void AudioFileInfoCacheBenchmark();
+
+/// Measures how probing a batch of files scales with the number of threads.
+void BatchProbeBenchmark();
+
+/// Measures channel mixing with sparse and dense matrices against a per-frame loop.
+void ChannelMatrixMixerBenchmark();
+
+/// Compares PCMConverter with the runtime-selected built-in kernels.
+void PCMConverterBenchmark();
+
+/// Compares sequential packet reads with and without read-ahead.
+void PacketPrefetcherBenchmark();
+
+/// Measures interleaving and deinterleaving for each channel count with built-in kernels, and compares
+/// CAAudioConverter::ConvertComplexBuffer with and without them.
+void PCMLayoutBenchmark();
+
+/// Measures recording durations in a histogram and the cost of timing render cycles of nested and sequential nodes.
+void RenderProfilerBenchmark();
+
+/// Measures how transcoding a batch of files scales with the number of threads.
+void TranscodeEngineBenchmark();
+
+/// Measures how a work-stealing pool running tasks of uneven cost scales with the number of threads.
+void WorkStealingPoolBenchmark();
+
+} /* namespace benchmarks */
@@ -0,0 +1,156 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include <audio_toolbox/ChannelMatrixMixer.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::ChannelMatrixMixer;
+
+/// The number of frames mixed per call.
+constexpr UInt32 kFrameCount = 4096;
+
+/// The number of calls per run.
+constexpr auto kCallCount = 256;
+
+/// Returns a native-endian float linear PCM format.
+AudioStreamBasicDescription MakeFormat(UInt32 channels, bool interleaved) noexcept {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = 48'000;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagsNativeFloatPacked;
+    if (!interleaved) {
+        format.mFormatFlags |= kAudioFormatFlagIsNonInterleaved;
+    }
+    format.mBytesPerFrame = sizeof(float) * (interleaved ? channels : 1);
+    format.mFramesPerPacket = 1;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    format.mChannelsPerFrame = channels;
+    format.mBitsPerChannel = 32;
+    return format;
+}
+
+/// A mix of one channel layout into another.
+struct Mix {
+    /// The name of the mix.
+    const char *name_;
+    /// The number of input channels.
+    UInt32 inputs_;
+    /// The number of output channels.
+    UInt32 outputs_;
+    /// The mix matrix in row-major order.
+    std::vector<Float32> matrix_;
+};
+
+/// Returns the mixes measured: a sparse downmix, a dense downmix, a sparse upmix, and a channel reordering.
+std::vector<Mix> MakeMixes() {
+    constexpr auto g = 0.70710678f;
+    std::vector<Mix> mixes;
+    // L R C LFE Ls Rs
+    mixes.push_back({"5.1 to stereo", 6, 2, {1, 0, 0, 1, g, g, 0, 0, g, 0, 0, g}});
+
+    Mix dense{"8 to 2", 8, 2, std::vector<Float32>(16)};
+    for (std::size_t i = 0; i < dense.matrix_.size(); ++i) {
+        dense.matrix_[i] = .125f * static_cast<float>(i % 5 + 1);
+    }
+    mixes.push_back(std::move(dense));
+
+    Mix upmix{"stereo to 5.1", 2, 6, std::vector<Float32>(12)};
+    upmix.matrix_[0 * 6 + 0] = upmix.matrix_[1 * 6 + 1] = 1;
+    upmix.matrix_[0 * 6 + 2] = upmix.matrix_[1 * 6 + 2] = g;
+    mixes.push_back(std::move(upmix));
+
+    Mix reorder{"8 channel reorder", 8, 8, std::vector<Float32>(64)};
+    for (UInt32 i = 0; i < 8; ++i) {
+        reorder.matrix_[i * 8 + (i + 3) % 8] = 1;
+    }
+    mixes.push_back(std::move(reorder));
+    return mixes;
+}
+
+/// Measures a mix with the mixer for each interleaving, and with a per-frame loop over interleaved samples.
+void MeasureMix(const Mix &mix) {
+    const auto items = static_cast<double>(kFrameCount) * kCallCount;
+
+    for (const auto interleaved : {true, false}) {
+        const auto bufferCount = [interleaved](UInt32 channels) { return interleaved ? 1 : channels; };
+        const auto sourceBuffers = bufferCount(mix.inputs_);
+        const auto destinationBuffers = bufferCount(mix.outputs_);
+
+        std::vector<std::vector<float>> input(sourceBuffers,
+                                              std::vector<float>(kFrameCount * mix.inputs_ / sourceBuffers, .25f));
+        std::vector<std::vector<float>> output(destinationBuffers,
+                                               std::vector<float>(kFrameCount * mix.outputs_ / destinationBuffers));
+
+        std::vector<unsigned char> inputStorage(offsetof(AudioBufferList, mBuffers) +
+                                                sizeof(AudioBuffer) * sourceBuffers);
+        auto inputList = reinterpret_cast<AudioBufferList *>(inputStorage.data());
+        inputList->mNumberBuffers = sourceBuffers;
+        for (UInt32 i = 0; i < sourceBuffers; ++i) {
+            inputList->mBuffers[i] = AudioBuffer{mix.inputs_ / sourceBuffers,
+                                                 static_cast<UInt32>(input[i].size() * sizeof(float)), input[i].data()};
+        }
+        std::vector<unsigned char> outputStorage(offsetof(AudioBufferList, mBuffers) +
+                                                 sizeof(AudioBuffer) * destinationBuffers);
+        auto outputList = reinterpret_cast<AudioBufferList *>(outputStorage.data());
+        outputList->mNumberBuffers = destinationBuffers;
+
+        ChannelMatrixMixer mixer;
+        mixer.New(MakeFormat(mix.inputs_, interleaved), MakeFormat(mix.outputs_, interleaved), mix.matrix_);
+
+        const auto name = std::string{"ChannelMatrixMixer: "} + mix.name_ +
+                          (mixer.IsSparse() ? ", sparse" : ", dense") +
+                          (interleaved ? ", interleaved" : ", non-interleaved");
+        benchmarks::Measure(name.c_str(), items, "frames", [&] {
+            for (auto n = 0; n < kCallCount; ++n) {
+                for (UInt32 i = 0; i < destinationBuffers; ++i) {
+                    outputList->mBuffers[i] =
+                            AudioBuffer{mix.outputs_ / destinationBuffers,
+                                        static_cast<UInt32>(output[i].size() * sizeof(float)), output[i].data()};
+                }
+                mixer.Process(kFrameCount, inputList, outputList);
+                benchmarks::DoNotOptimize(output.back().back());
+            }
+        });
+    }
+
+    std::vector<float> input(static_cast<std::size_t>(kFrameCount) * mix.inputs_, .25f);
+    std::vector<float> output(static_cast<std::size_t>(kFrameCount) * mix.outputs_);
+    const auto name = std::string{"ChannelMatrixMixer: "} + mix.name_ + ", per-frame loop";
+    benchmarks::Measure(name.c_str(), items, "frames", [&] {
+        for (auto n = 0; n < kCallCount; ++n) {
+            for (std::size_t frame = 0; frame < kFrameCount; ++frame) {
+                const auto *in = input.data() + frame * mix.inputs_;
+                auto *out = output.data() + frame * mix.outputs_;
+                for (UInt32 o = 0; o < mix.outputs_; ++o) {
+                    auto sum = 0.f;
+                    for (UInt32 i = 0; i < mix.inputs_; ++i) {
+                        sum += in[i] * mix.matrix_[i * mix.outputs_ + o];
+                    }
+                    out[o] = sum;
+                }
+            }
+            benchmarks::DoNotOptimize(output.back());
+        }
+    });
+}
+
+} /* namespace */
+
+void benchmarks::ChannelMatrixMixerBenchmark() {
+    for (const auto &mix : MakeMixes()) {
+        MeasureMix(mix);
+    }
+}
@@ -0,0 +1,73 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include "PCMKernels.hpp"
+
+#include <audio_toolbox/PCMFormat.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::PCMConverter;
+
+/// The number of frames converted per call.
+constexpr UInt32 kFrameCount = 4096;
+
+/// The number of calls per run.
+constexpr auto kCallCount = 256;
+
+/// The number of channels converted.
+constexpr UInt32 kChannels = 2;
+
+/// Measures converting interleaved frames with PCMConverter and with the runtime-selected built-in kernel.
+template <typename Source, typename Destination> void MeasureConversion(const char *name) {
+    constexpr auto source = Source::kDescriptor;
+    constexpr auto destination = Destination::kDescriptor;
+    std::vector<unsigned char> input(static_cast<std::size_t>(kFrameCount) * source.BytesPerFrame());
+    std::vector<unsigned char> output(static_cast<std::size_t>(kFrameCount) * destination.BytesPerFrame());
+    const auto items = static_cast<double>(kFrameCount) * kChannels * kCallCount;
+
+    benchmarks::Measure((std::string{"PCMConverter: "} + name + ", static").c_str(), items, "samples", [&] {
+        for (auto n = 0; n < kCallCount; ++n) {
+            PCMConverter<Source, Destination>::Convert(input.data(), output.data(), kFrameCount);
+            benchmarks::DoNotOptimize(output.back());
+        }
+    });
+
+    const auto converter = audio_toolbox::detail::SelectPCMSampleConverter(Source::StreamDescription(44'100),
+                                                                            Destination::StreamDescription(44'100));
+    benchmarks::Measure((std::string{"PCMConverter: "} + name + ", runtime").c_str(), items, "samples", [&] {
+        for (auto n = 0; n < kCallCount; ++n) {
+            converter(input.data(), output.data(), kFrameCount * kChannels);
+            benchmarks::DoNotOptimize(output.back());
+        }
+    });
+}
+
+} /* namespace */
+
+void benchmarks::PCMConverterBenchmark() {
+    using Float = audio_toolbox::Float32PCMFormat<kChannels>;
+    using Int16 = audio_toolbox::Int16PCMFormat<kChannels>;
+    using Int24 = audio_toolbox::Int24PCMFormat<kChannels>;
+    using Int32 = audio_toolbox::Int32PCMFormat<kChannels>;
+    using SwappedInt16 = audio_toolbox::Int16PCMFormat<kChannels, true, !audio_toolbox::detail::kNativeBigEndian>;
+
+    MeasureConversion<Int16, Float>("Int16 to Float32");
+    MeasureConversion<Float, Int16>("Float32 to Int16");
+    MeasureConversion<Float, SwappedInt16>("Float32 to byte-swapped Int16");
+    MeasureConversion<Int24, Float>("Int24 to Float32");
+    MeasureConversion<Float, Int24>("Float32 to Int24");
+    MeasureConversion<Int32, Float>("Int32 to Float32");
+    MeasureConversion<Float, Int32>("Float32 to Int32");
+}
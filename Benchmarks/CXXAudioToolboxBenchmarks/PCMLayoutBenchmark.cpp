@@ -0,0 +1,119 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include <audio_toolbox/CAAudioConverter.hpp>
+#include <audio_toolbox/PCMLayout.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::CAAudioConverter;
+
+/// The number of frames converted per call.
+constexpr UInt32 kFrameCount = 4096;
+
+/// The number of calls per run.
+constexpr auto kCallCount = 256;
+
+/// Returns a native-endian float linear PCM format.
+AudioStreamBasicDescription MakeFormat(UInt32 channels, bool interleaved) noexcept {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = 44'100;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagsNativeFloatPacked;
+    if (!interleaved) {
+        format.mFormatFlags |= kAudioFormatFlagIsNonInterleaved;
+    }
+    format.mBytesPerFrame = sizeof(float) * (interleaved ? channels : 1);
+    format.mFramesPerPacket = 1;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    format.mChannelsPerFrame = channels;
+    format.mBitsPerChannel = 32;
+    return format;
+}
+
+/// Measures deinterleaving and interleaving samples of bytesPerSample bytes for a channel count.
+void MeasureLayout(UInt32 bytesPerSample, UInt32 channels) {
+    std::vector<unsigned char> interleaved(static_cast<std::size_t>(kFrameCount) * channels * bytesPerSample);
+    std::vector<std::vector<unsigned char>> storage(channels,
+                                                    std::vector<unsigned char>(kFrameCount * bytesPerSample));
+    std::vector<void *> pointers;
+    for (auto &channel : storage) {
+        pointers.push_back(channel.data());
+    }
+
+    const auto items = static_cast<double>(kFrameCount) * channels * kCallCount;
+    const auto suffix = std::to_string(bytesPerSample * 8) + "-bit, " + std::to_string(channels) + " channels";
+
+    benchmarks::Measure(("PCMLayout: deinterleave " + suffix).c_str(), items, "samples", [&] {
+        for (auto n = 0; n < kCallCount; ++n) {
+            audio_toolbox::pcm_layout::Deinterleave(bytesPerSample, channels, kFrameCount, interleaved.data(),
+                                                    pointers.data());
+            benchmarks::DoNotOptimize(storage.back().back());
+        }
+    });
+
+    benchmarks::Measure(("PCMLayout: interleave " + suffix).c_str(), items, "samples", [&] {
+        for (auto n = 0; n < kCallCount; ++n) {
+            audio_toolbox::pcm_layout::Interleave(bytesPerSample, channels, kFrameCount, pointers.data(),
+                                                  interleaved.data());
+            benchmarks::DoNotOptimize(interleaved.back());
+        }
+    });
+}
+
+/// Measures deinterleaving float samples with CAAudioConverter::ConvertComplexBuffer with and without the PCM fast
+/// path.
+void MeasureConverter(UInt32 channels) {
+    std::vector<float> interleaved(static_cast<std::size_t>(kFrameCount) * channels);
+    std::vector<std::vector<float>> storage(channels, std::vector<float>(kFrameCount));
+
+    AudioBufferList input{1, {{channels, static_cast<UInt32>(interleaved.size() * sizeof(float)),
+                               interleaved.data()}}};
+    std::vector<unsigned char> outputStorage(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * channels);
+    auto output = reinterpret_cast<AudioBufferList *>(outputStorage.data());
+    output->mNumberBuffers = channels;
+
+    const auto items = static_cast<double>(kFrameCount) * channels * kCallCount;
+    for (const auto enabled : {false, true}) {
+        CAAudioConverter converter;
+        converter.New(MakeFormat(channels, true), MakeFormat(channels, false));
+        converter.SetPCMFastPathEnabled(enabled);
+
+        const auto name = std::string{"PCMLayout: "} + (enabled ? "fast path" : "AudioConverter") + " deinterleave, " +
+                          std::to_string(channels) + " channels";
+        benchmarks::Measure(name.c_str(), items, "samples", [&] {
+            for (auto n = 0; n < kCallCount; ++n) {
+                for (UInt32 c = 0; c < channels; ++c) {
+                    output->mBuffers[c] = AudioBuffer{1, kFrameCount * sizeof(float), storage[c].data()};
+                }
+                converter.ConvertComplexBuffer(kFrameCount, &input, output);
+                benchmarks::DoNotOptimize(storage.back().back());
+            }
+        });
+    }
+}
+
+} /* namespace */
+
+void benchmarks::PCMLayoutBenchmark() {
+    for (const auto bytesPerSample : {2U, 4U}) {
+        for (const auto channels : {2U, 4U, 6U, 8U}) {
+            MeasureLayout(bytesPerSample, channels);
+        }
+    }
+
+    for (const auto channels : {2U, 6U, 8U}) {
+        MeasureConverter(channels);
+    }
+}
@@ -0,0 +1,94 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include <audio_toolbox/CAAudioFile.hpp>
+#include <audio_toolbox/PacketPrefetcher.hpp>
+
+#include <test_support/Fixtures.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::CAAudioFile;
+using audio_toolbox::PacketPrefetcher;
+
+/// The number of frames in the benchmark file.
+constexpr UInt32 kFrameCount = 44'100 * 120;
+/// The number of packets read at a time.
+constexpr UInt32 kPacketsPerChunk = 4096;
+
+/// Opens an audio file for reading.
+CAAudioFile OpenAudioFile(const std::string &path) {
+    const auto url = test_support::detail::CreateURL(path);
+    CAAudioFile file;
+    file.OpenURL(url.get(), kAudioFileReadPermission, 0);
+    return file;
+}
+
+/// Simulates consumer work proportional to the size of a chunk of packets.
+UInt64 Consume(const unsigned char *data, UInt32 byteCount) noexcept {
+    auto hash = UInt64{0xcbf29ce484222325};
+    for (UInt32 i = 0; i < byteCount; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001b3;
+    }
+    return hash;
+}
+
+} /* namespace */
+
+void benchmarks::PacketPrefetcherBenchmark() {
+    test_support::detail::TemporaryDirectory directory;
+    const auto path = directory.Path("aac.m4a");
+    test_support::detail::WriteTestFile(
+            path, kAudioFileM4AType, test_support::detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, 2),
+            kFrameCount);
+
+    auto file = OpenAudioFile(path);
+    const auto packetCount = static_cast<double>(file.AudioDataPacketCount());
+
+    UInt32 maximumPacketSize;
+    UInt32 size = sizeof maximumPacketSize;
+    file.GetProperty(kAudioFilePropertyMaximumPacketSize, size, &maximumPacketSize);
+
+    std::vector<unsigned char> data(static_cast<std::size_t>(maximumPacketSize) * kPacketsPerChunk);
+    std::vector<AudioStreamPacketDescription> descriptions(kPacketsPerChunk);
+
+    Measure("PacketPrefetcher: ReadPacketData then consume", packetCount, "packets", [&] {
+        UInt64 hash = 0;
+        for (SInt64 packet = 0;;) {
+            auto byteCount = static_cast<UInt32>(data.size());
+            auto count = kPacketsPerChunk;
+            file.ReadPacketData(false, byteCount, descriptions.data(), packet, count, data.data());
+            if (count == 0) {
+                break;
+            }
+            hash ^= Consume(data.data(), byteCount);
+            packet += count;
+        }
+        DoNotOptimize(hash);
+    });
+
+    for (const auto chunksInFlight : {1U, 2U, 4U, 8U}) {
+        PacketPrefetcher prefetcher{OpenAudioFile(path), kPacketsPerChunk, chunksInFlight};
+        const auto name = "PacketPrefetcher: prefetch " + std::to_string(chunksInFlight) + " chunks and consume";
+        Measure(name.c_str(), packetCount, "packets", [&] {
+            UInt64 hash = 0;
+            prefetcher.Start();
+            PacketPrefetcher::Chunk chunk;
+            while (prefetcher.ReadNext(chunk)) {
+                hash ^= Consume(chunk.data_.data(), chunk.byteCount_);
+            }
+            DoNotOptimize(hash);
+        });
+    }
+}
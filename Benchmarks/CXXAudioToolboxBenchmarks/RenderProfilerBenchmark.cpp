@@ -0,0 +1,92 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include "RenderCycleTimer.hpp"
+
+#include <audio_toolbox/TimingHistogram.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::TimingHistogram;
+using audio_toolbox::detail::RenderCycleTimer;
+
+/// The number of durations recorded per run.
+constexpr std::size_t kDurationCount = 1'000'000;
+
+/// The number of render cycles timed per run.
+constexpr auto kCycleCount = 20'000;
+
+/// Times kCycleCount render cycles in which the head node pulls every other node, nested as a chain or in turn.
+void MeasureCycles(std::size_t nodeCount, bool chain) {
+    const auto timer = std::make_unique<RenderCycleTimer>(nodeCount);
+    const auto deadline = std::chrono::duration_cast<RenderCycleTimer::Clock::duration>(std::chrono::milliseconds{10});
+    const auto name = "RenderProfiler: " + std::to_string(nodeCount) + " nodes, " + (chain ? "chain" : "fan-in");
+    const auto notifications = static_cast<double>(kCycleCount) * static_cast<double>(2 * nodeCount + 2);
+
+    benchmarks::Measure(name.c_str(), notifications, "notifications", [&] {
+        using Clock = RenderCycleTimer::Clock;
+        for (auto n = 0; n < kCycleCount; ++n) {
+            timer->BeginCycle(deadline, Clock::now());
+            timer->BeginNode(0, Clock::now());
+            if (chain) {
+                for (std::size_t i = 1; i < nodeCount; ++i) {
+                    timer->BeginNode(i, Clock::now());
+                }
+                for (auto i = nodeCount - 1; i > 0; --i) {
+                    timer->EndNode(i, Clock::now());
+                }
+            } else {
+                for (std::size_t i = 1; i < nodeCount; ++i) {
+                    timer->BeginNode(i, Clock::now());
+                    timer->EndNode(i, Clock::now());
+                }
+            }
+            timer->EndNode(0, Clock::now());
+            timer->EndCycle(Clock::now());
+        }
+        benchmarks::DoNotOptimize(timer->DeadlineMisses());
+    });
+}
+
+} /* namespace */
+
+void benchmarks::RenderProfilerBenchmark() {
+    // Durations of up to about 2 ms spread over many buckets, generated in advance
+    std::vector<std::chrono::nanoseconds> durations(kDurationCount);
+    auto state = std::uint64_t{0x9e3779b97f4a7c15};
+    for (auto &duration : durations) {
+        state = state * 6364136223846793005 + 1442695040888963407;
+        const auto bits = 6 + (state >> 59) % 16;
+        const auto value = (state >> 20) & ((std::uint64_t{1} << bits) - 1);
+        duration = std::chrono::nanoseconds{static_cast<std::int64_t>(value)};
+    }
+
+    // The histogram is large, so it is not placed on the stack
+    const auto histogram = std::make_unique<TimingHistogram>();
+    Measure("RenderProfiler: TimingHistogram::Record", kDurationCount, "durations", [&] {
+        for (const auto duration : durations) {
+            histogram->Record(duration);
+        }
+        DoNotOptimize(histogram.get());
+    });
+
+    for (const std::size_t nodeCount : {2, 8, 32}) {
+        MeasureCycles(nodeCount, true);
+        MeasureCycles(nodeCount, false);
+    }
+}
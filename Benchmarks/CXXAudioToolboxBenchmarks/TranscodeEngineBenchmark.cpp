@@ -0,0 +1,60 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include <audio_toolbox/TranscodeEngine.hpp>
+
+#include <test_support/Fixtures.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::TranscodeEngine;
+
+/// The number of files transcoded.
+constexpr auto kFileCount = 32;
+
+/// The number of frames in each file.
+constexpr UInt32 kFrameCount = 5 * 44'100;
+
+} /* namespace */
+
+void benchmarks::TranscodeEngineBenchmark() {
+    test_support::detail::TemporaryDirectory directory;
+
+    // Encoding AAC makes each job CPU-bound, so throughput reflects the work spread across threads
+    std::vector<TranscodeEngine::Job> jobs;
+    for (auto i = 0; i < kFileCount; ++i) {
+        TranscodeEngine::Job job;
+        job.sourcePath_ = directory.Path((std::to_string(i) + ".caf").c_str());
+        job.destinationPath_ = directory.Path((std::to_string(i) + ".m4a").c_str());
+        job.fileType_ = kAudioFileM4AType;
+        job.format_ = test_support::detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, 2);
+        test_support::detail::WriteTestFile(job.sourcePath_, kAudioFileCAFType,
+                                            test_support::detail::MakeInt16Format(44'100, 2, false), kFrameCount);
+        jobs.push_back(std::move(job));
+    }
+
+    const auto maximumThreadCount = std::max(std::thread::hardware_concurrency(), 1U);
+    for (auto threadCount = 1U;; threadCount = std::min(threadCount * 2, maximumThreadCount)) {
+        TranscodeEngine engine{threadCount};
+        const auto name = "TranscodeEngine: " + std::to_string(threadCount) + " threads";
+        Measure(name.c_str(), static_cast<double>(kFileCount) * kFrameCount, "frames", [&] {
+            const auto results = engine.Transcode(jobs);
+            DoNotOptimize(results.data());
+        });
+        if (threadCount == maximumThreadCount) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmark.hpp"
+#include "Benchmarks.hpp"
+
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace {
+
+using audio_toolbox::detail::WorkStealingPool;
+
+/// The number of tasks submitted per run.
+constexpr auto kTaskCount = 20'000;
+
+/// Performs work proportional to cost.
+std::uint64_t Work(unsigned cost) noexcept {
+    auto hash = std::uint64_t{0xcbf29ce484222325};
+    for (unsigned i = 0; i < cost; ++i) {
+        hash = (hash ^ i) * 0x100000001b3;
+    }
+    return hash;
+}
+
+} /* namespace */
+
+void benchmarks::WorkStealingPoolBenchmark() {
+    const auto maximumThreadCount = std::max(std::thread::hardware_concurrency(), 1U);
+    for (auto threadCount = 1U;; threadCount = std::min(threadCount * 2, maximumThreadCount)) {
+        WorkStealingPool pool{threadCount};
+
+        // Every sixteenth task is a hundred times as costly, so queues assigned round-robin become unbalanced
+        // unless idle workers steal
+        const auto name = "WorkStealingPool: uneven tasks, " + std::to_string(threadCount) + " threads";
+        Measure(name.c_str(), kTaskCount, "tasks", [&] {
+            std::atomic<std::uint64_t> hash{0};
+            for (auto i = 0; i < kTaskCount; ++i) {
+                pool.Submit([&hash, i](unsigned) { hash ^= Work(i % 16 == 0 ? 100'000 : 1'000); });
+            }
+            pool.Wait();
+            DoNotOptimize(hash.load());
+        });
+        if (threadCount == maximumThreadCount) {
+            break;
+        }
+    }
+}
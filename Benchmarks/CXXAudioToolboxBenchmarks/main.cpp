@@ -0,0 +1,57 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "Benchmarks.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+namespace {
+
+/// A named benchmark.
+struct Benchmark {
+    const char *name_;
+    void (*run_)();
+};
+
+/// All benchmarks, in the order they are run.
+constexpr Benchmark kBenchmarks[] = {
+        {"AudioFileInfoCache", &benchmarks::AudioFileInfoCacheBenchmark},
+        {"BatchProbe", &benchmarks::BatchProbeBenchmark},
+        {"ChannelMatrixMixer", &benchmarks::ChannelMatrixMixerBenchmark},
+        {"PacketPrefetcher", &benchmarks::PacketPrefetcherBenchmark},
+        {"PCMConverter", &benchmarks::PCMConverterBenchmark},
+        {"PCMLayout", &benchmarks::PCMLayoutBenchmark},
+        {"RenderProfiler", &benchmarks::RenderProfilerBenchmark},
+        {"TranscodeEngine", &benchmarks::TranscodeEngineBenchmark},
+        {"WorkStealingPool", &benchmarks::WorkStealingPoolBenchmark},
+};
+
+} /* namespace */
+
+/// Runs the benchmarks whose names contain any of the command-line arguments, or all benchmarks if none are given.
+int main(int argc, char *argv[]) {
+    auto result = 0;
+    for (const auto &benchmark : kBenchmarks) {
+        auto selected = argc < 2;
+        for (auto i = 1; i < argc && !selected; ++i) {
+            selected = std::strstr(benchmark.name_, argv[i]) != nullptr;
+        }
+        if (!selected) {
+            continue;
+        }
+
+        try {
+            benchmark.run_();
+        } catch (const std::exception &e) {
+            std::fprintf(stderr, "%s: %s\n", benchmark.name_, e.what());
+            result = 1;
+        }
+    }
+    return result;
+}
@@ -34,10 +34,33 @@ let package = Package(
                 .linkedFramework("AudioToolbox"),
             ]
         ),
+        .target(
+            name: "CXXAudioToolboxTestSupport",
+            dependencies: [
+                "CXXAudioToolbox",
+            ],
+            path: "Tests/CXXAudioToolboxTestSupport",
+            cxxSettings: [
+                // Tests of portable internals include their private headers
+                .headerSearchPath("../../Sources/CXXAudioToolbox"),
+            ]
+        ),
+        .executableTarget(
+            name: "CXXAudioToolboxBenchmarks",
+            dependencies: [
+                "CXXAudioToolbox",
+                "CXXAudioToolboxTestSupport",
+            ],
+            path: "Benchmarks/CXXAudioToolboxBenchmarks",
+            cxxSettings: [
+                .headerSearchPath("../../Sources/CXXAudioToolbox"),
+            ]
+        ),
         .testTarget(
             name: "CXXAudioToolboxTests",
             dependencies: [
                 "CXXAudioToolbox",
+                "CXXAudioToolboxTestSupport",
             ],
             swiftSettings: [
                 .interoperabilityMode(.Cxx),
@@ -0,0 +1,98 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/AudioFileInfoCache.hpp"
+#include "audio_toolbox/CAAudioFile.hpp"
+
+#include "MemoTable.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::detail::MemoTable;
+
+/// A retained CFStringRef usable as a hash table key.
+class StringKey final {
+  public:
+    explicit StringKey(CFStringRef string) noexcept : string_{static_cast<CFStringRef>(CFRetain(string))} {}
+    StringKey(const StringKey &other) noexcept : StringKey(other.string_) {}
+    StringKey &operator=(const StringKey &) = delete;
+    ~StringKey() noexcept { CFRelease(string_); }
+
+    bool operator==(const StringKey &other) const noexcept { return CFEqual(string_, other.string_); }
+
+    /// The key.
+    CFStringRef string_;
+};
+
+/// Hash function for StringKey.
+struct StringKeyHash {
+    std::size_t operator()(const StringKey &key) const noexcept { return CFHash(key.string_); }
+};
+
+/// Selectors for the unkeyed type lists.
+enum class TypeList { readable, writable };
+
+/// Hash function for TypeList.
+struct TypeListHash {
+    std::size_t operator()(TypeList list) const noexcept { return static_cast<std::size_t>(list); }
+};
+
+MemoTable<TypeList, std::vector<AudioFileTypeID>, TypeListHash> typeLists;
+MemoTable<UInt64, std::vector<core_audio::StreamDescription>> streamDescriptions;
+MemoTable<AudioFileTypeID, std::vector<AudioFormatID>> formatIDs;
+MemoTable<StringKey, std::vector<AudioFileTypeID>, StringKeyHash> typesForMIMEType;
+MemoTable<StringKey, std::vector<AudioFileTypeID>, StringKeyHash> typesForUTI;
+MemoTable<StringKey, std::vector<AudioFileTypeID>, StringKeyHash> typesForExtension;
+
+} /* namespace */
+
+audio_toolbox::AudioFileInfoCache::FileTypeList audio_toolbox::AudioFileInfoCache::ReadableTypes() {
+    return typeLists.Get(TypeList::readable, CAAudioFile::ReadableTypes);
+}
+
+audio_toolbox::AudioFileInfoCache::FileTypeList audio_toolbox::AudioFileInfoCache::WritableTypes() {
+    return typeLists.Get(TypeList::writable, CAAudioFile::WritableTypes);
+}
+
+audio_toolbox::AudioFileInfoCache::StreamDescriptionList
+audio_toolbox::AudioFileInfoCache::AvailableStreamDescriptions(AudioFileTypeID fileType, AudioFormatID formatID) {
+    const auto key = (static_cast<UInt64>(fileType) << 32) | formatID;
+    return streamDescriptions.Get(
+            key, [fileType, formatID] { return CAAudioFile::AvailableStreamDescriptions(fileType, formatID); });
+}
+
+audio_toolbox::AudioFileInfoCache::FormatIDList
+audio_toolbox::AudioFileInfoCache::AvailableFormatIDs(AudioFileTypeID type) {
+    return formatIDs.Get(type, [type] { return CAAudioFile::AvailableFormatIDs(type); });
+}
+
+audio_toolbox::AudioFileInfoCache::FileTypeList
+audio_toolbox::AudioFileInfoCache::TypesForMIMEType(CFStringRef mimeType) {
+    return typesForMIMEType.Get(StringKey{mimeType}, [mimeType] { return CAAudioFile::TypesForMIMEType(mimeType); });
+}
+
+audio_toolbox::AudioFileInfoCache::FileTypeList audio_toolbox::AudioFileInfoCache::TypesForUTI(CFStringRef uti) {
+    return typesForUTI.Get(StringKey{uti}, [uti] { return CAAudioFile::TypesForUTI(uti); });
+}
+
+audio_toolbox::AudioFileInfoCache::FileTypeList
+audio_toolbox::AudioFileInfoCache::TypesForExtension(CFStringRef extension) {
+    return typesForExtension.Get(StringKey{extension},
+                                 [extension] { return CAAudioFile::TypesForExtension(extension); });
+}
+
+void audio_toolbox::AudioFileInfoCache::Invalidate() noexcept {
+    typeLists.Clear();
+    streamDescriptions.Clear();
+    formatIDs.Clear();
+    typesForMIMEType.Clear();
+    typesForUTI.Clear();
+    typesForExtension.Clear();
+}
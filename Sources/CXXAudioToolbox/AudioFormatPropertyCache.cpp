@@ -0,0 +1,259 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/AudioFormatPropertyCache.hpp"
+#include "audio_toolbox/CAAudioFormat.hpp"
+
+#include <core_audio/ChannelLayout.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+/// Appends the bytes of an object to key.
+void AppendBytes(std::string &key, const void *_Nullable bytes, std::size_t size) {
+    if (bytes && size > 0) {
+        key.append(static_cast<const char *>(bytes), size);
+    }
+}
+
+/// Appends a channel layout, or a marker if layout is null, to key.
+void AppendChannelLayout(std::string &key, const AudioChannelLayout *_Nullable layout) {
+    const UInt32 size = layout ? static_cast<UInt32>(core_audio::audioChannelLayoutSize(layout)) : 0;
+    AppendBytes(key, &size, sizeof size);
+    AppendBytes(key, layout, size);
+}
+
+/// Returns the cache key for a property and specifier.
+std::string MakeKey(AudioFormatPropertyID inPropertyID, UInt32 inSpecifierSize, const void *_Nullable inSpecifier) {
+    std::string key;
+    key.reserve(sizeof inPropertyID + inSpecifierSize);
+    AppendBytes(key, &inPropertyID, sizeof inPropertyID);
+
+    switch (inPropertyID) {
+    case kAudioFormatProperty_FormatList:
+        // The specifier is an AudioFormatInfo pointing to a magic cookie
+        if (inSpecifierSize == sizeof(AudioFormatInfo) && inSpecifier) {
+            const auto formatInfo = static_cast<const AudioFormatInfo *>(inSpecifier);
+            AppendBytes(key, &formatInfo->mASBD, sizeof formatInfo->mASBD);
+            AppendBytes(key, &formatInfo->mMagicCookieSize, sizeof formatInfo->mMagicCookieSize);
+            AppendBytes(key, formatInfo->mMagicCookie, formatInfo->mMagicCookieSize);
+            return key;
+        }
+        break;
+
+    case kAudioFormatProperty_ChannelMap:
+    case kAudioFormatProperty_MatrixMixMap:
+        // The specifier is an array of two channel layout pointers
+        if (inSpecifierSize == 2 * sizeof(const AudioChannelLayout *) && inSpecifier) {
+            const auto layouts = static_cast<const AudioChannelLayout *const *>(inSpecifier);
+            AppendChannelLayout(key, layouts[0]);
+            AppendChannelLayout(key, layouts[1]);
+            return key;
+        }
+        break;
+    }
+
+    AppendBytes(key, inSpecifier, inSpecifierSize);
+    return key;
+}
+
+} /* namespace */
+
+audio_toolbox::AudioFormatPropertyCache &audio_toolbox::AudioFormatPropertyCache::Shared() {
+    static AudioFormatPropertyCache cache;
+    return cache;
+}
+
+bool audio_toolbox::AudioFormatPropertyCache::IsCacheable(AudioFormatPropertyID inPropertyID) noexcept {
+    switch (inPropertyID) {
+    case kAudioFormatProperty_FormatList:
+    case kAudioFormatProperty_FormatIsVBR:
+    case kAudioFormatProperty_FormatIsExternallyFramed:
+    case kAudioFormatProperty_FormatIsEncrypted:
+    case kAudioFormatProperty_EncodeFormatIDs:
+    case kAudioFormatProperty_DecodeFormatIDs:
+    case kAudioFormatProperty_Encoders:
+    case kAudioFormatProperty_Decoders:
+    case kAudioFormatProperty_AvailableEncodeBitRates:
+    case kAudioFormatProperty_AvailableEncodeSampleRates:
+    case kAudioFormatProperty_AvailableEncodeChannelLayoutTags:
+    case kAudioFormatProperty_AvailableEncodeNumberChannels:
+    case kAudioFormatProperty_ChannelLayoutForTag:
+    case kAudioFormatProperty_ChannelLayoutForBitmap:
+    case kAudioFormatProperty_BitmapForLayoutTag:
+    case kAudioFormatProperty_NumberOfChannelsForLayout:
+    case kAudioFormatProperty_TagsForNumberOfChannels:
+    case kAudioFormatProperty_ChannelMap:
+    case kAudioFormatProperty_MatrixMixMap:
+        return true;
+
+    // Other properties return retained objects, depend on the contents of the output buffer, or are not pure
+    default:
+        return false;
+    }
+}
+
+audio_toolbox::AudioFormatPropertyCache::AudioFormatPropertyCache(std::size_t capacity) noexcept
+    : capacity_{capacity} {}
+
+UInt32 audio_toolbox::AudioFormatPropertyCache::GetPropertyInfo(AudioFormatPropertyID inPropertyID,
+                                                                UInt32 inSpecifierSize,
+                                                                const void *_Nullable inSpecifier) {
+    if (!IsCacheable(inPropertyID)) {
+        {
+            std::lock_guard lock{mutex_};
+            ++bypasses_;
+        }
+        return CAAudioFormat::GetPropertyInfo(inPropertyID, inSpecifierSize, inSpecifier);
+    }
+
+    {
+        std::lock_guard lock{mutex_};
+        if (const auto *value = Find(MakeKey(inPropertyID, inSpecifierSize, inSpecifier)); value) {
+            return static_cast<UInt32>(value->size());
+        }
+        ++misses_;
+    }
+
+    // Only the size is retrieved so a size query does not fetch and cache a value that may never be read
+    return CAAudioFormat::GetPropertyInfo(inPropertyID, inSpecifierSize, inSpecifier);
+}
+
+void audio_toolbox::AudioFormatPropertyCache::GetProperty(AudioFormatPropertyID inPropertyID, UInt32 inSpecifierSize,
+                                                          const void *_Nullable inSpecifier,
+                                                          UInt32 &ioPropertyDataSize, void *_Nullable outPropertyData) {
+    if (!IsCacheable(inPropertyID)) {
+        {
+            std::lock_guard lock{mutex_};
+            ++bypasses_;
+        }
+        CAAudioFormat::GetProperty(inPropertyID, inSpecifierSize, inSpecifier, ioPropertyDataSize, outPropertyData);
+        return;
+    }
+
+    std::unique_lock lock{mutex_};
+    const auto &value = Lookup(inPropertyID, inSpecifierSize, inSpecifier, lock);
+    // A buffer smaller than the value receives its leading portion
+    const auto size = outPropertyData ? std::min(ioPropertyDataSize, static_cast<UInt32>(value.size()))
+                                      : static_cast<UInt32>(value.size());
+    ioPropertyDataSize = size;
+    if (outPropertyData && size > 0) {
+        std::memcpy(outPropertyData, value.data(), size);
+    }
+}
+
+std::vector<AudioFormatID> audio_toolbox::AudioFormatPropertyCache::EncodeFormatIDs() {
+    std::unique_lock lock{mutex_};
+    const auto &value = Lookup(kAudioFormatProperty_EncodeFormatIDs, 0, nullptr, lock);
+    auto formatIDs = std::vector<AudioFormatID>(value.size() / sizeof(AudioFormatID));
+    std::memcpy(formatIDs.data(), value.data(), formatIDs.size() * sizeof(AudioFormatID));
+    return formatIDs;
+}
+
+std::vector<AudioFormatID> audio_toolbox::AudioFormatPropertyCache::DecodeFormatIDs() {
+    std::unique_lock lock{mutex_};
+    const auto &value = Lookup(kAudioFormatProperty_DecodeFormatIDs, 0, nullptr, lock);
+    auto formatIDs = std::vector<AudioFormatID>(value.size() / sizeof(AudioFormatID));
+    std::memcpy(formatIDs.data(), value.data(), formatIDs.size() * sizeof(AudioFormatID));
+    return formatIDs;
+}
+
+audio_toolbox::AudioFormatPropertyCache::Statistics audio_toolbox::AudioFormatPropertyCache::GetStatistics() const {
+    std::lock_guard lock{mutex_};
+    Statistics statistics;
+    statistics.hits_ = hits_;
+    statistics.misses_ = misses_;
+    statistics.evictions_ = evictions_;
+    statistics.bypasses_ = bypasses_;
+    statistics.size_ = size_;
+    return statistics;
+}
+
+void audio_toolbox::AudioFormatPropertyCache::ResetStatistics() {
+    std::lock_guard lock{mutex_};
+    hits_ = 0;
+    misses_ = 0;
+    evictions_ = 0;
+    bypasses_ = 0;
+}
+
+void audio_toolbox::AudioFormatPropertyCache::Clear() {
+    std::lock_guard lock{mutex_};
+    index_.clear();
+    entries_.clear();
+    size_ = 0;
+}
+
+const std::vector<unsigned char> &
+audio_toolbox::AudioFormatPropertyCache::Lookup(AudioFormatPropertyID inPropertyID, UInt32 inSpecifierSize,
+                                                const void *_Nullable inSpecifier, std::unique_lock<std::mutex> &lock) {
+    auto key = MakeKey(inPropertyID, inSpecifierSize, inSpecifier);
+
+    if (const auto *value = Find(key); value) {
+        return *value;
+    }
+
+    ++misses_;
+
+    // AudioFormat is queried without holding the lock; concurrent misses for the same key are harmless
+    lock.unlock();
+    std::vector<unsigned char> value;
+    try {
+        auto size = CAAudioFormat::GetPropertyInfo(inPropertyID, inSpecifierSize, inSpecifier);
+        value.resize(size);
+        CAAudioFormat::GetProperty(inPropertyID, inSpecifierSize, inSpecifier, size, value.data());
+        value.resize(size);
+    } catch (...) {
+        lock.lock();
+        throw;
+    }
+    lock.lock();
+
+    if (const auto it = index_.find(key); it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->value_;
+    }
+
+    size_ += key.size() + value.size();
+    entries_.push_front({std::move(key), std::move(value)});
+    try {
+        index_.emplace(entries_.front().key_, entries_.begin());
+    } catch (...) {
+        size_ -= entries_.front().key_.size() + entries_.front().value_.size();
+        entries_.pop_front();
+        throw;
+    }
+
+    Trim();
+
+    return entries_.front().value_;
+}
+
+const std::vector<unsigned char> *_Nullable audio_toolbox::AudioFormatPropertyCache::Find(
+        const std::string &key) noexcept {
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->value_;
+}
+
+void audio_toolbox::AudioFormatPropertyCache::Trim() noexcept {
+    // The most recently used entry is retained even if it alone exceeds the capacity
+    while (size_ > capacity_ && entries_.size() > 1) {
+        const auto &entry = entries_.back();
+        size_ -= entry.key_.size() + entry.value_.size();
+        index_.erase(entry.key_);
+        entries_.pop_back();
+        ++evictions_;
+    }
+}
@@ -0,0 +1,79 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/BatchProbe.hpp"
+#include "audio_toolbox/CAAudioFile.hpp"
+#include "audio_toolbox/CAExtAudioFile.hpp"
+
+#include "WorkStealingPool.hpp"
+
+#include <system_error>
+
+namespace {
+
+/// Deleter for CoreFoundation objects.
+struct CFReleaser {
+    void operator()(CFTypeRef cf) const noexcept { CFRelease(cf); }
+};
+
+} /* namespace */
+
+audio_toolbox::BatchProbe::BatchProbe(unsigned threadCount)
+    : pool_{std::make_unique<detail::WorkStealingPool>(threadCount)} {}
+
+audio_toolbox::BatchProbe::~BatchProbe() noexcept = default;
+
+unsigned audio_toolbox::BatchProbe::ThreadCount() const noexcept { return pool_->ThreadCount(); }
+
+std::vector<audio_toolbox::BatchProbe::Result> audio_toolbox::BatchProbe::Probe(const std::vector<std::string> &paths) {
+    std::vector<Result> results(paths.size());
+
+    // The tasks refer to paths and results, so submitted tasks must finish before either is destroyed
+    try {
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            pool_->Submit([&paths, &results, i](unsigned) {
+                auto &result = results[i];
+                try {
+                    const auto &path = paths[i];
+                    std::unique_ptr<const __CFURL, CFReleaser> url{CFURLCreateFromFileSystemRepresentation(
+                            kCFAllocatorDefault, reinterpret_cast<const UInt8 *>(path.c_str()),
+                            static_cast<CFIndex>(path.size()), false)};
+                    if (!url) {
+                        throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                                "CFURLCreateFromFileSystemRepresentation");
+                    }
+                    result = ProbeFile(url.get());
+                } catch (...) {
+                    result.error_ = std::current_exception();
+                }
+            });
+        }
+    } catch (...) {
+        pool_->Wait();
+        throw;
+    }
+
+    pool_->Wait();
+
+    return results;
+}
+
+audio_toolbox::BatchProbe::Result audio_toolbox::BatchProbe::ProbeFile(CFURLRef inURL) {
+    // The extended audio file wraps the audio file so the file is only opened once
+    CAAudioFile audioFile;
+    audioFile.OpenURL(inURL, kAudioFileReadPermission, 0);
+
+    CAExtAudioFile extAudioFile;
+    extAudioFile.WrapAudioFileID(audioFile, false);
+
+    Result result;
+    result.fileFormat_ = audioFile.FileFormat();
+    result.dataFormat_ = extAudioFile.FileDataFormat();
+    result.channelLayout_ = extAudioFile.FileChannelLayout();
+    result.frameLength_ = extAudioFile.FrameLength();
+    return result;
+}
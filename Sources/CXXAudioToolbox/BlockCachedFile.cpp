@@ -0,0 +1,445 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/BlockCachedFile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+/// The maximum number of blocks read by a single system call.
+constexpr UInt32 kMaximumRunLength = 64;
+
+} /* namespace */
+
+audio_toolbox::BlockCachedFile::BlockCachedFile() : BlockCachedFile(Configuration{}) {}
+
+audio_toolbox::BlockCachedFile::BlockCachedFile(const Configuration &configuration) : configuration_{configuration} {
+    if (configuration_.blockSize_ == 0 || configuration_.blockCount_ < 2) {
+        throw std::invalid_argument("blockSize must be greater than 0 and blockCount at least 2");
+    }
+    if (configuration_.prefetchBlockCount_ >= configuration_.blockCount_) {
+        throw std::invalid_argument("prefetchBlockCount must be less than blockCount");
+    }
+}
+
+audio_toolbox::BlockCachedFile::~BlockCachedFile() noexcept { Close(); }
+
+void audio_toolbox::BlockCachedFile::Open(const char *path) {
+    Close();
+
+    const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), "open");
+    }
+
+    struct stat s;
+    if (::fstat(fd, &s) == -1) {
+        const auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+
+    try {
+        if (!arena_) {
+            arena_ = std::make_unique<unsigned char[]>(static_cast<std::size_t>(configuration_.blockSize_) *
+                                                       configuration_.blockCount_);
+            slots_.resize(configuration_.blockCount_);
+            ResetSlots();
+        }
+        blockToSlot_.reserve(configuration_.blockCount_);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+
+    fd_ = fd;
+    size_ = s.st_size;
+
+    // Read-ahead is only useful for sequential access, so the advice is purely a hint
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif /* defined(POSIX_FADV_SEQUENTIAL) */
+
+    try {
+        for (UInt32 i = 0; i < configuration_.workerCount_ && configuration_.prefetchBlockCount_ > 0; ++i) {
+            workers_.emplace_back(&BlockCachedFile::WorkerThreadEntry, this);
+        }
+    } catch (...) {
+        Close();
+        throw;
+    }
+}
+
+void audio_toolbox::BlockCachedFile::Open(CFURLRef inURL) {
+    char path[PATH_MAX];
+    if (!CFURLGetFileSystemRepresentation(inURL, true, reinterpret_cast<UInt8 *>(path), PATH_MAX)) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), "CFURLGetFileSystemRepresentation");
+    }
+    Open(path);
+}
+
+void audio_toolbox::BlockCachedFile::Close() noexcept {
+    StopWorkers();
+
+    if (fd_ != -1) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    size_ = 0;
+
+    std::lock_guard lock{mutex_};
+    ResetSlots();
+    blockToSlot_.clear();
+    requests_.clear();
+    nextSequentialPosition_ = -1;
+}
+
+std::size_t audio_toolbox::BlockCachedFile::Read(SInt64 inPosition, std::size_t inByteCount, void *outBuffer) {
+    if (fd_ == -1) {
+        throw std::system_error(std::make_error_code(std::errc::bad_file_descriptor), "BlockCachedFile::Read");
+    }
+    if (inPosition < 0) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), "BlockCachedFile::Read");
+    }
+    if (inPosition >= size_) {
+        return 0;
+    }
+
+    const auto byteCount =
+            static_cast<std::size_t>(std::min<SInt64>(static_cast<SInt64>(inByteCount), size_ - inPosition));
+    const auto blockSize = static_cast<SInt64>(configuration_.blockSize_);
+    const auto lastBlock = (inPosition + static_cast<SInt64>(byteCount) - 1) / blockSize;
+    auto output = static_cast<unsigned char *>(outBuffer);
+
+    bytesRequested_.fetch_add(byteCount, std::memory_order_relaxed);
+
+    std::unique_lock lock{mutex_};
+
+    std::size_t bytesCopied = 0;
+    while (bytesCopied < byteCount) {
+        const auto position = inPosition + static_cast<SInt64>(bytesCopied);
+        const auto block = position / blockSize;
+        const auto offset = static_cast<UInt32>(position % blockSize);
+
+        if (auto slot = FindSlot(block); slot) {
+            // A block being read ahead is worth waiting for
+            if (slot->loading_) {
+                loadedCondition_.wait(lock);
+                continue;
+            }
+
+            cacheHits_.fetch_add(1, std::memory_order_relaxed);
+
+            // The file may have been truncated since it was opened
+            if (slot->length_ <= offset) {
+                break;
+            }
+
+            // A block being copied from is not evictable, so the copy is made without holding the lock
+            const auto index = static_cast<UInt32>(slot - slots_.data());
+            if (slot->readers_++ == 0) {
+                Unlink(index);
+            }
+
+            const auto count = std::min<std::size_t>(slot->length_ - offset, byteCount - bytesCopied);
+            lock.unlock();
+            std::memcpy(output + bytesCopied,
+                        arena_.get() + static_cast<std::size_t>(index) * configuration_.blockSize_ + offset, count);
+            lock.lock();
+
+            if (--slot->readers_ == 0) {
+                LinkMostRecent(index);
+                loadedCondition_.notify_all();
+            }
+            bytesCopied += count;
+            continue;
+        }
+
+        // Read the missing blocks needed by this request with one system call
+        const auto wanted =
+                static_cast<UInt32>(std::min<SInt64>(lastBlock - block + 1, configuration_.blockCount_ / 2));
+        const auto run = ClaimRun(block, wanted);
+        if (run.empty()) {
+            // Every slot is being loaded or copied from
+            loadedCondition_.wait(lock);
+            continue;
+        }
+
+        cacheMisses_.fetch_add(run.size(), std::memory_order_relaxed);
+
+        lock.unlock();
+        const auto error = LoadRun(block, run);
+        lock.lock();
+
+        if (error) {
+            throw std::system_error(error, std::generic_category(), "preadv");
+        }
+    }
+
+    // Sequential access schedules the blocks following the request to be read ahead
+    if (inPosition == nextSequentialPosition_ && !workers_.empty()) {
+        const auto firstBlock = lastBlock + 1;
+        auto run = ClaimRun(firstBlock, configuration_.prefetchBlockCount_);
+        if (!run.empty()) {
+            requests_.emplace_back(firstBlock, std::move(run));
+            workCondition_.notify_one();
+        }
+    }
+    nextSequentialPosition_ = inPosition + static_cast<SInt64>(bytesCopied);
+
+    return bytesCopied;
+}
+
+void audio_toolbox::BlockCachedFile::OpenAudioFile(CAAudioFile &audioFile, AudioFileTypeID inFileTypeHint) {
+    audioFile.OpenWithCallbacks(this, ReadProc, nullptr, GetSizeProc, nullptr, inFileTypeHint);
+}
+
+audio_toolbox::BlockCachedFile::Statistics audio_toolbox::BlockCachedFile::GetStatistics() const noexcept {
+    Statistics statistics;
+    statistics.readCalls_ = readCalls_.load(std::memory_order_relaxed);
+    statistics.bytesRead_ = bytesRead_.load(std::memory_order_relaxed);
+    statistics.bytesRequested_ = bytesRequested_.load(std::memory_order_relaxed);
+    statistics.cacheHits_ = cacheHits_.load(std::memory_order_relaxed);
+    statistics.cacheMisses_ = cacheMisses_.load(std::memory_order_relaxed);
+    statistics.prefetchedBlocks_ = prefetchedBlocks_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void audio_toolbox::BlockCachedFile::ResetStatistics() noexcept {
+    readCalls_.store(0, std::memory_order_relaxed);
+    bytesRead_.store(0, std::memory_order_relaxed);
+    bytesRequested_.store(0, std::memory_order_relaxed);
+    cacheHits_.store(0, std::memory_order_relaxed);
+    cacheMisses_.store(0, std::memory_order_relaxed);
+    prefetchedBlocks_.store(0, std::memory_order_relaxed);
+}
+
+OSStatus audio_toolbox::BlockCachedFile::ReadProc(void *inClientData, SInt64 inPosition, UInt32 requestCount,
+                                                  void *buffer, UInt32 *actualCount) noexcept {
+    if (inPosition < 0) {
+        return kAudioFilePositionError;
+    }
+    try {
+        auto *file = static_cast<BlockCachedFile *>(inClientData);
+        *actualCount = static_cast<UInt32>(file->Read(inPosition, requestCount, buffer));
+        return noErr;
+    } catch (...) {
+        *actualCount = 0;
+        return kAudioFileUnspecifiedError;
+    }
+}
+
+SInt64 audio_toolbox::BlockCachedFile::GetSizeProc(void *inClientData) noexcept {
+    return static_cast<const BlockCachedFile *>(inClientData)->Size();
+}
+
+std::vector<UInt32> audio_toolbox::BlockCachedFile::ClaimRun(SInt64 firstBlock, UInt32 maximumCount) {
+    std::vector<UInt32> run;
+    if (size_ == 0) {
+        return run;
+    }
+
+    const auto lastBlock = (size_ - 1) / static_cast<SInt64>(configuration_.blockSize_);
+    maximumCount = std::min(maximumCount, kMaximumRunLength);
+    run.reserve(maximumCount);
+
+    for (auto block = firstBlock; block <= lastBlock && run.size() < maximumCount; ++block) {
+        if (blockToSlot_.find(block) != blockToSlot_.end()) {
+            break;
+        }
+
+        // Evict the least recently used slot; loading slots are not in the eviction list
+        const auto index = leastRecentlyUsed_;
+        if (index == kNoSlot) {
+            break;
+        }
+        Unlink(index);
+
+        auto &victim = slots_[index];
+        if (victim.block_ != -1) {
+            blockToSlot_.erase(victim.block_);
+        }
+
+        victim.block_ = block;
+        victim.length_ = 0;
+        victim.loading_ = true;
+        blockToSlot_.emplace(block, index);
+        run.push_back(index);
+    }
+
+    return run;
+}
+
+int audio_toolbox::BlockCachedFile::LoadRun(SInt64 firstBlock, const std::vector<UInt32> &slots) noexcept {
+    const auto blockSize = static_cast<std::size_t>(configuration_.blockSize_);
+
+    iovec iov[kMaximumRunLength];
+    const auto iovcnt = static_cast<int>(slots.size());
+    for (int i = 0; i < iovcnt; ++i) {
+        iov[i].iov_base = arena_.get() + slots[static_cast<std::size_t>(i)] * blockSize;
+        iov[i].iov_len = blockSize;
+    }
+
+    const auto offset = static_cast<off_t>(firstBlock * static_cast<SInt64>(blockSize));
+    const auto wanted = std::min<std::size_t>(blockSize * slots.size(), static_cast<std::size_t>(size_ - offset));
+
+    // Regular files only return short reads at end of file or when interrupted
+    std::size_t total = 0;
+    auto first = 0;
+    auto error = 0;
+    while (total < wanted) {
+        const auto n = ::preadv(fd_, iov + first, iovcnt - first, offset + static_cast<off_t>(total));
+        readCalls_.fetch_add(1, std::memory_order_relaxed);
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = errno;
+            break;
+        }
+        if (n == 0) {
+            break;
+        }
+
+        bytesRead_.fetch_add(static_cast<UInt64>(n), std::memory_order_relaxed);
+        total += static_cast<std::size_t>(n);
+
+        // Skip the fully read buffers and advance into a partially read one
+        auto remaining = static_cast<std::size_t>(n);
+        while (first < iovcnt && remaining >= iov[first].iov_len) {
+            remaining -= iov[first].iov_len;
+            ++first;
+        }
+        if (first < iovcnt) {
+            iov[first].iov_base = static_cast<unsigned char *>(iov[first].iov_base) + remaining;
+            iov[first].iov_len -= remaining;
+        }
+    }
+
+    {
+        std::lock_guard lock{mutex_};
+        for (std::size_t i = 0; i < slots.size(); ++i) {
+            auto &slot = slots_[slots[i]];
+            const auto blockStart = i * blockSize;
+            slot.loading_ = false;
+            if (error || total <= blockStart) {
+                blockToSlot_.erase(slot.block_);
+                slot.block_ = -1;
+                slot.length_ = 0;
+                LinkLeastRecent(slots[i]);
+            } else {
+                // Blocks read ahead are used as of their arrival so they are not evicted before they are read
+                slot.length_ = static_cast<UInt32>(std::min(total - blockStart, blockSize));
+                LinkMostRecent(slots[i]);
+            }
+        }
+    }
+    loadedCondition_.notify_all();
+
+    return error;
+}
+
+audio_toolbox::BlockCachedFile::Slot *audio_toolbox::BlockCachedFile::FindSlot(SInt64 block) noexcept {
+    const auto it = blockToSlot_.find(block);
+    return it != blockToSlot_.end() ? &slots_[it->second] : nullptr;
+}
+
+void audio_toolbox::BlockCachedFile::ResetSlots() noexcept {
+    std::fill(slots_.begin(), slots_.end(), Slot{});
+    leastRecentlyUsed_ = kNoSlot;
+    mostRecentlyUsed_ = kNoSlot;
+    for (UInt32 i = 0; i < slots_.size(); ++i) {
+        LinkMostRecent(i);
+    }
+}
+
+void audio_toolbox::BlockCachedFile::Unlink(UInt32 index) noexcept {
+    auto &slot = slots_[index];
+    if (slot.previous_ != kNoSlot) {
+        slots_[slot.previous_].next_ = slot.next_;
+    } else {
+        leastRecentlyUsed_ = slot.next_;
+    }
+    if (slot.next_ != kNoSlot) {
+        slots_[slot.next_].previous_ = slot.previous_;
+    } else {
+        mostRecentlyUsed_ = slot.previous_;
+    }
+    slot.previous_ = kNoSlot;
+    slot.next_ = kNoSlot;
+}
+
+void audio_toolbox::BlockCachedFile::LinkMostRecent(UInt32 index) noexcept {
+    auto &slot = slots_[index];
+    slot.previous_ = mostRecentlyUsed_;
+    slot.next_ = kNoSlot;
+    if (mostRecentlyUsed_ != kNoSlot) {
+        slots_[mostRecentlyUsed_].next_ = index;
+    } else {
+        leastRecentlyUsed_ = index;
+    }
+    mostRecentlyUsed_ = index;
+}
+
+void audio_toolbox::BlockCachedFile::LinkLeastRecent(UInt32 index) noexcept {
+    auto &slot = slots_[index];
+    slot.previous_ = kNoSlot;
+    slot.next_ = leastRecentlyUsed_;
+    if (leastRecentlyUsed_ != kNoSlot) {
+        slots_[leastRecentlyUsed_].previous_ = index;
+    } else {
+        mostRecentlyUsed_ = index;
+    }
+    leastRecentlyUsed_ = index;
+}
+
+void audio_toolbox::BlockCachedFile::WorkerThreadEntry() noexcept {
+    for (;;) {
+        std::pair<SInt64, std::vector<UInt32>> request;
+
+        {
+            std::unique_lock lock{mutex_};
+            workCondition_.wait(lock, [this] { return stopRequested_ || !requests_.empty(); });
+            if (stopRequested_) {
+                break;
+            }
+            request = std::move(requests_.front());
+            requests_.pop_front();
+        }
+
+        if (LoadRun(request.first, request.second) == 0) {
+            prefetchedBlocks_.fetch_add(request.second.size(), std::memory_order_relaxed);
+        }
+    }
+}
+
+void audio_toolbox::BlockCachedFile::StopWorkers() noexcept {
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = true;
+    }
+    workCondition_.notify_all();
+
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    std::lock_guard lock{mutex_};
+    stopRequested_ = false;
+}
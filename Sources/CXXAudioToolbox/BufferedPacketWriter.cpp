@@ -0,0 +1,155 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/BufferedPacketWriter.hpp"
+
+#include "AudioToolboxErrors.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+audio_toolbox::BufferedPacketWriter::BufferedPacketWriter(CAAudioFile &&audioFile, UInt32 byteCapacity,
+                                                          UInt32 packetCapacity,
+                                                          std::chrono::milliseconds maximumLatency, bool inUseCache,
+                                                          UInt32 packetAlignment)
+    : audioFile_{std::move(audioFile)}, byteCapacity_{byteCapacity}, packetCapacity_{packetCapacity},
+      maximumLatency_{maximumLatency}, useCache_{inUseCache}, packetAlignment_{packetAlignment} {
+    if (byteCapacity_ == 0 || packetCapacity_ == 0) {
+        throw std::invalid_argument("byteCapacity and packetCapacity must be greater than 0");
+    }
+    if (packetAlignment_ == 0 || packetAlignment_ > packetCapacity_) {
+        throw std::invalid_argument("packetAlignment must be greater than 0 and at most packetCapacity");
+    }
+
+    data_ = std::make_unique<unsigned char[]>(byteCapacity_);
+    packetDescriptions_ = std::make_unique<AudioStreamPacketDescription[]>(packetCapacity_);
+}
+
+audio_toolbox::BufferedPacketWriter::~BufferedPacketWriter() noexcept {
+    try {
+        Flush();
+    } catch (...) {
+    }
+}
+
+void audio_toolbox::BufferedPacketWriter::WritePackets(
+        UInt32 inNumBytes, const AudioStreamPacketDescription *_Nullable inPacketDescriptions, SInt64 inStartingPacket,
+        UInt32 inNumPackets, const void *inBuffer) {
+    if (inNumPackets == 0) {
+        return;
+    }
+
+    const auto hasPacketDescriptions = inPacketDescriptions != nullptr;
+
+    // Buffered packets are written before packets that cannot be appended to them
+    if (packetCount_ > 0 && (inStartingPacket != NextPacket() || hasPacketDescriptions != hasPacketDescriptions_)) {
+        Flush();
+    }
+
+    // Contiguous packets that do not fit make room with an aligned batch if possible
+    if (packetCount_ > 0 && !Fits(inNumBytes, inNumPackets)) {
+        FlushAligned();
+        if (!Fits(inNumBytes, inNumPackets)) {
+            Flush();
+        }
+    }
+
+    if (inNumBytes > byteCapacity_ || inNumPackets > packetCapacity_) {
+        auto packetCount = inNumPackets;
+        ++fileWriteCount_;
+        audioFile_.WritePackets(useCache_, inNumBytes, inPacketDescriptions, inStartingPacket, packetCount, inBuffer);
+        if (packetCount != inNumPackets) {
+            ThrowIfAudioFileError(kAudioFileUnspecifiedError, "AudioFileWritePackets");
+        }
+        startingPacket_ = inStartingPacket + inNumPackets;
+        return;
+    }
+
+    if (packetCount_ == 0) {
+        startingPacket_ = inStartingPacket;
+        hasPacketDescriptions_ = hasPacketDescriptions;
+        bufferedTime_ = std::chrono::steady_clock::now();
+    }
+
+    std::memcpy(data_.get() + byteCount_, inBuffer, inNumBytes);
+    if (hasPacketDescriptions) {
+        // Packet offsets are relative to the start of the buffered data
+        for (UInt32 i = 0; i < inNumPackets; ++i) {
+            auto &packetDescription = packetDescriptions_[packetCount_ + i];
+            packetDescription = inPacketDescriptions[i];
+            packetDescription.mStartOffset += byteCount_;
+        }
+    }
+
+    byteCount_ += inNumBytes;
+    packetCount_ += inNumPackets;
+
+    if (std::chrono::steady_clock::now() - bufferedTime_ >= maximumLatency_) {
+        Flush();
+    } else if (byteCount_ == byteCapacity_ || packetCount_ == packetCapacity_) {
+        FlushAligned();
+    }
+}
+
+void audio_toolbox::BufferedPacketWriter::Flush() {
+    if (packetCount_ == 0) {
+        return;
+    }
+    WriteBuffered(packetCount_);
+}
+
+bool audio_toolbox::BufferedPacketWriter::FlushIfExpired() {
+    if (packetCount_ == 0 || std::chrono::steady_clock::now() - bufferedTime_ < maximumLatency_) {
+        return false;
+    }
+    WriteBuffered(packetCount_);
+    return true;
+}
+
+void audio_toolbox::BufferedPacketWriter::FlushAligned() {
+    const auto remainder = static_cast<UInt32>(NextPacket() % packetAlignment_);
+    WriteBuffered(remainder < packetCount_ ? packetCount_ - remainder : packetCount_);
+}
+
+void audio_toolbox::BufferedPacketWriter::WriteBuffered(UInt32 packetCount) {
+    // Packet descriptions locate the end of the batch; constant size packets divide the data evenly
+    UInt32 byteCount = byteCount_;
+    if (packetCount < packetCount_) {
+        byteCount = hasPacketDescriptions_ ? static_cast<UInt32>(packetDescriptions_[packetCount].mStartOffset)
+                                           : byteCount_ / packetCount_ * packetCount;
+    }
+
+    auto writtenCount = packetCount;
+    ++fileWriteCount_;
+    audioFile_.WritePackets(useCache_, byteCount, hasPacketDescriptions_ ? packetDescriptions_.get() : nullptr,
+                            startingPacket_, writtenCount, data_.get());
+    // A retry rewrites the same packet positions so a partial write leaves everything buffered
+    if (writtenCount != packetCount) {
+        ThrowIfAudioFileError(kAudioFileUnspecifiedError, "AudioFileWritePackets");
+    }
+
+    const auto remainingPackets = packetCount_ - packetCount;
+    const auto remainingBytes = byteCount_ - byteCount;
+    if (remainingPackets > 0) {
+        // The latency of packets remaining after an aligned batch is measured from the batch, not from the
+        // already written packets that preceded them
+        bufferedTime_ = std::chrono::steady_clock::now();
+        std::memmove(data_.get(), data_.get() + byteCount, remainingBytes);
+        if (hasPacketDescriptions_) {
+            for (UInt32 i = 0; i < remainingPackets; ++i) {
+                auto &packetDescription = packetDescriptions_[i];
+                packetDescription = packetDescriptions_[packetCount + i];
+                packetDescription.mStartOffset -= byteCount;
+            }
+        }
+    }
+
+    startingPacket_ += packetCount;
+    packetCount_ = remainingPackets;
+    byteCount_ = remainingBytes;
+}
@@ -9,6 +9,19 @@
 
 #include "AudioToolboxErrors.hpp"
 
+namespace {
+
+/// Returns the value of a Float64 property in the global scope of an Audio Unit.
+Float64 GetGlobalFloat64Property(AudioUnit au, AudioUnitPropertyID inID, const char *operation) {
+    Float64 value = 0;
+    UInt32 dataSize = sizeof value;
+    const auto result = AudioUnitGetProperty(au, inID, kAudioUnitScope_Global, 0, &value, &dataSize);
+    audio_toolbox::ThrowIfAudioUnitError(result, operation);
+    return value;
+}
+
+} /* namespace */
+
 audio_toolbox::CAAUGraph::~CAAUGraph() noexcept { reset(); }
 
 audio_toolbox::CAAUGraph::CAAUGraph(CAAUGraph &&other) noexcept : graph_{other.release()} {}
@@ -25,6 +38,7 @@ void audio_toolbox::CAAUGraph::New() {
 }
 
 void audio_toolbox::CAAUGraph::Dispose() {
+    TopologyChanged();
     if (graph_) {
         const auto result = DisposeAUGraph(graph_);
         graph_ = nullptr;
@@ -35,6 +49,7 @@ void audio_toolbox::CAAUGraph::Dispose() {
 // MARK: - Node State
 
 AUNode audio_toolbox::CAAUGraph::AddNode(const AudioComponentDescription *inDescription) {
+    TopologyChanged();
     AUNode node{-1};
     const auto result = AUGraphAddNode(graph_, inDescription, &node);
     ThrowIfAUGraphError(result, "AUGraphAddNode");
@@ -42,6 +57,7 @@ AUNode audio_toolbox::CAAUGraph::AddNode(const AudioComponentDescription *inDesc
 }
 
 void audio_toolbox::CAAUGraph::RemoveNode(AUNode inNode) {
+    TopologyChanged();
     const auto result = AUGraphRemoveNode(graph_, inNode);
     ThrowIfAUGraphError(result, "AUGraphRemoveNode");
 }
@@ -70,6 +86,7 @@ void audio_toolbox::CAAUGraph::NodeInfo(AUNode inNode, AudioComponentDescription
 // MARK: - Sub Graphs
 
 AUNode audio_toolbox::CAAUGraph::NewNodeSubGraph() {
+    TopologyChanged();
     AUNode node = -1;
     const auto result = AUGraphNewNodeSubGraph(graph_, &node);
     ThrowIfAUGraphError(result, "AUGraphNewNodeSubGraph");
@@ -95,6 +112,7 @@ bool audio_toolbox::CAAUGraph::IsNodeSubGraph(AUNode inNode) const {
 
 void audio_toolbox::CAAUGraph::ConnectNodeInput(AUNode inSourceNode, UInt32 inSourceOutputNumber, AUNode inDestNode,
                                                 UInt32 inDestInputNumber) {
+    TopologyChanged();
     const auto result =
             AUGraphConnectNodeInput(graph_, inSourceNode, inSourceOutputNumber, inDestNode, inDestInputNumber);
     ThrowIfAUGraphError(result, "AUGraphConnectNodeInput");
@@ -102,16 +120,19 @@ void audio_toolbox::CAAUGraph::ConnectNodeInput(AUNode inSourceNode, UInt32 inSo
 
 void audio_toolbox::CAAUGraph::SetNodeInputCallback(AUNode inDestNode, UInt32 inDestInputNumber,
                                                     const AURenderCallbackStruct *inInputCallback) {
+    TopologyChanged();
     const auto result = AUGraphSetNodeInputCallback(graph_, inDestNode, inDestInputNumber, inInputCallback);
     ThrowIfAUGraphError(result, "AUGraphSetNodeInputCallback");
 }
 
 void audio_toolbox::CAAUGraph::DisconnectNodeInput(AUNode inDestNode, UInt32 inDestInputNumber) {
+    TopologyChanged();
     const auto result = AUGraphDisconnectNodeInput(graph_, inDestNode, inDestInputNumber);
     ThrowIfAUGraphError(result, "AUGraphDisconnectNodeInput");
 }
 
 void audio_toolbox::CAAUGraph::ClearConnections() {
+    TopologyChanged();
     const auto result = AUGraphClearConnections(graph_);
     ThrowIfAUGraphError(result, "AUGraphClearConnections");
 }
@@ -146,6 +167,7 @@ void audio_toolbox::CAAUGraph::GetNodeInteractions(AUNode inNode, UInt32 *ioNumI
 // MARK: -
 
 bool audio_toolbox::CAAUGraph::Update() {
+    TopologyChanged();
     Boolean flag = 0;
     const auto result = AUGraphUpdate(graph_, &flag);
     ThrowIfAUGraphError(result, "AUGraphUpdate");
@@ -155,21 +177,25 @@ bool audio_toolbox::CAAUGraph::Update() {
 // MARK: - State Management
 
 void audio_toolbox::CAAUGraph::Open() {
+    TopologyChanged();
     const auto result = AUGraphOpen(graph_);
     ThrowIfAUGraphError(result, "AUGraphOpen");
 }
 
 void audio_toolbox::CAAUGraph::Close() {
+    TopologyChanged();
     const auto result = AUGraphClose(graph_);
     ThrowIfAUGraphError(result, "AUGraphClose");
 }
 
 void audio_toolbox::CAAUGraph::Initialize() {
+    TopologyChanged();
     const auto result = AUGraphInitialize(graph_);
     ThrowIfAUGraphError(result, "AUGraphInitialize");
 }
 
 void audio_toolbox::CAAUGraph::Uninitialize() {
+    TopologyChanged();
     const auto result = AUGraphUninitialize(graph_);
     ThrowIfAUGraphError(result, "AUGraphUninitialize");
 }
@@ -235,7 +261,8 @@ void audio_toolbox::CAAUGraph::RemoveRenderNotify(AURenderCallback inCallback, v
 
 std::vector<AUNode> audio_toolbox::CAAUGraph::Nodes() const {
     auto nodeCount = GetNodeCount();
-    auto nodes = std::vector<AUNode>(nodeCount);
+    auto nodes = std::vector<AUNode>();
+    nodes.reserve(nodeCount);
     for (UInt32 i = 0; i < nodeCount; ++i) {
         auto node = GetIndNode(i);
         nodes.push_back(node);
@@ -247,54 +274,80 @@ std::vector<AUNodeInteraction> audio_toolbox::CAAUGraph::NodeInteractions(AUNode
     auto interactionCount = CountNodeInteractions(inNode);
     auto interactions = std::vector<AUNodeInteraction>(interactionCount);
     GetNodeInteractions(inNode, &interactionCount, interactions.data());
+    interactions.resize(interactionCount);
     return interactions;
 }
 
 std::map<AUNode, std::vector<AUNodeInteraction>> audio_toolbox::CAAUGraph::NodesAndInteractions() const {
-    auto nodes = Nodes();
+    const auto snapshot = Snapshot();
     auto nodesAndInteractions = std::map<AUNode, std::vector<AUNodeInteraction>>();
-    for (auto node : nodes) {
-        nodesAndInteractions[node] = NodeInteractions(node);
+    for (std::size_t i = 0; i < snapshot->NodeCount(); ++i) {
+        const auto interactions = snapshot->NodeInteractions(i);
+        nodesAndInteractions.emplace_hint(nodesAndInteractions.end(), snapshot->Nodes()[i],
+                                          std::vector<AUNodeInteraction>(interactions.begin(), interactions.end()));
     }
     return nodesAndInteractions;
 }
 
-Float64 audio_toolbox::CAAUGraph::Latency() const {
-    Float64 latency = 0;
-    auto nodeCount = GetNodeCount();
-    for (UInt32 i = 0; i < nodeCount; ++i) {
-        auto node = GetIndNode(i);
-        AudioUnit au = nullptr;
-        NodeInfo(node, nullptr, &au);
+std::shared_ptr<const audio_toolbox::GraphSnapshot> audio_toolbox::CAAUGraph::Snapshot() const {
+    if (auto snapshot = std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+        snapshot && snapshot->Version() == topologyVersion_) {
+        return snapshot;
+    }
 
-        Float64 auLatency = 0;
-        UInt32 dataSize = sizeof auLatency;
-        const auto result =
-                AudioUnitGetProperty(au, kAudioUnitProperty_Latency, kAudioUnitScope_Global, 0, &auLatency, &dataSize);
-        ThrowIfAudioUnitError(result, "AudioUnitGetProperty (kAudioUnitProperty_Latency, kAudioUnitScope_Global)");
+    auto nodes = Nodes();
 
-        latency += auLatency;
+    const auto interactionCount = GetNumberOfInteractions();
+    auto interactions = std::vector<AUNodeInteraction>();
+    interactions.reserve(interactionCount);
+    for (UInt32 i = 0; i < interactionCount; ++i) {
+        interactions.push_back(GetInteractionInfo(i));
     }
 
-    return latency;
+    // Threads querying concurrently each publish an equivalent snapshot
+    auto snapshot = std::make_shared<const GraphSnapshot>(std::move(nodes), std::move(interactions), topologyVersion_);
+    std::atomic_store_explicit(&snapshot_, snapshot, std::memory_order_release);
+    return snapshot;
 }
 
-Float64 audio_toolbox::CAAUGraph::TailTime() const {
-    Float64 tailTime = 0;
-    auto nodeCount = GetNodeCount();
-    for (UInt32 i = 0; i < nodeCount; ++i) {
-        auto node = GetIndNode(i);
+std::shared_ptr<const audio_toolbox::GraphLatencyAnalysis> audio_toolbox::CAAUGraph::LatencyAnalysis() const {
+    if (const auto cached = std::atomic_load_explicit(&latencyAnalysis_, std::memory_order_acquire);
+        cached && cached->version_ == topologyVersion_) {
+        return {cached, &cached->analysis_};
+    }
+
+    const auto snapshot = Snapshot();
+    GraphLatencyAnalysis::Topology topology;
+
+    for (const auto node : snapshot->Nodes()) {
         AudioUnit au = nullptr;
         NodeInfo(node, nullptr, &au);
 
-        Float64 auTailTime = 0;
-        UInt32 dataSize = sizeof auTailTime;
-        const auto result = AudioUnitGetProperty(au, kAudioUnitProperty_TailTime, kAudioUnitScope_Global, 0,
-                                                 &auTailTime, &dataSize);
-        ThrowIfAudioUnitError(result, "AudioUnitGetProperty (kAudioUnitProperty_TailTime, kAudioUnitScope_Global)");
+        GraphLatencyAnalysis::NodeTiming timing;
+        if (au) {
+            timing.latency_ = GetGlobalFloat64Property(au, kAudioUnitProperty_Latency,
+                                                       "AudioUnitGetProperty (kAudioUnitProperty_Latency, "
+                                                       "kAudioUnitScope_Global)");
+            timing.tailTime_ = GetGlobalFloat64Property(au, kAudioUnitProperty_TailTime,
+                                                        "AudioUnitGetProperty (kAudioUnitProperty_TailTime, "
+                                                        "kAudioUnitScope_Global)");
+        }
+        topology.nodes_.emplace_hint(topology.nodes_.end(), node, timing);
+    }
 
-        tailTime += auTailTime;
+    for (const auto &interaction : snapshot->Interactions()) {
+        if (interaction.nodeInteractionType == kAUNodeInteraction_Connection) {
+            topology.connections_.push_back(interaction.nodeInteraction.connection);
+        }
     }
 
-    return tailTime;
+    // Threads analyzing concurrently each publish an equivalent analysis
+    const auto cached = std::make_shared<const CachedLatencyAnalysis>(
+            CachedLatencyAnalysis{snapshot->Version(), GraphLatencyAnalysis::Analyze(topology)});
+    std::atomic_store_explicit(&latencyAnalysis_, cached, std::memory_order_release);
+    return {cached, &cached->analysis_};
 }
+
+Float64 audio_toolbox::CAAUGraph::Latency() const { return LatencyAnalysis()->latency_; }
+
+Float64 audio_toolbox::CAAUGraph::TailTime() const { return LatencyAnalysis()->tailTime_; }
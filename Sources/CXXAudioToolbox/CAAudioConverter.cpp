@@ -6,15 +6,20 @@
 //
 
 #include "audio_toolbox/CAAudioConverter.hpp"
+#include "audio_toolbox/PCMLayout.hpp"
 
 #include "AudioToolboxErrors.hpp"
+#include "PCMKernels.hpp"
 
 audio_toolbox::CAAudioConverter::~CAAudioConverter() noexcept { reset(); }
 
-audio_toolbox::CAAudioConverter::CAAudioConverter(CAAudioConverter &&other) noexcept : converter_{other.release()} {}
+audio_toolbox::CAAudioConverter::CAAudioConverter(CAAudioConverter &&other) noexcept { swap(other); }
 
 audio_toolbox::CAAudioConverter &audio_toolbox::CAAudioConverter::operator=(CAAudioConverter &&other) noexcept {
-    reset(other.release());
+    if (this != &other) {
+        reset();
+        swap(other);
+    }
     return *this;
 }
 
@@ -23,6 +28,13 @@ void audio_toolbox::CAAudioConverter::New(const AudioStreamBasicDescription &inS
     Dispose();
     const auto result = AudioConverterNew(&inSourceFormat, &inDestinationFormat, &converter_);
     ThrowIfAudioConverterError(result, "AudioConverterNew");
+    sourceFormat_ = inSourceFormat;
+    destinationFormat_ = inDestinationFormat;
+    // The kernels convert one contiguous run of samples, which holds every channel only if interleaved or mono
+    if (!(inSourceFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved) || inSourceFormat.mChannelsPerFrame == 1) {
+        pcmSampleConverter_ = detail::SelectPCMSampleConverter(inSourceFormat, inDestinationFormat);
+    }
+    layoutConversion_ = pcm_layout::IsLayoutConversion(inSourceFormat, inDestinationFormat);
 }
 
 void audio_toolbox::CAAudioConverter::NewSpecific(const AudioStreamBasicDescription &inSourceFormat,
@@ -33,9 +45,13 @@ void audio_toolbox::CAAudioConverter::NewSpecific(const AudioStreamBasicDescript
     const auto result = AudioConverterNewSpecific(&inSourceFormat, &inDestinationFormat, inNumberClassDescriptions,
                                                   inClassDescriptions, &converter_);
     ThrowIfAudioConverterError(result, "AudioConverterNewSpecific");
+    // Specific codecs were requested so the built-in kernels are not used
+    sourceFormat_ = inSourceFormat;
+    destinationFormat_ = inDestinationFormat;
 }
 
 void audio_toolbox::CAAudioConverter::Dispose() {
+    ClearFormats();
     if (converter_) {
         const auto result = AudioConverterDispose(converter_);
         converter_ = nullptr;
@@ -62,12 +78,27 @@ void audio_toolbox::CAAudioConverter::GetProperty(AudioConverterPropertyID inPro
 
 void audio_toolbox::CAAudioConverter::SetProperty(AudioConverterPropertyID inPropertyID, UInt32 inPropertyDataSize,
                                                   const void *inPropertyData) {
+    // Properties such as the channel map or dithering change the conversion
+    pcmSampleConverter_ = nullptr;
+    layoutConversion_ = false;
     const auto result = AudioConverterSetProperty(converter_, inPropertyID, inPropertyDataSize, inPropertyData);
     ThrowIfAudioConverterError(result, "AudioConverterSetProperty");
 }
 
 void audio_toolbox::CAAudioConverter::ConvertBuffer(UInt32 inInputDataSize, const void *inInputData,
                                                     UInt32 &ioOutputDataSize, void *outOutputData) {
+    if (pcmFastPathEnabled_ && pcmSampleConverter_) {
+        const auto frameCount = inInputDataSize / sourceFormat_.mBytesPerFrame;
+        const auto outputSize = static_cast<UInt64>(frameCount) * destinationFormat_.mBytesPerFrame;
+        // Partial frames and undersized output buffers are left to AudioConverter to report
+        if (frameCount * sourceFormat_.mBytesPerFrame == inInputDataSize && outputSize <= ioOutputDataSize) {
+            pcmSampleConverter_(inInputData, outOutputData,
+                                static_cast<std::size_t>(frameCount) * sourceFormat_.mChannelsPerFrame);
+            ioOutputDataSize = static_cast<UInt32>(outputSize);
+            return;
+        }
+    }
+
     const auto result =
             AudioConverterConvertBuffer(converter_, inInputDataSize, inInputData, &ioOutputDataSize, outOutputData);
     ThrowIfAudioConverterError(result, "AudioConverterConvertBuffer");
@@ -84,6 +115,15 @@ void audio_toolbox::CAAudioConverter::FillComplexBuffer(AudioConverterComplexInp
 
 void audio_toolbox::CAAudioConverter::ConvertComplexBuffer(UInt32 inNumberPCMFrames, const AudioBufferList *inInputData,
                                                            AudioBufferList *outOutputData) {
+    if (pcmFastPathEnabled_ && layoutConversion_) {
+        pcm_layout::Convert(sourceFormat_, destinationFormat_, inNumberPCMFrames, inInputData, outOutputData);
+        return;
+    }
+
     const auto result = AudioConverterConvertComplexBuffer(converter_, inNumberPCMFrames, inInputData, outOutputData);
     ThrowIfAudioConverterError(result, "AudioConverterConvertComplexBuffer");
 }
+
+void audio_toolbox::CAAudioConverter::ThrowIfError(OSStatus result, const char *operation) {
+    ThrowIfAudioConverterError(result, operation);
+}
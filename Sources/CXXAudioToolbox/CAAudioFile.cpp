@@ -168,6 +168,27 @@ core_audio::StreamDescription audio_toolbox::CAAudioFile::DataFormat() const {
     return fileDataFormat;
 }
 
+SInt64 audio_toolbox::CAAudioFile::DataOffset() const {
+    SInt64 dataOffset;
+    UInt32 size = sizeof dataOffset;
+    GetProperty(kAudioFilePropertyDataOffset, size, &dataOffset);
+    return dataOffset;
+}
+
+UInt64 audio_toolbox::CAAudioFile::AudioDataByteCount() const {
+    UInt64 byteCount;
+    UInt32 size = sizeof byteCount;
+    GetProperty(kAudioFilePropertyAudioDataByteCount, size, &byteCount);
+    return byteCount;
+}
+
+UInt64 audio_toolbox::CAAudioFile::AudioDataPacketCount() const {
+    UInt64 packetCount;
+    UInt32 size = sizeof packetCount;
+    GetProperty(kAudioFilePropertyAudioDataPacketCount, size, &packetCount);
+    return packetCount;
+}
+
 // MARK: Global Properties
 
 UInt32 audio_toolbox::CAAudioFile::GetGlobalInfoSize(AudioFilePropertyID inPropertyID, UInt32 inSpecifierSize,
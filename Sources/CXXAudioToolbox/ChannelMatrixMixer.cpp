@@ -0,0 +1,312 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/ChannelMatrixMixer.hpp"
+#include "audio_toolbox/AudioFormatPropertyCache.hpp"
+#include "audio_toolbox/PCMLayout.hpp"
+
+#include "AudioToolboxErrors.hpp"
+#include "LinearPCM.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/// The maximum number of frames mixed at a time.
+constexpr UInt32 kBlockFrames = 512;
+
+using audio_toolbox::detail::BufferCount;
+using audio_toolbox::detail::IsNativeFloat32;
+using audio_toolbox::detail::IsNonInterleaved;
+
+/// Returns true if an output buffer begins at the same address as an input buffer it overlaps.
+/// @throw std::system_error if an output buffer overlaps an input buffer at a different address.
+bool IsInPlace(const AudioBufferList *inInputData, UInt64 inputByteCount, const AudioBufferList *outOutputData,
+               UInt64 outputByteCount) {
+    auto inPlace = false;
+    for (UInt32 i = 0; i < outOutputData->mNumberBuffers; ++i) {
+        const auto outputBegin = reinterpret_cast<std::uintptr_t>(outOutputData->mBuffers[i].mData);
+        for (UInt32 j = 0; j < inInputData->mNumberBuffers; ++j) {
+            const auto inputBegin = reinterpret_cast<std::uintptr_t>(inInputData->mBuffers[j].mData);
+            if (outputBegin < inputBegin + inputByteCount && inputBegin < outputBegin + outputByteCount) {
+                if (outputBegin != inputBegin) {
+                    audio_toolbox::ThrowIfAudioConverterError(kAudio_ParamError, "ChannelMatrixMixer::Process");
+                }
+                inPlace = true;
+            }
+        }
+    }
+    return inPlace;
+}
+
+// MARK: - Kernels
+
+/// Stores input scaled by gain in output.
+void Scale(float *output, const float *input, float gain, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if defined(__x86_64__)
+    const auto g = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_loadu_ps(input + i), g));
+    }
+#elif defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(output + i, vmulq_n_f32(vld1q_f32(input + i), gain));
+    }
+#endif
+    for (; i < count; ++i) {
+        output[i] = input[i] * gain;
+    }
+}
+
+/// Adds input scaled by gain to output.
+void Accumulate(float *output, const float *input, float gain, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if defined(__x86_64__)
+    const auto g = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(_mm_loadu_ps(input + i), g)));
+    }
+#elif defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(output + i, vaddq_f32(vld1q_f32(output + i), vmulq_n_f32(vld1q_f32(input + i), gain)));
+    }
+#endif
+    for (; i < count; ++i) {
+        output[i] += input[i] * gain;
+    }
+}
+
+/// Stores the sum of all inputs scaled by the gains in a matrix column in output.
+///
+/// Each vector of frames is accumulated in a register across all inputs and stored once.
+void MixColumn(float *output, const float *const *inputs, const Float32 *column, std::size_t inputCount,
+               std::size_t stride, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if defined(__x86_64__)
+    for (; i + 4 <= count; i += 4) {
+        auto sum = _mm_mul_ps(_mm_loadu_ps(inputs[0] + i), _mm_set1_ps(column[0]));
+        for (std::size_t j = 1; j < inputCount; ++j) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(inputs[j] + i), _mm_set1_ps(column[j * stride])));
+        }
+        _mm_storeu_ps(output + i, sum);
+    }
+#elif defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        auto sum = vmulq_n_f32(vld1q_f32(inputs[0] + i), column[0]);
+        for (std::size_t j = 1; j < inputCount; ++j) {
+            sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(inputs[j] + i), column[j * stride]));
+        }
+        vst1q_f32(output + i, sum);
+    }
+#endif
+    for (; i < count; ++i) {
+        auto sum = inputs[0][i] * column[0];
+        for (std::size_t j = 1; j < inputCount; ++j) {
+            sum += inputs[j][i] * column[j * stride];
+        }
+        output[i] = sum;
+    }
+}
+
+} /* namespace */
+
+std::vector<Float32> audio_toolbox::ChannelMatrixMixer::MatrixForLayouts(const AudioChannelLayout &inInputLayout,
+                                                                         const AudioChannelLayout &inOutputLayout) {
+    const AudioChannelLayout *layouts[] = {&inInputLayout, &inOutputLayout};
+    auto &cache = AudioFormatPropertyCache::Shared();
+    auto size = cache.GetPropertyInfo(kAudioFormatProperty_MatrixMixMap, sizeof layouts, layouts);
+    std::vector<Float32> matrix(size / sizeof(Float32));
+    cache.GetProperty(kAudioFormatProperty_MatrixMixMap, sizeof layouts, layouts, size, matrix.data());
+    matrix.resize(size / sizeof(Float32));
+    return matrix;
+}
+
+void audio_toolbox::ChannelMatrixMixer::New(const AudioStreamBasicDescription &inSourceFormat,
+                                            const AudioChannelLayout &inSourceLayout,
+                                            const AudioStreamBasicDescription &inDestinationFormat,
+                                            const AudioChannelLayout &inDestinationLayout) {
+    New(inSourceFormat, inDestinationFormat, MatrixForLayouts(inSourceLayout, inDestinationLayout));
+}
+
+void audio_toolbox::ChannelMatrixMixer::New(const AudioStreamBasicDescription &inSourceFormat,
+                                            const AudioStreamBasicDescription &inDestinationFormat,
+                                            std::vector<Float32> inMatrix) {
+    if (!IsNativeFloat32(inSourceFormat) || !IsNativeFloat32(inDestinationFormat) ||
+        inSourceFormat.mSampleRate != inDestinationFormat.mSampleRate) {
+        ThrowIfAudioConverterError(kAudioConverterErr_FormatNotSupported, "ChannelMatrixMixer::New");
+    }
+
+    const auto inputCount = inSourceFormat.mChannelsPerFrame;
+    const auto outputCount = inDestinationFormat.mChannelsPerFrame;
+    if (inMatrix.size() != static_cast<std::size_t>(inputCount) * outputCount) {
+        ThrowIfAudioConverterError(kAudio_ParamError, "ChannelMatrixMixer::New");
+    }
+
+    std::vector<Term> terms;
+    std::vector<UInt32> termOffsets;
+    termOffsets.reserve(outputCount + 1);
+    for (UInt32 output = 0; output < outputCount; ++output) {
+        termOffsets.push_back(static_cast<UInt32>(terms.size()));
+        for (UInt32 input = 0; input < inputCount; ++input) {
+            if (const auto gain = inMatrix[input * outputCount + output]; gain != 0) {
+                terms.push_back({input, gain});
+            }
+        }
+    }
+    termOffsets.push_back(static_cast<UInt32>(terms.size()));
+
+    // The dense kernel keeps each output in a register, which pays off once most gains are nonzero
+    const auto sparse = terms.size() * 2 <= inMatrix.size();
+
+    // Input is always given scratch space so it can be copied before being overwritten in place
+    std::size_t scratchChannels = inputCount;
+    if (!IsNonInterleaved(inDestinationFormat)) {
+        scratchChannels += outputCount;
+    }
+    std::vector<float> scratch(scratchChannels * kBlockFrames);
+    std::vector<const float *> inputs(inputCount);
+    std::vector<float *> outputs(outputCount);
+    std::vector<void *> channels(std::max(inputCount, outputCount));
+
+    sourceFormat_ = inSourceFormat;
+    destinationFormat_ = inDestinationFormat;
+    matrix_ = std::move(inMatrix);
+    sparse_ = sparse;
+    terms_ = std::move(terms);
+    termOffsets_ = std::move(termOffsets);
+    scratch_ = std::move(scratch);
+    inputs_ = std::move(inputs);
+    outputs_ = std::move(outputs);
+    channels_ = std::move(channels);
+}
+
+void audio_toolbox::ChannelMatrixMixer::Dispose() noexcept {
+    matrix_.clear();
+    matrix_.shrink_to_fit();
+    terms_.clear();
+    terms_.shrink_to_fit();
+    termOffsets_.clear();
+    termOffsets_.shrink_to_fit();
+    scratch_.clear();
+    scratch_.shrink_to_fit();
+    inputs_.clear();
+    inputs_.shrink_to_fit();
+    outputs_.clear();
+    outputs_.shrink_to_fit();
+    channels_.clear();
+    channels_.shrink_to_fit();
+}
+
+void audio_toolbox::ChannelMatrixMixer::Process(UInt32 inNumberFrames, const AudioBufferList *inInputData,
+                                                AudioBufferList *outOutputData) {
+    if (matrix_.empty()) {
+        ThrowIfAudioConverterError(kAudio_ParamError, "ChannelMatrixMixer::Process");
+    }
+
+    const auto inputByteCount = UInt64{inNumberFrames} * sourceFormat_.mBytesPerFrame;
+    const auto outputByteCount = UInt64{inNumberFrames} * destinationFormat_.mBytesPerFrame;
+    detail::ValidateBufferList(inInputData, BufferCount(sourceFormat_), inputByteCount, "ChannelMatrixMixer::Process");
+    detail::ValidateBufferList(outOutputData, BufferCount(destinationFormat_), outputByteCount,
+                               "ChannelMatrixMixer::Process");
+
+    // Each block of input is copied before its output is written. Output written in place must also not overwrite
+    // input of blocks yet to be mixed: when output frames are larger than input frames the blocks are mixed last to
+    // first, so each block's output only covers the input of blocks already mixed.
+    const auto inPlace = IsInPlace(inInputData, inputByteCount, outOutputData, outputByteCount);
+    const auto blockCount = (inNumberFrames + kBlockFrames - 1) / kBlockFrames;
+    const auto reverse = inPlace && destinationFormat_.mBytesPerFrame > sourceFormat_.mBytesPerFrame;
+    for (UInt32 n = 0; n < blockCount; ++n) {
+        const auto offset = (reverse ? blockCount - 1 - n : n) * kBlockFrames;
+        ProcessBlock(inInputData, outOutputData, offset, std::min(kBlockFrames, inNumberFrames - offset), inPlace);
+    }
+
+    for (UInt32 i = 0; i < outOutputData->mNumberBuffers; ++i) {
+        outOutputData->mBuffers[i].mDataByteSize = inNumberFrames * destinationFormat_.mBytesPerFrame;
+    }
+}
+
+void audio_toolbox::ChannelMatrixMixer::ProcessBlock(const AudioBufferList *inInputData,
+                                                     AudioBufferList *outOutputData, UInt32 offset,
+                                                     UInt32 frameCount, bool copyInput) noexcept {
+    const auto inputCount = sourceFormat_.mChannelsPerFrame;
+    const auto outputCount = destinationFormat_.mChannelsPerFrame;
+    auto *scratch = scratch_.data();
+
+    // Interleaved input is deinterleaved into scratch; non-interleaved input is used where it is unless it is
+    // overwritten in place
+    if (IsNonInterleaved(sourceFormat_)) {
+        for (UInt32 i = 0; i < inputCount; ++i) {
+            inputs_[i] = static_cast<const float *>(inInputData->mBuffers[i].mData) + offset;
+            if (copyInput) {
+                std::memcpy(scratch, inputs_[i], frameCount * sizeof(float));
+                inputs_[i] = scratch;
+            }
+            scratch += kBlockFrames;
+        }
+    } else {
+        for (UInt32 i = 0; i < inputCount; ++i) {
+            inputs_[i] = scratch;
+            channels_[i] = scratch;
+            scratch += kBlockFrames;
+        }
+        pcm_layout::Deinterleave(sizeof(float), inputCount, frameCount,
+                                 static_cast<const float *>(inInputData->mBuffers[0].mData) +
+                                         static_cast<std::size_t>(offset) * inputCount,
+                                 channels_.data());
+    }
+
+    const auto interleavedOutput = !IsNonInterleaved(destinationFormat_);
+    for (UInt32 i = 0; i < outputCount; ++i) {
+        if (interleavedOutput) {
+            outputs_[i] = scratch;
+            scratch += kBlockFrames;
+        } else {
+            outputs_[i] = static_cast<float *>(outOutputData->mBuffers[i].mData) + offset;
+        }
+    }
+
+    for (UInt32 output = 0; output < outputCount; ++output) {
+        if (!sparse_) {
+            MixColumn(outputs_[output], inputs_.data(), matrix_.data() + output, inputCount, outputCount, frameCount);
+            continue;
+        }
+
+        const auto *term = terms_.data() + termOffsets_[output];
+        const auto *end = terms_.data() + termOffsets_[output + 1];
+        if (term == end) {
+            std::memset(outputs_[output], 0, frameCount * sizeof(float));
+            continue;
+        }
+
+        if (term->gain_ == 1) {
+            std::memcpy(outputs_[output], inputs_[term->input_], frameCount * sizeof(float));
+        } else {
+            Scale(outputs_[output], inputs_[term->input_], term->gain_, frameCount);
+        }
+        for (++term; term != end; ++term) {
+            Accumulate(outputs_[output], inputs_[term->input_], term->gain_, frameCount);
+        }
+    }
+
+    if (interleavedOutput) {
+        std::copy(outputs_.begin(), outputs_.end(), channels_.begin());
+        pcm_layout::Interleave(sizeof(float), outputCount, frameCount, channels_.data(),
+                               static_cast<float *>(outOutputData->mBuffers[0].mData) +
+                                       static_cast<std::size_t>(offset) * outputCount);
+    }
+}
@@ -0,0 +1,198 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/ConverterPool.hpp"
+
+#include <iterator>
+
+namespace {
+
+/// Appends the bytes of an object to key.
+void AppendBytes(std::string &key, const void *_Nullable bytes, std::size_t size) {
+    if (bytes && size > 0) {
+        key.append(static_cast<const char *>(bytes), size);
+    }
+}
+
+/// Returns the pool key for a converter configuration.
+std::string MakeKey(const AudioStreamBasicDescription &inSourceFormat,
+                    const AudioStreamBasicDescription &inDestinationFormat,
+                    const std::vector<AudioClassDescription> &inClassDescriptions,
+                    const std::vector<audio_toolbox::ConverterPool::Property> &inProperties) {
+    std::string key;
+    AppendBytes(key, &inSourceFormat, sizeof inSourceFormat);
+    AppendBytes(key, &inDestinationFormat, sizeof inDestinationFormat);
+
+    const auto classDescriptionCount = static_cast<UInt32>(inClassDescriptions.size());
+    AppendBytes(key, &classDescriptionCount, sizeof classDescriptionCount);
+    AppendBytes(key, inClassDescriptions.data(), inClassDescriptions.size() * sizeof(AudioClassDescription));
+
+    // Properties are keyed in order since the order they are set may matter
+    for (const auto &property : inProperties) {
+        const auto size = static_cast<UInt32>(property.data_.size());
+        AppendBytes(key, &property.propertyID_, sizeof property.propertyID_);
+        AppendBytes(key, &size, sizeof size);
+        AppendBytes(key, property.data_.data(), property.data_.size());
+    }
+
+    return key;
+}
+
+} /* namespace */
+
+void audio_toolbox::ConverterPool::Lease::Discard() noexcept {
+    converter_.reset();
+    if (pool_) {
+        pool_->Checkin(std::move(*this));
+    }
+}
+
+audio_toolbox::ConverterPool::ConverterPool(std::size_t capacity,
+                                            std::chrono::steady_clock::duration maximumIdleTime) noexcept
+    : capacity_{capacity}, maximumIdleTime_{maximumIdleTime} {}
+
+audio_toolbox::ConverterPool::Lease
+audio_toolbox::ConverterPool::Checkout(const AudioStreamBasicDescription &inSourceFormat,
+                                       const AudioStreamBasicDescription &inDestinationFormat,
+                                       const std::vector<AudioClassDescription> &inClassDescriptions,
+                                       const std::vector<Property> &inProperties) {
+    Lease lease;
+    lease.key_ = MakeKey(inSourceFormat, inDestinationFormat, inClassDescriptions, inProperties);
+
+    // Converters are disposed after the lock is released
+    std::list<Entry> disposed;
+    {
+        std::lock_guard lock{mutex_};
+        Trim(Clock::now(), disposed);
+
+        if (const auto it = index_.find(lease.key_); it != index_.end()) {
+            const auto entry = it->second;
+            index_.erase(it);
+            lease.converter_ = std::move(entry->converter_);
+            disposed.splice(disposed.end(), entries_, entry);
+            ++hits_;
+        } else {
+            ++misses_;
+        }
+
+        ++checkedOutCount_;
+        lease.pool_ = this;
+    }
+
+    if (!lease.converter_) {
+        try {
+            if (inClassDescriptions.empty()) {
+                lease.converter_.New(inSourceFormat, inDestinationFormat);
+            } else {
+                lease.converter_.NewSpecific(inSourceFormat, inDestinationFormat,
+                                             static_cast<UInt32>(inClassDescriptions.size()),
+                                             inClassDescriptions.data());
+            }
+
+            for (const auto &property : inProperties) {
+                lease.converter_.SetProperty(property.propertyID_, static_cast<UInt32>(property.data_.size()),
+                                             property.data_.data());
+            }
+        } catch (...) {
+            // A partially configured converter must not be pooled under the key
+            lease.Discard();
+            throw;
+        }
+    }
+
+    return lease;
+}
+
+void audio_toolbox::ConverterPool::Checkin(Lease &&lease) noexcept {
+    if (lease.pool_ != this) {
+        return;
+    }
+    lease.pool_ = nullptr;
+
+    std::list<Entry> disposed;
+    try {
+        if (lease.converter_) {
+            // Converters are reset here so checkouts do not pay for it
+            lease.converter_.Reset();
+            disposed.push_back({std::move(lease.key_), std::move(lease.converter_), Clock::now()});
+        }
+    } catch (...) {
+        lease.converter_.reset();
+    }
+
+    std::lock_guard lock{mutex_};
+    --checkedOutCount_;
+
+    if (!disposed.empty()) {
+        try {
+            const auto entry = disposed.begin();
+            index_.emplace(entry->key_, entry);
+            entries_.splice(entries_.begin(), disposed, entry);
+        } catch (...) {
+            // The converter is disposed if it cannot be indexed
+        }
+    }
+
+    Trim(Clock::now(), disposed);
+}
+
+void audio_toolbox::ConverterPool::EvictExpired() noexcept {
+    std::list<Entry> disposed;
+    std::lock_guard lock{mutex_};
+    Trim(Clock::now(), disposed);
+}
+
+void audio_toolbox::ConverterPool::Clear() noexcept {
+    std::list<Entry> disposed;
+    std::lock_guard lock{mutex_};
+    index_.clear();
+    disposed.splice(disposed.end(), entries_);
+}
+
+audio_toolbox::ConverterPool::Statistics audio_toolbox::ConverterPool::GetStatistics() const {
+    std::lock_guard lock{mutex_};
+    Statistics statistics;
+    statistics.hits_ = hits_;
+    statistics.misses_ = misses_;
+    statistics.evictions_ = evictions_;
+    statistics.expirations_ = expirations_;
+    statistics.idleCount_ = entries_.size();
+    statistics.checkedOutCount_ = checkedOutCount_;
+    return statistics;
+}
+
+void audio_toolbox::ConverterPool::ResetStatistics() noexcept {
+    std::lock_guard lock{mutex_};
+    hits_ = 0;
+    misses_ = 0;
+    evictions_ = 0;
+    expirations_ = 0;
+}
+
+void audio_toolbox::ConverterPool::Trim(Clock::time_point now, std::list<Entry> &disposed) noexcept {
+    const auto remove = [&](std::list<Entry>::iterator entry) {
+        const auto range = index_.equal_range(entry->key_);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == entry) {
+                index_.erase(it);
+                break;
+            }
+        }
+        disposed.splice(disposed.end(), entries_, entry);
+    };
+
+    // Entries are ordered by checkin time so expired entries are at the back
+    while (!entries_.empty() && now - entries_.back().checkinTime_ > maximumIdleTime_) {
+        remove(std::prev(entries_.end()));
+        ++expirations_;
+    }
+
+    while (entries_.size() > capacity_) {
+        remove(std::prev(entries_.end()));
+        ++evictions_;
+    }
+}
@@ -0,0 +1,258 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/DecodeAheadReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+/// A preallocated buffer list and its storage.
+struct audio_toolbox::DecodeAheadReader::Buffer {
+    /// Allocates a buffer list for frameCapacity frames of format.
+    Buffer(const AudioStreamBasicDescription &format, UInt32 frameCapacity);
+
+    /// Resets the buffer sizes to their capacity before reading.
+    void Prepare() noexcept;
+
+    /// Storage for the buffer list followed by the audio data.
+    std::unique_ptr<unsigned char[]> storage_;
+    /// The buffer list.
+    AudioBufferList *list_{nullptr};
+    /// The capacity of each buffer in frames.
+    UInt32 frameCapacity_{0};
+    /// The number of bytes per frame in each buffer.
+    UInt32 bytesPerFrame_{0};
+    /// The number of valid frames.
+    UInt32 frameLength_{0};
+};
+
+audio_toolbox::DecodeAheadReader::Buffer::Buffer(const AudioStreamBasicDescription &format, UInt32 frameCapacity)
+    : frameCapacity_{frameCapacity}, bytesPerFrame_{format.mBytesPerFrame} {
+    const auto nonInterleaved = (format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+    const auto bufferCount = nonInterleaved ? format.mChannelsPerFrame : 1;
+    const auto channelsPerBuffer = nonInterleaved ? 1 : format.mChannelsPerFrame;
+
+    constexpr std::size_t alignment = 16;
+    const auto align = [](std::size_t size) { return (size + alignment - 1) & ~(alignment - 1); };
+
+    const auto listSize = align(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * std::max(bufferCount, 1U));
+    const auto bufferSize = align(static_cast<std::size_t>(frameCapacity_) * bytesPerFrame_);
+
+    storage_ = std::make_unique<unsigned char[]>(listSize + bufferSize * bufferCount);
+    list_ = reinterpret_cast<AudioBufferList *>(storage_.get());
+    list_->mNumberBuffers = bufferCount;
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        list_->mBuffers[i].mNumberChannels = channelsPerBuffer;
+        list_->mBuffers[i].mData = storage_.get() + listSize + bufferSize * i;
+    }
+    Prepare();
+}
+
+void audio_toolbox::DecodeAheadReader::Buffer::Prepare() noexcept {
+    for (UInt32 i = 0; i < list_->mNumberBuffers; ++i) {
+        list_->mBuffers[i].mDataByteSize = frameCapacity_ * bytesPerFrame_;
+    }
+    frameLength_ = 0;
+}
+
+audio_toolbox::DecodeAheadReader::DecodeAheadReader(CAExtAudioFile &&extAudioFile, UInt32 framesPerBuffer,
+                                                    UInt32 bufferCount)
+    : extAudioFile_{std::move(extAudioFile)}, framesPerBuffer_{framesPerBuffer}, bufferCount_{bufferCount} {
+    if (framesPerBuffer_ == 0 || bufferCount_ == 0) {
+        throw std::invalid_argument("framesPerBuffer and bufferCount must be greater than 0");
+    }
+
+    clientDataFormat_ = extAudioFile_.ClientDataFormat();
+    if (clientDataFormat_.mFormatID != kAudioFormatLinearPCM || clientDataFormat_.mBytesPerFrame == 0) {
+        throw std::invalid_argument("Client data format must be linear PCM");
+    }
+}
+
+audio_toolbox::DecodeAheadReader::~DecodeAheadReader() noexcept { Stop(); }
+
+void audio_toolbox::DecodeAheadReader::Start() {
+    Stop();
+
+    std::lock_guard lock{mutex_};
+
+    if (current_) {
+        free_.push_back(std::move(current_));
+    }
+    currentOffset_ = 0;
+    while (!ready_.empty()) {
+        free_.push_back(std::move(ready_.front()));
+        ready_.pop_front();
+    }
+
+    // The buffer held by the consumer is one of the bufferCount_ buffers
+    free_.reserve(bufferCount_);
+    while (free_.size() < bufferCount_) {
+        free_.push_back(std::make_unique<Buffer>(clientDataFormat_, framesPerBuffer_));
+    }
+
+    error_ = nullptr;
+    started_ = true;
+    finished_ = false;
+
+    decoderThread_ = std::thread(&DecodeAheadReader::DecoderThreadEntry, this);
+}
+
+void audio_toolbox::DecodeAheadReader::Stop() noexcept {
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = true;
+    }
+    freeCondition_.notify_all();
+
+    if (decoderThread_.joinable()) {
+        decoderThread_.join();
+    }
+
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = false;
+        finished_ = true;
+    }
+    readyCondition_.notify_all();
+}
+
+const AudioBufferList *audio_toolbox::DecodeAheadReader::Read(UInt32 &outNumberFrames) {
+    if (!AdvanceBuffer()) {
+        outNumberFrames = 0;
+        return nullptr;
+    }
+    currentOffset_ = current_->frameLength_;
+    outNumberFrames = current_->frameLength_;
+    return current_->list_;
+}
+
+void audio_toolbox::DecodeAheadReader::Read(core_audio::BufferList &buffer) {
+    buffer.prepareForReading();
+
+    AudioBufferList *const bufferList = buffer;
+    const auto frameCapacity = buffer.frameCapacity();
+    const auto bytesPerFrame = clientDataFormat_.mBytesPerFrame;
+
+    const auto nonInterleaved = (clientDataFormat_.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+    const auto channelsPerBuffer = nonInterleaved ? 1 : clientDataFormat_.mChannelsPerFrame;
+    if (!bufferList || bufferList->mNumberBuffers != (nonInterleaved ? clientDataFormat_.mChannelsPerFrame : 1)) {
+        throw std::invalid_argument("Buffer count does not match the client data format");
+    }
+    for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+        if (bufferList->mBuffers[i].mNumberChannels != channelsPerBuffer ||
+            bufferList->mBuffers[i].mDataByteSize != frameCapacity * bytesPerFrame) {
+            throw std::invalid_argument("Buffer format does not match the client data format");
+        }
+    }
+
+    UInt32 framesCopied = 0;
+    while (framesCopied < frameCapacity) {
+        if (!current_ || currentOffset_ == current_->frameLength_) {
+            if (!AdvanceBuffer()) {
+                break;
+            }
+        }
+
+        const auto frameCount = std::min(frameCapacity - framesCopied, current_->frameLength_ - currentOffset_);
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            std::memcpy(static_cast<unsigned char *>(bufferList->mBuffers[i].mData) + framesCopied * bytesPerFrame,
+                        static_cast<const unsigned char *>(current_->list_->mBuffers[i].mData) +
+                                currentOffset_ * bytesPerFrame,
+                        frameCount * bytesPerFrame);
+        }
+
+        framesCopied += frameCount;
+        currentOffset_ += frameCount;
+    }
+
+    buffer.setFrameLength(framesCopied);
+}
+
+void audio_toolbox::DecodeAheadReader::Seek(SInt64 inFrameOffset) {
+    Stop();
+    extAudioFile_.Seek(inFrameOffset);
+    Start();
+}
+
+bool audio_toolbox::DecodeAheadReader::AdvanceBuffer() {
+    std::unique_lock lock{mutex_};
+
+    if (!started_) {
+        throw std::logic_error("Decoding has not been started");
+    }
+
+    if (current_) {
+        free_.push_back(std::move(current_));
+        freeCondition_.notify_one();
+    }
+    currentOffset_ = 0;
+
+    readyCondition_.wait(lock, [this] { return !ready_.empty() || finished_; });
+
+    if (ready_.empty()) {
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+        return false;
+    }
+
+    current_ = std::move(ready_.front());
+    ready_.pop_front();
+
+    return true;
+}
+
+void audio_toolbox::DecodeAheadReader::DecoderThreadEntry() noexcept {
+    for (;;) {
+        std::unique_ptr<Buffer> buffer;
+
+        {
+            std::unique_lock lock{mutex_};
+            freeCondition_.wait(lock, [this] { return stopRequested_ || !free_.empty(); });
+            if (stopRequested_) {
+                break;
+            }
+            buffer = std::move(free_.back());
+            free_.pop_back();
+        }
+
+        buffer->Prepare();
+        auto frameCount = buffer->frameCapacity_;
+
+        try {
+            extAudioFile_.Read(frameCount, buffer->list_);
+        } catch (...) {
+            std::lock_guard lock{mutex_};
+            free_.push_back(std::move(buffer));
+            error_ = std::current_exception();
+            break;
+        }
+
+        if (frameCount == 0) {
+            std::lock_guard lock{mutex_};
+            free_.push_back(std::move(buffer));
+            break;
+        }
+
+        buffer->frameLength_ = frameCount;
+
+        {
+            std::lock_guard lock{mutex_};
+            ready_.push_back(std::move(buffer));
+        }
+        readyCondition_.notify_one();
+    }
+
+    {
+        std::lock_guard lock{mutex_};
+        finished_ = true;
+    }
+    readyCondition_.notify_all();
+}
@@ -0,0 +1,41 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AudioConverter.h>
+
+#include <cstddef>
+
+namespace audio_toolbox {
+namespace detail {
+
+/// The number of independent xorshift generators per channel used for dither.
+constexpr std::size_t kDitherGeneratorLanes = 4;
+
+/// Stores dither values in LSBs from a channel's generators at intervals of stride.
+///
+/// Each group of four values comes from the four generators in order. Rectangular dither is uniform in [-½, ½) and
+/// triangular dither is the sum of two uniform values in [-1, 1).
+///
+/// The fastest implementation supported by the processor is used: SSE2 on x86-64, NEON on arm64, or portable C++.
+/// @param state The states of the channel's kDitherGeneratorLanes generators.
+/// @param triangular Whether to generate triangular instead of rectangular dither.
+/// @param output The location of the first value.
+/// @param count The number of values to store, which must be a multiple of kDitherGeneratorLanes.
+/// @param stride The distance between values in floats.
+void GenerateDitherNoise(UInt32 *state, bool triangular, float *output, std::size_t count,
+                         std::size_t stride) noexcept;
+
+/// Stores dither values in LSBs from a channel's generators at intervals of stride using portable C++.
+///
+/// The values and final generator states are bit-identical to those of GenerateDitherNoise.
+void GenerateDitherNoiseScalar(UInt32 *state, bool triangular, float *output, std::size_t count,
+                               std::size_t stride) noexcept;
+
+} /* namespace detail */
+} /* namespace audio_toolbox */
@@ -0,0 +1,591 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/DitherStage.hpp"
+#include "audio_toolbox/CAExtAudioFile.hpp"
+
+#include "AudioToolboxErrors.hpp"
+#include "DitherKernels.hpp"
+#include "LinearPCM.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/// The maximum number of frames quantized at a time.
+constexpr UInt32 kBlockFrames = 512;
+using audio_toolbox::detail::BufferCount;
+using audio_toolbox::detail::IsNativeFloat32;
+using audio_toolbox::detail::kDitherGeneratorLanes;
+using audio_toolbox::detail::kNativeBigEndian;
+
+/// The number of error feedback coefficients in the longest noise-shaping filter.
+constexpr std::size_t kMaximumFilterOrder = 9;
+/// Converts the upper 24 bits of a generator state to a float in [0, 1).
+constexpr float kUniformScale = 1.f / 16777216.f;
+
+#if TARGET_OS_IPHONE
+/// The time to wait before writing again when the codec is unavailable.
+constexpr std::chrono::milliseconds kCodecUnavailableRetryInterval{10};
+#endif /* TARGET_OS_IPHONE */
+
+// MARK: - Noise-Shaping Filters
+
+constexpr float kFirstOrderFilter[] = {1.f};
+constexpr float kLipshitzFilter[] = {2.033f, -2.165f, 1.959f, -1.590f, 0.6149f};
+constexpr float kWannamakerFilter[] = {2.412f,  -3.370f, 3.937f, -4.174f, 3.353f,
+                                       -2.205f, 1.281f,  -0.569f, 0.0847f};
+
+/// Error feedback coefficients, applied to the most recent error first.
+struct Filter {
+    const float *coefficients_{nullptr};
+    std::size_t order_{0};
+};
+
+Filter FilterFor(audio_toolbox::DitherStage::NoiseShaping noiseShaping) noexcept {
+    using NoiseShaping = audio_toolbox::DitherStage::NoiseShaping;
+    switch (noiseShaping) {
+    case NoiseShaping::firstOrder:
+        return {kFirstOrderFilter, std::size(kFirstOrderFilter)};
+    case NoiseShaping::lipshitz:
+        return {kLipshitzFilter, std::size(kLipshitzFilter)};
+    case NoiseShaping::wannamaker:
+        return {kWannamakerFilter, std::size(kWannamakerFilter)};
+    default:
+        return {};
+    }
+}
+
+// MARK: - Sample Formats
+
+/// Native-endian signed integer samples of Width bytes.
+template <std::size_t Width> struct IntSample {
+    static constexpr std::size_t size = Width;
+    static constexpr float scale = static_cast<float>(std::uint64_t{1} << (8 * Width - 1));
+    // As in the PCM fast path, 32-bit samples clip to 2^31 and full scale is corrected to INT32_MAX
+    static constexpr float maximum = Width == 4 ? scale : scale - 1;
+
+    static void Store(unsigned char *p, std::int32_t i) noexcept {
+        if constexpr (Width == 3) {
+            const auto u = static_cast<std::uint32_t>(i);
+            if constexpr (kNativeBigEndian) {
+                p[0] = static_cast<unsigned char>(u >> 16);
+                p[1] = static_cast<unsigned char>(u >> 8);
+                p[2] = static_cast<unsigned char>(u);
+            } else {
+                p[0] = static_cast<unsigned char>(u);
+                p[1] = static_cast<unsigned char>(u >> 8);
+                p[2] = static_cast<unsigned char>(u >> 16);
+            }
+        } else if constexpr (Width == 1) {
+            *p = static_cast<unsigned char>(static_cast<std::int8_t>(i));
+        } else if constexpr (Width == 2) {
+            const auto s = static_cast<std::int16_t>(i);
+            std::memcpy(p, &s, sizeof s);
+        } else {
+            std::memcpy(p, &i, sizeof i);
+        }
+    }
+};
+
+/// Clips and rounds a scaled sample.
+///
+/// The comparisons are ordered so NaN clips to the minimum, matching the vector implementations. Positive full scale
+/// clips to the integer maximum.
+template <typename Int> std::int32_t Round(float v) noexcept {
+    v = v > -Int::scale ? v : -Int::scale;
+    v = v < Int::maximum ? v : Int::maximum;
+    if constexpr (Int::maximum == Int::scale) {
+        if (v == Int::scale) {
+            return INT32_MAX;
+        }
+    }
+    return static_cast<std::int32_t>(std::nearbyint(v));
+}
+
+// MARK: - Generators
+
+/// Returns the next value of a SplitMix32 sequence, used to seed the generators.
+UInt32 SplitMix32(UInt32 &state) noexcept {
+    auto z = (state += 0x9e3779b9);
+    z = (z ^ (z >> 16)) * 0x85ebca6b;
+    z = (z ^ (z >> 13)) * 0xc2b2ae35;
+    return z ^ (z >> 16);
+}
+
+/// Advances a xorshift32 generator and returns a float in [0, 1).
+float NextUniform(UInt32 &state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state >> 8) * kUniformScale;
+}
+
+// MARK: - Scalar Kernels
+
+template <typename Out>
+void QuantizeScalar(const float *input, const float *noise, unsigned char *output, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        Out::Store(output + i * Out::size, Round<Out>(input[i] * Out::scale + noise[i]));
+    }
+}
+
+/// Quantizes count samples of one channel at intervals of stride with error feedback.
+///
+/// The error is measured before clipping so a clipped signal cannot drive the filter unstable.
+template <typename Out>
+void ShapeScalar(const float *input, const float *noise, unsigned char *output, std::size_t count, std::size_t stride,
+                 const Filter &filter, float *errors) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto v = input[i * stride] * Out::scale;
+        for (std::size_t k = 0; k < filter.order_; ++k) {
+            v -= filter.coefficients_[k] * errors[k];
+        }
+        const auto q = std::nearbyint(v + noise[i * stride]);
+        std::memmove(errors + 1, errors, (filter.order_ - 1) * sizeof(float));
+        errors[0] = q - v;
+        Out::Store(output + i * stride * Out::size, Round<Out>(q));
+    }
+}
+
+#if defined(__x86_64__)
+
+// MARK: - SSE2 Kernels
+
+void GenerateNoiseSSE2(UInt32 *state, bool triangular, float *output, std::size_t count,
+                       std::size_t stride) noexcept {
+    auto s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+    const auto next = [&s] {
+        s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+        s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+        s = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+        return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(s, 8)), _mm_set1_ps(kUniformScale));
+    };
+
+    for (std::size_t i = 0; i < count; i += kDitherGeneratorLanes) {
+        auto values = next();
+        values = triangular ? _mm_add_ps(values, _mm_sub_ps(next(), _mm_set1_ps(1.f)))
+                            : _mm_sub_ps(values, _mm_set1_ps(.5f));
+        if (stride == 1) {
+            _mm_storeu_ps(output + i, values);
+        } else {
+            alignas(16) float lanes[kDitherGeneratorLanes];
+            _mm_store_ps(lanes, values);
+            for (std::size_t lane = 0; lane < kDitherGeneratorLanes; ++lane) {
+                output[(i + lane) * stride] = lanes[lane];
+            }
+        }
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), s);
+}
+
+/// Returns four scaled, dithered, and clipped samples rounded to integers.
+template <typename Out> __m128i QuantizeSSE2(const float *input, const float *noise) noexcept {
+    // MAXPS and MINPS return the second operand if either is NaN
+    auto v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(input), _mm_set1_ps(Out::scale)), _mm_loadu_ps(noise));
+    v = _mm_max_ps(v, _mm_set1_ps(-Out::scale));
+    v = _mm_min_ps(v, _mm_set1_ps(Out::maximum));
+    const auto i = _mm_cvtps_epi32(v);
+    if constexpr (Out::maximum == Out::scale) {
+        // Out of range conversions return INT32_MIN, which is inverted to INT32_MAX
+        return _mm_xor_si128(i, _mm_castps_si128(_mm_cmpeq_ps(v, _mm_set1_ps(Out::scale))));
+    }
+    return i;
+}
+
+void QuantizeInt16SSE2(const float *input, const float *noise, unsigned char *output, std::size_t count) noexcept {
+    using Out = IntSample<2>;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto lo = QuantizeSSE2<Out>(input + i, noise + i);
+        const auto hi = QuantizeSSE2<Out>(input + i + 4, noise + i + 4);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i * Out::size), _mm_packs_epi32(lo, hi));
+    }
+    QuantizeScalar<Out>(input + i, noise + i, output + i * Out::size, count - i);
+}
+
+void QuantizeInt32SSE2(const float *input, const float *noise, unsigned char *output, std::size_t count) noexcept {
+    using Out = IntSample<4>;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i * Out::size), QuantizeSSE2<Out>(input + i, noise + i));
+    }
+    QuantizeScalar<Out>(input + i, noise + i, output + i * Out::size, count - i);
+}
+
+#elif defined(__aarch64__)
+
+// MARK: - NEON Kernels
+
+void GenerateNoiseNEON(UInt32 *state, bool triangular, float *output, std::size_t count,
+                       std::size_t stride) noexcept {
+    auto s = vld1q_u32(state);
+    const auto next = [&s] {
+        s = veorq_u32(s, vshlq_n_u32(s, 13));
+        s = veorq_u32(s, vshrq_n_u32(s, 17));
+        s = veorq_u32(s, vshlq_n_u32(s, 5));
+        return vmulq_n_f32(vcvtq_f32_u32(vshrq_n_u32(s, 8)), kUniformScale);
+    };
+
+    for (std::size_t i = 0; i < count; i += kDitherGeneratorLanes) {
+        auto values = next();
+        values = triangular ? vaddq_f32(values, vsubq_f32(next(), vdupq_n_f32(1.f)))
+                            : vsubq_f32(values, vdupq_n_f32(.5f));
+        if (stride == 1) {
+            vst1q_f32(output + i, values);
+        } else {
+            float lanes[kDitherGeneratorLanes];
+            vst1q_f32(lanes, values);
+            for (std::size_t lane = 0; lane < kDitherGeneratorLanes; ++lane) {
+                output[(i + lane) * stride] = lanes[lane];
+            }
+        }
+    }
+
+    vst1q_u32(state, s);
+}
+
+/// Returns four scaled, dithered, and clipped samples rounded to integers.
+template <typename Out> int32x4_t QuantizeNEON(const float *input, const float *noise) noexcept {
+    // Selects are used instead of FMAX and FMIN so NaN clips to the minimum as in the scalar implementation
+    auto v = vmlaq_n_f32(vld1q_f32(noise), vld1q_f32(input), Out::scale);
+    const auto minimum = vdupq_n_f32(-Out::scale);
+    const auto maximum = vdupq_n_f32(Out::maximum);
+    v = vbslq_f32(vcgtq_f32(v, minimum), v, minimum);
+    v = vbslq_f32(vcltq_f32(v, maximum), v, maximum);
+    // Conversion saturates, so full scale becomes INT32_MAX
+    return vcvtnq_s32_f32(v);
+}
+
+void QuantizeInt16NEON(const float *input, const float *noise, unsigned char *output, std::size_t count) noexcept {
+    using Out = IntSample<2>;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto lo = vqmovn_s32(QuantizeNEON<Out>(input + i, noise + i));
+        const auto hi = vqmovn_s32(QuantizeNEON<Out>(input + i + 4, noise + i + 4));
+        vst1q_s16(reinterpret_cast<std::int16_t *>(output + i * Out::size), vcombine_s16(lo, hi));
+    }
+    QuantizeScalar<Out>(input + i, noise + i, output + i * Out::size, count - i);
+}
+
+void QuantizeInt32NEON(const float *input, const float *noise, unsigned char *output, std::size_t count) noexcept {
+    using Out = IntSample<4>;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_s32(reinterpret_cast<std::int32_t *>(output + i * Out::size), QuantizeNEON<Out>(input + i, noise + i));
+    }
+    QuantizeScalar<Out>(input + i, noise + i, output + i * Out::size, count - i);
+}
+
+#endif
+
+// MARK: - Dispatch
+
+/// Stores count dither values from a channel's generators at intervals of stride and returns the number of values
+/// left unused.
+///
+/// Values are generated in groups of four, so the unused values of the final group are kept and stored first by the
+/// next call. This makes the noise independent of how frames are divided between calls.
+/// @param leftover The channel's final group of values, of which the last leftoverCount are unused.
+std::size_t GenerateNoise(UInt32 *state, float *leftover, std::size_t leftoverCount, bool triangular, float *output,
+                          std::size_t count, std::size_t stride) noexcept {
+    const auto reused = std::min(leftoverCount, count);
+    for (std::size_t i = 0; i < reused; ++i) {
+        output[i * stride] = leftover[kDitherGeneratorLanes - leftoverCount + i];
+    }
+    output += reused * stride;
+    count -= reused;
+    leftoverCount -= reused;
+
+    const auto whole = count - count % kDitherGeneratorLanes;
+    audio_toolbox::detail::GenerateDitherNoise(state, triangular, output, whole, stride);
+    if (const auto remaining = count - whole; remaining > 0) {
+        audio_toolbox::detail::GenerateDitherNoise(state, triangular, leftover, kDitherGeneratorLanes, 1);
+        for (std::size_t i = 0; i < remaining; ++i) {
+            output[(whole + i) * stride] = leftover[i];
+        }
+        leftoverCount = kDitherGeneratorLanes - remaining;
+    }
+    return leftoverCount;
+}
+
+void Quantize(UInt32 width, const float *input, const float *noise, unsigned char *output,
+              std::size_t count) noexcept {
+    switch (width) {
+    case 1:
+        QuantizeScalar<IntSample<1>>(input, noise, output, count);
+        break;
+    case 2:
+#if defined(__x86_64__)
+        QuantizeInt16SSE2(input, noise, output, count);
+#elif defined(__aarch64__)
+        QuantizeInt16NEON(input, noise, output, count);
+#else
+        QuantizeScalar<IntSample<2>>(input, noise, output, count);
+#endif
+        break;
+    case 3:
+        // Packed 24-bit samples do not map onto vector lanes and always use the portable implementation
+        QuantizeScalar<IntSample<3>>(input, noise, output, count);
+        break;
+    case 4:
+#if defined(__x86_64__)
+        QuantizeInt32SSE2(input, noise, output, count);
+#elif defined(__aarch64__)
+        QuantizeInt32NEON(input, noise, output, count);
+#else
+        QuantizeScalar<IntSample<4>>(input, noise, output, count);
+#endif
+        break;
+    }
+}
+
+void Shape(UInt32 width, const float *input, const float *noise, unsigned char *output, std::size_t count,
+           std::size_t stride, const Filter &filter, float *errors) noexcept {
+    switch (width) {
+    case 1:
+        ShapeScalar<IntSample<1>>(input, noise, output, count, stride, filter, errors);
+        break;
+    case 2:
+        ShapeScalar<IntSample<2>>(input, noise, output, count, stride, filter, errors);
+        break;
+    case 3:
+        ShapeScalar<IntSample<3>>(input, noise, output, count, stride, filter, errors);
+        break;
+    case 4:
+        ShapeScalar<IntSample<4>>(input, noise, output, count, stride, filter, errors);
+        break;
+    }
+}
+
+// MARK: - Validation
+
+bool IsNativePackedSignedInteger(const AudioStreamBasicDescription &format) noexcept {
+    const auto nonInterleaved = (format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+    const auto channelsPerBuffer = nonInterleaved ? 1 : format.mChannelsPerFrame;
+    const auto bits = format.mBitsPerChannel;
+    return format.mFormatID == kAudioFormatLinearPCM && (format.mFormatFlags & kAudioFormatFlagIsFloat) == 0 &&
+           (format.mFormatFlags & kAudioFormatFlagIsSignedInteger) != 0 &&
+           ((format.mFormatFlags & kAudioFormatFlagIsBigEndian) != 0) == kNativeBigEndian &&
+           (bits == 8 || bits == 16 || bits == 24 || bits == 32) &&
+           format.mBytesPerFrame == bits / 8 * channelsPerBuffer;
+}
+
+} /* namespace */
+
+void audio_toolbox::detail::GenerateDitherNoise(UInt32 *state, bool triangular, float *output, std::size_t count,
+                                                std::size_t stride) noexcept {
+#if defined(__x86_64__)
+    GenerateNoiseSSE2(state, triangular, output, count, stride);
+#elif defined(__aarch64__)
+    GenerateNoiseNEON(state, triangular, output, count, stride);
+#else
+    GenerateDitherNoiseScalar(state, triangular, output, count, stride);
+#endif
+}
+
+void audio_toolbox::detail::GenerateDitherNoiseScalar(UInt32 *state, bool triangular, float *output, std::size_t count,
+                                                      std::size_t stride) noexcept {
+    for (std::size_t i = 0; i < count; i += kDitherGeneratorLanes) {
+        float values[kDitherGeneratorLanes];
+        for (std::size_t lane = 0; lane < kDitherGeneratorLanes; ++lane) {
+            values[lane] = NextUniform(state[lane]);
+        }
+        if (triangular) {
+            for (std::size_t lane = 0; lane < kDitherGeneratorLanes; ++lane) {
+                values[lane] += NextUniform(state[lane]) - 1.f;
+            }
+        } else {
+            for (std::size_t lane = 0; lane < kDitherGeneratorLanes; ++lane) {
+                values[lane] -= .5f;
+            }
+        }
+        for (std::size_t lane = 0; lane < kDitherGeneratorLanes; ++lane) {
+            output[(i + lane) * stride] = values[lane];
+        }
+    }
+}
+
+void audio_toolbox::DitherStage::New(const AudioStreamBasicDescription &inSourceFormat,
+                                     const AudioStreamBasicDescription &inDestinationFormat, Dither dither,
+                                     NoiseShaping noiseShaping, UInt32 seed) {
+    if (!IsNativeFloat32(inSourceFormat) || !IsNativePackedSignedInteger(inDestinationFormat) ||
+        inSourceFormat.mSampleRate != inDestinationFormat.mSampleRate ||
+        inSourceFormat.mChannelsPerFrame != inDestinationFormat.mChannelsPerFrame ||
+        (inSourceFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved) !=
+                (inDestinationFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved)) {
+        ThrowIfAudioConverterError(kAudioConverterErr_FormatNotSupported, "DitherStage::New");
+    }
+
+    const auto channelCount = inSourceFormat.mChannelsPerFrame;
+    const auto nonInterleaved = detail::IsNonInterleaved(inSourceFormat);
+    const auto bufferCount = BufferCount(inSourceFormat);
+    const auto channelsPerBuffer = nonInterleaved ? 1 : channelCount;
+
+    std::vector<UInt32> generators(channelCount * kDitherGeneratorLanes);
+    std::vector<float> leftoverNoise(channelCount * kDitherGeneratorLanes);
+    std::vector<float> errors(channelCount * kMaximumFilterOrder);
+    std::vector<float> noise(static_cast<std::size_t>(kBlockFrames) * channelsPerBuffer);
+
+    // The buffer list is followed by the sample storage for each buffer
+    const auto listSize = (offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * bufferCount + 15) & ~15;
+    const auto bufferSize = static_cast<std::size_t>(kBlockFrames) * inDestinationFormat.mBytesPerFrame;
+    std::vector<unsigned char> writeBuffer(listSize + bufferSize * bufferCount);
+    auto *bufferList = reinterpret_cast<AudioBufferList *>(writeBuffer.data());
+    bufferList->mNumberBuffers = bufferCount;
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        bufferList->mBuffers[i].mNumberChannels = channelsPerBuffer;
+        bufferList->mBuffers[i].mDataByteSize = static_cast<UInt32>(bufferSize);
+        bufferList->mBuffers[i].mData = writeBuffer.data() + listSize + bufferSize * i;
+    }
+
+    sourceFormat_ = inSourceFormat;
+    destinationFormat_ = inDestinationFormat;
+    dither_ = dither;
+    noiseShaping_ = noiseShaping;
+    seed_ = seed;
+    generators_ = std::move(generators);
+    leftoverNoise_ = std::move(leftoverNoise);
+    errors_ = std::move(errors);
+    noise_ = std::move(noise);
+    writeBuffer_ = std::move(writeBuffer);
+
+    Reset();
+}
+
+void audio_toolbox::DitherStage::Dispose() noexcept {
+    generators_.clear();
+    generators_.shrink_to_fit();
+    leftoverNoise_.clear();
+    leftoverNoise_.shrink_to_fit();
+    errors_.clear();
+    errors_.shrink_to_fit();
+    noise_.clear();
+    noise_.shrink_to_fit();
+    writeBuffer_.clear();
+    writeBuffer_.shrink_to_fit();
+}
+
+void audio_toolbox::DitherStage::Reset() noexcept {
+    auto state = seed_;
+    for (auto &generator : generators_) {
+        // xorshift generators must not be seeded with zero
+        do {
+            generator = SplitMix32(state);
+        } while (generator == 0);
+    }
+    std::fill(leftoverNoise_.begin(), leftoverNoise_.end(), 0.f);
+    leftoverNoiseCount_ = 0;
+    std::fill(errors_.begin(), errors_.end(), 0.f);
+    std::fill(noise_.begin(), noise_.end(), 0.f);
+}
+
+void audio_toolbox::DitherStage::Process(UInt32 inNumberFrames, const AudioBufferList *inInputData,
+                                         AudioBufferList *outOutputData) {
+    if (!*this) {
+        ThrowIfAudioConverterError(kAudio_ParamError, "DitherStage::Process");
+    }
+
+    const auto bufferCount = BufferCount(sourceFormat_);
+    detail::ValidateBufferList(inInputData, bufferCount, UInt64{inNumberFrames} * sourceFormat_.mBytesPerFrame,
+                               "DitherStage::Process");
+    detail::ValidateBufferList(outOutputData, bufferCount, UInt64{inNumberFrames} * destinationFormat_.mBytesPerFrame,
+                               "DitherStage::Process");
+
+    for (UInt32 offset = 0; offset < inNumberFrames; offset += kBlockFrames) {
+        ProcessBlock(inInputData, offset, outOutputData, offset, std::min(kBlockFrames, inNumberFrames - offset));
+    }
+
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        outOutputData->mBuffers[i].mDataByteSize = inNumberFrames * destinationFormat_.mBytesPerFrame;
+    }
+}
+
+void audio_toolbox::DitherStage::Write(CAExtAudioFile &extAudioFile, UInt32 inNumberFrames,
+                                       const AudioBufferList *inInputData) {
+    if (!*this) {
+        ThrowIfAudioConverterError(kAudio_ParamError, "DitherStage::Write");
+    }
+
+    const auto bufferCount = BufferCount(sourceFormat_);
+    detail::ValidateBufferList(inInputData, bufferCount, UInt64{inNumberFrames} * sourceFormat_.mBytesPerFrame,
+                               "DitherStage::Write");
+
+    auto *bufferList = reinterpret_cast<AudioBufferList *>(writeBuffer_.data());
+    for (UInt32 offset = 0; offset < inNumberFrames; offset += kBlockFrames) {
+        const auto frameCount = std::min(kBlockFrames, inNumberFrames - offset);
+        ProcessBlock(inInputData, offset, bufferList, 0, frameCount);
+        for (UInt32 i = 0; i < bufferCount; ++i) {
+            bufferList->mBuffers[i].mDataByteSize = frameCount * destinationFormat_.mBytesPerFrame;
+        }
+
+#if TARGET_OS_IPHONE
+        // Write throws on errors and returns the codec unavailable statuses, which are not errors. Consumed input was
+        // written, and input not consumed is written again once the codec is available.
+        while (extAudioFile.Write(frameCount, bufferList) == kExtAudioFileError_CodecUnavailableInputNotConsumed) {
+            std::this_thread::sleep_for(kCodecUnavailableRetryInterval);
+        }
+#else
+        extAudioFile.Write(frameCount, bufferList);
+#endif /* TARGET_OS_IPHONE */
+    }
+}
+
+void audio_toolbox::DitherStage::ProcessBlock(const AudioBufferList *inInputData, UInt32 inputOffset,
+                                              AudioBufferList *outOutputData, UInt32 outputOffset,
+                                              UInt32 frameCount) noexcept {
+    const auto nonInterleaved = (sourceFormat_.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+    const auto channelsPerBuffer = nonInterleaved ? 1 : sourceFormat_.mChannelsPerFrame;
+    const auto width = destinationFormat_.mBitsPerChannel / 8;
+    const auto sampleCount = static_cast<std::size_t>(frameCount) * channelsPerBuffer;
+    const auto filter = FilterFor(noiseShaping_);
+    auto leftoverNoiseCount = leftoverNoiseCount_;
+
+    for (UInt32 i = 0; i < inInputData->mNumberBuffers; ++i) {
+        const auto firstChannel = nonInterleaved ? i : 0;
+        const auto *input = static_cast<const float *>(inInputData->mBuffers[i].mData) +
+                            static_cast<std::size_t>(inputOffset) * channelsPerBuffer;
+        auto *output = static_cast<unsigned char *>(outOutputData->mBuffers[i].mData) +
+                       static_cast<std::size_t>(outputOffset) * destinationFormat_.mBytesPerFrame;
+
+        // With no dither noise_ remains zero
+        if (dither_ != Dither::none) {
+            for (UInt32 c = 0; c < channelsPerBuffer; ++c) {
+                const auto channel = (firstChannel + c) * kDitherGeneratorLanes;
+                leftoverNoiseCount = GenerateNoise(&generators_[channel], &leftoverNoise_[channel],
+                                                   leftoverNoiseCount_, dither_ == Dither::triangular,
+                                                   noise_.data() + c, frameCount, channelsPerBuffer);
+            }
+        }
+
+        if (filter.order_ == 0) {
+            Quantize(width, input, noise_.data(), output, sampleCount);
+        } else {
+            for (UInt32 c = 0; c < channelsPerBuffer; ++c) {
+                Shape(width, input + c, noise_.data() + c, output + c * width, frameCount, channelsPerBuffer, filter,
+                      &errors_[(firstChannel + c) * kMaximumFilterOrder]);
+            }
+        }
+    }
+
+    // Every channel advances by the same number of frames
+    leftoverNoiseCount_ = leftoverNoiseCount;
+}
@@ -0,0 +1,132 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/GraphLatencyAnalysis.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/// Marks a node without a predecessor on its longest path.
+constexpr auto kNoPredecessor = std::numeric_limits<std::size_t>::max();
+
+} /* namespace */
+
+audio_toolbox::GraphLatencyAnalysis audio_toolbox::GraphLatencyAnalysis::Analyze(const Topology &topology) {
+    const auto nodeCount = topology.nodes_.size();
+
+    // Nodes are indexed in key order
+    std::vector<AUNode> nodes;
+    std::vector<NodeTiming> timing;
+    nodes.reserve(nodeCount);
+    timing.reserve(nodeCount);
+    for (const auto &[node, nodeTiming] : topology.nodes_) {
+        nodes.push_back(node);
+        timing.push_back(nodeTiming);
+    }
+
+    const auto indexOf = [&nodes](AUNode node) {
+        const auto it = std::lower_bound(nodes.begin(), nodes.end(), node);
+        if (it == nodes.end() || *it != node) {
+            throw std::invalid_argument("Connection refers to an unknown node");
+        }
+        return static_cast<std::size_t>(it - nodes.begin());
+    };
+
+    // Build the successor lists in CSR form
+    const auto connectionCount = topology.connections_.size();
+    std::vector<std::size_t> sources(connectionCount);
+    std::vector<std::size_t> destinations(connectionCount);
+    std::vector<std::size_t> successorOffsets(nodeCount + 1, 0);
+    std::vector<std::size_t> inDegree(nodeCount, 0);
+    for (std::size_t i = 0; i < connectionCount; ++i) {
+        sources[i] = indexOf(topology.connections_[i].sourceNode);
+        destinations[i] = indexOf(topology.connections_[i].destNode);
+        ++successorOffsets[sources[i] + 1];
+        ++inDegree[destinations[i]];
+    }
+    for (std::size_t i = 0; i < nodeCount; ++i) {
+        successorOffsets[i + 1] += successorOffsets[i];
+    }
+    std::vector<std::size_t> successors(connectionCount);
+    {
+        auto next = successorOffsets;
+        for (std::size_t i = 0; i < connectionCount; ++i) {
+            successors[next[sources[i]]++] = destinations[i];
+        }
+    }
+
+    // Order the nodes so every node follows its predecessors
+    std::vector<std::size_t> order;
+    order.reserve(nodeCount);
+    for (std::size_t i = 0; i < nodeCount; ++i) {
+        if (inDegree[i] == 0) {
+            order.push_back(i);
+        }
+    }
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        const auto node = order[head];
+        for (auto j = successorOffsets[node]; j < successorOffsets[node + 1]; ++j) {
+            if (--inDegree[successors[j]] == 0) {
+                order.push_back(successors[j]);
+            }
+        }
+    }
+    if (order.size() != nodeCount) {
+        throw std::invalid_argument("Connections form a cycle");
+    }
+
+    // Relax the longest path to each node's input, then add the node's own latency and tail time
+    std::vector<Float64> inputLatency(nodeCount, 0);
+    std::vector<Float64> inputTailTime(nodeCount, 0);
+    std::vector<std::size_t> predecessor(nodeCount, kNoPredecessor);
+    std::vector<Float64> outputLatency(nodeCount, 0);
+    std::vector<Float64> outputTailTime(nodeCount, 0);
+    for (const auto node : order) {
+        outputLatency[node] = inputLatency[node] + timing[node].latency_;
+        outputTailTime[node] = inputTailTime[node] + timing[node].tailTime_;
+        for (auto j = successorOffsets[node]; j < successorOffsets[node + 1]; ++j) {
+            const auto successor = successors[j];
+            if (predecessor[successor] == kNoPredecessor || outputLatency[node] > inputLatency[successor]) {
+                inputLatency[successor] = outputLatency[node];
+                predecessor[successor] = node;
+            }
+            inputTailTime[successor] = std::max(inputTailTime[successor], outputTailTime[node]);
+        }
+    }
+
+    GraphLatencyAnalysis analysis;
+
+    auto sink = kNoPredecessor;
+    for (std::size_t i = 0; i < nodeCount; ++i) {
+        analysis.pathLatency_.emplace_hint(analysis.pathLatency_.end(), nodes[i], outputLatency[i]);
+        analysis.pathTailTime_.emplace_hint(analysis.pathTailTime_.end(), nodes[i], outputTailTime[i]);
+        // The critical path ends at a node without successors
+        const auto isSink = successorOffsets[i] == successorOffsets[i + 1];
+        if (isSink && (sink == kNoPredecessor || outputLatency[i] > analysis.latency_)) {
+            analysis.latency_ = outputLatency[i];
+            sink = i;
+        }
+        analysis.tailTime_ = std::max(analysis.tailTime_, outputTailTime[i]);
+    }
+
+    for (auto node = sink; node != kNoPredecessor; node = predecessor[node]) {
+        analysis.criticalPath_.push_back(nodes[node]);
+    }
+    std::reverse(analysis.criticalPath_.begin(), analysis.criticalPath_.end());
+
+    for (std::size_t i = 0; i < connectionCount; ++i) {
+        if (const auto delay = inputLatency[destinations[i]] - outputLatency[sources[i]]; delay > 0) {
+            analysis.compensation_.push_back({topology.connections_[i], delay});
+        }
+    }
+
+    return analysis;
+}
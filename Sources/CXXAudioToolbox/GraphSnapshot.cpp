@@ -0,0 +1,86 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/GraphSnapshot.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/// Groups (index, value) entries by index into flat values and offsets, preserving entry order within each index.
+template <typename T>
+void BuildCSR(std::size_t count, const std::vector<std::pair<std::size_t, T>> &entries,
+              std::vector<std::size_t> &offsets, std::vector<T> &values) {
+    offsets.assign(count + 1, 0);
+    for (const auto &entry : entries) {
+        ++offsets[entry.first + 1];
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    values.resize(entries.size());
+    auto next = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+    for (const auto &entry : entries) {
+        values[next[entry.first]++] = entry.second;
+    }
+}
+
+} /* namespace */
+
+audio_toolbox::GraphSnapshot::GraphSnapshot(std::vector<AUNode> nodes, std::vector<AUNodeInteraction> interactions,
+                                            UInt64 version)
+    : version_{version}, nodes_{std::move(nodes)}, interactions_{std::move(interactions)} {
+    std::sort(nodes_.begin(), nodes_.end());
+    nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+
+    const auto indexOf = [this](AUNode node) {
+        const auto index = IndexOf(node);
+        if (!index) {
+            throw std::invalid_argument("Interaction refers to an unknown node");
+        }
+        return *index;
+    };
+
+    std::vector<std::pair<std::size_t, AUNodeInteraction>> nodeInteractions;
+    std::vector<std::pair<std::size_t, std::size_t>> successors;
+    std::vector<std::pair<std::size_t, std::size_t>> predecessors;
+    nodeInteractions.reserve(2 * interactions_.size());
+    successors.reserve(interactions_.size());
+    predecessors.reserve(interactions_.size());
+
+    for (const auto &interaction : interactions_) {
+        if (interaction.nodeInteractionType == kAUNodeInteraction_Connection) {
+            const auto &connection = interaction.nodeInteraction.connection;
+            const auto source = indexOf(connection.sourceNode);
+            const auto destination = indexOf(connection.destNode);
+            nodeInteractions.emplace_back(source, interaction);
+            if (destination != source) {
+                nodeInteractions.emplace_back(destination, interaction);
+            }
+            successors.emplace_back(source, destination);
+            predecessors.emplace_back(destination, source);
+        } else if (interaction.nodeInteractionType == kAUNodeInteraction_InputCallback) {
+            nodeInteractions.emplace_back(indexOf(interaction.nodeInteraction.inputCallback.destNode), interaction);
+        }
+    }
+
+    const auto nodeCount = nodes_.size();
+    BuildCSR(nodeCount, nodeInteractions, nodeInteractionOffsets_, nodeInteractions_);
+    BuildCSR(nodeCount, successors, successorOffsets_, successors_);
+    BuildCSR(nodeCount, predecessors, predecessorOffsets_, predecessors_);
+}
+
+std::optional<std::size_t> audio_toolbox::GraphSnapshot::IndexOf(AUNode node) const noexcept {
+    const auto it = std::lower_bound(nodes_.begin(), nodes_.end(), node);
+    if (it == nodes_.end() || *it != node) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(it - nodes_.begin());
+}
@@ -0,0 +1,60 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include "audio_toolbox/PCMFormat.hpp"
+
+#include "AudioToolboxErrors.hpp"
+
+#include <AudioToolbox/AudioConverter.h>
+
+namespace audio_toolbox {
+namespace detail {
+
+/// Returns true if format has its channels in separate buffers.
+[[nodiscard]] inline bool IsNonInterleaved(const AudioStreamBasicDescription &format) noexcept {
+    return (format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+}
+
+/// Returns the number of buffers in an AudioBufferList for format.
+[[nodiscard]] inline UInt32 BufferCount(const AudioStreamBasicDescription &format) noexcept {
+    return IsNonInterleaved(format) ? format.mChannelsPerFrame : 1;
+}
+
+/// Returns the number of bytes in one sample of format.
+[[nodiscard]] inline UInt32 BytesPerSample(const AudioStreamBasicDescription &format) noexcept {
+    return IsNonInterleaved(format) ? format.mBytesPerFrame : format.mBytesPerFrame / format.mChannelsPerFrame;
+}
+
+/// Returns true if format is packed native-endian 32-bit float linear PCM with one frame per packet.
+[[nodiscard]] inline bool IsNativeFloat32(const AudioStreamBasicDescription &format) noexcept {
+    const auto channelsPerBuffer = IsNonInterleaved(format) ? 1 : format.mChannelsPerFrame;
+    return format.mFormatID == kAudioFormatLinearPCM && (format.mFormatFlags & kAudioFormatFlagIsFloat) != 0 &&
+           ((format.mFormatFlags & kAudioFormatFlagIsBigEndian) != 0) == kNativeBigEndian &&
+           format.mBitsPerChannel == 32 && format.mChannelsPerFrame > 0 && format.mFramesPerPacket == 1 &&
+           format.mBytesPerPacket == format.mBytesPerFrame && format.mBytesPerFrame == 4 * channelsPerBuffer;
+}
+
+/// Throws if bufferList does not contain bufferCount buffers of at least byteCount bytes.
+///
+/// Buffers may have no data only if byteCount is zero.
+/// @throw std::system_error with kAudio_ParamError.
+inline void ValidateBufferList(const AudioBufferList *bufferList, UInt32 bufferCount, UInt64 byteCount,
+                               const char *operation) {
+    if (!bufferList || bufferList->mNumberBuffers != bufferCount) {
+        ThrowIfAudioConverterError(kAudio_ParamError, operation);
+    }
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        if (bufferList->mBuffers[i].mDataByteSize < byteCount || (byteCount > 0 && !bufferList->mBuffers[i].mData)) {
+            ThrowIfAudioConverterError(kAudio_ParamError, operation);
+        }
+    }
+}
+
+} /* namespace detail */
+} /* namespace audio_toolbox */
@@ -0,0 +1,214 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace audio_toolbox {
+namespace detail {
+
+/// A table of values computed on first use.
+///
+/// The table is an immutable map replaced on each insertion. Readers register in the current epoch and look up values
+/// without locking, and a replaced map is freed once every reader that may hold it has finished. A missing value is
+/// computed without holding a lock, copied into a new map together with the existing values, and published with a
+/// compare-and-swap, so concurrent first queries for a key may each compute it but all return the value published
+/// first. Only freeing replaced maps is serialized. Values are shared with callers so they outlive their removal from
+/// the table. When the table is full the oldest value is evicted.
+template <typename Key, typename Value, typename Hash = std::hash<Key>> class MemoTable final {
+  public:
+    /// The maximum number of values in the table.
+    static constexpr std::size_t kCapacity = 256;
+
+    /// Creates an empty table.
+    MemoTable() noexcept = default;
+
+    // This class is non-copyable
+    MemoTable(const MemoTable &) = delete;
+
+    // This class is non-assignable
+    MemoTable &operator=(const MemoTable &) = delete;
+
+    /// Frees the values not referenced elsewhere.
+    ~MemoTable() noexcept;
+
+    /// Returns the value for key, calling compute to produce it if not present.
+    ///
+    /// If compute throws, nothing is inserted and the exception propagates.
+    /// @throw std::bad_alloc.
+    /// @throw Any exception thrown by compute.
+    template <typename Compute> [[nodiscard]] std::shared_ptr<const Value> Get(const Key &key, Compute &&compute);
+
+    /// Returns the value for key, or nullptr if not present.
+    [[nodiscard]] std::shared_ptr<const Value> Find(const Key &key) const noexcept;
+
+    /// Returns the number of values in the table.
+    [[nodiscard]] std::size_t Size() const noexcept;
+
+    /// Discards all values.
+    void Clear() noexcept;
+
+  private:
+    /// A value and its insertion order.
+    struct Entry {
+        /// The value.
+        std::shared_ptr<const Value> value_;
+        /// The order in which the value was inserted.
+        std::uint64_t order_;
+    };
+
+    /// An immutable map of values.
+    struct Map {
+        /// The values.
+        std::unordered_map<Key, Entry, Hash> entries_;
+        /// The insertion order of the next value.
+        std::uint64_t nextOrder_{0};
+    };
+
+    /// Registers a reader in the current epoch for its lifetime.
+    class Reader final {
+      public:
+        explicit Reader(const MemoTable &table) noexcept;
+
+        // This class is non-copyable
+        Reader(const Reader &) = delete;
+
+        // This class is non-assignable
+        Reader &operator=(const Reader &) = delete;
+
+        ~Reader() noexcept;
+
+      private:
+        /// The reader count of the epoch the reader registered in.
+        std::atomic_uint32_t &readers_;
+    };
+
+    /// Frees a replaced map once the readers that may hold it have finished.
+    void Retire(const Map *map) noexcept;
+
+    /// The current map, or nullptr if empty.
+    std::atomic<const Map *> current_{nullptr};
+    /// The reader epoch, whose low bit selects the reader count used by new readers.
+    alignas(64) std::atomic_uint32_t epoch_{0};
+    /// The number of readers in each epoch.
+    mutable std::atomic_uint32_t readers_[2]{};
+    /// Serializes Retire() so each call switches the epoch twice without interruption.
+    std::mutex retireMutex_;
+};
+
+// MARK: - Implementation -
+
+template <typename Key, typename Value, typename Hash> inline MemoTable<Key, Value, Hash>::~MemoTable() noexcept {
+    delete current_.load();
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename Compute>
+inline std::shared_ptr<const Value> MemoTable<Key, Value, Hash>::Get(const Key &key, Compute &&compute) {
+    if (auto cached = Find(key); cached) {
+        return cached;
+    }
+
+    const auto value = std::make_shared<const Value>(compute());
+
+    for (;;) {
+        const Map *map;
+        {
+            // Registering as a reader keeps the map alive while it is copied, so it cannot be freed and its address
+            // reused before the compare-and-swap
+            const Reader reader{*this};
+            map = current_.load();
+
+            // Another thread may have inserted the value while it was computed
+            if (map) {
+                if (const auto it = map->entries_.find(key); it != map->entries_.end()) {
+                    return it->second.value_;
+                }
+            }
+
+            auto next = map ? std::make_unique<Map>(*map) : std::make_unique<Map>();
+            if (next->entries_.size() >= kCapacity) {
+                const auto oldest = [](const auto &a, const auto &b) { return a.second.order_ < b.second.order_; };
+                next->entries_.erase(std::min_element(next->entries_.begin(), next->entries_.end(), oldest));
+            }
+            next->entries_.emplace(key, Entry{value, next->nextOrder_++});
+
+            if (!current_.compare_exchange_strong(map, next.get())) {
+                continue;
+            }
+            next.release();
+        }
+
+        Retire(map);
+        return value;
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+inline std::shared_ptr<const Value> MemoTable<Key, Value, Hash>::Find(const Key &key) const noexcept {
+    const Reader reader{*this};
+    if (const auto *map = current_.load(); map) {
+        if (const auto it = map->entries_.find(key); it != map->entries_.end()) {
+            return it->second.value_;
+        }
+    }
+    return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash>
+inline std::size_t MemoTable<Key, Value, Hash>::Size() const noexcept {
+    const Reader reader{*this};
+    const auto *map = current_.load();
+    return map ? map->entries_.size() : 0;
+}
+
+template <typename Key, typename Value, typename Hash> inline void MemoTable<Key, Value, Hash>::Clear() noexcept {
+    Retire(current_.exchange(nullptr));
+}
+
+template <typename Key, typename Value, typename Hash>
+inline MemoTable<Key, Value, Hash>::Reader::Reader(const MemoTable &table) noexcept
+    : readers_{table.readers_[table.epoch_.load() & 1]} {
+    readers_.fetch_add(1);
+}
+
+template <typename Key, typename Value, typename Hash>
+inline MemoTable<Key, Value, Hash>::Reader::~Reader() noexcept {
+    readers_.fetch_sub(1);
+}
+
+template <typename Key, typename Value, typename Hash>
+inline void MemoTable<Key, Value, Hash>::Retire(const Map *map) noexcept {
+    if (!map) {
+        return;
+    }
+
+    // A reader may hold the map only if it registered before the map was replaced, in either epoch. Each epoch's
+    // count is awaited after switching new readers to the other epoch so it cannot be starved by later readers.
+    // Concurrent calls could otherwise interleave their switches and await the same epoch twice.
+    std::lock_guard lock{retireMutex_};
+    for (auto i = 0; i < 2; ++i) {
+        const auto epoch = epoch_.fetch_add(1) & 1;
+        while (readers_[epoch].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    delete map;
+}
+
+} /* namespace detail */
+} /* namespace audio_toolbox */
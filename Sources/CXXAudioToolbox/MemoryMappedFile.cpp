@@ -0,0 +1,137 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/MemoryMappedFile.hpp"
+
+#include "AudioToolboxErrors.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/// Closes a file descriptor when it goes out of scope.
+struct fd_closer {
+    int fd_;
+    ~fd_closer() noexcept { ::close(fd_); }
+};
+
+} /* namespace */
+
+void audio_toolbox::MemoryMappedFile::Map(const char *path) {
+    Unmap();
+
+    const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), "open");
+    }
+    fd_closer closer{fd};
+
+    struct stat s;
+    if (::fstat(fd, &s) == -1) {
+        throw std::system_error(errno, std::generic_category(), "fstat");
+    }
+
+    // mmap fails for zero-length files; an empty mapping is treated as unmapped
+    if (s.st_size == 0) {
+        return;
+    }
+
+    const auto size = static_cast<std::size_t>(s.st_size);
+    auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+
+    // Audio files are most often read front to back
+    ::posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+
+    data_ = data;
+    size_ = size;
+}
+
+void audio_toolbox::MemoryMappedFile::Map(CFURLRef inURL) {
+    char path[PATH_MAX];
+    if (!CFURLGetFileSystemRepresentation(inURL, true, reinterpret_cast<UInt8 *>(path), PATH_MAX)) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), "CFURLGetFileSystemRepresentation");
+    }
+    Map(path);
+}
+
+void audio_toolbox::MemoryMappedFile::Unmap() noexcept {
+    if (data_) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+void audio_toolbox::MemoryMappedFile::OpenAudioFile(CAAudioFile &audioFile, AudioFileTypeID inFileTypeHint) {
+    audioFile.OpenWithCallbacks(this, ReadProc, nullptr, GetSizeProc, nullptr, inFileTypeHint);
+}
+
+const void *audio_toolbox::MemoryMappedFile::PCMPacketData(const CAAudioFile &audioFile, SInt64 inStartingPacket,
+                                                           UInt32 &ioNumPackets, UInt32 &outNumBytes) const {
+    const auto format = audioFile.DataFormat();
+    if (format.mBytesPerPacket == 0) {
+        throw std::invalid_argument("Data format does not have a constant packet size");
+    }
+    if (inStartingPacket < 0) {
+        ThrowIfAudioFileError(kAudioFileInvalidPacketOffsetError, "PCMPacketData");
+    }
+
+    const auto dataOffset = audioFile.DataOffset();
+    const auto dataByteCount =
+            std::min(audioFile.AudioDataByteCount(), static_cast<UInt64>(std::max<SInt64>(0, Size() - dataOffset)));
+    const auto totalPackets = dataByteCount / format.mBytesPerPacket;
+
+    const auto startingPacket = static_cast<UInt64>(inStartingPacket);
+    if (startingPacket >= totalPackets) {
+        ioNumPackets = 0;
+        outNumBytes = 0;
+        return nullptr;
+    }
+
+    // Limit the packet count so the byte count fits in a UInt32
+    const auto maxPackets = std::min<UInt64>(totalPackets - startingPacket, UINT32_MAX / format.mBytesPerPacket);
+    ioNumPackets = static_cast<UInt32>(std::min<UInt64>(ioNumPackets, maxPackets));
+    outNumBytes = ioNumPackets * format.mBytesPerPacket;
+
+    return static_cast<const unsigned char *>(data_) + dataOffset + startingPacket * format.mBytesPerPacket;
+}
+
+OSStatus audio_toolbox::MemoryMappedFile::ReadProc(void *inClientData, SInt64 inPosition, UInt32 requestCount,
+                                                   void *buffer, UInt32 *actualCount) noexcept {
+    const auto mappedFile = static_cast<const MemoryMappedFile *>(inClientData);
+    if (inPosition < 0) {
+        return kAudioFilePositionError;
+    }
+
+    const auto size = mappedFile->Size();
+    if (inPosition >= size) {
+        *actualCount = 0;
+        return noErr;
+    }
+
+    const auto count = static_cast<UInt32>(std::min<SInt64>(requestCount, size - inPosition));
+    std::memcpy(buffer, static_cast<const unsigned char *>(mappedFile->data_) + inPosition, count);
+    *actualCount = count;
+    return noErr;
+}
+
+SInt64 audio_toolbox::MemoryMappedFile::GetSizeProc(void *inClientData) noexcept {
+    return static_cast<const MemoryMappedFile *>(inClientData)->Size();
+}
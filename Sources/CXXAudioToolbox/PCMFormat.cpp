@@ -0,0 +1,28 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/PCMFormat.hpp"
+
+#include "AudioToolboxErrors.hpp"
+#include "LinearPCM.hpp"
+
+UInt32 audio_toolbox::detail::PCMConverterFrameCount(UInt32 inputSize, UInt32 inputBytesPerFrame,
+                                                     UInt32 outputCapacity, UInt32 outputBytesPerFrame) {
+    const auto frameCount = inputSize / inputBytesPerFrame;
+    if (frameCount * inputBytesPerFrame != inputSize) {
+        ThrowIfAudioConverterError(kAudioConverterErr_InvalidInputSize, "PCMConverter::ConvertBuffer");
+    }
+    if (static_cast<UInt64>(frameCount) * outputBytesPerFrame > outputCapacity) {
+        ThrowIfAudioConverterError(kAudioConverterErr_InvalidOutputSize, "PCMConverter::ConvertBuffer");
+    }
+    return frameCount;
+}
+
+void audio_toolbox::detail::ValidatePCMConverterBufferList(const AudioBufferList *bufferList, UInt32 bufferCount,
+                                                           UInt64 byteCount) {
+    ValidateBufferList(bufferList, bufferCount, byteCount, "PCMConverter::ConvertComplexBuffer");
+}
@@ -0,0 +1,777 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/PCMFormat.hpp"
+
+#include "LinearPCM.hpp"
+#include "PCMKernels.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+using audio_toolbox::detail::kNativeBigEndian;
+using audio_toolbox::detail::PCMSampleConverter;
+
+// MARK: - Sample Formats
+
+/// 16-bit signed integer samples, byte swapped if Swap is true.
+template <bool Swap> struct Int16Sample {
+    static constexpr std::size_t size = 2;
+    static constexpr float scale = 32768.f;
+    static constexpr float maximum = 32767.f;
+
+    static std::int32_t Load(const unsigned char *p) noexcept {
+        std::uint16_t u;
+        std::memcpy(&u, p, sizeof u);
+        if constexpr (Swap) {
+            u = __builtin_bswap16(u);
+        }
+        return static_cast<std::int16_t>(u);
+    }
+
+    static void Store(unsigned char *p, std::int32_t i) noexcept {
+        auto u = static_cast<std::uint16_t>(i);
+        if constexpr (Swap) {
+            u = __builtin_bswap16(u);
+        }
+        std::memcpy(p, &u, sizeof u);
+    }
+};
+
+/// Packed 24-bit signed integer samples in big-endian byte order if BigEndian is true.
+template <bool BigEndian> struct Int24Sample {
+    static constexpr std::size_t size = 3;
+    static constexpr float scale = 8388608.f;
+    static constexpr float maximum = 8388607.f;
+
+    static std::int32_t Load(const unsigned char *p) noexcept {
+        std::uint32_t u;
+        if constexpr (BigEndian) {
+            u = (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8);
+        } else {
+            u = (std::uint32_t{p[2]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[0]} << 8);
+        }
+        // Arithmetic shift sign-extends
+        return static_cast<std::int32_t>(u) >> 8;
+    }
+
+    static void Store(unsigned char *p, std::int32_t i) noexcept {
+        const auto u = static_cast<std::uint32_t>(i);
+        if constexpr (BigEndian) {
+            p[0] = static_cast<unsigned char>(u >> 16);
+            p[1] = static_cast<unsigned char>(u >> 8);
+            p[2] = static_cast<unsigned char>(u);
+        } else {
+            p[0] = static_cast<unsigned char>(u);
+            p[1] = static_cast<unsigned char>(u >> 8);
+            p[2] = static_cast<unsigned char>(u >> 16);
+        }
+    }
+};
+
+/// 32-bit signed integer samples, byte swapped if Swap is true.
+template <bool Swap> struct Int32Sample {
+    static constexpr std::size_t size = 4;
+    static constexpr float scale = 2147483648.f;
+    // 2^31 is not representable as a 32-bit integer, so full scale is corrected to INT32_MAX after clipping
+    static constexpr float maximum = 2147483648.f;
+
+    static std::int32_t Load(const unsigned char *p) noexcept {
+        std::uint32_t u;
+        std::memcpy(&u, p, sizeof u);
+        if constexpr (Swap) {
+            u = __builtin_bswap32(u);
+        }
+        return static_cast<std::int32_t>(u);
+    }
+
+    static void Store(unsigned char *p, std::int32_t i) noexcept {
+        auto u = static_cast<std::uint32_t>(i);
+        if constexpr (Swap) {
+            u = __builtin_bswap32(u);
+        }
+        std::memcpy(p, &u, sizeof u);
+    }
+};
+
+/// 32-bit float samples, byte swapped if Swap is true.
+template <bool Swap> struct Float32Sample {
+    static constexpr std::size_t size = 4;
+
+    static float Load(const unsigned char *p) noexcept {
+        std::uint32_t u;
+        std::memcpy(&u, p, sizeof u);
+        if constexpr (Swap) {
+            u = __builtin_bswap32(u);
+        }
+        float f;
+        std::memcpy(&f, &u, sizeof f);
+        return f;
+    }
+
+    static void Store(unsigned char *p, float f) noexcept {
+        std::uint32_t u;
+        std::memcpy(&u, &f, sizeof u);
+        if constexpr (Swap) {
+            u = __builtin_bswap32(u);
+        }
+        std::memcpy(p, &u, sizeof u);
+    }
+};
+
+/// Scales, clips, and rounds a float sample to an integer format.
+///
+/// The comparisons are ordered so NaN clips to the minimum, matching the vector implementations. Positive full scale
+/// clips to the integer maximum.
+template <typename Int> std::int32_t Quantize(float f) noexcept {
+    auto v = f * Int::scale;
+    v = v > -Int::scale ? v : -Int::scale;
+    v = v < Int::maximum ? v : Int::maximum;
+    if constexpr (Int::maximum == Int::scale) {
+        if (v == Int::scale) {
+            return INT32_MAX;
+        }
+    }
+    return static_cast<std::int32_t>(std::nearbyint(v));
+}
+
+// MARK: - Scalar Kernels
+
+template <typename In, typename Out>
+void IntToFloatScalar(const unsigned char *input, unsigned char *output, std::size_t count) noexcept {
+    constexpr float scale = 1.f / In::scale;
+    for (std::size_t i = 0; i < count; ++i) {
+        Out::Store(output + i * Out::size, static_cast<float>(In::Load(input + i * In::size)) * scale);
+    }
+}
+
+template <typename In, typename Out>
+void FloatToIntScalar(const unsigned char *input, unsigned char *output, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        Out::Store(output + i * Out::size, Quantize<Out>(In::Load(input + i * In::size)));
+    }
+}
+
+template <typename In, typename Out> void IntToFloat(const void *input, void *output, std::size_t count) {
+    IntToFloatScalar<In, Out>(static_cast<const unsigned char *>(input), static_cast<unsigned char *>(output), count);
+}
+
+template <typename In, typename Out> void FloatToInt(const void *input, void *output, std::size_t count) {
+    FloatToIntScalar<In, Out>(static_cast<const unsigned char *>(input), static_cast<unsigned char *>(output), count);
+}
+
+#if defined(__x86_64__)
+
+// MARK: - SSE2 Kernels
+
+inline __m128i Swap16SSE2(__m128i v) noexcept { return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); }
+
+inline __m128i Swap32SSE2(__m128i v) noexcept {
+    v = _mm_or_si128(_mm_slli_epi32(v, 16), _mm_srli_epi32(v, 16));
+    return Swap16SSE2(v);
+}
+
+template <bool Swap> __m128 LoadFloatsSSE2(const unsigned char *p) noexcept {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    if constexpr (Swap) {
+        v = Swap32SSE2(v);
+    }
+    return _mm_castsi128_ps(v);
+}
+
+template <bool Swap> void StoreFloatsSSE2(unsigned char *p, __m128 f) noexcept {
+    auto v = _mm_castps_si128(f);
+    if constexpr (Swap) {
+        v = Swap32SSE2(v);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+}
+
+template <bool SwapIn, bool SwapOut> void Int16ToFloatSSE2(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+    const auto scale = _mm_set1_ps(1.f / Int16Sample<SwapIn>::scale);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 2 * i));
+        if constexpr (SwapIn) {
+            v = Swap16SSE2(v);
+        }
+        const auto lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const auto hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        StoreFloatsSSE2<SwapOut>(out + 4 * i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        StoreFloatsSSE2<SwapOut>(out + 4 * i + 16, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+
+    IntToFloatScalar<Int16Sample<SwapIn>, Float32Sample<SwapOut>>(in + 2 * i, out + 4 * i, count - i);
+}
+
+template <typename Int> __m128i QuantizeSSE2(__m128 f) noexcept {
+    // MAXPS and MINPS return the second operand if either is NaN
+    auto v = _mm_mul_ps(f, _mm_set1_ps(Int::scale));
+    v = _mm_max_ps(v, _mm_set1_ps(-Int::scale));
+    v = _mm_min_ps(v, _mm_set1_ps(Int::maximum));
+    const auto i = _mm_cvtps_epi32(v);
+    if constexpr (Int::maximum == Int::scale) {
+        // Out of range conversions return INT32_MIN, which is inverted to INT32_MAX
+        return _mm_xor_si128(i, _mm_castps_si128(_mm_cmpeq_ps(v, _mm_set1_ps(Int::scale))));
+    }
+    return i;
+}
+
+template <bool SwapIn, bool SwapOut> void FloatToInt16SSE2(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto a = QuantizeSSE2<Int16Sample<SwapOut>>(LoadFloatsSSE2<SwapIn>(in + 4 * i));
+        const auto b = QuantizeSSE2<Int16Sample<SwapOut>>(LoadFloatsSSE2<SwapIn>(in + 4 * i + 16));
+        auto v = _mm_packs_epi32(a, b);
+        if constexpr (SwapOut) {
+            v = Swap16SSE2(v);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i), v);
+    }
+
+    FloatToIntScalar<Float32Sample<SwapIn>, Int16Sample<SwapOut>>(in + 4 * i, out + 2 * i, count - i);
+}
+
+template <bool SwapIn, bool SwapOut> void Int32ToFloatSSE2(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+    const auto scale = _mm_set1_ps(1.f / Int32Sample<SwapIn>::scale);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 4 * i));
+        if constexpr (SwapIn) {
+            v = Swap32SSE2(v);
+        }
+        StoreFloatsSSE2<SwapOut>(out + 4 * i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+
+    IntToFloatScalar<Int32Sample<SwapIn>, Float32Sample<SwapOut>>(in + 4 * i, out + 4 * i, count - i);
+}
+
+template <bool SwapIn, bool SwapOut> void FloatToInt32SSE2(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto v = QuantizeSSE2<Int32Sample<SwapOut>>(LoadFloatsSSE2<SwapIn>(in + 4 * i));
+        if constexpr (SwapOut) {
+            v = Swap32SSE2(v);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * i), v);
+    }
+
+    FloatToIntScalar<Float32Sample<SwapIn>, Int32Sample<SwapOut>>(in + 4 * i, out + 4 * i, count - i);
+}
+
+// MARK: - AVX2 Kernels
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET inline __m256i Swap16AVX2(__m256i v) noexcept {
+    const auto mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9,
+                                       8, 11, 10, 13, 12, 15, 14);
+    return _mm256_shuffle_epi8(v, mask);
+}
+
+AVX2_TARGET inline __m256i Swap32AVX2(__m256i v) noexcept {
+    const auto mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11,
+                                       10, 9, 8, 15, 14, 13, 12);
+    return _mm256_shuffle_epi8(v, mask);
+}
+
+template <bool Swap> AVX2_TARGET __m256 LoadFloatsAVX2(const unsigned char *p) noexcept {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    if constexpr (Swap) {
+        v = Swap32AVX2(v);
+    }
+    return _mm256_castsi256_ps(v);
+}
+
+template <bool Swap> AVX2_TARGET void StoreFloatsAVX2(unsigned char *p, __m256 f) noexcept {
+    auto v = _mm256_castps_si256(f);
+    if constexpr (Swap) {
+        v = Swap32AVX2(v);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+}
+
+template <typename Int> AVX2_TARGET __m256i QuantizeAVX2(__m256 f) noexcept {
+    auto v = _mm256_mul_ps(f, _mm256_set1_ps(Int::scale));
+    v = _mm256_max_ps(v, _mm256_set1_ps(-Int::scale));
+    v = _mm256_min_ps(v, _mm256_set1_ps(Int::maximum));
+    const auto i = _mm256_cvtps_epi32(v);
+    if constexpr (Int::maximum == Int::scale) {
+        // Out of range conversions return INT32_MIN, which is inverted to INT32_MAX
+        return _mm256_xor_si256(i, _mm256_castps_si256(_mm256_cmp_ps(v, _mm256_set1_ps(Int::scale), _CMP_EQ_OQ)));
+    }
+    return i;
+}
+
+template <bool SwapIn, bool SwapOut>
+AVX2_TARGET void Int16ToFloatAVX2(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+    const auto scale = _mm256_set1_ps(1.f / Int16Sample<SwapIn>::scale);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + 2 * i));
+        if constexpr (SwapIn) {
+            v = Swap16AVX2(v);
+        }
+        const auto lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v));
+        const auto hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1));
+        StoreFloatsAVX2<SwapOut>(out + 4 * i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+        StoreFloatsAVX2<SwapOut>(out + 4 * i + 32, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+    }
+
+    IntToFloatScalar<Int16Sample<SwapIn>, Float32Sample<SwapOut>>(in + 2 * i, out + 4 * i, count - i);
+}
+
+template <bool SwapIn, bool SwapOut>
+AVX2_TARGET void FloatToInt16AVX2(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const auto a = QuantizeAVX2<Int16Sample<SwapOut>>(LoadFloatsAVX2<SwapIn>(in + 4 * i));
+        const auto b = QuantizeAVX2<Int16Sample<SwapOut>>(LoadFloatsAVX2<SwapIn>(in + 4 * i + 32));
+        // Packing operates within 128-bit lanes so the 64-bit groups are reordered afterward
+        auto v = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xd8);
+        if constexpr (SwapOut) {
+            v = Swap16AVX2(v);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i), v);
+    }
+
+    FloatToIntScalar<Float32Sample<SwapIn>, Int16Sample<SwapOut>>(in + 4 * i, out + 2 * i, count - i);
+}
+
+template <bool SwapIn, bool SwapOut>
+AVX2_TARGET void Int32ToFloatAVX2(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+    const auto scale = _mm256_set1_ps(1.f / Int32Sample<SwapIn>::scale);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + 4 * i));
+        if constexpr (SwapIn) {
+            v = Swap32AVX2(v);
+        }
+        StoreFloatsAVX2<SwapOut>(out + 4 * i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+
+    IntToFloatScalar<Int32Sample<SwapIn>, Float32Sample<SwapOut>>(in + 4 * i, out + 4 * i, count - i);
+}
+
+template <bool SwapIn, bool SwapOut>
+AVX2_TARGET void FloatToInt32AVX2(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto v = QuantizeAVX2<Int32Sample<SwapOut>>(LoadFloatsAVX2<SwapIn>(in + 4 * i));
+        if constexpr (SwapOut) {
+            v = Swap32AVX2(v);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 4 * i), v);
+    }
+
+    FloatToIntScalar<Float32Sample<SwapIn>, Int32Sample<SwapOut>>(in + 4 * i, out + 4 * i, count - i);
+}
+
+#undef AVX2_TARGET
+
+/// Returns true if the processor supports AVX2.
+bool HasAVX2() noexcept {
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    return hasAVX2;
+}
+
+#elif defined(__aarch64__)
+
+// MARK: - NEON Kernels
+
+template <bool Swap> float32x4_t LoadFloatsNEON(const unsigned char *p) noexcept {
+    auto v = vld1q_u8(p);
+    if constexpr (Swap) {
+        v = vrev32q_u8(v);
+    }
+    return vreinterpretq_f32_u8(v);
+}
+
+template <bool Swap> void StoreFloatsNEON(unsigned char *p, float32x4_t f) noexcept {
+    auto v = vreinterpretq_u8_f32(f);
+    if constexpr (Swap) {
+        v = vrev32q_u8(v);
+    }
+    vst1q_u8(p, v);
+}
+
+template <typename Int> int32x4_t QuantizeNEON(float32x4_t f) noexcept {
+    // Selects are used instead of FMAX and FMIN so NaN clips to the minimum as in the scalar implementation
+    auto v = vmulq_n_f32(f, Int::scale);
+    const auto minimum = vdupq_n_f32(-Int::scale);
+    const auto maximum = vdupq_n_f32(Int::maximum);
+    v = vbslq_f32(vcgtq_f32(v, minimum), v, minimum);
+    v = vbslq_f32(vcltq_f32(v, maximum), v, maximum);
+    // Conversion saturates, so full scale becomes INT32_MAX
+    return vcvtnq_s32_f32(v);
+}
+
+template <bool SwapIn, bool SwapOut> void Int16ToFloatNEON(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+    constexpr float scale = 1.f / Int16Sample<SwapIn>::scale;
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        auto u = vld1q_u8(in + 2 * i);
+        if constexpr (SwapIn) {
+            u = vrev16q_u8(u);
+        }
+        const auto v = vreinterpretq_s16_u8(u);
+        const auto lo = vmovl_s16(vget_low_s16(v));
+        const auto hi = vmovl_high_s16(v);
+        StoreFloatsNEON<SwapOut>(out + 4 * i, vmulq_n_f32(vcvtq_f32_s32(lo), scale));
+        StoreFloatsNEON<SwapOut>(out + 4 * i + 16, vmulq_n_f32(vcvtq_f32_s32(hi), scale));
+    }
+
+    IntToFloatScalar<Int16Sample<SwapIn>, Float32Sample<SwapOut>>(in + 2 * i, out + 4 * i, count - i);
+}
+
+template <bool SwapIn, bool SwapOut> void FloatToInt16NEON(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto a = QuantizeNEON<Int16Sample<SwapOut>>(LoadFloatsNEON<SwapIn>(in + 4 * i));
+        const auto b = QuantizeNEON<Int16Sample<SwapOut>>(LoadFloatsNEON<SwapIn>(in + 4 * i + 16));
+        auto u = vreinterpretq_u8_s16(vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+        if constexpr (SwapOut) {
+            u = vrev16q_u8(u);
+        }
+        vst1q_u8(out + 2 * i, u);
+    }
+
+    FloatToIntScalar<Float32Sample<SwapIn>, Int16Sample<SwapOut>>(in + 4 * i, out + 2 * i, count - i);
+}
+
+template <bool SwapIn, bool SwapOut> void Int32ToFloatNEON(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+    constexpr float scale = 1.f / Int32Sample<SwapIn>::scale;
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto u = vld1q_u8(in + 4 * i);
+        if constexpr (SwapIn) {
+            u = vrev32q_u8(u);
+        }
+        StoreFloatsNEON<SwapOut>(out + 4 * i, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u8(u)), scale));
+    }
+
+    IntToFloatScalar<Int32Sample<SwapIn>, Float32Sample<SwapOut>>(in + 4 * i, out + 4 * i, count - i);
+}
+
+template <bool SwapIn, bool SwapOut> void FloatToInt32NEON(const void *input, void *output, std::size_t count) {
+    auto in = static_cast<const unsigned char *>(input);
+    auto out = static_cast<unsigned char *>(output);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto u = vreinterpretq_u8_s32(QuantizeNEON<Int32Sample<SwapOut>>(LoadFloatsNEON<SwapIn>(in + 4 * i)));
+        if constexpr (SwapOut) {
+            u = vrev32q_u8(u);
+        }
+        vst1q_u8(out + 4 * i, u);
+    }
+
+    FloatToIntScalar<Float32Sample<SwapIn>, Int32Sample<SwapOut>>(in + 4 * i, out + 4 * i, count - i);
+}
+
+#endif
+
+// MARK: - Selection
+
+/// Sample encodings with built-in converters.
+enum class Encoding { int16, int24, int32, float32 };
+
+/// A linear PCM sample format.
+struct SampleFormat {
+    /// The sample encoding.
+    Encoding encoding_;
+    /// True if samples are big-endian.
+    bool bigEndian_;
+};
+
+/// Determines the sample format of an ASBD, returning false if it has no built-in converter.
+bool GetSampleFormat(const AudioStreamBasicDescription &format, SampleFormat &sampleFormat) noexcept {
+    if (format.mFormatID != kAudioFormatLinearPCM || format.mFramesPerPacket != 1 || format.mChannelsPerFrame == 0 ||
+        format.mBytesPerPacket != format.mBytesPerFrame) {
+        return false;
+    }
+
+    const auto flags = format.mFormatFlags;
+    if (flags & kLinearPCMFormatFlagsSampleFractionMask) {
+        return false;
+    }
+
+    const auto channelsPerBuffer = (flags & kAudioFormatFlagIsNonInterleaved) ? 1 : format.mChannelsPerFrame;
+    if (format.mBytesPerFrame % channelsPerBuffer) {
+        return false;
+    }
+    const auto bytesPerSample = format.mBytesPerFrame / channelsPerBuffer;
+
+    // Samples must occupy the full sample width
+    if (format.mBitsPerChannel != 8 * bytesPerSample) {
+        return false;
+    }
+
+    sampleFormat.bigEndian_ = (flags & kAudioFormatFlagIsBigEndian) != 0;
+
+    if (flags & kAudioFormatFlagIsFloat) {
+        if (bytesPerSample != 4) {
+            return false;
+        }
+        sampleFormat.encoding_ = Encoding::float32;
+        return true;
+    }
+
+    if (!(flags & kAudioFormatFlagIsSignedInteger)) {
+        return false;
+    }
+
+    switch (bytesPerSample) {
+    case 2:
+        sampleFormat.encoding_ = Encoding::int16;
+        return true;
+    case 3:
+        sampleFormat.encoding_ = Encoding::int24;
+        return true;
+    case 4:
+        sampleFormat.encoding_ = Encoding::int32;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Calls select with std::bool_constant arguments corresponding to a and b.
+template <typename Select> PCMSampleConverter Dispatch(bool a, bool b, Select select) noexcept {
+    if (a) {
+        return b ? select(std::true_type{}, std::true_type{}) : select(std::true_type{}, std::false_type{});
+    }
+    return b ? select(std::false_type{}, std::true_type{}) : select(std::false_type{}, std::false_type{});
+}
+
+/// Returns a converter between integer and float samples.
+/// @param intFormat The integer sample format.
+/// @param floatSwap True if the float samples are byte swapped.
+/// @param toFloat True if converting from integer to float.
+/// @param scalar True to use the portable implementation.
+PCMSampleConverter SelectConverter(SampleFormat intFormat, bool floatSwap, bool toFloat, bool scalar) noexcept {
+    const auto intSwap = intFormat.bigEndian_ != kNativeBigEndian;
+
+    switch (intFormat.encoding_) {
+    case Encoding::int24:
+        // Packed 24-bit samples do not map onto vector lanes and always use the portable implementation
+        return Dispatch(intFormat.bigEndian_, floatSwap, [toFloat](auto bigEndian, auto swap) -> PCMSampleConverter {
+            using I = Int24Sample<decltype(bigEndian)::value>;
+            using F = Float32Sample<decltype(swap)::value>;
+            return toFloat ? &IntToFloat<I, F> : &FloatToInt<F, I>;
+        });
+
+    case Encoding::int16:
+        return Dispatch(intSwap, floatSwap, [toFloat, scalar](auto swapInt, auto swapFloat) -> PCMSampleConverter {
+            constexpr bool i = decltype(swapInt)::value;
+            constexpr bool f = decltype(swapFloat)::value;
+#if defined(__x86_64__)
+            if (!scalar && HasAVX2()) {
+                return toFloat ? &Int16ToFloatAVX2<i, f> : &FloatToInt16AVX2<f, i>;
+            }
+            if (!scalar) {
+                return toFloat ? &Int16ToFloatSSE2<i, f> : &FloatToInt16SSE2<f, i>;
+            }
+#elif defined(__aarch64__)
+            if (!scalar) {
+                return toFloat ? &Int16ToFloatNEON<i, f> : &FloatToInt16NEON<f, i>;
+            }
+#endif
+            return toFloat ? &IntToFloat<Int16Sample<i>, Float32Sample<f>>
+                           : &FloatToInt<Float32Sample<f>, Int16Sample<i>>;
+        });
+
+    case Encoding::int32:
+        return Dispatch(intSwap, floatSwap, [toFloat, scalar](auto swapInt, auto swapFloat) -> PCMSampleConverter {
+            constexpr bool i = decltype(swapInt)::value;
+            constexpr bool f = decltype(swapFloat)::value;
+#if defined(__x86_64__)
+            if (!scalar && HasAVX2()) {
+                return toFloat ? &Int32ToFloatAVX2<i, f> : &FloatToInt32AVX2<f, i>;
+            }
+            if (!scalar) {
+                return toFloat ? &Int32ToFloatSSE2<i, f> : &FloatToInt32SSE2<f, i>;
+            }
+#elif defined(__aarch64__)
+            if (!scalar) {
+                return toFloat ? &Int32ToFloatNEON<i, f> : &FloatToInt32NEON<f, i>;
+            }
+#endif
+            return toFloat ? &IntToFloat<Int32Sample<i>, Float32Sample<f>>
+                           : &FloatToInt<Float32Sample<f>, Int32Sample<i>>;
+        });
+
+    default:
+        return nullptr;
+    }
+}
+
+PCMSampleConverter Select(const AudioStreamBasicDescription &source, const AudioStreamBasicDescription &destination,
+                          bool scalar) noexcept {
+    if (source.mSampleRate != destination.mSampleRate ||
+        source.mChannelsPerFrame != destination.mChannelsPerFrame ||
+        (source.mFormatFlags & kAudioFormatFlagIsNonInterleaved) !=
+                (destination.mFormatFlags & kAudioFormatFlagIsNonInterleaved)) {
+        return nullptr;
+    }
+
+    SampleFormat sourceFormat, destinationFormat;
+    if (!GetSampleFormat(source, sourceFormat) || !GetSampleFormat(destination, destinationFormat)) {
+        return nullptr;
+    }
+
+    const auto sourceIsFloat = sourceFormat.encoding_ == Encoding::float32;
+    const auto destinationIsFloat = destinationFormat.encoding_ == Encoding::float32;
+    if (sourceIsFloat == destinationIsFloat) {
+        return nullptr;
+    }
+
+    if (destinationIsFloat) {
+        return SelectConverter(sourceFormat, destinationFormat.bigEndian_ != kNativeBigEndian, true, scalar);
+    }
+    return SelectConverter(destinationFormat, sourceFormat.bigEndian_ != kNativeBigEndian, false, scalar);
+}
+
+} /* namespace */
+
+audio_toolbox::detail::PCMSampleConverter
+audio_toolbox::detail::SelectPCMSampleConverter(const AudioStreamBasicDescription &source,
+                                                const AudioStreamBasicDescription &destination) noexcept {
+    return Select(source, destination, false);
+}
+
+audio_toolbox::detail::PCMSampleConverter
+audio_toolbox::detail::SelectScalarPCMSampleConverter(const AudioStreamBasicDescription &source,
+                                                      const AudioStreamBasicDescription &destination) noexcept {
+    return Select(source, destination, true);
+}
+
+// MARK: - Static Kernels
+
+// The kernel for the target architecture is chosen at compile time, except that on x86-64 AVX2 is used if the processor
+// supports it
+
+template <UInt32 IntBits, bool SwapInt, bool SwapFloat>
+void audio_toolbox::detail::ConvertIntToFloat32(const void *input, void *output, std::size_t count) noexcept {
+    static_assert(IntBits == 16 || IntBits == 32);
+#if defined(__x86_64__)
+    if (HasAVX2()) {
+        if constexpr (IntBits == 16) {
+            Int16ToFloatAVX2<SwapInt, SwapFloat>(input, output, count);
+        } else {
+            Int32ToFloatAVX2<SwapInt, SwapFloat>(input, output, count);
+        }
+    } else if constexpr (IntBits == 16) {
+        Int16ToFloatSSE2<SwapInt, SwapFloat>(input, output, count);
+    } else {
+        Int32ToFloatSSE2<SwapInt, SwapFloat>(input, output, count);
+    }
+#elif defined(__aarch64__)
+    if constexpr (IntBits == 16) {
+        Int16ToFloatNEON<SwapInt, SwapFloat>(input, output, count);
+    } else {
+        Int32ToFloatNEON<SwapInt, SwapFloat>(input, output, count);
+    }
+#else
+    if constexpr (IntBits == 16) {
+        IntToFloat<Int16Sample<SwapInt>, Float32Sample<SwapFloat>>(input, output, count);
+    } else {
+        IntToFloat<Int32Sample<SwapInt>, Float32Sample<SwapFloat>>(input, output, count);
+    }
+#endif
+}
+
+template <UInt32 IntBits, bool SwapFloat, bool SwapInt>
+void audio_toolbox::detail::ConvertFloat32ToInt(const void *input, void *output, std::size_t count) noexcept {
+    static_assert(IntBits == 16 || IntBits == 32);
+#if defined(__x86_64__)
+    if (HasAVX2()) {
+        if constexpr (IntBits == 16) {
+            FloatToInt16AVX2<SwapFloat, SwapInt>(input, output, count);
+        } else {
+            FloatToInt32AVX2<SwapFloat, SwapInt>(input, output, count);
+        }
+    } else if constexpr (IntBits == 16) {
+        FloatToInt16SSE2<SwapFloat, SwapInt>(input, output, count);
+    } else {
+        FloatToInt32SSE2<SwapFloat, SwapInt>(input, output, count);
+    }
+#elif defined(__aarch64__)
+    if constexpr (IntBits == 16) {
+        FloatToInt16NEON<SwapFloat, SwapInt>(input, output, count);
+    } else {
+        FloatToInt32NEON<SwapFloat, SwapInt>(input, output, count);
+    }
+#else
+    if constexpr (IntBits == 16) {
+        FloatToInt<Float32Sample<SwapFloat>, Int16Sample<SwapInt>>(input, output, count);
+    } else {
+        FloatToInt<Float32Sample<SwapFloat>, Int32Sample<SwapInt>>(input, output, count);
+    }
+#endif
+}
+
+template void audio_toolbox::detail::ConvertIntToFloat32<16, false, false>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertIntToFloat32<16, false, true>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertIntToFloat32<16, true, false>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertIntToFloat32<16, true, true>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertIntToFloat32<32, false, false>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertIntToFloat32<32, false, true>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertIntToFloat32<32, true, false>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertIntToFloat32<32, true, true>(const void *, void *, std::size_t) noexcept;
+
+template void audio_toolbox::detail::ConvertFloat32ToInt<16, false, false>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertFloat32ToInt<16, false, true>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertFloat32ToInt<16, true, false>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertFloat32ToInt<16, true, true>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertFloat32ToInt<32, false, false>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertFloat32ToInt<32, false, true>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertFloat32ToInt<32, true, false>(const void *, void *, std::size_t) noexcept;
+template void audio_toolbox::detail::ConvertFloat32ToInt<32, true, true>(const void *, void *, std::size_t) noexcept;
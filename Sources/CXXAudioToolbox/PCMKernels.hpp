@@ -0,0 +1,42 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AudioConverter.h>
+
+#include <cstddef>
+
+namespace audio_toolbox {
+namespace detail {
+
+/// A function converting interleaved linear PCM samples between two formats.
+/// @param input The input samples.
+/// @param output The output samples.
+/// @param sampleCount The number of samples (frames times channels) to convert.
+using PCMSampleConverter = void (*)(const void *input, void *output, std::size_t sampleCount);
+
+/// Returns a built-in converter between two linear PCM formats or nullptr if none is available.
+///
+/// Converters are available between 32-bit float and 16-bit, packed 24-bit, or 32-bit signed integer samples of
+/// either byte order, with the same sample rate, channel count, and interleaving. Integer samples are scaled by
+/// 2^(bits - 1); float samples are clipped to the integer range and rounded to nearest, ties to even.
+///
+/// The fastest implementation supported by the processor is selected: AVX2 or SSE2 on x86-64, NEON on arm64, or
+/// portable C++.
+[[nodiscard]] PCMSampleConverter SelectPCMSampleConverter(const AudioStreamBasicDescription &source,
+                                                          const AudioStreamBasicDescription &destination) noexcept;
+
+/// Returns the portable C++ converter between two linear PCM formats or nullptr if none is available.
+///
+/// The result is bit-identical to the converter returned by SelectPCMSampleConverter.
+[[nodiscard]] PCMSampleConverter
+SelectScalarPCMSampleConverter(const AudioStreamBasicDescription &source,
+                               const AudioStreamBasicDescription &destination) noexcept;
+
+} /* namespace detail */
+} /* namespace audio_toolbox */
@@ -0,0 +1,899 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/PCMLayout.hpp"
+
+#include "AudioToolboxErrors.hpp"
+#include "LinearPCM.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/// A function interleaving channel buffers into one buffer.
+using InterleaveFunction = void (*)(const unsigned char *const *inputs, unsigned char *output, std::size_t channels,
+                                    std::size_t frames);
+
+/// A function deinterleaving one buffer into channel buffers.
+using DeinterleaveFunction = void (*)(const unsigned char *input, unsigned char *const *outputs, std::size_t channels,
+                                      std::size_t frames);
+
+/// The largest channel count for which channel buffer pointers are kept on the stack.
+constexpr UInt32 kMaximumStackChannels = 32;
+
+// MARK: - Portable Kernels
+
+/// Interleaves frames of Width-byte samples for a fixed number of channels.
+template <std::size_t Width, std::size_t Channels>
+void InterleaveFixed(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                     std::size_t frames) noexcept {
+    for (std::size_t f = 0; f < frames; ++f) {
+        for (std::size_t c = 0; c < Channels; ++c) {
+            std::memcpy(output + (f * Channels + c) * Width, inputs[c] + f * Width, Width);
+        }
+    }
+}
+
+/// Deinterleaves frames of Width-byte samples for a fixed number of channels.
+template <std::size_t Width, std::size_t Channels>
+void DeinterleaveFixed(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                       std::size_t frames) noexcept {
+    for (std::size_t f = 0; f < frames; ++f) {
+        for (std::size_t c = 0; c < Channels; ++c) {
+            std::memcpy(outputs[c] + f * Width, input + (f * Channels + c) * Width, Width);
+        }
+    }
+}
+
+/// Interleaves frames of Width-byte samples for any number of channels, one channel at a time.
+template <std::size_t Width>
+void InterleaveStrided(const unsigned char *const *inputs, unsigned char *output, std::size_t channels,
+                       std::size_t frames) noexcept {
+    const auto stride = channels * Width;
+    for (std::size_t c = 0; c < channels; ++c) {
+        const auto input = inputs[c];
+        auto out = output + c * Width;
+        for (std::size_t f = 0; f < frames; ++f, out += stride) {
+            std::memcpy(out, input + f * Width, Width);
+        }
+    }
+}
+
+/// Deinterleaves frames of Width-byte samples for any number of channels, one channel at a time.
+template <std::size_t Width>
+void DeinterleaveStrided(const unsigned char *input, unsigned char *const *outputs, std::size_t channels,
+                         std::size_t frames) noexcept {
+    const auto stride = channels * Width;
+    for (std::size_t c = 0; c < channels; ++c) {
+        const auto output = outputs[c];
+        auto in = input + c * Width;
+        for (std::size_t f = 0; f < frames; ++f, in += stride) {
+            std::memcpy(output + f * Width, in, Width);
+        }
+    }
+}
+
+/// Interleaves the frames from start to frames using InterleaveFixed.
+template <std::size_t Width, std::size_t Channels>
+void InterleaveRemaining(const unsigned char *const *inputs, unsigned char *output, std::size_t start,
+                         std::size_t frames) noexcept {
+    const unsigned char *remaining[Channels];
+    for (std::size_t c = 0; c < Channels; ++c) {
+        remaining[c] = inputs[c] + start * Width;
+    }
+    InterleaveFixed<Width, Channels>(remaining, output + start * Channels * Width, Channels, frames - start);
+}
+
+/// Deinterleaves the frames from start to frames using DeinterleaveFixed.
+template <std::size_t Width, std::size_t Channels>
+void DeinterleaveRemaining(const unsigned char *input, unsigned char *const *outputs, std::size_t start,
+                           std::size_t frames) noexcept {
+    unsigned char *remaining[Channels];
+    for (std::size_t c = 0; c < Channels; ++c) {
+        remaining[c] = outputs[c] + start * Width;
+    }
+    DeinterleaveFixed<Width, Channels>(input + start * Channels * Width, remaining, Channels, frames - start);
+}
+
+#if defined(__x86_64__)
+
+// MARK: - SSE2 Kernels
+
+__m128i Load(const unsigned char *p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+
+void Store(unsigned char *p, __m128i v) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+
+/// Transposes a 4x4 matrix of 32-bit elements.
+void Transpose4x32(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) noexcept {
+    const auto t0 = _mm_unpacklo_epi32(r0, r1);
+    const auto t1 = _mm_unpacklo_epi32(r2, r3);
+    const auto t2 = _mm_unpackhi_epi32(r0, r1);
+    const auto t3 = _mm_unpackhi_epi32(r2, r3);
+    r0 = _mm_unpacklo_epi64(t0, t1);
+    r1 = _mm_unpackhi_epi64(t0, t1);
+    r2 = _mm_unpacklo_epi64(t2, t3);
+    r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+/// Interleaves two channels of Width-byte samples, 16 bytes per channel at a time.
+template <std::size_t Width>
+void Interleave2SSE2(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                     std::size_t frames) noexcept {
+    constexpr std::size_t lanes = 16 / Width;
+    std::size_t f = 0;
+    for (; f + lanes <= frames; f += lanes) {
+        const auto a = Load(inputs[0] + f * Width);
+        const auto b = Load(inputs[1] + f * Width);
+        auto out = output + 2 * f * Width;
+        if constexpr (Width == 2) {
+            Store(out, _mm_unpacklo_epi16(a, b));
+            Store(out + 16, _mm_unpackhi_epi16(a, b));
+        } else if constexpr (Width == 4) {
+            Store(out, _mm_unpacklo_epi32(a, b));
+            Store(out + 16, _mm_unpackhi_epi32(a, b));
+        } else {
+            Store(out, _mm_unpacklo_epi64(a, b));
+            Store(out + 16, _mm_unpackhi_epi64(a, b));
+        }
+    }
+    InterleaveRemaining<Width, 2>(inputs, output, f, frames);
+}
+
+/// Deinterleaves two channels of Width-byte samples, 16 bytes per channel at a time.
+template <std::size_t Width>
+void Deinterleave2SSE2(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                       std::size_t frames) noexcept {
+    constexpr std::size_t lanes = 16 / Width;
+    std::size_t f = 0;
+    for (; f + lanes <= frames; f += lanes) {
+        const auto in = input + 2 * f * Width;
+        const auto v0 = Load(in);
+        const auto v1 = Load(in + 16);
+        if constexpr (Width == 2) {
+            // Sign extension keeps the saturating pack exact
+            const auto a0 = _mm_srai_epi32(_mm_slli_epi32(v0, 16), 16);
+            const auto a1 = _mm_srai_epi32(_mm_slli_epi32(v1, 16), 16);
+            Store(outputs[0] + f * Width, _mm_packs_epi32(a0, a1));
+            Store(outputs[1] + f * Width, _mm_packs_epi32(_mm_srai_epi32(v0, 16), _mm_srai_epi32(v1, 16)));
+        } else if constexpr (Width == 4) {
+            // Shuffles move the bits of each element unchanged
+            const auto p0 = _mm_castsi128_ps(v0);
+            const auto p1 = _mm_castsi128_ps(v1);
+            Store(outputs[0] + f * Width, _mm_castps_si128(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0))));
+            Store(outputs[1] + f * Width, _mm_castps_si128(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1))));
+        } else {
+            Store(outputs[0] + f * Width, _mm_unpacklo_epi64(v0, v1));
+            Store(outputs[1] + f * Width, _mm_unpackhi_epi64(v0, v1));
+        }
+    }
+    DeinterleaveRemaining<Width, 2>(input, outputs, f, frames);
+}
+
+/// Interleaves four channels of 16-bit samples, eight frames at a time.
+void Interleave4x16SSE2(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                        std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 8 <= frames; f += 8) {
+        const auto a = Load(inputs[0] + 2 * f);
+        const auto b = Load(inputs[1] + 2 * f);
+        const auto c = Load(inputs[2] + 2 * f);
+        const auto d = Load(inputs[3] + 2 * f);
+        const auto abLow = _mm_unpacklo_epi16(a, b);
+        const auto cdLow = _mm_unpacklo_epi16(c, d);
+        const auto abHigh = _mm_unpackhi_epi16(a, b);
+        const auto cdHigh = _mm_unpackhi_epi16(c, d);
+        auto out = output + 8 * f;
+        Store(out, _mm_unpacklo_epi32(abLow, cdLow));
+        Store(out + 16, _mm_unpackhi_epi32(abLow, cdLow));
+        Store(out + 32, _mm_unpacklo_epi32(abHigh, cdHigh));
+        Store(out + 48, _mm_unpackhi_epi32(abHigh, cdHigh));
+    }
+    InterleaveRemaining<2, 4>(inputs, output, f, frames);
+}
+
+/// Deinterleaves four channels of 16-bit samples, eight frames at a time.
+void Deinterleave4x16SSE2(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                          std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 8 <= frames; f += 8) {
+        const auto in = input + 8 * f;
+        const auto v0 = Load(in);
+        const auto v1 = Load(in + 16);
+        const auto v2 = Load(in + 32);
+        const auto v3 = Load(in + 48);
+        const auto t0 = _mm_unpacklo_epi16(v0, v1);
+        const auto t1 = _mm_unpackhi_epi16(v0, v1);
+        const auto t2 = _mm_unpacklo_epi16(v2, v3);
+        const auto t3 = _mm_unpackhi_epi16(v2, v3);
+        const auto u0 = _mm_unpacklo_epi16(t0, t1);
+        const auto u1 = _mm_unpackhi_epi16(t0, t1);
+        const auto u2 = _mm_unpacklo_epi16(t2, t3);
+        const auto u3 = _mm_unpackhi_epi16(t2, t3);
+        Store(outputs[0] + 2 * f, _mm_unpacklo_epi64(u0, u2));
+        Store(outputs[1] + 2 * f, _mm_unpackhi_epi64(u0, u2));
+        Store(outputs[2] + 2 * f, _mm_unpacklo_epi64(u1, u3));
+        Store(outputs[3] + 2 * f, _mm_unpackhi_epi64(u1, u3));
+    }
+    DeinterleaveRemaining<2, 4>(input, outputs, f, frames);
+}
+
+/// Interleaves four channels of 32-bit samples, four frames at a time.
+void Interleave4x32SSE2(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                        std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 4 <= frames; f += 4) {
+        auto r0 = Load(inputs[0] + 4 * f);
+        auto r1 = Load(inputs[1] + 4 * f);
+        auto r2 = Load(inputs[2] + 4 * f);
+        auto r3 = Load(inputs[3] + 4 * f);
+        Transpose4x32(r0, r1, r2, r3);
+        auto out = output + 16 * f;
+        Store(out, r0);
+        Store(out + 16, r1);
+        Store(out + 32, r2);
+        Store(out + 48, r3);
+    }
+    InterleaveRemaining<4, 4>(inputs, output, f, frames);
+}
+
+/// Deinterleaves four channels of 32-bit samples, four frames at a time.
+void Deinterleave4x32SSE2(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                          std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 4 <= frames; f += 4) {
+        const auto in = input + 16 * f;
+        auto r0 = Load(in);
+        auto r1 = Load(in + 16);
+        auto r2 = Load(in + 32);
+        auto r3 = Load(in + 48);
+        Transpose4x32(r0, r1, r2, r3);
+        Store(outputs[0] + 4 * f, r0);
+        Store(outputs[1] + 4 * f, r1);
+        Store(outputs[2] + 4 * f, r2);
+        Store(outputs[3] + 4 * f, r3);
+    }
+    DeinterleaveRemaining<4, 4>(input, outputs, f, frames);
+}
+
+/// Transposes an 8x8 matrix of 16-bit elements.
+void Transpose8x16(__m128i (&r)[8]) noexcept {
+    const auto a0 = _mm_unpacklo_epi16(r[0], r[1]);
+    const auto a1 = _mm_unpackhi_epi16(r[0], r[1]);
+    const auto a2 = _mm_unpacklo_epi16(r[2], r[3]);
+    const auto a3 = _mm_unpackhi_epi16(r[2], r[3]);
+    const auto a4 = _mm_unpacklo_epi16(r[4], r[5]);
+    const auto a5 = _mm_unpackhi_epi16(r[4], r[5]);
+    const auto a6 = _mm_unpacklo_epi16(r[6], r[7]);
+    const auto a7 = _mm_unpackhi_epi16(r[6], r[7]);
+    const auto b0 = _mm_unpacklo_epi32(a0, a2);
+    const auto b1 = _mm_unpackhi_epi32(a0, a2);
+    const auto b2 = _mm_unpacklo_epi32(a1, a3);
+    const auto b3 = _mm_unpackhi_epi32(a1, a3);
+    const auto b4 = _mm_unpacklo_epi32(a4, a6);
+    const auto b5 = _mm_unpackhi_epi32(a4, a6);
+    const auto b6 = _mm_unpacklo_epi32(a5, a7);
+    const auto b7 = _mm_unpackhi_epi32(a5, a7);
+    r[0] = _mm_unpacklo_epi64(b0, b4);
+    r[1] = _mm_unpackhi_epi64(b0, b4);
+    r[2] = _mm_unpacklo_epi64(b1, b5);
+    r[3] = _mm_unpackhi_epi64(b1, b5);
+    r[4] = _mm_unpacklo_epi64(b2, b6);
+    r[5] = _mm_unpackhi_epi64(b2, b6);
+    r[6] = _mm_unpacklo_epi64(b3, b7);
+    r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+/// Interleaves six channels of 16-bit samples, eight frames at a time.
+void Interleave6x16SSE2(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                        std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 8 <= frames; f += 8) {
+        // The matrix is padded with two empty channels that are not stored
+        __m128i r[8];
+        for (std::size_t c = 0; c < 6; ++c) {
+            r[c] = Load(inputs[c] + 2 * f);
+        }
+        r[6] = r[7] = _mm_setzero_si128();
+        Transpose8x16(r);
+        auto out = output + 12 * f;
+        for (std::size_t i = 0; i < 8; ++i, out += 12) {
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(out), r[i]);
+            const auto last = _mm_cvtsi128_si32(_mm_srli_si128(r[i], 8));
+            std::memcpy(out + 8, &last, sizeof last);
+        }
+    }
+    InterleaveRemaining<2, 6>(inputs, output, f, frames);
+}
+
+/// Deinterleaves six channels of 16-bit samples, eight frames at a time.
+void Deinterleave6x16SSE2(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                          std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 8 <= frames; f += 8) {
+        __m128i r[8];
+        auto in = input + 12 * f;
+        for (std::size_t i = 0; i < 8; ++i, in += 12) {
+            std::int32_t last;
+            std::memcpy(&last, in + 8, sizeof last);
+            r[i] = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in)), _mm_cvtsi32_si128(last));
+        }
+        Transpose8x16(r);
+        for (std::size_t c = 0; c < 6; ++c) {
+            Store(outputs[c] + 2 * f, r[c]);
+        }
+    }
+    DeinterleaveRemaining<2, 6>(input, outputs, f, frames);
+}
+
+/// Interleaves eight channels of 16-bit samples, eight frames at a time.
+void Interleave8x16SSE2(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                        std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 8 <= frames; f += 8) {
+        __m128i r[8];
+        for (std::size_t c = 0; c < 8; ++c) {
+            r[c] = Load(inputs[c] + 2 * f);
+        }
+        Transpose8x16(r);
+        for (std::size_t i = 0; i < 8; ++i) {
+            Store(output + 16 * (f + i), r[i]);
+        }
+    }
+    InterleaveRemaining<2, 8>(inputs, output, f, frames);
+}
+
+/// Deinterleaves eight channels of 16-bit samples, eight frames at a time.
+void Deinterleave8x16SSE2(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                          std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 8 <= frames; f += 8) {
+        __m128i r[8];
+        for (std::size_t i = 0; i < 8; ++i) {
+            r[i] = Load(input + 16 * (f + i));
+        }
+        Transpose8x16(r);
+        for (std::size_t c = 0; c < 8; ++c) {
+            Store(outputs[c] + 2 * f, r[c]);
+        }
+    }
+    DeinterleaveRemaining<2, 8>(input, outputs, f, frames);
+}
+
+/// Interleaves six channels of 32-bit samples, four frames at a time.
+void Interleave6x32SSE2(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                        std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 4 <= frames; f += 4) {
+        __m128i r[4];
+        for (std::size_t c = 0; c < 4; ++c) {
+            r[c] = Load(inputs[c] + 4 * f);
+        }
+        Transpose4x32(r[0], r[1], r[2], r[3]);
+        // The last two channels of each frame are stored as one 64-bit pair
+        const auto e = Load(inputs[4] + 4 * f);
+        const auto g = Load(inputs[5] + 4 * f);
+        const auto low = _mm_unpacklo_epi32(e, g);
+        const auto high = _mm_unpackhi_epi32(e, g);
+        const __m128i pairs[4] = {low, _mm_srli_si128(low, 8), high, _mm_srli_si128(high, 8)};
+        auto out = output + 24 * f;
+        for (std::size_t i = 0; i < 4; ++i, out += 24) {
+            Store(out, r[i]);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 16), pairs[i]);
+        }
+    }
+    InterleaveRemaining<4, 6>(inputs, output, f, frames);
+}
+
+/// Deinterleaves six channels of 32-bit samples, four frames at a time.
+void Deinterleave6x32SSE2(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                          std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 4 <= frames; f += 4) {
+        __m128i r[4];
+        __m128i pairs[4];
+        auto in = input + 24 * f;
+        for (std::size_t i = 0; i < 4; ++i, in += 24) {
+            r[i] = Load(in);
+            pairs[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + 16));
+        }
+        Transpose4x32(r[0], r[1], r[2], r[3]);
+        for (std::size_t c = 0; c < 4; ++c) {
+            Store(outputs[c] + 4 * f, r[c]);
+        }
+        const auto low = _mm_castsi128_ps(_mm_unpacklo_epi64(pairs[0], pairs[1]));
+        const auto high = _mm_castsi128_ps(_mm_unpacklo_epi64(pairs[2], pairs[3]));
+        Store(outputs[4] + 4 * f, _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0))));
+        Store(outputs[5] + 4 * f, _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1))));
+    }
+    DeinterleaveRemaining<4, 6>(input, outputs, f, frames);
+}
+
+/// Interleaves eight channels of 32-bit samples, four frames at a time.
+void Interleave8x32SSE2(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                        std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 4 <= frames; f += 4) {
+        __m128i r[8];
+        for (std::size_t c = 0; c < 8; ++c) {
+            r[c] = Load(inputs[c] + 4 * f);
+        }
+        Transpose4x32(r[0], r[1], r[2], r[3]);
+        Transpose4x32(r[4], r[5], r[6], r[7]);
+        auto out = output + 32 * f;
+        for (std::size_t i = 0; i < 4; ++i, out += 32) {
+            Store(out, r[i]);
+            Store(out + 16, r[4 + i]);
+        }
+    }
+    InterleaveRemaining<4, 8>(inputs, output, f, frames);
+}
+
+/// Deinterleaves eight channels of 32-bit samples, four frames at a time.
+void Deinterleave8x32SSE2(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                          std::size_t frames) noexcept {
+    std::size_t f = 0;
+    for (; f + 4 <= frames; f += 4) {
+        __m128i r[8];
+        auto in = input + 32 * f;
+        for (std::size_t i = 0; i < 4; ++i, in += 32) {
+            r[i] = Load(in);
+            r[4 + i] = Load(in + 16);
+        }
+        Transpose4x32(r[0], r[1], r[2], r[3]);
+        Transpose4x32(r[4], r[5], r[6], r[7]);
+        for (std::size_t c = 0; c < 8; ++c) {
+            Store(outputs[c] + 4 * f, r[c]);
+        }
+    }
+    DeinterleaveRemaining<4, 8>(input, outputs, f, frames);
+}
+
+#elif defined(__aarch64__)
+
+// MARK: - NEON Kernels
+
+/// NEON structure loads and stores for Channels channels of Element samples.
+template <typename Element, std::size_t Channels> struct NEONVectors;
+
+template <> struct NEONVectors<std::uint16_t, 2> {
+    using Type = uint16x8x2_t;
+    static Type Load(const std::uint16_t *p) noexcept { return vld2q_u16(p); }
+    static void Store(std::uint16_t *p, Type v) noexcept { vst2q_u16(p, v); }
+};
+
+template <> struct NEONVectors<std::uint16_t, 3> {
+    using Type = uint16x8x3_t;
+    static Type Load(const std::uint16_t *p) noexcept { return vld3q_u16(p); }
+    static void Store(std::uint16_t *p, Type v) noexcept { vst3q_u16(p, v); }
+};
+
+template <> struct NEONVectors<std::uint16_t, 4> {
+    using Type = uint16x8x4_t;
+    static Type Load(const std::uint16_t *p) noexcept { return vld4q_u16(p); }
+    static void Store(std::uint16_t *p, Type v) noexcept { vst4q_u16(p, v); }
+};
+
+template <> struct NEONVectors<std::uint32_t, 2> {
+    using Type = uint32x4x2_t;
+    static Type Load(const std::uint32_t *p) noexcept { return vld2q_u32(p); }
+    static void Store(std::uint32_t *p, Type v) noexcept { vst2q_u32(p, v); }
+};
+
+template <> struct NEONVectors<std::uint32_t, 3> {
+    using Type = uint32x4x3_t;
+    static Type Load(const std::uint32_t *p) noexcept { return vld3q_u32(p); }
+    static void Store(std::uint32_t *p, Type v) noexcept { vst3q_u32(p, v); }
+};
+
+template <> struct NEONVectors<std::uint32_t, 4> {
+    using Type = uint32x4x4_t;
+    static Type Load(const std::uint32_t *p) noexcept { return vld4q_u32(p); }
+    static void Store(std::uint32_t *p, Type v) noexcept { vst4q_u32(p, v); }
+};
+
+template <> struct NEONVectors<std::uint64_t, 3> {
+    using Type = uint64x2x3_t;
+    static Type Load(const std::uint64_t *p) noexcept { return vld3q_u64(p); }
+    static void Store(std::uint64_t *p, Type v) noexcept { vst3q_u64(p, v); }
+};
+
+template <> struct NEONVectors<std::uint64_t, 4> {
+    using Type = uint64x2x4_t;
+    static Type Load(const std::uint64_t *p) noexcept { return vld4q_u64(p); }
+    static void Store(std::uint64_t *p, Type v) noexcept { vst4q_u64(p, v); }
+};
+
+uint16x8_t LoadVector(const std::uint16_t *p) noexcept { return vld1q_u16(p); }
+uint32x4_t LoadVector(const std::uint32_t *p) noexcept { return vld1q_u32(p); }
+void StoreVector(std::uint16_t *p, uint16x8_t v) noexcept { vst1q_u16(p, v); }
+void StoreVector(std::uint32_t *p, uint32x4_t v) noexcept { vst1q_u32(p, v); }
+
+/// Interleaves the first or second halves of two channels into pairs of samples.
+uint32x4_t ZipLow(uint16x8_t a, uint16x8_t b) noexcept { return vreinterpretq_u32_u16(vzip1q_u16(a, b)); }
+uint32x4_t ZipHigh(uint16x8_t a, uint16x8_t b) noexcept { return vreinterpretq_u32_u16(vzip2q_u16(a, b)); }
+uint64x2_t ZipLow(uint32x4_t a, uint32x4_t b) noexcept { return vreinterpretq_u64_u32(vzip1q_u32(a, b)); }
+uint64x2_t ZipHigh(uint32x4_t a, uint32x4_t b) noexcept { return vreinterpretq_u64_u32(vzip2q_u32(a, b)); }
+
+/// Returns the first or second samples of the pairs in two vectors.
+uint16x8_t UnzipFirst(uint32x4_t a, uint32x4_t b) noexcept {
+    return vuzp1q_u16(vreinterpretq_u16_u32(a), vreinterpretq_u16_u32(b));
+}
+uint16x8_t UnzipSecond(uint32x4_t a, uint32x4_t b) noexcept {
+    return vuzp2q_u16(vreinterpretq_u16_u32(a), vreinterpretq_u16_u32(b));
+}
+uint32x4_t UnzipFirst(uint64x2_t a, uint64x2_t b) noexcept {
+    return vuzp1q_u32(vreinterpretq_u32_u64(a), vreinterpretq_u32_u64(b));
+}
+uint32x4_t UnzipSecond(uint64x2_t a, uint64x2_t b) noexcept {
+    return vuzp2q_u32(vreinterpretq_u32_u64(a), vreinterpretq_u32_u64(b));
+}
+
+/// Interleaves Channels channels of Element samples, 16 bytes per channel at a time.
+template <typename Element, std::size_t Channels>
+void InterleaveNEON(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                    std::size_t frames) noexcept {
+    constexpr std::size_t lanes = 16 / sizeof(Element);
+    std::size_t f = 0;
+    for (; f + lanes <= frames; f += lanes) {
+        typename NEONVectors<Element, Channels>::Type v;
+        for (std::size_t c = 0; c < Channels; ++c) {
+            v.val[c] = LoadVector(reinterpret_cast<const Element *>(inputs[c]) + f);
+        }
+        NEONVectors<Element, Channels>::Store(reinterpret_cast<Element *>(output) + f * Channels, v);
+    }
+    InterleaveRemaining<sizeof(Element), Channels>(inputs, output, f, frames);
+}
+
+/// Deinterleaves Channels channels of Element samples, 16 bytes per channel at a time.
+template <typename Element, std::size_t Channels>
+void DeinterleaveNEON(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                      std::size_t frames) noexcept {
+    constexpr std::size_t lanes = 16 / sizeof(Element);
+    std::size_t f = 0;
+    for (; f + lanes <= frames; f += lanes) {
+        const auto v = NEONVectors<Element, Channels>::Load(reinterpret_cast<const Element *>(input) + f * Channels);
+        for (std::size_t c = 0; c < Channels; ++c) {
+            StoreVector(reinterpret_cast<Element *>(outputs[c]) + f, v.val[c]);
+        }
+    }
+    DeinterleaveRemaining<sizeof(Element), Channels>(input, outputs, f, frames);
+}
+
+/// Interleaves Channels channels of Element samples as Channels / 2 channels of sample pairs, since structure loads
+/// and stores handle at most four channels.
+template <typename Element, std::size_t Channels>
+void InterleavePairsNEON(const unsigned char *const *inputs, unsigned char *output, std::size_t /*channels*/,
+                         std::size_t frames) noexcept {
+    using Pair = std::conditional_t<sizeof(Element) == 2, std::uint32_t, std::uint64_t>;
+    using Vectors = NEONVectors<Pair, Channels / 2>;
+    constexpr std::size_t lanes = 16 / sizeof(Element);
+    std::size_t f = 0;
+    for (; f + lanes <= frames; f += lanes) {
+        typename Vectors::Type low;
+        typename Vectors::Type high;
+        for (std::size_t c = 0; c < Channels / 2; ++c) {
+            const auto a = LoadVector(reinterpret_cast<const Element *>(inputs[2 * c]) + f);
+            const auto b = LoadVector(reinterpret_cast<const Element *>(inputs[2 * c + 1]) + f);
+            low.val[c] = ZipLow(a, b);
+            high.val[c] = ZipHigh(a, b);
+        }
+        const auto out = reinterpret_cast<Pair *>(output) + f * Channels / 2;
+        Vectors::Store(out, low);
+        Vectors::Store(out + lanes / 2 * Channels / 2, high);
+    }
+    InterleaveRemaining<sizeof(Element), Channels>(inputs, output, f, frames);
+}
+
+/// Deinterleaves Channels channels of Element samples as Channels / 2 channels of sample pairs, since structure loads
+/// and stores handle at most four channels.
+template <typename Element, std::size_t Channels>
+void DeinterleavePairsNEON(const unsigned char *input, unsigned char *const *outputs, std::size_t /*channels*/,
+                           std::size_t frames) noexcept {
+    using Pair = std::conditional_t<sizeof(Element) == 2, std::uint32_t, std::uint64_t>;
+    using Vectors = NEONVectors<Pair, Channels / 2>;
+    constexpr std::size_t lanes = 16 / sizeof(Element);
+    std::size_t f = 0;
+    for (; f + lanes <= frames; f += lanes) {
+        const auto in = reinterpret_cast<const Pair *>(input) + f * Channels / 2;
+        const auto low = Vectors::Load(in);
+        const auto high = Vectors::Load(in + lanes / 2 * Channels / 2);
+        for (std::size_t c = 0; c < Channels / 2; ++c) {
+            StoreVector(reinterpret_cast<Element *>(outputs[2 * c]) + f, UnzipFirst(low.val[c], high.val[c]));
+            StoreVector(reinterpret_cast<Element *>(outputs[2 * c + 1]) + f, UnzipSecond(low.val[c], high.val[c]));
+        }
+    }
+    DeinterleaveRemaining<sizeof(Element), Channels>(input, outputs, f, frames);
+}
+
+#endif
+
+// MARK: - Kernel Selection
+
+/// Returns the portable kernel pair for Width-byte samples and channels channels.
+template <std::size_t Width>
+void SelectPortable(std::size_t channels, InterleaveFunction &interleave, DeinterleaveFunction &deinterleave) noexcept {
+    switch (channels) {
+    case 2:
+        interleave = &InterleaveFixed<Width, 2>;
+        deinterleave = &DeinterleaveFixed<Width, 2>;
+        break;
+    case 3:
+        interleave = &InterleaveFixed<Width, 3>;
+        deinterleave = &DeinterleaveFixed<Width, 3>;
+        break;
+    case 4:
+        interleave = &InterleaveFixed<Width, 4>;
+        deinterleave = &DeinterleaveFixed<Width, 4>;
+        break;
+    case 5:
+        interleave = &InterleaveFixed<Width, 5>;
+        deinterleave = &DeinterleaveFixed<Width, 5>;
+        break;
+    case 6:
+        interleave = &InterleaveFixed<Width, 6>;
+        deinterleave = &DeinterleaveFixed<Width, 6>;
+        break;
+    case 7:
+        interleave = &InterleaveFixed<Width, 7>;
+        deinterleave = &DeinterleaveFixed<Width, 7>;
+        break;
+    case 8:
+        interleave = &InterleaveFixed<Width, 8>;
+        deinterleave = &DeinterleaveFixed<Width, 8>;
+        break;
+    default:
+        interleave = &InterleaveStrided<Width>;
+        deinterleave = &DeinterleaveStrided<Width>;
+        break;
+    }
+}
+
+/// Returns the fastest kernel pair for width-byte samples and channels channels, or false for unsupported widths.
+bool SelectKernels(std::size_t width, std::size_t channels, InterleaveFunction &interleave,
+                   DeinterleaveFunction &deinterleave) noexcept {
+    switch (width) {
+    case 1:
+        SelectPortable<1>(channels, interleave, deinterleave);
+        return true;
+    case 2:
+        SelectPortable<2>(channels, interleave, deinterleave);
+#if defined(__x86_64__)
+        if (channels == 2) {
+            interleave = &Interleave2SSE2<2>;
+            deinterleave = &Deinterleave2SSE2<2>;
+        } else if (channels == 4) {
+            interleave = &Interleave4x16SSE2;
+            deinterleave = &Deinterleave4x16SSE2;
+        } else if (channels == 6) {
+            interleave = &Interleave6x16SSE2;
+            deinterleave = &Deinterleave6x16SSE2;
+        } else if (channels == 8) {
+            interleave = &Interleave8x16SSE2;
+            deinterleave = &Deinterleave8x16SSE2;
+        }
+#elif defined(__aarch64__)
+        if (channels == 2) {
+            interleave = &InterleaveNEON<std::uint16_t, 2>;
+            deinterleave = &DeinterleaveNEON<std::uint16_t, 2>;
+        } else if (channels == 3) {
+            interleave = &InterleaveNEON<std::uint16_t, 3>;
+            deinterleave = &DeinterleaveNEON<std::uint16_t, 3>;
+        } else if (channels == 4) {
+            interleave = &InterleaveNEON<std::uint16_t, 4>;
+            deinterleave = &DeinterleaveNEON<std::uint16_t, 4>;
+        } else if (channels == 6) {
+            interleave = &InterleavePairsNEON<std::uint16_t, 6>;
+            deinterleave = &DeinterleavePairsNEON<std::uint16_t, 6>;
+        } else if (channels == 8) {
+            interleave = &InterleavePairsNEON<std::uint16_t, 8>;
+            deinterleave = &DeinterleavePairsNEON<std::uint16_t, 8>;
+        }
+#endif
+        return true;
+    case 3:
+        SelectPortable<3>(channels, interleave, deinterleave);
+        return true;
+    case 4:
+        SelectPortable<4>(channels, interleave, deinterleave);
+#if defined(__x86_64__)
+        if (channels == 2) {
+            interleave = &Interleave2SSE2<4>;
+            deinterleave = &Deinterleave2SSE2<4>;
+        } else if (channels == 4) {
+            interleave = &Interleave4x32SSE2;
+            deinterleave = &Deinterleave4x32SSE2;
+        } else if (channels == 6) {
+            interleave = &Interleave6x32SSE2;
+            deinterleave = &Deinterleave6x32SSE2;
+        } else if (channels == 8) {
+            interleave = &Interleave8x32SSE2;
+            deinterleave = &Deinterleave8x32SSE2;
+        }
+#elif defined(__aarch64__)
+        if (channels == 2) {
+            interleave = &InterleaveNEON<std::uint32_t, 2>;
+            deinterleave = &DeinterleaveNEON<std::uint32_t, 2>;
+        } else if (channels == 3) {
+            interleave = &InterleaveNEON<std::uint32_t, 3>;
+            deinterleave = &DeinterleaveNEON<std::uint32_t, 3>;
+        } else if (channels == 4) {
+            interleave = &InterleaveNEON<std::uint32_t, 4>;
+            deinterleave = &DeinterleaveNEON<std::uint32_t, 4>;
+        } else if (channels == 6) {
+            interleave = &InterleavePairsNEON<std::uint32_t, 6>;
+            deinterleave = &DeinterleavePairsNEON<std::uint32_t, 6>;
+        } else if (channels == 8) {
+            interleave = &InterleavePairsNEON<std::uint32_t, 8>;
+            deinterleave = &DeinterleavePairsNEON<std::uint32_t, 8>;
+        }
+#endif
+        return true;
+    case 8:
+        SelectPortable<8>(channels, interleave, deinterleave);
+#if defined(__x86_64__)
+        if (channels == 2) {
+            interleave = &Interleave2SSE2<8>;
+            deinterleave = &Deinterleave2SSE2<8>;
+        }
+#endif
+        return true;
+    default:
+        return false;
+    }
+}
+
+} /* namespace */
+
+bool audio_toolbox::pcm_layout::IsLayoutConversion(const AudioStreamBasicDescription &inSourceFormat,
+                                                   const AudioStreamBasicDescription &inDestinationFormat) noexcept {
+    const auto &src = inSourceFormat;
+    const auto &dst = inDestinationFormat;
+    if (src.mFormatID != kAudioFormatLinearPCM || dst.mFormatID != kAudioFormatLinearPCM) {
+        return false;
+    }
+    if (src.mSampleRate != dst.mSampleRate || src.mChannelsPerFrame == 0 ||
+        src.mChannelsPerFrame != dst.mChannelsPerFrame || src.mBitsPerChannel != dst.mBitsPerChannel ||
+        src.mFramesPerPacket != 1 || dst.mFramesPerPacket != 1 || src.mBytesPerPacket != src.mBytesPerFrame ||
+        dst.mBytesPerPacket != dst.mBytesPerFrame) {
+        return false;
+    }
+    if ((src.mFormatFlags ^ dst.mFormatFlags) != kAudioFormatFlagIsNonInterleaved) {
+        return false;
+    }
+
+    for (const auto &format : {src, dst}) {
+        if (!(format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) &&
+            format.mBytesPerFrame % format.mChannelsPerFrame) {
+            return false;
+        }
+    }
+
+    const auto bytesPerSample = detail::BytesPerSample(src);
+    return bytesPerSample > 0 && bytesPerSample == detail::BytesPerSample(dst);
+}
+
+void audio_toolbox::pcm_layout::Convert(const AudioStreamBasicDescription &inSourceFormat,
+                                        const AudioStreamBasicDescription &inDestinationFormat,
+                                        UInt32 inNumberPCMFrames, const AudioBufferList *inInputData,
+                                        AudioBufferList *outOutputData) {
+    if (!IsLayoutConversion(inSourceFormat, inDestinationFormat)) {
+        ThrowIfAudioConverterError(kAudioConverterErr_FormatNotSupported, "pcm_layout::Convert");
+    }
+
+    const auto channels = inSourceFormat.mChannelsPerFrame;
+    const auto bytesPerSample = detail::BytesPerSample(inSourceFormat);
+    const auto sourceIsInterleaved = !(inSourceFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved);
+    const auto destinationIsInterleaved = !(inDestinationFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved);
+
+    const auto interleavedSize = static_cast<UInt64>(inNumberPCMFrames) * bytesPerSample * channels;
+    if (interleavedSize > std::numeric_limits<UInt32>::max()) {
+        ThrowIfAudioConverterError(kAudio_ParamError, "pcm_layout::Convert");
+    }
+    const auto channelSize = static_cast<UInt32>(interleavedSize / channels);
+
+    detail::ValidateBufferList(inInputData, sourceIsInterleaved ? 1 : channels,
+                               sourceIsInterleaved ? interleavedSize : channelSize, "pcm_layout::Convert");
+    detail::ValidateBufferList(outOutputData, destinationIsInterleaved ? 1 : channels,
+                               destinationIsInterleaved ? interleavedSize : channelSize, "pcm_layout::Convert");
+
+    // Channel buffer pointers for typical channel counts are kept on the stack
+    void *stackPointers[kMaximumStackChannels];
+    std::vector<void *> heapPointers;
+    auto pointers = stackPointers;
+    if (channels > kMaximumStackChannels) {
+        heapPointers.resize(channels);
+        pointers = heapPointers.data();
+    }
+
+    if (sourceIsInterleaved) {
+        for (UInt32 i = 0; i < channels; ++i) {
+            pointers[i] = outOutputData->mBuffers[i].mData;
+            outOutputData->mBuffers[i].mDataByteSize = channelSize;
+        }
+        Deinterleave(bytesPerSample, channels, inNumberPCMFrames, inInputData->mBuffers[0].mData, pointers);
+    } else {
+        for (UInt32 i = 0; i < channels; ++i) {
+            pointers[i] = inInputData->mBuffers[i].mData;
+        }
+        Interleave(bytesPerSample, channels, inNumberPCMFrames, pointers, outOutputData->mBuffers[0].mData);
+        outOutputData->mBuffers[0].mDataByteSize = static_cast<UInt32>(interleavedSize);
+    }
+}
+
+void audio_toolbox::pcm_layout::Interleave(UInt32 inBytesPerSample, UInt32 inNumberChannels, UInt32 inNumberPCMFrames,
+                                           const void *const *inInputData, void *outOutputData) noexcept {
+    if (inNumberChannels == 0 || inNumberPCMFrames == 0) {
+        return;
+    }
+
+    const auto output = static_cast<unsigned char *>(outOutputData);
+    const auto inputs = reinterpret_cast<const unsigned char *const *>(inInputData);
+
+    if (inNumberChannels == 1) {
+        std::memcpy(output, inputs[0], static_cast<std::size_t>(inNumberPCMFrames) * inBytesPerSample);
+        return;
+    }
+
+    InterleaveFunction interleave;
+    DeinterleaveFunction deinterleave;
+    if (SelectKernels(inBytesPerSample, inNumberChannels, interleave, deinterleave)) {
+        interleave(inputs, output, inNumberChannels, inNumberPCMFrames);
+        return;
+    }
+
+    // Samples of unusual sizes are copied individually
+    const auto stride = static_cast<std::size_t>(inNumberChannels) * inBytesPerSample;
+    for (UInt32 c = 0; c < inNumberChannels; ++c) {
+        for (UInt32 f = 0; f < inNumberPCMFrames; ++f) {
+            std::memcpy(output + f * stride + c * inBytesPerSample,
+                        inputs[c] + static_cast<std::size_t>(f) * inBytesPerSample, inBytesPerSample);
+        }
+    }
+}
+
+void audio_toolbox::pcm_layout::Deinterleave(UInt32 inBytesPerSample, UInt32 inNumberChannels,
+                                             UInt32 inNumberPCMFrames, const void *inInputData,
+                                             void *const *outOutputData) noexcept {
+    if (inNumberChannels == 0 || inNumberPCMFrames == 0) {
+        return;
+    }
+
+    const auto input = static_cast<const unsigned char *>(inInputData);
+    const auto outputs = reinterpret_cast<unsigned char *const *>(outOutputData);
+
+    if (inNumberChannels == 1) {
+        std::memcpy(outputs[0], input, static_cast<std::size_t>(inNumberPCMFrames) * inBytesPerSample);
+        return;
+    }
+
+    InterleaveFunction interleave;
+    DeinterleaveFunction deinterleave;
+    if (SelectKernels(inBytesPerSample, inNumberChannels, interleave, deinterleave)) {
+        deinterleave(input, outputs, inNumberChannels, inNumberPCMFrames);
+        return;
+    }
+
+    // Samples of unusual sizes are copied individually
+    const auto stride = static_cast<std::size_t>(inNumberChannels) * inBytesPerSample;
+    for (UInt32 c = 0; c < inNumberChannels; ++c) {
+        for (UInt32 f = 0; f < inNumberPCMFrames; ++f) {
+            std::memcpy(outputs[c] + static_cast<std::size_t>(f) * inBytesPerSample,
+                        input + f * stride + c * inBytesPerSample, inBytesPerSample);
+        }
+    }
+}
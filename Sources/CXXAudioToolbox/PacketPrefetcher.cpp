@@ -0,0 +1,159 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/PacketPrefetcher.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+audio_toolbox::PacketPrefetcher::PacketPrefetcher(CAAudioFile &&audioFile, UInt32 packetsPerChunk,
+                                                  UInt32 chunksInFlight)
+    : audioFile_{std::move(audioFile)}, packetsPerChunk_{packetsPerChunk}, chunksInFlight_{chunksInFlight} {
+    if (packetsPerChunk_ == 0 || chunksInFlight_ == 0) {
+        throw std::invalid_argument("packetsPerChunk and chunksInFlight must be greater than 0");
+    }
+
+    dataFormat_ = audioFile_.DataFormat();
+
+    UInt32 packetSizeUpperBound;
+    UInt32 size = sizeof packetSizeUpperBound;
+    audioFile_.GetProperty(kAudioFilePropertyPacketSizeUpperBound, size, &packetSizeUpperBound);
+
+    if (packetSizeUpperBound > UINT32_MAX / packetsPerChunk_) {
+        throw std::invalid_argument("packetsPerChunk is too large");
+    }
+    chunkByteCapacity_ = packetSizeUpperBound * packetsPerChunk_;
+}
+
+audio_toolbox::PacketPrefetcher::~PacketPrefetcher() noexcept { Stop(); }
+
+void audio_toolbox::PacketPrefetcher::Start(SInt64 inStartingPacket) {
+    Stop();
+
+    const auto hasPacketDescriptions = dataFormat_.mBytesPerPacket == 0 || dataFormat_.mFramesPerPacket == 0;
+
+    {
+        std::lock_guard lock{mutex_};
+
+        while (!ready_.empty()) {
+            free_.push_back(std::move(ready_.front()));
+            ready_.pop_front();
+        }
+        // The consumer's chunk circulates through the free list as well
+        free_.reserve(chunksInFlight_ + 1);
+        while (free_.size() < chunksInFlight_) {
+            free_.emplace_back();
+        }
+        for (auto &chunk : free_) {
+            chunk.data_.resize(chunkByteCapacity_);
+            chunk.packetDescriptions_.resize(hasPacketDescriptions ? packetsPerChunk_ : 0);
+        }
+
+        error_ = nullptr;
+        finished_ = false;
+    }
+
+    readerThread_ = std::thread(&PacketPrefetcher::ReaderThreadEntry, this, inStartingPacket);
+}
+
+void audio_toolbox::PacketPrefetcher::Stop() noexcept {
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = true;
+    }
+    freeCondition_.notify_all();
+
+    if (readerThread_.joinable()) {
+        readerThread_.join();
+    }
+
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = false;
+        finished_ = true;
+    }
+    readyCondition_.notify_all();
+}
+
+bool audio_toolbox::PacketPrefetcher::ReadNext(Chunk &chunk) {
+    std::unique_lock lock{mutex_};
+    readyCondition_.wait(lock, [this] { return !ready_.empty() || finished_; });
+
+    if (ready_.empty()) {
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+        return false;
+    }
+
+    std::swap(chunk, ready_.front());
+    free_.push_back(std::move(ready_.front()));
+    ready_.pop_front();
+
+    lock.unlock();
+    freeCondition_.notify_one();
+
+    return true;
+}
+
+void audio_toolbox::PacketPrefetcher::ReaderThreadEntry(SInt64 inStartingPacket) noexcept {
+    const auto hasPacketDescriptions = dataFormat_.mBytesPerPacket == 0 || dataFormat_.mFramesPerPacket == 0;
+    auto packet = inStartingPacket;
+
+    for (;;) {
+        Chunk chunk;
+
+        {
+            std::unique_lock lock{mutex_};
+            freeCondition_.wait(lock, [this] { return stopRequested_ || !free_.empty(); });
+            if (stopRequested_) {
+                break;
+            }
+            chunk = std::move(free_.back());
+            free_.pop_back();
+        }
+
+        // Chunks handed to the consumer may have been replaced with unsized buffers
+        try {
+            chunk.data_.resize(chunkByteCapacity_);
+            chunk.packetDescriptions_.resize(hasPacketDescriptions ? packetsPerChunk_ : 0);
+
+            chunk.byteCount_ = chunkByteCapacity_;
+            chunk.packetCount_ = packetsPerChunk_;
+            audioFile_.ReadPacketData(false, chunk.byteCount_,
+                                      hasPacketDescriptions ? chunk.packetDescriptions_.data() : nullptr, packet,
+                                      chunk.packetCount_, chunk.data_.data());
+        } catch (...) {
+            std::lock_guard lock{mutex_};
+            free_.push_back(std::move(chunk));
+            error_ = std::current_exception();
+            break;
+        }
+
+        if (chunk.packetCount_ == 0) {
+            std::lock_guard lock{mutex_};
+            free_.push_back(std::move(chunk));
+            break;
+        }
+
+        chunk.startingPacket_ = packet;
+        packet += chunk.packetCount_;
+
+        {
+            std::lock_guard lock{mutex_};
+            ready_.push_back(std::move(chunk));
+        }
+        readyCondition_.notify_one();
+    }
+
+    {
+        std::lock_guard lock{mutex_};
+        finished_ = true;
+    }
+    readyCondition_.notify_all();
+}
@@ -0,0 +1,312 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/PacketTableIndex.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/// The magic number identifying a packet table index sidecar.
+constexpr UInt32 kSidecarMagic = 0x43585054; // 'CXPT'
+/// The current sidecar version.
+constexpr UInt32 kSidecarVersion = 2;
+/// The byte-order marker, read back byte-swapped when a sidecar was written on a host of the other byte order.
+constexpr UInt32 kSidecarByteOrderMark = 0x01020304;
+/// The number of bytes hashed at each end of an audio file.
+constexpr std::size_t kHashedRegionSize = 64 * 1024;
+
+/// The sidecar file header, followed by the packet byte offsets and optionally the packet frame positions.
+struct SidecarHeader {
+    UInt32 magic_;
+    UInt32 version_;
+    UInt64 fileSize_;
+    SInt64 fileModificationTime_;
+    UInt64 fileContentHash_;
+    UInt64 packetCount_;
+    UInt32 framesPerPacket_;
+    UInt32 byteOrderMark_;
+};
+
+static_assert(sizeof(SidecarHeader) % sizeof(UInt64) == 0, "Sidecar header must preserve UInt64 alignment");
+
+/// Closes a file descriptor when it goes out of scope.
+struct fd_closer {
+    int fd_;
+    ~fd_closer() noexcept { ::close(fd_); }
+};
+
+/// Closes a FILE when it goes out of scope.
+struct file_closer {
+    void operator()(std::FILE *_Nonnull file) const noexcept { std::fclose(file); }
+};
+
+/// Hashes bytes using 64-bit FNV-1a.
+UInt64 fnv1a(UInt64 hash, const unsigned char *data, std::size_t size) noexcept {
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+/// Reads up to count bytes at offset, returning the number of bytes read.
+std::size_t pread_fully(int fd, unsigned char *buffer, std::size_t count, off_t offset) {
+    std::size_t total = 0;
+    while (total < count) {
+        const auto n = ::pread(fd, buffer + total, count - total, offset + static_cast<off_t>(total));
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "pread");
+        }
+        if (n == 0) {
+            break;
+        }
+        total += static_cast<std::size_t>(n);
+    }
+    return total;
+}
+
+} /* namespace */
+
+audio_toolbox::PacketTableIndex::FileIdentity audio_toolbox::PacketTableIndex::FileIdentity::ForFile(const char *path) {
+    const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), "open");
+    }
+    fd_closer closer{fd};
+
+    struct stat s;
+    if (::fstat(fd, &s) == -1) {
+        throw std::system_error(errno, std::generic_category(), "fstat");
+    }
+
+    FileIdentity identity;
+    identity.size_ = static_cast<UInt64>(s.st_size);
+#if defined(__APPLE__)
+    identity.modificationTime_ = static_cast<SInt64>(s.st_mtimespec.tv_sec) * 1'000'000'000 + s.st_mtimespec.tv_nsec;
+#else
+    identity.modificationTime_ = static_cast<SInt64>(s.st_mtim.tv_sec) * 1'000'000'000 + s.st_mtim.tv_nsec;
+#endif /* defined(__APPLE__) */
+
+    auto buffer = std::make_unique<unsigned char[]>(kHashedRegionSize);
+    auto hash = UInt64{0xcbf29ce484222325};
+
+    auto count = pread_fully(fd, buffer.get(), kHashedRegionSize, 0);
+    hash = fnv1a(hash, buffer.get(), count);
+
+    if (identity.size_ > kHashedRegionSize) {
+        const auto offset = std::max(identity.size_ - kHashedRegionSize, UInt64{kHashedRegionSize});
+        count = pread_fully(fd, buffer.get(), kHashedRegionSize, static_cast<off_t>(offset));
+        hash = fnv1a(hash, buffer.get(), count);
+    }
+
+    identity.contentHash_ = hash;
+    return identity;
+}
+
+void audio_toolbox::PacketTableIndex::Build(CAAudioFile &audioFile, const FileIdentity &identity) {
+    Clear();
+
+    const auto format = audioFile.DataFormat();
+    const auto packetCount = audioFile.AudioDataPacketCount();
+    const auto framesPerPacket = format.mFramesPerPacket;
+
+    std::vector<UInt64> storage((packetCount + 1) * (framesPerPacket != 0 ? 1 : 2));
+    auto byteOffsets = storage.data();
+    auto framePositions = framesPerPacket != 0 ? nullptr : storage.data() + packetCount + 1;
+
+    for (UInt64 packet = 0; packet < packetCount; ++packet) {
+        AudioBytePacketTranslation byteTranslation{};
+        byteTranslation.mPacket = static_cast<SInt64>(packet);
+        UInt32 size = sizeof byteTranslation;
+        audioFile.GetProperty(kAudioFilePropertyPacketToByte, size, &byteTranslation);
+        byteOffsets[packet] = static_cast<UInt64>(byteTranslation.mByte);
+
+        if (framePositions) {
+            AudioFramePacketTranslation frameTranslation{};
+            frameTranslation.mPacket = static_cast<SInt64>(packet);
+            size = sizeof frameTranslation;
+            audioFile.GetProperty(kAudioFilePropertyPacketToFrame, size, &frameTranslation);
+            framePositions[packet] = static_cast<UInt64>(frameTranslation.mFrame);
+        }
+    }
+
+    byteOffsets[packetCount] = audioFile.AudioDataByteCount();
+
+    // The frame count of the final packet is only available from its packet description
+    if (framePositions) {
+        framePositions[packetCount] = 0;
+        if (packetCount > 0) {
+            UInt32 maximumPacketSize;
+            UInt32 size = sizeof maximumPacketSize;
+            audioFile.GetProperty(kAudioFilePropertyMaximumPacketSize, size, &maximumPacketSize);
+
+            std::vector<unsigned char> packet(maximumPacketSize);
+            AudioStreamPacketDescription packetDescription{};
+            UInt32 byteCount = maximumPacketSize;
+            UInt32 numPackets = 1;
+            audioFile.ReadPacketData(false, byteCount, &packetDescription, static_cast<SInt64>(packetCount - 1),
+                                     numPackets, packet.data());
+            framePositions[packetCount] = framePositions[packetCount - 1] + packetDescription.mVariableFramesInPacket;
+        }
+    }
+
+    identity_ = identity;
+    packetCount_ = packetCount;
+    framesPerPacket_ = framesPerPacket;
+    byteOffsets_ = byteOffsets;
+    framePositions_ = framePositions;
+    storage_ = std::move(storage);
+}
+
+void audio_toolbox::PacketTableIndex::Save(const char *path) const {
+    // Write to a temporary file and rename it so readers never observe a partial index
+    const auto temporaryPath = std::string{path} + ".tmp";
+    std::unique_ptr<std::FILE, file_closer> file{std::fopen(temporaryPath.c_str(), "wb")};
+    if (!file) {
+        throw std::system_error(errno, std::generic_category(), "fopen");
+    }
+
+    SidecarHeader header{};
+    header.magic_ = kSidecarMagic;
+    header.version_ = kSidecarVersion;
+    header.fileSize_ = identity_.size_;
+    header.fileModificationTime_ = identity_.modificationTime_;
+    header.fileContentHash_ = identity_.contentHash_;
+    header.packetCount_ = packetCount_;
+    header.framesPerPacket_ = framesPerPacket_;
+    header.byteOrderMark_ = kSidecarByteOrderMark;
+
+    const auto entryCount = static_cast<std::size_t>(packetCount_ + 1);
+    auto ok = std::fwrite(&header, sizeof header, 1, file.get()) == 1;
+    if (ok && byteOffsets_) {
+        ok = std::fwrite(byteOffsets_, sizeof(UInt64), entryCount, file.get()) == entryCount;
+    }
+    if (ok && framePositions_) {
+        ok = std::fwrite(framePositions_, sizeof(UInt64), entryCount, file.get()) == entryCount;
+    }
+    if (!ok || std::fclose(file.release()) != 0) {
+        const auto error = errno;
+        std::remove(temporaryPath.c_str());
+        throw std::system_error(error, std::generic_category(), "fwrite");
+    }
+
+    if (std::rename(temporaryPath.c_str(), path) != 0) {
+        const auto error = errno;
+        std::remove(temporaryPath.c_str());
+        throw std::system_error(error, std::generic_category(), "rename");
+    }
+}
+
+bool audio_toolbox::PacketTableIndex::Load(const char *path, const FileIdentity &identity) {
+    Clear();
+
+    MemoryMappedFile mapping;
+    try {
+        mapping.Map(path);
+    } catch (const std::system_error &e) {
+        if (e.code() == std::errc::no_such_file_or_directory) {
+            return false;
+        }
+        throw;
+    }
+
+    const auto size = static_cast<UInt64>(mapping.Size());
+    if (size < sizeof(SidecarHeader)) {
+        return false;
+    }
+
+    const auto header = static_cast<const SidecarHeader *>(mapping.Data());
+    // The sidecar is stored in native byte order and is not portable between hosts of different byte order
+    if (header->magic_ != kSidecarMagic || header->version_ != kSidecarVersion ||
+        header->byteOrderMark_ != kSidecarByteOrderMark) {
+        return false;
+    }
+
+    FileIdentity sidecarIdentity;
+    sidecarIdentity.size_ = header->fileSize_;
+    sidecarIdentity.modificationTime_ = header->fileModificationTime_;
+    sidecarIdentity.contentHash_ = header->fileContentHash_;
+    if (sidecarIdentity != identity) {
+        return false;
+    }
+
+    const auto arrayCount = UInt64{header->framesPerPacket_ != 0 ? 1U : 2U};
+    const auto entryCount = header->packetCount_ + 1;
+    if (header->packetCount_ > (size - sizeof(SidecarHeader)) / sizeof(UInt64) ||
+        size != sizeof(SidecarHeader) + arrayCount * entryCount * sizeof(UInt64)) {
+        return false;
+    }
+
+    const auto entries = reinterpret_cast<const UInt64 *>(header + 1);
+
+    identity_ = identity;
+    packetCount_ = header->packetCount_;
+    framesPerPacket_ = header->framesPerPacket_;
+    byteOffsets_ = entries;
+    framePositions_ = header->framesPerPacket_ != 0 ? nullptr : entries + entryCount;
+    mapping_ = std::move(mapping);
+
+    return true;
+}
+
+void audio_toolbox::PacketTableIndex::Clear() noexcept {
+    identity_ = {};
+    packetCount_ = 0;
+    framesPerPacket_ = 0;
+    byteOffsets_ = nullptr;
+    framePositions_ = nullptr;
+    storage_.clear();
+    mapping_.Unmap();
+}
+
+UInt64 audio_toolbox::PacketTableIndex::PacketForFrame(UInt64 inFrame) const noexcept {
+    if (inFrame >= FrameCount()) {
+        return packetCount_;
+    }
+    if (framesPerPacket_ != 0) {
+        return inFrame / framesPerPacket_;
+    }
+    // The last packet whose first frame is <= inFrame
+    const auto end = framePositions_ + packetCount_ + 1;
+    const auto it = std::upper_bound(framePositions_, end, inFrame);
+    return static_cast<UInt64>(it - framePositions_) - 1;
+}
+
+UInt64 audio_toolbox::PacketTableIndex::GetPacketDescriptions(
+        UInt64 inStartingPacket, UInt32 &ioNumPackets,
+        AudioStreamPacketDescription *outPacketDescriptions) const noexcept {
+    if (inStartingPacket >= packetCount_) {
+        ioNumPackets = 0;
+        return 0;
+    }
+
+    ioNumPackets = static_cast<UInt32>(std::min<UInt64>(ioNumPackets, packetCount_ - inStartingPacket));
+
+    const auto firstOffset = byteOffsets_[inStartingPacket];
+    for (UInt32 i = 0; i < ioNumPackets; ++i) {
+        const auto packet = inStartingPacket + i;
+        outPacketDescriptions[i].mStartOffset = static_cast<SInt64>(byteOffsets_[packet] - firstOffset);
+        outPacketDescriptions[i].mDataByteSize = static_cast<UInt32>(byteOffsets_[packet + 1] - byteOffsets_[packet]);
+        outPacketDescriptions[i].mVariableFramesInPacket =
+                framePositions_ ? static_cast<UInt32>(framePositions_[packet + 1] - framePositions_[packet]) : 0;
+    }
+
+    return byteOffsets_[inStartingPacket + ioNumPackets] - firstOffset;
+}
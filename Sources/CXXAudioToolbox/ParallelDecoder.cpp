@@ -0,0 +1,198 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/ParallelDecoder.hpp"
+#include "audio_toolbox/CAExtAudioFile.hpp"
+
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+/// The maximum number of frames requested from a single read.
+constexpr SInt64 kMaximumReadFrames = 65536;
+
+/// Per-worker decoding state.
+struct Worker {
+    /// The worker's view of the file.
+    audio_toolbox::CAExtAudioFile file_;
+    /// Storage for the buffer list passed to CAExtAudioFile::Read.
+    std::vector<unsigned char> bufferList_;
+    /// Storage for discarded pre-roll frames.
+    std::vector<unsigned char> discard_;
+};
+
+/// Returns bufferList_ in worker configured for bufferCount buffers of channelsPerBuffer channels.
+AudioBufferList *PrepareBufferList(Worker &worker, UInt32 bufferCount, UInt32 channelsPerBuffer) {
+    if (worker.bufferList_.empty()) {
+        worker.bufferList_.resize(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * bufferCount);
+    }
+    auto *bufferList = reinterpret_cast<AudioBufferList *>(worker.bufferList_.data());
+    bufferList->mNumberBuffers = bufferCount;
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        bufferList->mBuffers[i].mNumberChannels = channelsPerBuffer;
+    }
+    return bufferList;
+}
+
+} /* namespace */
+
+audio_toolbox::ParallelDecoder::ParallelDecoder(unsigned threadCount, SInt64 segmentFrames, SInt64 prerollFrames)
+    : segmentFrames_{segmentFrames}, prerollFrames_{prerollFrames} {
+    if (segmentFrames_ <= 0 || prerollFrames_ < 0) {
+        throw std::invalid_argument("segmentFrames must be greater than 0 and prerollFrames must not be negative");
+    }
+    pool_ = std::make_unique<detail::WorkStealingPool>(threadCount);
+}
+
+audio_toolbox::ParallelDecoder::~ParallelDecoder() noexcept = default;
+
+unsigned audio_toolbox::ParallelDecoder::ThreadCount() const noexcept { return pool_->ThreadCount(); }
+
+SInt64 audio_toolbox::ParallelDecoder::Decode(CFURLRef inURL, const AudioStreamBasicDescription &inClientDataFormat,
+                                              AudioBufferList *ioBufferList) {
+    std::lock_guard lock{decodeMutex_};
+
+    if (inClientDataFormat.mFormatID != kAudioFormatLinearPCM || inClientDataFormat.mBytesPerFrame == 0) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), "ParallelDecoder::Decode");
+    }
+
+    const auto nonInterleaved = (inClientDataFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+    const auto bufferCount = nonInterleaved ? inClientDataFormat.mChannelsPerFrame : 1;
+    const auto channelsPerBuffer = nonInterleaved ? 1 : inClientDataFormat.mChannelsPerFrame;
+    const auto bytesPerFrame = inClientDataFormat.mBytesPerFrame;
+    if (ioBufferList->mNumberBuffers != bufferCount) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), "ParallelDecoder::Decode");
+    }
+
+    SInt64 frameCapacity = std::numeric_limits<SInt64>::max();
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        frameCapacity = std::min<SInt64>(frameCapacity, ioBufferList->mBuffers[i].mDataByteSize / bytesPerFrame);
+    }
+
+    // The file is opened here to validate it and determine its length, then handed to the first worker
+    std::vector<Worker> workers(pool_->ThreadCount());
+    auto &file = workers[0].file_;
+    file.OpenURL(inURL);
+    if (file.FileDataFormat().mSampleRate != inClientDataFormat.mSampleRate) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), "ParallelDecoder::Decode");
+    }
+    file.SetClientDataFormat(inClientDataFormat);
+
+    const auto frameLength = file.FrameLength();
+    if (frameLength > frameCapacity) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), "ParallelDecoder::Decode");
+    }
+
+    const auto segmentCount = std::max<SInt64>(1, (frameLength + segmentFrames_ - 1) / segmentFrames_);
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    SInt64 framesDecoded = 0;
+
+    // The tasks refer to locals of this function, so submitted tasks must finish before it returns
+    try {
+        for (SInt64 segment = 0; segment < segmentCount; ++segment) {
+            pool_->Submit([&, segment](unsigned index) {
+                if (failed.load(std::memory_order_relaxed)) {
+                    return;
+                }
+
+                auto &worker = workers[index];
+                const auto isLastSegment = segment == segmentCount - 1;
+                const auto segmentStart = segment * segmentFrames_;
+                // The last segment decodes until end of file in case the reported length is short
+                const auto segmentEnd = isLastSegment ? frameCapacity : segmentStart + segmentFrames_;
+
+                try {
+                    if (!worker.file_) {
+                        worker.file_.OpenURL(inURL);
+                        worker.file_.SetClientDataFormat(inClientDataFormat);
+                    }
+
+                    auto *bufferList = PrepareBufferList(worker, bufferCount, channelsPerBuffer);
+
+                    const auto prerollStart = std::max<SInt64>(0, segmentStart - prerollFrames_);
+                    worker.file_.Seek(prerollStart);
+
+                    for (auto position = prerollStart; position < segmentStart;) {
+                        const auto discardFrames = std::min(segmentStart - position, kMaximumReadFrames);
+                        const auto discardBytes = static_cast<std::size_t>(discardFrames) * bytesPerFrame;
+                        if (worker.discard_.size() < discardBytes) {
+                            worker.discard_.resize(discardBytes);
+                        }
+
+                        auto frameCount = static_cast<UInt32>(discardFrames);
+                        for (UInt32 i = 0; i < bufferCount; ++i) {
+                            // Every channel is decoded into the same scratch space
+                            bufferList->mBuffers[i].mData = worker.discard_.data();
+                            bufferList->mBuffers[i].mDataByteSize = static_cast<UInt32>(discardBytes);
+                        }
+                        worker.file_.Read(frameCount, bufferList);
+                        if (frameCount == 0) {
+                            throw std::runtime_error("File ended before its reported length");
+                        }
+                        position += frameCount;
+                    }
+
+                    auto position = segmentStart;
+                    while (position < segmentEnd) {
+                        auto frameCount = static_cast<UInt32>(std::min(segmentEnd - position, kMaximumReadFrames));
+                        for (UInt32 i = 0; i < bufferCount; ++i) {
+                            auto *output = static_cast<unsigned char *>(ioBufferList->mBuffers[i].mData);
+                            bufferList->mBuffers[i].mData = output + position * bytesPerFrame;
+                            bufferList->mBuffers[i].mDataByteSize = frameCount * bytesPerFrame;
+                        }
+                        worker.file_.Read(frameCount, bufferList);
+                        if (frameCount == 0) {
+                            break;
+                        }
+                        position += frameCount;
+                    }
+
+                    if (isLastSegment) {
+                        framesDecoded = position;
+                    } else if (position != segmentEnd) {
+                        throw std::runtime_error("File ended before its reported length");
+                    }
+                } catch (...) {
+                    std::lock_guard errorLock{errorMutex};
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            });
+        }
+    } catch (...) {
+        // Tasks not yet started are skipped
+        failed.store(true, std::memory_order_relaxed);
+        pool_->Wait();
+        throw;
+    }
+
+    pool_->Wait();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        ioBufferList->mBuffers[i].mDataByteSize = static_cast<UInt32>(framesDecoded * bytesPerFrame);
+    }
+
+    return framesDecoded;
+}
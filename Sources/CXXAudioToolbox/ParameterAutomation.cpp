@@ -0,0 +1,132 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/ParameterAutomation.hpp"
+
+#include "ParameterEventQueue.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+/// A node's event queue and render-thread state.
+struct audio_toolbox::ParameterAutomation::NodeQueue {
+    NodeQueue(AudioUnit audioUnit, UInt32 capacity)
+        : audioUnit_{audioUnit}, events_{capacity},
+          parameterEvents_{std::make_unique<AudioUnitParameterEvent[]>(capacity)} {}
+
+    /// The node's Audio Unit.
+    AudioUnit audioUnit_;
+    /// The node's events.
+    detail::ParameterEventQueue events_;
+    /// Storage for the events passed to AudioUnitScheduleParameters, used only by the render thread.
+    std::unique_ptr<AudioUnitParameterEvent[]> parameterEvents_;
+};
+
+audio_toolbox::ParameterAutomation::ParameterAutomation(CAAUGraph &graph, const std::vector<AUNode> &nodes,
+                                                        UInt32 capacity)
+    : graph_{graph}, nodes_{nodes} {
+    if (capacity == 0) {
+        throw std::invalid_argument("capacity must be greater than 0");
+    }
+    if (capacity > (UInt32{1} << 31)) {
+        throw std::invalid_argument("capacity is too large");
+    }
+    capacity_ = 1;
+    while (capacity_ < capacity) {
+        capacity_ <<= 1;
+    }
+
+    std::sort(nodes_.begin(), nodes_.end());
+    nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+
+    queues_.reserve(nodes_.size());
+    for (const auto node : nodes_) {
+        AudioUnit au = nullptr;
+        graph_.NodeInfo(node, nullptr, &au);
+        if (!au) {
+            throw std::invalid_argument("Node has no Audio Unit");
+        }
+        queues_.push_back(std::make_unique<NodeQueue>(au, capacity_));
+    }
+
+    graph_.AddRenderNotify(&RenderNotify, this);
+}
+
+audio_toolbox::ParameterAutomation::~ParameterAutomation() noexcept {
+    try {
+        graph_.RemoveRenderNotify(&RenderNotify, this);
+    } catch (...) {
+    }
+}
+
+bool audio_toolbox::ParameterAutomation::Schedule(AUNode node, const Event &event) noexcept {
+    const auto it = std::lower_bound(nodes_.begin(), nodes_.end(), node);
+    if (it == nodes_.end() || *it != node) {
+        return false;
+    }
+
+    if (!queues_[static_cast<std::size_t>(it - nodes_.begin())]->events_.Push(event)) {
+        overflows_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    scheduled_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+audio_toolbox::ParameterAutomation::Statistics audio_toolbox::ParameterAutomation::GetStatistics() const noexcept {
+    Statistics statistics;
+    statistics.scheduled_ = scheduled_.load(std::memory_order_relaxed);
+    statistics.overflows_ = overflows_.load(std::memory_order_relaxed);
+    statistics.applied_ = applied_.load(std::memory_order_relaxed);
+    statistics.late_ = late_.load(std::memory_order_relaxed);
+    statistics.errors_ = errors_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+OSStatus audio_toolbox::ParameterAutomation::RenderNotify(void *inRefCon, AudioUnitRenderActionFlags *ioActionFlags,
+                                                         const AudioTimeStamp *inTimeStamp, UInt32 inBusNumber,
+                                                         UInt32 inNumberFrames,
+                                                         AudioBufferList *_Nullable ioData) noexcept {
+    (void)inBusNumber;
+    (void)ioData;
+    if ((*ioActionFlags & kAudioUnitRenderAction_PreRender) &&
+        (inTimeStamp->mFlags & kAudioTimeStampSampleTimeValid)) {
+        static_cast<ParameterAutomation *>(inRefCon)->Render(inTimeStamp->mSampleTime, inNumberFrames);
+    }
+    return noErr;
+}
+
+void audio_toolbox::ParameterAutomation::Render(Float64 sampleTime, UInt32 frameCount) noexcept {
+    UInt64 applied = 0;
+    UInt64 late = 0;
+    UInt64 errors = 0;
+
+    for (auto &queue : queues_) {
+        queue->events_.Drain();
+        const auto split = queue->events_.Split(sampleTime, frameCount, queue->parameterEvents_.get());
+        late += split.late_;
+
+        if (split.due_ > 0) {
+            if (AudioUnitScheduleParameters(queue->audioUnit_, queue->parameterEvents_.get(), split.due_) == noErr) {
+                applied += split.due_;
+            } else {
+                ++errors;
+            }
+        }
+    }
+
+    if (applied > 0) {
+        applied_.store(applied_.load(std::memory_order_relaxed) + applied, std::memory_order_relaxed);
+    }
+    if (late > 0) {
+        late_.store(late_.load(std::memory_order_relaxed) + late, std::memory_order_relaxed);
+    }
+    if (errors > 0) {
+        errors_.store(errors_.load(std::memory_order_relaxed) + errors, std::memory_order_relaxed);
+    }
+}
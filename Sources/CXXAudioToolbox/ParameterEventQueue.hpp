@@ -0,0 +1,195 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include "audio_toolbox/ParameterAutomation.hpp"
+
+#include <AudioToolbox/AudioUnit.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+namespace detail {
+
+/// The number of events in each part of a split.
+struct DueEvents {
+    /// The number of events due within the render slice.
+    UInt32 due_{0};
+    /// The number of events held for later slices.
+    UInt32 held_{0};
+    /// The number of due events whose sample time had passed.
+    UInt32 late_{0};
+};
+
+/// Splits events into those due within a render slice and those held for later slices, preserving their order.
+///
+/// Each due event is written to parameterEvents as an immediate change at its offset in the slice, clamped to the last
+/// frame. Late events, whose sample time precedes the slice or is NaN, are applied at offset 0. The held events are
+/// moved to the start of events.
+/// @param events The events to split.
+/// @param count The number of events.
+/// @param sampleTime The sample time of the first frame in the slice.
+/// @param frameCount The number of frames in the slice.
+/// @param parameterEvents Storage for at least count parameter events.
+/// @return The number of due, held, and late events.
+DueEvents SplitDueEvents(ParameterAutomation::Event *events, UInt32 count, Float64 sampleTime, UInt32 frameCount,
+                         AudioUnitParameterEvent *parameterEvents) noexcept;
+
+/// A bounded multiple-producer, single-consumer queue of parameter events.
+///
+/// Producers first reserve space by incrementing reserved_, which bounds the number of events queued or being read
+/// to the capacity, and then claim a slot with a ticket from tail_. Because a reservation guarantees the slot's
+/// previous event has been read, neither step can fail or retry. A slot is published by storing its ticket plus one
+/// in the slot's sequence number.
+///
+/// The consumer drains published events into a pending list and removes them with Split() once they are due.
+class ParameterEventQueue final {
+  public:
+    /// Creates a queue.
+    /// @param capacity The capacity of the queue and pending list in events, which must be a power of two.
+    /// @throw std::bad_alloc.
+    explicit ParameterEventQueue(UInt32 capacity);
+
+    // This class is non-copyable
+    ParameterEventQueue(const ParameterEventQueue &) = delete;
+
+    // This class is non-assignable
+    ParameterEventQueue &operator=(const ParameterEventQueue &) = delete;
+
+    /// Returns the capacity of the queue in events.
+    [[nodiscard]] UInt32 Capacity() const noexcept;
+
+    /// Queues an event.
+    ///
+    /// This function is wait-free and may be called from any number of threads concurrently.
+    /// @return false if the queue is full.
+    bool Push(const ParameterAutomation::Event &event) noexcept;
+
+    /// Moves published events to the pending list, stopping at the first slot still being written or when the pending
+    /// list is full.
+    ///
+    /// This function may be called by a single consumer concurrently with Push().
+    void Drain() noexcept;
+
+    /// Returns the number of drained events not yet removed by Split().
+    [[nodiscard]] UInt32 PendingCount() const noexcept;
+
+    /// Removes the pending events due within a render slice and writes them to parameterEvents.
+    /// @param sampleTime The sample time of the first frame in the slice.
+    /// @param frameCount The number of frames in the slice.
+    /// @param parameterEvents Storage for at least Capacity() parameter events.
+    /// @return The number of due, held, and late events.
+    DueEvents Split(Float64 sampleTime, UInt32 frameCount, AudioUnitParameterEvent *parameterEvents) noexcept;
+
+  private:
+    /// A queue slot.
+    struct Slot {
+        /// The ticket plus one of the event in the slot once it has been published.
+        std::atomic_uint64_t sequence_{0};
+        /// The event.
+        ParameterAutomation::Event event_;
+    };
+
+    /// The capacity of the queue and pending list.
+    UInt32 capacity_;
+    /// The queue slots.
+    std::unique_ptr<Slot[]> slots_;
+
+    /// The number of events reserved by producers and not yet drained.
+    alignas(64) std::atomic_uint64_t reserved_{0};
+    /// The next ticket.
+    std::atomic_uint64_t tail_{0};
+
+    /// The ticket of the next event to drain, modified only by the consumer.
+    alignas(64) UInt64 head_{0};
+    /// Drained events not yet due, in queue order.
+    std::unique_ptr<ParameterAutomation::Event[]> pending_;
+    /// The number of events in pending_.
+    UInt32 pendingCount_{0};
+};
+
+// MARK: - Implementation -
+
+inline DueEvents SplitDueEvents(ParameterAutomation::Event *events, UInt32 count, Float64 sampleTime,
+                                UInt32 frameCount, AudioUnitParameterEvent *parameterEvents) noexcept {
+    const auto sliceEnd = sampleTime + frameCount;
+
+    DueEvents split;
+    for (UInt32 i = 0; i < count; ++i) {
+        const auto &event = events[i];
+        if (event.sampleTime_ >= sliceEnd) {
+            events[split.held_++] = event;
+            continue;
+        }
+
+        // The offset is clamped because sliceEnd is rounded and may exceed the sample time of the last frame
+        UInt32 bufferOffset = 0;
+        if (!(event.sampleTime_ >= sampleTime)) {
+            ++split.late_;
+        } else {
+            bufferOffset = std::min(static_cast<UInt32>(event.sampleTime_ - sampleTime), frameCount - 1);
+        }
+
+        auto &parameterEvent = parameterEvents[split.due_++];
+        parameterEvent.scope = event.scope_;
+        parameterEvent.element = event.element_;
+        parameterEvent.parameter = event.parameter_;
+        parameterEvent.eventType = kParameterEvent_Immediate;
+        parameterEvent.eventValues.immediate.bufferOffset = bufferOffset;
+        parameterEvent.eventValues.immediate.value = event.value_;
+    }
+    return split;
+}
+
+inline ParameterEventQueue::ParameterEventQueue(UInt32 capacity)
+    : capacity_{capacity}, slots_{std::make_unique<Slot[]>(capacity)},
+      pending_{std::make_unique<ParameterAutomation::Event[]>(capacity)} {}
+
+inline UInt32 ParameterEventQueue::Capacity() const noexcept { return capacity_; }
+
+inline bool ParameterEventQueue::Push(const ParameterAutomation::Event &event) noexcept {
+    if (reserved_.fetch_add(1, std::memory_order_acquire) >= capacity_) {
+        reserved_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+    const auto ticket = tail_.fetch_add(1, std::memory_order_relaxed);
+    auto &slot = slots_[ticket & (capacity_ - 1)];
+    slot.event_ = event;
+    slot.sequence_.store(ticket + 1, std::memory_order_release);
+    return true;
+}
+
+inline void ParameterEventQueue::Drain() noexcept {
+    while (pendingCount_ < capacity_) {
+        auto &slot = slots_[head_ & (capacity_ - 1)];
+        if (slot.sequence_.load(std::memory_order_acquire) != head_ + 1) {
+            break;
+        }
+        pending_[pendingCount_++] = slot.event_;
+        ++head_;
+        reserved_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+inline UInt32 ParameterEventQueue::PendingCount() const noexcept { return pendingCount_; }
+
+inline DueEvents ParameterEventQueue::Split(Float64 sampleTime, UInt32 frameCount,
+                                            AudioUnitParameterEvent *parameterEvents) noexcept {
+    const auto split = SplitDueEvents(pending_.get(), pendingCount_, sampleTime, frameCount, parameterEvents);
+    pendingCount_ = split.held_;
+    return split;
+}
+
+} /* namespace detail */
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,506 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/PolyphaseResampler.hpp"
+#include "audio_toolbox/PCMLayout.hpp"
+
+#include "AudioToolboxErrors.hpp"
+#include "LinearPCM.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+
+#if defined(__x86_64__)
+#include <xmmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/// A set of filter phases for one rate ratio and quality.
+struct audio_toolbox::detail::PolyphaseFilterBank {
+    /// The number of taps per phase, a multiple of 8.
+    UInt32 taps_{0};
+    /// The number of phases in coefficients_, excluding the extra interpolation phase.
+    UInt64 phases_{0};
+    /// True if the output phase is interpolated between adjacent phases.
+    bool interpolated_{false};
+    /// phases_ (plus one if interpolated_) rows of taps_ coefficients.
+    std::vector<float> coefficients_;
+};
+
+namespace {
+
+using FilterBank = audio_toolbox::detail::PolyphaseFilterBank;
+using Quality = audio_toolbox::PolyphaseResampler::Quality;
+using audio_toolbox::detail::BufferCount;
+using audio_toolbox::detail::IsNativeFloat32;
+
+/// The largest number of phases stored for exact ratios; ratios requiring more use interpolated phases.
+constexpr UInt64 kMaximumExactPhases = 1024;
+
+/// The number of phases used when interpolating between phases.
+constexpr UInt64 kInterpolatedPhases = 1024;
+
+/// The largest number of input frames requested from the input callback at once.
+constexpr UInt32 kMaximumInputRequest = 4096;
+
+/// The largest ratio of source to destination rate; the filter length grows in proportion to it.
+constexpr UInt64 kMaximumDownsamplingRatio = 64;
+
+/// The largest number of filter banks cached for the process.
+constexpr std::size_t kMaximumCachedFilterBanks = 32;
+
+constexpr double kPi = 3.14159265358979323846;
+
+/// Filter design parameters for a quality tier.
+struct FilterDesign {
+    /// Taps per phase when upsampling.
+    UInt32 taps_;
+    /// Cutoff frequency as a fraction of the lower Nyquist frequency.
+    double cutoff_;
+    /// Kaiser window shape parameter.
+    double beta_;
+};
+
+/// Returns the filter design for a quality tier.
+///
+/// Each beta yields the tier's stopband attenuation with margin by Kaiser's formula, and each cutoff is low enough
+/// that the transition band for that attenuation ends at the lower Nyquist frequency.
+FilterDesign DesignForQuality(Quality quality) noexcept {
+    switch (quality) {
+    case Quality::low:
+        return {16, 0.745, 6.0};
+    case Quality::medium:
+        return {32, 0.81, 8.9};
+    case Quality::maximum:
+        return {128, 0.925, 14.0};
+    case Quality::high:
+    default:
+        return {64, 0.885, 10.7};
+    }
+}
+
+/// Returns the zeroth-order modified Bessel function of the first kind.
+double BesselI0(double x) noexcept {
+    double sum = 1;
+    double term = 1;
+    const auto halfX = x / 2;
+    for (int k = 1; k < 64; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-17) {
+            break;
+        }
+    }
+    return sum;
+}
+
+/// Returns sin(pi x) / (pi x).
+double Sinc(double x) noexcept {
+    if (std::abs(x) < 1e-12) {
+        return 1;
+    }
+    const auto px = kPi * x;
+    return std::sin(px) / px;
+}
+
+/// Computes the filter bank for a ratio of upsampling to downsampling.
+std::shared_ptr<const FilterBank> MakeFilterBank(UInt64 upsampling, UInt64 downsampling, Quality quality) {
+    const auto design = DesignForQuality(quality);
+
+    // When downsampling the cutoff moves below the input Nyquist frequency and the filter lengthens to match
+    const auto scale = std::min(1.0, static_cast<double>(upsampling) / static_cast<double>(downsampling));
+    const auto cutoff = design.cutoff_ * scale;
+    auto taps = static_cast<UInt32>(std::ceil(design.taps_ / scale));
+    taps = (taps + 7) & ~UInt32{7};
+
+    auto bank = std::make_shared<FilterBank>();
+    bank->taps_ = taps;
+    bank->interpolated_ = upsampling > kMaximumExactPhases;
+    bank->phases_ = bank->interpolated_ ? kInterpolatedPhases : upsampling;
+
+    const auto rows = bank->phases_ + (bank->interpolated_ ? 1 : 0);
+    bank->coefficients_.resize(rows * taps);
+
+    const auto halfLength = taps / 2.0;
+    const auto windowNormalization = 1 / BesselI0(design.beta_);
+
+    for (UInt64 row = 0; row < rows; ++row) {
+        const auto fraction = static_cast<double>(row) / static_cast<double>(bank->phases_);
+        auto coefficients = bank->coefficients_.data() + row * taps;
+
+        double sum = 0;
+        std::vector<double> values(taps);
+        for (UInt32 k = 0; k < taps; ++k) {
+            // The distance from the output time to input sample k of the window
+            const auto x = fraction + halfLength - 1 - k;
+            const auto r = x / halfLength;
+            const auto window = r * r < 1 ? BesselI0(design.beta_ * std::sqrt(1 - r * r)) * windowNormalization : 0;
+            values[k] = cutoff * Sinc(cutoff * x) * window;
+            sum += values[k];
+        }
+
+        // Each phase has unity gain at DC
+        for (UInt32 k = 0; k < taps; ++k) {
+            coefficients[k] = static_cast<float>(values[k] / sum);
+        }
+    }
+
+    return bank;
+}
+
+/// Returns the dot product of two arrays of count floats; count must be a multiple of 8.
+float DotProduct(const float *x, const float *h, std::size_t count) noexcept {
+#if defined(__x86_64__)
+    auto sum0 = _mm_setzero_ps();
+    auto sum1 = _mm_setzero_ps();
+    for (std::size_t i = 0; i < count; i += 8) {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(h + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(x + i + 4), _mm_loadu_ps(h + i + 4)));
+    }
+    const auto sum = _mm_add_ps(sum0, sum1);
+    const auto high = _mm_movehl_ps(sum, sum);
+    const auto pair = _mm_add_ps(sum, high);
+    return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+#elif defined(__aarch64__)
+    auto sum0 = vdupq_n_f32(0);
+    auto sum1 = vdupq_n_f32(0);
+    for (std::size_t i = 0; i < count; i += 8) {
+        sum0 = vfmaq_f32(sum0, vld1q_f32(x + i), vld1q_f32(h + i));
+        sum1 = vfmaq_f32(sum1, vld1q_f32(x + i + 4), vld1q_f32(h + i + 4));
+    }
+    return vaddvq_f32(vaddq_f32(sum0, sum1));
+#else
+    float sum[8]{};
+    for (std::size_t i = 0; i < count; i += 8) {
+        for (std::size_t j = 0; j < 8; ++j) {
+            sum[j] += x[i + j] * h[i + j];
+        }
+    }
+    return ((sum[0] + sum[4]) + (sum[1] + sum[5])) + ((sum[2] + sum[6]) + (sum[3] + sum[7]));
+#endif
+}
+
+/// Returns true if rate is a whole number of frames per second.
+bool IsWholeRate(Float64 rate) noexcept { return rate >= 1 && rate <= 4294967295.0 && std::floor(rate) == rate; }
+
+/// Process-wide filter banks keyed by upsampling, downsampling, and quality.
+std::mutex filterBankMutex;
+std::map<std::tuple<UInt64, UInt64, Quality>, std::shared_ptr<const FilterBank>> filterBanks;
+
+/// Returns the filter bank for a rate ratio and quality, computing it if necessary.
+std::shared_ptr<const FilterBank> GetFilterBank(UInt64 upsampling, UInt64 downsampling, Quality quality) {
+    const auto key = std::make_tuple(upsampling, downsampling, quality);
+    {
+        std::lock_guard lock{filterBankMutex};
+        if (const auto it = filterBanks.find(key); it != filterBanks.end()) {
+            return it->second;
+        }
+    }
+
+    // Concurrent computations of the same bank are harmless; the first one stored wins
+    auto bank = MakeFilterBank(upsampling, downsampling, quality);
+    std::lock_guard lock{filterBankMutex};
+    if (const auto it = filterBanks.find(key); it != filterBanks.end()) {
+        return it->second;
+    }
+
+    // A full cache makes room by evicting a bank no resampler is using, or leaves the new bank uncached
+    if (filterBanks.size() >= kMaximumCachedFilterBanks) {
+        const auto unused = std::find_if(filterBanks.begin(), filterBanks.end(),
+                                         [](const auto &entry) { return entry.second.use_count() == 1; });
+        if (unused == filterBanks.end()) {
+            return bank;
+        }
+        filterBanks.erase(unused);
+    }
+
+    return filterBanks.emplace(key, std::move(bank)).first->second;
+}
+
+} /* namespace */
+
+void audio_toolbox::PolyphaseResampler::PrecomputeCommonFilterBanks(Quality quality) {
+    constexpr UInt64 rates[] = {44100, 48000, 96000};
+    for (const auto from : rates) {
+        for (const auto to : rates) {
+            if (from != to) {
+                const auto divisor = std::gcd(from, to);
+                (void)GetFilterBank(to / divisor, from / divisor, quality);
+            }
+        }
+    }
+}
+
+void audio_toolbox::PolyphaseResampler::New(const AudioStreamBasicDescription &inSourceFormat,
+                                            const AudioStreamBasicDescription &inDestinationFormat, Quality quality) {
+    if (!IsNativeFloat32(inSourceFormat) || !IsNativeFloat32(inDestinationFormat) ||
+        inSourceFormat.mChannelsPerFrame != inDestinationFormat.mChannelsPerFrame ||
+        BufferCount(inSourceFormat) != BufferCount(inDestinationFormat) || !IsWholeRate(inSourceFormat.mSampleRate) ||
+        !IsWholeRate(inDestinationFormat.mSampleRate)) {
+        ThrowIfAudioConverterError(kAudioConverterErr_FormatNotSupported, "PolyphaseResampler::New");
+    }
+
+    const auto sourceRate = static_cast<UInt64>(inSourceFormat.mSampleRate);
+    const auto destinationRate = static_cast<UInt64>(inDestinationFormat.mSampleRate);
+    if (sourceRate > destinationRate * kMaximumDownsamplingRatio) {
+        ThrowIfAudioConverterError(kAudioConverterErr_FormatNotSupported, "PolyphaseResampler::New");
+    }
+    const auto divisor = std::gcd(sourceRate, destinationRate);
+
+    Dispose();
+
+    auto filterBank = GetFilterBank(destinationRate / divisor, sourceRate / divisor, quality);
+
+    const auto channels = inSourceFormat.mChannelsPerFrame;
+    const auto bufferCount = BufferCount(inSourceFormat);
+    history_.assign(channels, std::vector<float>(filterBank->taps_ + kMaximumInputRequest));
+    channelPointers_.resize(channels);
+    inputBufferList_.resize(offsetof(AudioBufferList, mBuffers) + bufferCount * sizeof(AudioBuffer));
+
+    sourceFormat_ = inSourceFormat;
+    destinationFormat_ = inDestinationFormat;
+    quality_ = quality;
+    filterBank_ = std::move(filterBank);
+    upsampling_ = destinationRate / divisor;
+    downsampling_ = sourceRate / divisor;
+
+    Reset();
+}
+
+void audio_toolbox::PolyphaseResampler::Dispose() noexcept {
+    filterBank_.reset();
+    sourceFormat_ = {};
+    destinationFormat_ = {};
+    upsampling_ = 1;
+    downsampling_ = 1;
+    history_.clear();
+    channelPointers_.clear();
+    inputBufferList_.clear();
+    historyFrames_ = 0;
+    historyIndex_ = 0;
+    phase_ = 0;
+    endOfStream_ = false;
+    inputFrames_ = 0;
+    outputFrames_ = 0;
+    outputFrameLimit_ = 0;
+}
+
+void audio_toolbox::PolyphaseResampler::Reset() noexcept {
+    historyFrames_ = 0;
+    historyIndex_ = 0;
+    phase_ = 0;
+    endOfStream_ = false;
+    inputFrames_ = 0;
+    outputFrames_ = 0;
+    outputFrameLimit_ = 0;
+
+    if (!filterBank_) {
+        return;
+    }
+
+    // The window for output frame zero is centered on input frame zero
+    const std::size_t leading = filterBank_->taps_ / 2 - 1;
+    for (auto &channel : history_) {
+        std::fill_n(channel.begin(), leading, 0.f);
+    }
+    historyFrames_ = leading;
+}
+
+UInt32 audio_toolbox::PolyphaseResampler::FilterLength() const noexcept {
+    return filterBank_ ? filterBank_->taps_ : 0;
+}
+
+void audio_toolbox::PolyphaseResampler::FillComplexBuffer(AudioConverterComplexInputDataProc inInputDataProc,
+                                                          void *inInputDataProcUserData,
+                                                          UInt32 &ioOutputDataPacketSize,
+                                                          AudioBufferList *outOutputData,
+                                                          AudioStreamPacketDescription *outPacketDescription) {
+    if (!filterBank_ || !outOutputData || outOutputData->mNumberBuffers != BufferCount(destinationFormat_)) {
+        ThrowIfAudioConverterError(kAudio_ParamError, "PolyphaseResampler::FillComplexBuffer");
+    }
+
+    auto capacity = ioOutputDataPacketSize;
+    for (UInt32 i = 0; i < outOutputData->mNumberBuffers; ++i) {
+        if (!outOutputData->mBuffers[i].mData) {
+            ThrowIfAudioConverterError(kAudio_ParamError, "PolyphaseResampler::FillComplexBuffer");
+        }
+        capacity = std::min(capacity, outOutputData->mBuffers[i].mDataByteSize / destinationFormat_.mBytesPerFrame);
+    }
+
+    UInt32 produced = 0;
+    const auto setOutputSize = [&] {
+        ioOutputDataPacketSize = produced;
+        for (UInt32 i = 0; i < outOutputData->mNumberBuffers; ++i) {
+            outOutputData->mBuffers[i].mDataByteSize = produced * destinationFormat_.mBytesPerFrame;
+        }
+    };
+
+    OSStatus result = noErr;
+    try {
+        while (produced < capacity) {
+            produced += Render(outOutputData, produced, capacity - produced);
+            if (produced == capacity || (endOfStream_ && outputFrames_ >= outputFrameLimit_)) {
+                break;
+            }
+
+            if (endOfStream_) {
+                AppendSilence(filterBank_->taps_);
+                continue;
+            }
+
+            if (result = PullInput(inInputDataProc, inInputDataProcUserData, capacity - produced); result != noErr) {
+                produced += Render(outOutputData, produced, capacity - produced);
+                break;
+            }
+        }
+    } catch (...) {
+        setOutputSize();
+        throw;
+    }
+
+    setOutputSize();
+    ThrowIfAudioConverterError(result, "PolyphaseResampler::FillComplexBuffer");
+}
+
+OSStatus audio_toolbox::PolyphaseResampler::PullInput(AudioConverterComplexInputDataProc inInputDataProc,
+                                                      void *inInputDataProcUserData, UInt32 outputFrames) {
+    // Request enough input for the remaining output, within limits
+    const auto wanted = static_cast<UInt64>(outputFrames) * downsampling_ / upsampling_ + 1;
+    auto packetCount = static_cast<UInt32>(std::min<UInt64>(wanted, kMaximumInputRequest));
+
+    const auto bufferList = reinterpret_cast<AudioBufferList *>(inputBufferList_.data());
+    const auto bufferCount = BufferCount(sourceFormat_);
+    bufferList->mNumberBuffers = bufferCount;
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        bufferList->mBuffers[i].mNumberChannels = bufferCount == 1 ? sourceFormat_.mChannelsPerFrame : 1;
+        bufferList->mBuffers[i].mDataByteSize = 0;
+        bufferList->mBuffers[i].mData = nullptr;
+    }
+
+    AudioStreamPacketDescription *packetDescriptions = nullptr;
+    const auto result =
+            inInputDataProc(nullptr, &packetCount, bufferList, &packetDescriptions, inInputDataProcUserData);
+
+    // Trust the buffer sizes over the packet count
+    auto frameCount = packetCount;
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        const auto &buffer = bufferList->mBuffers[i];
+        frameCount = buffer.mData ? std::min(frameCount, buffer.mDataByteSize / sourceFormat_.mBytesPerFrame) : 0;
+    }
+
+    if (frameCount == 0) {
+        if (result == noErr) {
+            endOfStream_ = true;
+            outputFrameLimit_ = (inputFrames_ * upsampling_ + downsampling_ - 1) / downsampling_;
+        }
+        return result;
+    }
+
+    const auto index = ReserveHistory(frameCount);
+    const auto channels = sourceFormat_.mChannelsPerFrame;
+    if (bufferCount == 1) {
+        for (UInt32 c = 0; c < channels; ++c) {
+            channelPointers_[c] = history_[c].data() + index;
+        }
+        pcm_layout::Deinterleave(sizeof(float), channels, frameCount, bufferList->mBuffers[0].mData,
+                                 channelPointers_.data());
+    } else {
+        for (UInt32 c = 0; c < channels; ++c) {
+            std::memcpy(history_[c].data() + index, bufferList->mBuffers[c].mData, frameCount * sizeof(float));
+        }
+    }
+
+    historyFrames_ += frameCount;
+    inputFrames_ += frameCount;
+    return result;
+}
+
+void audio_toolbox::PolyphaseResampler::AppendSilence(std::size_t frameCount) {
+    const auto index = ReserveHistory(frameCount);
+    for (auto &channel : history_) {
+        std::fill_n(channel.begin() + static_cast<std::ptrdiff_t>(index), frameCount, 0.f);
+    }
+    historyFrames_ += frameCount;
+}
+
+std::size_t audio_toolbox::PolyphaseResampler::ReserveHistory(std::size_t frameCount) {
+    // Discard frames before the current filter window, which may begin past the end of the history when downsampling
+    if (const auto discarded = std::min(historyIndex_, historyFrames_); discarded > 0) {
+        const auto retained = historyFrames_ - discarded;
+        for (auto &channel : history_) {
+            std::memmove(channel.data(), channel.data() + discarded, retained * sizeof(float));
+        }
+        historyFrames_ = retained;
+        historyIndex_ -= discarded;
+    }
+
+    for (auto &channel : history_) {
+        if (channel.size() < historyFrames_ + frameCount) {
+            channel.resize(historyFrames_ + frameCount);
+        }
+    }
+
+    return historyFrames_;
+}
+
+UInt32 audio_toolbox::PolyphaseResampler::Render(AudioBufferList *outOutputData, UInt32 offset,
+                                                 UInt32 frameCount) noexcept {
+    const auto &bank = *filterBank_;
+    const auto taps = bank.taps_;
+    const auto channels = destinationFormat_.mChannelsPerFrame;
+    const auto interleaved = outOutputData->mNumberBuffers == 1 && channels > 1;
+
+    UInt32 produced = 0;
+    while (produced < frameCount && historyIndex_ + taps <= historyFrames_) {
+        if (endOfStream_ && outputFrames_ >= outputFrameLimit_) {
+            break;
+        }
+
+        const float *row = nullptr;
+        const float *nextRow = nullptr;
+        float weight = 0;
+        if (bank.interpolated_) {
+            const auto position = phase_ * bank.phases_;
+            const auto index = position / upsampling_;
+            row = bank.coefficients_.data() + index * taps;
+            nextRow = row + taps;
+            weight = static_cast<float>(position % upsampling_) / static_cast<float>(upsampling_);
+        } else {
+            row = bank.coefficients_.data() + phase_ * taps;
+        }
+
+        const auto frame = offset + produced;
+        for (UInt32 c = 0; c < channels; ++c) {
+            const auto x = history_[c].data() + historyIndex_;
+            auto y = DotProduct(x, row, taps);
+            if (nextRow) {
+                y += weight * (DotProduct(x, nextRow, taps) - y);
+            }
+
+            if (interleaved) {
+                static_cast<float *>(outOutputData->mBuffers[0].mData)[frame * channels + c] = y;
+            } else {
+                static_cast<float *>(outOutputData->mBuffers[c].mData)[frame] = y;
+            }
+        }
+
+        phase_ += downsampling_;
+        historyIndex_ += static_cast<std::size_t>(phase_ / upsampling_);
+        phase_ %= upsampling_;
+        ++outputFrames_;
+        ++produced;
+    }
+
+    return produced;
+}
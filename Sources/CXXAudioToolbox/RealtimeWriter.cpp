@@ -0,0 +1,241 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/RealtimeWriter.hpp"
+
+#include "AudioToolboxErrors.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+audio_toolbox::RealtimeWriter::RealtimeWriter(const AudioStreamBasicDescription &format, UInt32 capacity, Sink sink,
+                                              std::chrono::milliseconds drainInterval)
+    : format_{format}, capacity_{capacity}, sink_{std::move(sink)}, drainInterval_{drainInterval} {
+    if (format_.mFormatID != kAudioFormatLinearPCM || format_.mBytesPerFrame == 0) {
+        throw std::invalid_argument("Format must be linear PCM");
+    }
+    if (capacity_ == 0) {
+        throw std::invalid_argument("capacity must be greater than 0");
+    }
+    if (!sink_) {
+        throw std::invalid_argument("sink must not be empty");
+    }
+
+    const auto nonInterleaved = (format_.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+    bufferCount_ = nonInterleaved ? format_.mChannelsPerFrame : 1;
+
+    storage_ = std::make_unique<unsigned char[]>(static_cast<std::size_t>(capacity_) * format_.mBytesPerFrame *
+                                                 bufferCount_);
+
+    drainListStorage_ = std::make_unique<unsigned char[]>(offsetof(AudioBufferList, mBuffers) +
+                                                          sizeof(AudioBuffer) * std::max(bufferCount_, 1U));
+    auto drainList = reinterpret_cast<AudioBufferList *>(drainListStorage_.get());
+    drainList->mNumberBuffers = bufferCount_;
+    for (UInt32 i = 0; i < bufferCount_; ++i) {
+        drainList->mBuffers[i].mNumberChannels = nonInterleaved ? 1 : format_.mChannelsPerFrame;
+    }
+}
+
+audio_toolbox::RealtimeWriter::RealtimeWriter(CAExtAudioFile &extAudioFile, UInt32 capacity,
+                                              std::chrono::milliseconds drainInterval)
+    : RealtimeWriter(
+              extAudioFile.ClientDataFormat(), capacity,
+              [&extAudioFile](UInt32 inNumberFrames, const AudioBufferList *ioData) {
+#if TARGET_OS_IPHONE
+                  // Audio not consumed because of an interruption would otherwise be lost silently
+                  if (const auto result = extAudioFile.Write(inNumberFrames, ioData);
+                      result == kExtAudioFileError_CodecUnavailableInputNotConsumed) {
+                      ThrowIfExtAudioFileError(result, "ExtAudioFileWrite");
+                  }
+#else
+                  extAudioFile.Write(inNumberFrames, ioData);
+#endif /* TARGET_OS_IPHONE */
+              },
+              drainInterval) {}
+
+audio_toolbox::RealtimeWriter::~RealtimeWriter() noexcept {
+    try {
+        Stop();
+    } catch (...) {
+    }
+}
+
+void audio_toolbox::RealtimeWriter::Start() {
+    if (drainThread_.joinable()) {
+        // A drain thread exits after the sink fails, so only a thread that has not failed is still running
+        if (!failed_.load(std::memory_order_acquire)) {
+            return;
+        }
+        drainThread_.join();
+    }
+
+    CheckError();
+    failed_.store(false, std::memory_order_release);
+
+    drainThread_ = std::thread(&RealtimeWriter::DrainThreadEntry, this);
+}
+
+void audio_toolbox::RealtimeWriter::Stop() {
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = true;
+    }
+    stopCondition_.notify_all();
+
+    if (drainThread_.joinable()) {
+        drainThread_.join();
+    }
+
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = false;
+    }
+
+    CheckError();
+}
+
+UInt32 audio_toolbox::RealtimeWriter::Write(UInt32 inNumberFrames, const AudioBufferList *ioData) noexcept {
+    if (inNumberFrames == 0) {
+        return 0;
+    }
+
+    if (failed_.load(std::memory_order_acquire)) {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+        droppedFrames_.fetch_add(inNumberFrames, std::memory_order_relaxed);
+        return 0;
+    }
+
+    // The producer is behind real time if it writes after the previously written audio would have finished
+    // playing, allowing for the call to arrive up to the duration of its own audio late
+    if (format_.mSampleRate > 0) {
+        const auto now = std::chrono::steady_clock::now();
+        const auto duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(inNumberFrames / format_.mSampleRate));
+        if (!streaming_) {
+            streaming_ = true;
+            streamDeadline_ = now;
+        } else if (now > streamDeadline_ + duration) {
+            underruns_.fetch_add(1, std::memory_order_relaxed);
+            streamDeadline_ = now;
+        }
+        streamDeadline_ += duration;
+    }
+
+    const auto writePosition = writePosition_.load(std::memory_order_relaxed);
+    const auto readPosition = readPosition_.load(std::memory_order_acquire);
+    const auto available = capacity_ - static_cast<UInt32>(writePosition - readPosition);
+
+    const auto frameCount = std::min(inNumberFrames, available);
+    if (frameCount < inNumberFrames) {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+        droppedFrames_.fetch_add(inNumberFrames - frameCount, std::memory_order_relaxed);
+    }
+
+    if (frameCount > 0) {
+        const std::size_t bytesPerFrame = format_.mBytesPerFrame;
+        const auto ringBytes = static_cast<std::size_t>(capacity_) * bytesPerFrame;
+        const auto offset = static_cast<UInt32>(writePosition % capacity_);
+        const auto firstCount = std::min(frameCount, capacity_ - offset);
+        const auto secondCount = frameCount - firstCount;
+
+        for (UInt32 i = 0; i < bufferCount_; ++i) {
+            auto ring = storage_.get() + ringBytes * i;
+            const auto source = static_cast<const unsigned char *>(ioData->mBuffers[i].mData);
+            std::memcpy(ring + offset * bytesPerFrame, source, firstCount * bytesPerFrame);
+            if (secondCount > 0) {
+                std::memcpy(ring, source + firstCount * bytesPerFrame, secondCount * bytesPerFrame);
+            }
+        }
+
+        writePosition_.store(writePosition + frameCount, std::memory_order_release);
+
+        const auto fill = static_cast<UInt32>(writePosition + frameCount - readPosition);
+        if (fill > highWaterMark_.load(std::memory_order_relaxed)) {
+            highWaterMark_.store(fill, std::memory_order_relaxed);
+        }
+    }
+
+    return frameCount;
+}
+
+void audio_toolbox::RealtimeWriter::CheckError() {
+    std::exception_ptr error;
+    {
+        std::lock_guard lock{mutex_};
+        error = std::exchange(error_, nullptr);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+audio_toolbox::RealtimeWriter::Statistics audio_toolbox::RealtimeWriter::GetStatistics() const noexcept {
+    Statistics statistics;
+    statistics.framesWritten_ = writePosition_.load(std::memory_order_relaxed);
+    statistics.framesDrained_ = readPosition_.load(std::memory_order_relaxed);
+    statistics.overruns_ = overruns_.load(std::memory_order_relaxed);
+    statistics.droppedFrames_ = droppedFrames_.load(std::memory_order_relaxed);
+    statistics.underruns_ = underruns_.load(std::memory_order_relaxed);
+    statistics.highWaterMark_ = highWaterMark_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void audio_toolbox::RealtimeWriter::DrainThreadEntry() noexcept {
+    for (;;) {
+        bool stop;
+        {
+            std::unique_lock lock{mutex_};
+            stopCondition_.wait_for(lock, drainInterval_, [this] { return stopRequested_; });
+            stop = stopRequested_;
+        }
+
+        // The ring is drained once more after a stop request so no audio written before Stop() is lost
+        if (!Drain() || stop) {
+            break;
+        }
+    }
+}
+
+bool audio_toolbox::RealtimeWriter::Drain() noexcept {
+    auto readPosition = readPosition_.load(std::memory_order_relaxed);
+    const auto writePosition = writePosition_.load(std::memory_order_acquire);
+
+    const std::size_t bytesPerFrame = format_.mBytesPerFrame;
+    const auto ringBytes = static_cast<std::size_t>(capacity_) * bytesPerFrame;
+    auto drainList = reinterpret_cast<AudioBufferList *>(drainListStorage_.get());
+
+    // The readable frames occupy at most two contiguous regions of the ring
+    while (readPosition < writePosition) {
+        const auto offset = static_cast<UInt32>(readPosition % capacity_);
+        const auto frameCount = static_cast<UInt32>(std::min<UInt64>(writePosition - readPosition, capacity_ - offset));
+
+        for (UInt32 i = 0; i < bufferCount_; ++i) {
+            drainList->mBuffers[i].mData = storage_.get() + ringBytes * i + offset * bytesPerFrame;
+            drainList->mBuffers[i].mDataByteSize = static_cast<UInt32>(frameCount * bytesPerFrame);
+        }
+
+        try {
+            sink_(frameCount, drainList);
+        } catch (...) {
+            {
+                std::lock_guard lock{mutex_};
+                error_ = std::current_exception();
+            }
+            failedFramePosition_ = readPosition;
+            failed_.store(true, std::memory_order_release);
+            return false;
+        }
+
+        readPosition += frameCount;
+        readPosition_.store(readPosition, std::memory_order_release);
+    }
+
+    return true;
+}
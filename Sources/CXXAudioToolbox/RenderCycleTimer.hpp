@@ -0,0 +1,255 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include "audio_toolbox/TimingHistogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace audio_toolbox {
+namespace detail {
+
+/// Attributes the time of nested render calls to nodes and records the duration of each render cycle of a graph.
+///
+/// Render calls are tracked on a stack. A node's time is the duration of its render call less the time spent in the
+/// render calls nested within it. A cycle ends at the graph's post-render notification or, if node render calls are
+/// still in progress, when the outermost one ends. A cycle misses its deadline if it takes longer than the duration
+/// of the audio it renders, and at the end of each cycle the node that took the most time is noted.
+///
+/// The notification handlers must be called by one thread at a time and do not allocate, lock, or block. The
+/// statistics may be read from any thread.
+class RenderCycleTimer final {
+  public:
+    /// The clock used for timestamps.
+    using Clock = std::chrono::steady_clock;
+
+    /// The statistics of a node.
+    struct NodeStatistics {
+        /// The node's render times, excluding time spent in nested render calls.
+        TimingHistogram renderTime_;
+        /// The number of cycles in which the node took the most time.
+        std::atomic_uint64_t slowestCycles_{0};
+        /// The number of cycles missing the deadline in which the node took the most time.
+        std::atomic_uint64_t slowestMissedCycles_{0};
+    };
+
+    /// Creates a timer for nodeCount nodes identified by their indexes.
+    /// @throw std::bad_alloc.
+    explicit RenderCycleTimer(std::size_t nodeCount);
+
+    // This class is non-copyable
+    RenderCycleTimer(const RenderCycleTimer &) = delete;
+
+    // This class is non-assignable
+    RenderCycleTimer &operator=(const RenderCycleTimer &) = delete;
+
+    /// Returns the number of nodes.
+    [[nodiscard]] std::size_t NodeCount() const noexcept;
+
+    /// Returns the statistics of a node.
+    [[nodiscard]] const NodeStatistics &Node(std::size_t index) const noexcept;
+
+    /// Returns the render times of the graph's cycles.
+    [[nodiscard]] const TimingHistogram &CycleTime() const noexcept;
+
+    /// Returns the number of cycles missing the deadline.
+    [[nodiscard]] std::uint64_t DeadlineMisses() const noexcept;
+
+    /// Returns the index of the slowest node in the most recent cycle missing the deadline, if any.
+    [[nodiscard]] std::optional<std::size_t> LastMissSlowestNode() const noexcept;
+
+    /// Handles the graph's pre-render notification.
+    /// @param deadline The duration of the audio rendered by the cycle.
+    /// @param now The time of the notification.
+    void BeginCycle(Clock::duration deadline, Clock::time_point now) noexcept;
+
+    /// Handles the graph's post-render notification.
+    /// @param now The time of the notification.
+    void EndCycle(Clock::time_point now) noexcept;
+
+    /// Handles a node's pre-render notification.
+    /// @param index The index of the node.
+    /// @param now The time of the notification.
+    void BeginNode(std::size_t index, Clock::time_point now) noexcept;
+
+    /// Handles a node's post-render notification.
+    ///
+    /// Notifications that do not match the innermost render call in progress are ignored.
+    /// @param index The index of the node.
+    /// @param now The time of the notification.
+    void EndNode(std::size_t index, Clock::time_point now) noexcept;
+
+  private:
+    /// A node's statistics and render-thread state.
+    struct NodeState {
+        /// The node's statistics.
+        NodeStatistics statistics_;
+        /// The time taken by the node in the current cycle.
+        Clock::duration cycleTime_{0};
+    };
+
+    /// A node whose render call is in progress.
+    struct Frame {
+        /// The index of the node.
+        std::size_t index_{0};
+        /// The time the node's render call began.
+        Clock::time_point start_;
+        /// The time spent in render calls nested within the node's render call.
+        Clock::duration children_{0};
+    };
+
+    /// Records the statistics of the cycle that ended.
+    void RecordCycle(Clock::time_point end) noexcept;
+
+    /// The number of nodes.
+    std::size_t nodeCount_;
+    /// The state of each node.
+    std::unique_ptr<NodeState[]> nodes_;
+    /// The render calls in progress, innermost last.
+    std::unique_ptr<Frame[]> stack_;
+    /// The number of render calls in progress, which may exceed nodeCount_.
+    std::size_t depth_{0};
+    /// True if a cycle has begun and not been recorded.
+    bool cycleActive_{false};
+    /// True if the graph's post-render notification was received while node render calls were in progress.
+    bool cycleEnding_{false};
+    /// The time the current cycle began.
+    Clock::time_point cycleStart_;
+    /// The duration of the audio rendered by the current cycle.
+    Clock::duration cycleDeadline_{0};
+
+    /// The render times of the graph's cycles.
+    TimingHistogram cycleTime_;
+    /// The number of cycles missing the deadline.
+    std::atomic_uint64_t deadlineMisses_{0};
+    /// The index plus one of the slowest node in the most recent cycle missing the deadline, or zero.
+    std::atomic_size_t lastMissSlowestNode_{0};
+};
+
+// MARK: - Implementation -
+
+inline RenderCycleTimer::RenderCycleTimer(std::size_t nodeCount)
+    : nodeCount_{nodeCount}, nodes_{std::make_unique<NodeState[]>(nodeCount)},
+      stack_{std::make_unique<Frame[]>(nodeCount)} {}
+
+inline std::size_t RenderCycleTimer::NodeCount() const noexcept { return nodeCount_; }
+
+inline const RenderCycleTimer::NodeStatistics &RenderCycleTimer::Node(std::size_t index) const noexcept {
+    return nodes_[index].statistics_;
+}
+
+inline const TimingHistogram &RenderCycleTimer::CycleTime() const noexcept { return cycleTime_; }
+
+inline std::uint64_t RenderCycleTimer::DeadlineMisses() const noexcept {
+    return deadlineMisses_.load(std::memory_order_relaxed);
+}
+
+inline std::optional<std::size_t> RenderCycleTimer::LastMissSlowestNode() const noexcept {
+    if (const auto index = lastMissSlowestNode_.load(std::memory_order_relaxed); index > 0) {
+        return index - 1;
+    }
+    return std::nullopt;
+}
+
+inline void RenderCycleTimer::BeginCycle(Clock::duration deadline, Clock::time_point now) noexcept {
+    for (std::size_t i = 0; i < nodeCount_; ++i) {
+        nodes_[i].cycleTime_ = Clock::duration{0};
+    }
+    cycleActive_ = true;
+    cycleEnding_ = false;
+    cycleStart_ = now;
+    cycleDeadline_ = deadline;
+}
+
+inline void RenderCycleTimer::EndCycle(Clock::time_point now) noexcept {
+    if (!cycleActive_) {
+        return;
+    }
+
+    // The head node's post-render notification may follow the graph's
+    if (depth_ > 0) {
+        cycleEnding_ = true;
+    } else {
+        RecordCycle(now);
+    }
+}
+
+inline void RenderCycleTimer::BeginNode(std::size_t index, Clock::time_point now) noexcept {
+    // Render calls nested more deeply than the number of nodes are not timed
+    if (depth_ < nodeCount_) {
+        stack_[depth_] = {index, now, Clock::duration{0}};
+    }
+    ++depth_;
+}
+
+inline void RenderCycleTimer::EndNode(std::size_t index, Clock::time_point now) noexcept {
+    if (depth_ == 0) {
+        return;
+    }
+    if (depth_ > nodeCount_) {
+        --depth_;
+        return;
+    }
+
+    const auto &frame = stack_[depth_ - 1];
+    if (frame.index_ != index) {
+        return;
+    }
+    --depth_;
+
+    auto &node = nodes_[index];
+    const auto elapsed = now - frame.start_;
+    const auto own = elapsed - frame.children_;
+    node.statistics_.renderTime_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(own));
+    node.cycleTime_ += own;
+
+    if (depth_ > 0) {
+        stack_[depth_ - 1].children_ += elapsed;
+    } else if (cycleEnding_) {
+        RecordCycle(now);
+    }
+}
+
+inline void RenderCycleTimer::RecordCycle(Clock::time_point end) noexcept {
+    cycleActive_ = false;
+    cycleEnding_ = false;
+
+    const auto duration = end - cycleStart_;
+    cycleTime_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+
+    const auto missed = duration > cycleDeadline_;
+    if (missed) {
+        deadlineMisses_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::size_t slowest = nodeCount_;
+    auto slowestTime = Clock::duration{0};
+    for (std::size_t i = 0; i < nodeCount_; ++i) {
+        if (nodes_[i].cycleTime_ > slowestTime) {
+            slowest = i;
+            slowestTime = nodes_[i].cycleTime_;
+        }
+    }
+
+    if (slowest < nodeCount_) {
+        auto &statistics = nodes_[slowest].statistics_;
+        statistics.slowestCycles_.fetch_add(1, std::memory_order_relaxed);
+        if (missed) {
+            statistics.slowestMissedCycles_.fetch_add(1, std::memory_order_relaxed);
+            lastMissSlowestNode_.store(slowest + 1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} /* namespace detail */
+} /* namespace audio_toolbox */
@@ -0,0 +1,147 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/RenderNotifyDispatcher.hpp"
+
+#include "AudioToolboxErrors.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// An immutable list of observers.
+struct audio_toolbox::RenderNotifyDispatcher::ObserverList {
+    /// An observer and the render phases it receives.
+    struct Entry {
+        /// The observer's identifier.
+        ObserverID observerID_;
+        /// The render phases delivered to the observer.
+        AudioUnitRenderActionFlags phases_;
+        /// The observer.
+        Observer observer_;
+    };
+
+    /// The observers in the order they were added.
+    std::vector<Entry> entries_;
+};
+
+audio_toolbox::RenderNotifyDispatcher::RenderNotifyDispatcher(CAAUGraph &graph) : graph_{&graph} {
+    graph_->AddRenderNotify(&RenderNotify, this);
+}
+
+audio_toolbox::RenderNotifyDispatcher::RenderNotifyDispatcher(AudioUnit audioUnit) : audioUnit_{audioUnit} {
+    const auto result = AudioUnitAddRenderNotify(audioUnit_, &RenderNotify, this);
+    ThrowIfAudioUnitError(result, "AudioUnitAddRenderNotify");
+}
+
+audio_toolbox::RenderNotifyDispatcher::~RenderNotifyDispatcher() noexcept {
+    if (graph_) {
+        try {
+            graph_->RemoveRenderNotify(&RenderNotify, this);
+        } catch (...) {
+        }
+    } else {
+        AudioUnitRemoveRenderNotify(audioUnit_, &RenderNotify, this);
+    }
+
+    Publish(nullptr);
+}
+
+audio_toolbox::RenderNotifyDispatcher::ObserverID
+audio_toolbox::RenderNotifyDispatcher::AddObserver(Observer observer, AudioUnitRenderActionFlags phases) {
+    if (!observer) {
+        throw std::invalid_argument("observer must not be empty");
+    }
+    if ((phases & kAllPhases) == 0) {
+        throw std::invalid_argument("phases must include kAudioUnitRenderAction_PreRender or "
+                                    "kAudioUnitRenderAction_PostRender");
+    }
+
+    std::lock_guard lock{mutex_};
+
+    auto list = std::make_unique<ObserverList>();
+    if (const auto *current = observers_.load(std::memory_order_relaxed); current) {
+        list->entries_.reserve(current->entries_.size() + 1);
+        list->entries_ = current->entries_;
+    }
+    const auto observerID = nextObserverID_++;
+    list->entries_.push_back({observerID, phases & kAllPhases, std::move(observer)});
+
+    Publish(list.release());
+    return observerID;
+}
+
+bool audio_toolbox::RenderNotifyDispatcher::RemoveObserver(ObserverID observerID) {
+    std::lock_guard lock{mutex_};
+
+    const auto *current = observers_.load(std::memory_order_relaxed);
+    if (!current) {
+        return false;
+    }
+
+    const auto matches = [observerID](const auto &entry) { return entry.observerID_ == observerID; };
+    if (std::none_of(current->entries_.begin(), current->entries_.end(), matches)) {
+        return false;
+    }
+
+    std::unique_ptr<ObserverList> list;
+    if (current->entries_.size() > 1) {
+        list = std::make_unique<ObserverList>();
+        list->entries_.reserve(current->entries_.size() - 1);
+        std::copy_if(current->entries_.begin(), current->entries_.end(), std::back_inserter(list->entries_),
+                     [&matches](const auto &entry) { return !matches(entry); });
+    }
+
+    Publish(list.release());
+    return true;
+}
+
+OSStatus audio_toolbox::RenderNotifyDispatcher::RenderNotify(void *inRefCon,
+                                                            AudioUnitRenderActionFlags *ioActionFlags,
+                                                            const AudioTimeStamp *inTimeStamp, UInt32 inBusNumber,
+                                                            UInt32 inNumberFrames,
+                                                            AudioBufferList *_Nullable ioData) noexcept {
+    auto *dispatcher = static_cast<RenderNotifyDispatcher *>(inRefCon);
+    const auto actionFlags = *ioActionFlags;
+
+    // Register as a reader in the current epoch before loading the list so Publish() cannot free it while in use
+    auto &readers = dispatcher->readers_[dispatcher->epoch_.load() & 1];
+    readers.fetch_add(1);
+
+    if (const auto *list = dispatcher->observers_.load(); list) {
+        for (const auto &entry : list->entries_) {
+            if (actionFlags & entry.phases_) {
+                entry.observer_(actionFlags, *inTimeStamp, inBusNumber, inNumberFrames, ioData);
+            }
+        }
+    }
+
+    readers.fetch_sub(1, std::memory_order_release);
+    return noErr;
+}
+
+void audio_toolbox::RenderNotifyDispatcher::Publish(ObserverList *list) noexcept {
+    const auto *previous = observers_.exchange(list);
+    observerCount_.store(list ? list->entries_.size() : 0, std::memory_order_relaxed);
+
+    // A render call may hold the previous list only if it registered as a reader before the exchange, in either
+    // epoch. Each epoch's count is awaited after switching new render calls to the other epoch so it cannot be
+    // starved by render calls that began afterward. The counts are loaded sequentially consistent, like the exchange
+    // and the registration, so a render call whose registration is not observed here must load the new list.
+    for (auto i = 0; i < 2; ++i) {
+        const auto epoch = epoch_.fetch_add(1) & 1;
+        while (readers_[epoch].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    delete previous;
+}
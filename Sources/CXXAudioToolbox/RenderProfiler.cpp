@@ -0,0 +1,192 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/RenderProfiler.hpp"
+
+#include "RenderCycleTimer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/// Returns the nodes of a graph that have an Audio Unit.
+std::vector<AUNode> NodesWithAudioUnits(const audio_toolbox::CAAUGraph &graph) {
+    std::vector<AUNode> nodes;
+    for (const auto node : graph.Snapshot()->Nodes()) {
+        AudioUnit au = nullptr;
+        graph.NodeInfo(node, nullptr, &au);
+        if (au) {
+            nodes.push_back(node);
+        }
+    }
+    return nodes;
+}
+
+} /* namespace */
+
+audio_toolbox::RenderProfiler::RenderProfiler(CAAUGraph &graph, Float64 sampleRate)
+    : RenderProfiler(graph, NodesWithAudioUnits(graph), sampleRate) {}
+
+audio_toolbox::RenderProfiler::RenderProfiler(CAAUGraph &graph, const std::vector<AUNode> &nodes, Float64 sampleRate)
+    : sampleRate_{sampleRate} {
+    if (!(sampleRate_ > 0)) {
+        throw std::invalid_argument("sampleRate must be positive");
+    }
+
+    nodes_ = nodes;
+    std::sort(nodes_.begin(), nodes_.end());
+    nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+
+    std::vector<AudioUnit> audioUnits;
+    audioUnits.reserve(nodes_.size());
+    for (const auto node : nodes_) {
+        AudioUnit au = nullptr;
+        graph.NodeInfo(node, nullptr, &au);
+        if (!au) {
+            throw std::invalid_argument("Node has no Audio Unit");
+        }
+        audioUnits.push_back(au);
+    }
+    timer_ = std::make_unique<detail::RenderCycleTimer>(nodes_.size());
+
+    try {
+        // The graph's notification is added first so its pre-render notification precedes that of the head node
+        graphDispatcher_ = std::make_unique<RenderNotifyDispatcher>(graph);
+        graphDispatcher_->AddObserver([this](AudioUnitRenderActionFlags inActionFlags, const AudioTimeStamp &,
+                                             UInt32, UInt32 inNumberFrames, AudioBufferList *_Nullable) {
+            const auto now = detail::RenderCycleTimer::Clock::now();
+            if (inActionFlags & kAudioUnitRenderAction_PreRender) {
+                const auto deadline = std::chrono::duration_cast<detail::RenderCycleTimer::Clock::duration>(
+                        std::chrono::duration<Float64>{inNumberFrames / sampleRate_});
+                timer_->BeginCycle(deadline, now);
+            } else {
+                timer_->EndCycle(now);
+            }
+        });
+
+        nodeDispatchers_.reserve(nodes_.size());
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            nodeDispatchers_.push_back(std::make_unique<RenderNotifyDispatcher>(audioUnits[i]));
+            nodeDispatchers_.back()->AddObserver([this, i](AudioUnitRenderActionFlags inActionFlags,
+                                                           const AudioTimeStamp &, UInt32, UInt32,
+                                                           AudioBufferList *_Nullable) {
+                const auto now = detail::RenderCycleTimer::Clock::now();
+                if (inActionFlags & kAudioUnitRenderAction_PreRender) {
+                    timer_->BeginNode(i, now);
+                } else {
+                    timer_->EndNode(i, now);
+                }
+            });
+        }
+    } catch (...) {
+        graphDispatcher_.reset();
+        nodeDispatchers_.clear();
+        throw;
+    }
+}
+
+audio_toolbox::RenderProfiler::~RenderProfiler() noexcept {
+    try {
+        Stop();
+    } catch (...) {
+    }
+
+    // Remove the notifications before the state they use is destroyed
+    graphDispatcher_.reset();
+    nodeDispatchers_.clear();
+}
+
+audio_toolbox::RenderProfiler::Report audio_toolbox::RenderProfiler::GetReport() const {
+    Report report;
+    report.cycleTime_ = timer_->CycleTime().GetSnapshot();
+    report.deadlineMisses_ = timer_->DeadlineMisses();
+
+    report.nodes_.reserve(nodes_.size());
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        const auto &statistics = timer_->Node(i);
+        NodeReport nodeReport;
+        nodeReport.node_ = nodes_[i];
+        nodeReport.renderTime_ = statistics.renderTime_.GetSnapshot();
+        nodeReport.slowestCycles_ = statistics.slowestCycles_.load(std::memory_order_relaxed);
+        nodeReport.slowestMissedCycles_ = statistics.slowestMissedCycles_.load(std::memory_order_relaxed);
+        report.nodes_.push_back(std::move(nodeReport));
+    }
+
+    const auto mostOften = [&report](auto member) -> std::optional<AUNode> {
+        const auto it = std::max_element(report.nodes_.begin(), report.nodes_.end(),
+                                         [member](const auto &a, const auto &b) { return a.*member < b.*member; });
+        if (it == report.nodes_.end() || (*it).*member == 0) {
+            return std::nullopt;
+        }
+        return it->node_;
+    };
+    report.slowestNode_ = mostOften(&NodeReport::slowestMissedCycles_);
+    if (!report.slowestNode_) {
+        report.slowestNode_ = mostOften(&NodeReport::slowestCycles_);
+    }
+
+    if (const auto index = timer_->LastMissSlowestNode(); index) {
+        report.lastMissSlowestNode_ = nodes_[*index];
+    }
+
+    return report;
+}
+
+void audio_toolbox::RenderProfiler::Start(Reporter reporter, std::chrono::milliseconds interval) {
+    if (!reporter) {
+        throw std::invalid_argument("reporter must not be empty");
+    }
+
+    Stop();
+
+    reporter_ = std::move(reporter);
+    interval_ = interval;
+    reporterThread_ = std::thread(&RenderProfiler::ReporterThreadEntry, this);
+}
+
+void audio_toolbox::RenderProfiler::Stop() {
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = true;
+    }
+    stopCondition_.notify_all();
+
+    if (reporterThread_.joinable()) {
+        reporterThread_.join();
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = false;
+        error = std::exchange(error_, nullptr);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void audio_toolbox::RenderProfiler::ReporterThreadEntry() noexcept {
+    for (;;) {
+        {
+            std::unique_lock lock{mutex_};
+            if (stopCondition_.wait_for(lock, interval_, [this] { return stopRequested_; })) {
+                break;
+            }
+        }
+
+        try {
+            reporter_(GetReport());
+        } catch (...) {
+            std::lock_guard lock{mutex_};
+            error_ = std::current_exception();
+            break;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/TimingHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+std::chrono::nanoseconds audio_toolbox::TimingHistogram::Snapshot::ValueAtPercentile(double percentile) const noexcept {
+    if (count_ == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+
+    const auto fraction = percentile > 0 ? std::min(percentile, 100.0) / 100 : 0.0;
+    const auto rank =
+            std::max(std::uint64_t{1}, static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(count_))));
+
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        cumulative += counts_[i];
+        if (cumulative >= rank) {
+            return std::chrono::nanoseconds{std::min(BucketUpperBound(i), max_)};
+        }
+    }
+    return std::chrono::nanoseconds{max_};
+}
+
+audio_toolbox::TimingHistogram::Snapshot audio_toolbox::TimingHistogram::GetSnapshot() const {
+    Snapshot snapshot;
+    snapshot.counts_.resize(kBucketCount);
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        snapshot.counts_[i] = counts_[i].load(std::memory_order_relaxed);
+        snapshot.count_ += snapshot.counts_[i];
+    }
+    snapshot.sum_ = sum_.load(std::memory_order_relaxed);
+    snapshot.max_ = max_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+std::uint64_t audio_toolbox::TimingHistogram::BucketUpperBound(std::size_t index) noexcept {
+    constexpr auto subBucketCount = std::uint64_t{1} << kSubBucketBits;
+    if (index < subBucketCount) {
+        return index;
+    }
+    if (index >= kBucketCount - 1) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+
+    const auto shift = (index >> kSubBucketBits) - 1;
+    const auto subBucket = (index & (subBucketCount - 1)) + subBucketCount;
+    return ((subBucket + 1) << shift) - 1;
+}
@@ -0,0 +1,215 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "audio_toolbox/TranscodeEngine.hpp"
+#include "audio_toolbox/CAExtAudioFile.hpp"
+
+#include "WorkStealingPool.hpp"
+
+#include <cstdio>
+#include <system_error>
+#include <thread>
+
+namespace {
+
+#if TARGET_OS_IPHONE
+/// The time to wait before writing again when the codec is unavailable.
+constexpr std::chrono::milliseconds kCodecUnavailableRetryInterval{10};
+#endif /* TARGET_OS_IPHONE */
+
+/// Deleter for CoreFoundation objects.
+struct CFReleaser {
+    void operator()(CFTypeRef cf) const noexcept { CFRelease(cf); }
+};
+
+using URL = std::unique_ptr<const __CFURL, CFReleaser>;
+
+/// Returns a file URL for path.
+URL CreateURL(const std::string &path) {
+    URL url{CFURLCreateFromFileSystemRepresentation(kCFAllocatorDefault, reinterpret_cast<const UInt8 *>(path.c_str()),
+                                                    static_cast<CFIndex>(path.size()), false)};
+    if (!url) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                "CFURLCreateFromFileSystemRepresentation");
+    }
+    return url;
+}
+
+/// Returns interleaved native float samples with the sample rate and channel count of format.
+AudioStreamBasicDescription ClientFormatFor(const AudioStreamBasicDescription &format) noexcept {
+    AudioStreamBasicDescription clientFormat{};
+    clientFormat.mSampleRate = format.mSampleRate;
+    clientFormat.mFormatID = kAudioFormatLinearPCM;
+    clientFormat.mFormatFlags = kAudioFormatFlagsNativeFloatPacked;
+    clientFormat.mBitsPerChannel = 32;
+    clientFormat.mChannelsPerFrame = format.mChannelsPerFrame;
+    clientFormat.mFramesPerPacket = 1;
+    clientFormat.mBytesPerFrame = 4 * format.mChannelsPerFrame;
+    clientFormat.mBytesPerPacket = clientFormat.mBytesPerFrame;
+    return clientFormat;
+}
+
+} /* namespace */
+
+audio_toolbox::TranscodeEngine::TranscodeEngine(unsigned threadCount, UInt32 bufferFrames)
+    : pool_{std::make_unique<detail::WorkStealingPool>(threadCount)}, bufferFrames_{bufferFrames ? bufferFrames : 4096},
+      buffers_(pool_->ThreadCount()) {}
+
+audio_toolbox::TranscodeEngine::~TranscodeEngine() noexcept = default;
+
+unsigned audio_toolbox::TranscodeEngine::ThreadCount() const noexcept { return pool_->ThreadCount(); }
+
+std::vector<audio_toolbox::TranscodeEngine::Result>
+audio_toolbox::TranscodeEngine::Transcode(const std::vector<Job> &jobs, const ProgressCallback &progressCallback) {
+    std::lock_guard lock{transcodeMutex_};
+
+    std::vector<Result> results(jobs.size());
+
+    jobCount_.store(jobs.size(), std::memory_order_relaxed);
+    jobsFinished_.store(0, std::memory_order_relaxed);
+    jobsFailed_.store(0, std::memory_order_relaxed);
+    framesTranscoded_.store(0, std::memory_order_relaxed);
+    finishTime_.store(0, std::memory_order_relaxed);
+    startTime_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+
+    // The tasks refer to jobs, results, and progressCallback, so submitted tasks must finish before returning
+    try {
+        for (std::size_t i = 0; i < jobs.size(); ++i) {
+            pool_->Submit([this, &jobs, &results, &progressCallback, i](unsigned worker) {
+                auto &result = results[i];
+                const auto start = Clock::now();
+                try {
+                    if (cancelRequested_.load(std::memory_order_relaxed)) {
+                        throw std::system_error(std::make_error_code(std::errc::operation_canceled), "TranscodeEngine");
+                    }
+                    result.framesTranscoded_ = TranscodeFile(jobs[i], buffers_[worker]);
+                } catch (...) {
+                    result.error_ = std::current_exception();
+                    jobsFailed_.fetch_add(1, std::memory_order_relaxed);
+                }
+                result.elapsed_ = Clock::now() - start;
+                jobsFinished_.fetch_add(1, std::memory_order_relaxed);
+
+                if (progressCallback) {
+                    std::lock_guard callbackLock{callbackMutex_};
+                    try {
+                        progressCallback(GetProgress(), i, result);
+                    } catch (...) {
+                    }
+                }
+            });
+        }
+    } catch (...) {
+        pool_->Wait();
+        finishTime_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        cancelRequested_.store(false, std::memory_order_relaxed);
+        throw;
+    }
+
+    pool_->Wait();
+    finishTime_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+
+    // A request is cleared only once the call it applied to has finished, so a request made as the call started is
+    // not lost
+    cancelRequested_.store(false, std::memory_order_relaxed);
+
+    return results;
+}
+
+audio_toolbox::TranscodeEngine::Progress audio_toolbox::TranscodeEngine::GetProgress() const noexcept {
+    Progress progress;
+    progress.jobCount_ = jobCount_.load(std::memory_order_relaxed);
+    progress.jobsFinished_ = jobsFinished_.load(std::memory_order_relaxed);
+    progress.jobsFailed_ = jobsFailed_.load(std::memory_order_relaxed);
+    progress.framesTranscoded_ = framesTranscoded_.load(std::memory_order_relaxed);
+
+    const auto start = startTime_.load(std::memory_order_relaxed);
+    auto finish = finishTime_.load(std::memory_order_relaxed);
+    if (start != 0) {
+        if (finish == 0) {
+            finish = Clock::now().time_since_epoch().count();
+        }
+        progress.elapsed_ = Clock::duration{finish - start};
+    }
+
+    return progress;
+}
+
+SInt64 audio_toolbox::TranscodeEngine::TranscodeFile(const Job &job, std::vector<float> &buffer) {
+    const auto sourceURL = CreateURL(job.sourcePath_);
+    const auto destinationURL = CreateURL(job.destinationPath_);
+
+    CAExtAudioFile source;
+    source.OpenURL(sourceURL.get());
+
+    const auto sourceFormat = source.FileDataFormat();
+    const auto clientFormat = ClientFormatFor(sourceFormat);
+    source.SetClientDataFormat(clientFormat);
+
+    CAExtAudioFile destination;
+    destination.CreateWithURL(destinationURL.get(), job.fileType_, job.format_,
+                              job.channelLayout_ ? job.channelLayout_.get() : nullptr, kAudioFileFlags_EraseFile);
+
+    SInt64 framesTranscoded = 0;
+    try {
+        // The source channel layout lets the destination's converter map channels when the counts differ
+        const auto sourceChannelLayout = source.FileChannelLayout();
+        const auto remapChannels =
+                sourceChannelLayout && job.format_.mChannelsPerFrame != clientFormat.mChannelsPerFrame;
+        destination.SetClientDataFormat(clientFormat, remapChannels ? sourceChannelLayout.get() : nullptr);
+
+        // The worker's buffer grows to the largest frame size it has seen and is then reused
+        const auto sampleCount = static_cast<std::size_t>(bufferFrames_) * clientFormat.mChannelsPerFrame;
+        if (buffer.size() < sampleCount) {
+            buffer.resize(sampleCount);
+        }
+
+        for (;;) {
+            if (cancelRequested_.load(std::memory_order_relaxed)) {
+                throw std::system_error(std::make_error_code(std::errc::operation_canceled), "TranscodeEngine");
+            }
+
+            AudioBufferList bufferList;
+            bufferList.mNumberBuffers = 1;
+            bufferList.mBuffers[0].mNumberChannels = clientFormat.mChannelsPerFrame;
+            bufferList.mBuffers[0].mDataByteSize = bufferFrames_ * clientFormat.mBytesPerFrame;
+            bufferList.mBuffers[0].mData = buffer.data();
+
+            auto frameCount = bufferFrames_;
+            source.Read(frameCount, &bufferList);
+            if (frameCount == 0) {
+                break;
+            }
+
+#if TARGET_OS_IPHONE
+            // Write throws on errors and returns the codec unavailable statuses, which are not errors. Consumed input
+            // was written, and input not consumed is written again once the codec is available unless the job is
+            // canceled.
+            while (destination.Write(frameCount, &bufferList) == kExtAudioFileError_CodecUnavailableInputNotConsumed) {
+                if (cancelRequested_.load(std::memory_order_relaxed)) {
+                    throw std::system_error(std::make_error_code(std::errc::operation_canceled), "TranscodeEngine");
+                }
+                std::this_thread::sleep_for(kCodecUnavailableRetryInterval);
+            }
+#else
+            destination.Write(frameCount, &bufferList);
+#endif /* TARGET_OS_IPHONE */
+
+            framesTranscoded += frameCount;
+            framesTranscoded_.fetch_add(frameCount, std::memory_order_relaxed);
+        }
+
+        // Disposing flushes the destination so errors are reported here
+        destination.Dispose();
+    } catch (...) {
+        destination.reset();
+        std::remove(job.destinationPath_.c_str());
+        throw;
+    }
+
+    return framesTranscoded;
+}
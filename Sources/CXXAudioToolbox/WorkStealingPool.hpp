@@ -0,0 +1,241 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace audio_toolbox {
+namespace detail {
+
+/// A fixed-size thread pool in which idle workers steal tasks queued for other workers.
+///
+/// Each worker takes tasks from the back of its own queue and, when that is empty, from the front of the other
+/// workers' queues. Tasks are distributed across the queues round-robin as they are submitted. Submitting, taking,
+/// and completing a task lock only the queue involved; the pool-wide mutex is used only to put idle workers to sleep,
+/// to wake them when tasks are submitted while they sleep, and by Wait().
+class WorkStealingPool final {
+  public:
+    /// A task receiving the index of the worker executing it.
+    ///
+    /// Tasks must report their own errors; an exception escaping a task is discarded.
+    using Task = std::function<void(unsigned worker)>;
+
+    /// Creates a pool with threadCount workers, or one per hardware thread if threadCount is 0.
+    /// @throw std::system_error.
+    explicit WorkStealingPool(unsigned threadCount = 0);
+
+    // This class is non-copyable
+    WorkStealingPool(const WorkStealingPool &) = delete;
+
+    // This class is non-assignable
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /// Completes all submitted tasks and stops the workers.
+    ~WorkStealingPool() noexcept;
+
+    /// Returns the number of workers.
+    [[nodiscard]] unsigned ThreadCount() const noexcept;
+
+    /// Queues a task for execution.
+    /// @throw std::bad_alloc.
+    void Submit(Task task);
+
+    /// Waits until all submitted tasks have completed.
+    void Wait() noexcept;
+
+  private:
+    /// A worker's task queue.
+    struct alignas(64) Queue {
+        /// Protects tasks_.
+        std::mutex mutex_;
+        /// Queued tasks.
+        std::deque<Task> tasks_;
+    };
+
+    /// Claims one of the queued tasks if there are any.
+    bool TryClaim() noexcept;
+
+    /// Takes a task from the worker's own queue or steals one from another worker.
+    bool TryTake(unsigned worker, Task &task);
+
+    /// Marks a task as completed.
+    void Complete() noexcept;
+
+    /// Executes tasks until the pool is destroyed.
+    void WorkerThreadEntry(unsigned worker) noexcept;
+
+    /// The per-worker task queues.
+    std::vector<std::unique_ptr<Queue>> queues_;
+    /// The workers.
+    std::vector<std::thread> workers_;
+
+    /// The number of queued tasks not yet claimed by a worker.
+    alignas(64) std::atomic_size_t queued_{0};
+    /// The number of tasks submitted but not completed.
+    std::atomic_size_t pending_{0};
+    /// The number of workers sleeping or about to sleep.
+    std::atomic_size_t sleeping_{0};
+    /// The queue receiving the next submitted task.
+    std::atomic_size_t nextQueue_{0};
+
+    /// Serializes sleeping and waking.
+    alignas(64) std::mutex mutex_;
+    /// Signaled when a task is queued while workers sleep or the workers should stop.
+    std::condition_variable workCondition_;
+    /// Signaled when all submitted tasks have completed.
+    std::condition_variable idleCondition_;
+    /// True if the workers should stop once the queues are empty.
+    bool stopRequested_{false};
+};
+
+// MARK: - Implementation -
+
+inline WorkStealingPool::WorkStealingPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    queues_.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    workers_.reserve(threadCount);
+    try {
+        for (unsigned i = 0; i < threadCount; ++i) {
+            workers_.emplace_back(&WorkStealingPool::WorkerThreadEntry, this, i);
+        }
+    } catch (...) {
+        {
+            std::lock_guard lock{mutex_};
+            stopRequested_ = true;
+        }
+        workCondition_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+        throw;
+    }
+}
+
+inline WorkStealingPool::~WorkStealingPool() noexcept {
+    {
+        std::lock_guard lock{mutex_};
+        stopRequested_ = true;
+    }
+    workCondition_.notify_all();
+
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+inline unsigned WorkStealingPool::ThreadCount() const noexcept { return static_cast<unsigned>(workers_.size()); }
+
+inline void WorkStealingPool::Submit(Task task) {
+    // The task is pending before it is visible so Wait() cannot return while it runs
+    pending_.fetch_add(1);
+    try {
+        auto &queue = *queues_[nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size()];
+        std::lock_guard queueLock{queue.mutex_};
+        queue.tasks_.push_back(std::move(task));
+    } catch (...) {
+        Complete();
+        throw;
+    }
+
+    // A worker increments sleeping_ before checking queued_, so one of the two sees the other's increment
+    queued_.fetch_add(1);
+    if (sleeping_.load() > 0) {
+        std::lock_guard lock{mutex_};
+        workCondition_.notify_one();
+    }
+}
+
+inline void WorkStealingPool::Wait() noexcept {
+    std::unique_lock lock{mutex_};
+    idleCondition_.wait(lock, [this] { return pending_.load() == 0; });
+}
+
+inline bool WorkStealingPool::TryClaim() noexcept {
+    auto queued = queued_.load();
+    while (queued > 0) {
+        if (queued_.compare_exchange_weak(queued, queued - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool WorkStealingPool::TryTake(unsigned worker, Task &task) {
+    const auto queueCount = queues_.size();
+    for (std::size_t i = 0; i < queueCount; ++i) {
+        auto &queue = *queues_[(worker + i) % queueCount];
+        std::lock_guard queueLock{queue.mutex_};
+        if (queue.tasks_.empty()) {
+            continue;
+        }
+        // The owner works from the back and thieves from the front
+        if (i == 0) {
+            task = std::move(queue.tasks_.back());
+            queue.tasks_.pop_back();
+        } else {
+            task = std::move(queue.tasks_.front());
+            queue.tasks_.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+inline void WorkStealingPool::Complete() noexcept {
+    if (pending_.fetch_sub(1) == 1) {
+        std::lock_guard lock{mutex_};
+        idleCondition_.notify_all();
+    }
+}
+
+inline void WorkStealingPool::WorkerThreadEntry(unsigned worker) noexcept {
+    for (;;) {
+        if (TryClaim()) {
+            // A claimed task is in some queue, although a scan may miss it while other workers take theirs
+            Task task;
+            while (!TryTake(worker, task)) {
+                std::this_thread::yield();
+            }
+
+            try {
+                task(worker);
+            } catch (...) {
+            }
+
+            Complete();
+            continue;
+        }
+
+        std::unique_lock lock{mutex_};
+        sleeping_.fetch_add(1);
+        workCondition_.wait(lock, [this] { return stopRequested_ || queued_.load() > 0; });
+        sleeping_.fetch_sub(1);
+        if (stopRequested_ && queued_.load() == 0) {
+            break;
+        }
+    }
+}
+
+} /* namespace detail */
+} /* namespace audio_toolbox */
@@ -0,0 +1,84 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <core_audio/StreamDescription.hpp>
+
+#include <AudioToolbox/AudioFile.h>
+
+#include <memory>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A process-wide cache of AudioFile global information.
+///
+/// Each query is answered by the corresponding CAAudioFile function the first time it is made and from the cache
+/// thereafter. Cached reads are lock-free and do not allocate. No lock is held while CAAudioFile is queried, so
+/// concurrent first queries for the same information may each query it; all return the result cached first. Each
+/// table holds a bounded number of entries and evicts the oldest when full. The returned values are shared and remain
+/// valid while referenced, including after eviction or invalidation.
+class AudioFileInfoCache final {
+  public:
+    /// A shared list of file types.
+    using FileTypeList = std::shared_ptr<const std::vector<AudioFileTypeID>>;
+    /// A shared list of format IDs.
+    using FormatIDList = std::shared_ptr<const std::vector<AudioFormatID>>;
+    /// A shared list of stream descriptions.
+    using StreamDescriptionList = std::shared_ptr<const std::vector<core_audio::StreamDescription>>;
+
+    // This class cannot be instantiated
+    AudioFileInfoCache() = delete;
+
+    /// Returns the file types that can be opened for reading.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static FileTypeList ReadableTypes();
+
+    /// Returns the file types that can be opened for writing.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static FileTypeList WritableTypes();
+
+    /// Returns the supported formats for the fileType and formatID combination.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static StreamDescriptionList AvailableStreamDescriptions(AudioFileTypeID fileType,
+                                                                           AudioFormatID formatID);
+
+    /// Returns the format IDs supported by type.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static FormatIDList AvailableFormatIDs(AudioFileTypeID type);
+
+    /// Returns the file types that support mimeType.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static FileTypeList TypesForMIMEType(CFStringRef mimeType);
+
+    /// Returns the file types that support uti.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static FileTypeList TypesForUTI(CFStringRef uti);
+
+    /// Returns the file types that support extension.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static FileTypeList TypesForExtension(CFStringRef extension);
+
+    /// Discards all cached information so subsequent queries are answered by AudioFile.
+    ///
+    /// This is useful after audio file components are installed or removed.
+    static void Invalidate() noexcept;
+};
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,162 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AudioFormat.h>
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A least-recently-used cache of AudioFormat property values keyed by property ID and specifier.
+///
+/// The member functions have the same signatures as the functions in the CAAudioFormat namespace. Only properties
+/// whose values are plain data determined by the specifier are cached; other properties are passed through to
+/// AudioFormat. Specifiers containing pointers, such as the magic cookie in an AudioFormatInfo or the channel layouts
+/// for kAudioFormatProperty_ChannelMap, are keyed by the contents of the data they point to.
+///
+/// The cache is thread-safe.
+class AudioFormatPropertyCache final {
+  public:
+    /// Cache statistics.
+    struct Statistics {
+        /// The number of lookups satisfied by the cache.
+        UInt64 hits_{0};
+        /// The number of lookups requiring a call to AudioFormat.
+        UInt64 misses_{0};
+        /// The number of values evicted to stay within the capacity.
+        UInt64 evictions_{0};
+        /// The number of requests for properties that are not cached.
+        UInt64 bypasses_{0};
+        /// The number of bytes used by cached keys and values.
+        std::size_t size_{0};
+
+        /// Returns the fraction of lookups satisfied by the cache.
+        [[nodiscard]] double HitRate() const noexcept;
+    };
+
+    /// Returns the process-wide property cache.
+    [[nodiscard]] static AudioFormatPropertyCache &Shared();
+
+    /// Returns true if values of inPropertyID are cached.
+    [[nodiscard]] static bool IsCacheable(AudioFormatPropertyID inPropertyID) noexcept;
+
+    /// Creates a property cache holding at most capacity bytes of keys and values.
+    explicit AudioFormatPropertyCache(std::size_t capacity = 256 * 1024) noexcept;
+
+    // This class is non-copyable
+    AudioFormatPropertyCache(const AudioFormatPropertyCache &) = delete;
+
+    // This class is non-assignable
+    AudioFormatPropertyCache &operator=(const AudioFormatPropertyCache &) = delete;
+
+    /// Retrieves information about the given property.
+    ///
+    /// For cached properties whose value is not cached only the size is retrieved from AudioFormat, and the value is
+    /// not cached.
+    /// @param inPropertyID An AudioFormatPropertyID constant.
+    /// @param inSpecifierSize The size of the specifier data.
+    /// @param inSpecifier A specifier is a buffer of data used as an input argument to some of the properties.
+    /// @return The size in bytes of the current value of the property.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] UInt32 GetPropertyInfo(AudioFormatPropertyID inPropertyID, UInt32 inSpecifierSize,
+                                         const void *_Nullable inSpecifier);
+
+    /// Retrieves the indicated property data.
+    ///
+    /// For cached properties a buffer smaller than the value receives the leading portion of the value.
+    /// @param inPropertyID An AudioFormatPropertyID constant.
+    /// @param inSpecifierSize The size of the specifier data.
+    /// @param inSpecifier A specifier is a buffer of data used as an input argument to some of the properties.
+    /// @param ioPropertyDataSize On input the size of the outPropertyData buffer. On output the number of bytes written
+    /// to the buffer, or the size of the value if outPropertyData is null.
+    /// @param outPropertyData The buffer in which to write the property data.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void GetProperty(AudioFormatPropertyID inPropertyID, UInt32 inSpecifierSize, const void *_Nullable inSpecifier,
+                     UInt32 &ioPropertyDataSize, void *_Nullable outPropertyData);
+
+    /// Returns an array of format IDs that are valid output formats for a converter.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] std::vector<AudioFormatID> EncodeFormatIDs();
+
+    /// Returns an array of format IDs that are valid input formats for a converter.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] std::vector<AudioFormatID> DecodeFormatIDs();
+
+    /// Returns the cache statistics.
+    [[nodiscard]] Statistics GetStatistics() const;
+
+    /// Resets the hit, miss, eviction, and bypass counts.
+    void ResetStatistics();
+
+    /// Removes all cached values.
+    void Clear();
+
+  private:
+    /// A cached property value.
+    struct Entry {
+        /// The property ID and specifier contents.
+        std::string key_;
+        /// The property value.
+        std::vector<unsigned char> value_;
+    };
+
+    /// Returns the cached value for a property, retrieving it from AudioFormat if necessary.
+    /// @note lock must own mutex_. It is released while AudioFormat is queried and held on return.
+    const std::vector<unsigned char> &Lookup(AudioFormatPropertyID inPropertyID, UInt32 inSpecifierSize,
+                                             const void *_Nullable inSpecifier, std::unique_lock<std::mutex> &lock);
+
+    /// Returns the cached value for key and marks it most recently used, or nullptr if it is not cached.
+    /// @note mutex_ must be held.
+    const std::vector<unsigned char> *_Nullable Find(const std::string &key) noexcept;
+
+    /// Evicts least recently used entries until the cache is within its capacity.
+    void Trim() noexcept;
+
+    /// The maximum number of bytes of keys and values.
+    const std::size_t capacity_;
+
+    /// Protects the members below.
+    mutable std::mutex mutex_;
+    /// Cached entries in most recently used order.
+    std::list<Entry> entries_;
+    /// Maps keys to entries.
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    /// The number of bytes used by keys and values.
+    std::size_t size_{0};
+    /// The number of lookups satisfied by the cache.
+    UInt64 hits_{0};
+    /// The number of lookups requiring a call to AudioFormat.
+    UInt64 misses_{0};
+    /// The number of values evicted.
+    UInt64 evictions_{0};
+    /// The number of requests for properties that are not cached.
+    UInt64 bypasses_{0};
+};
+
+// MARK: - Implementation -
+
+inline double AudioFormatPropertyCache::Statistics::HitRate() const noexcept {
+    const auto lookups = hits_ + misses_;
+    return lookups ? static_cast<double>(hits_) / static_cast<double>(lookups) : 0;
+}
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
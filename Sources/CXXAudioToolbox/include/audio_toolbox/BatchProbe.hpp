@@ -0,0 +1,91 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <core_audio/ChannelLayout.hpp>
+#include <core_audio/StreamDescription.hpp>
+
+#include <AudioToolbox/AudioFile.h>
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+namespace detail {
+class WorkStealingPool;
+} /* namespace detail */
+
+/// A parallel audio file metadata reader.
+///
+/// Files are opened and queried on a work-stealing thread pool that persists for the lifetime of the probe.
+class BatchProbe final {
+  public:
+    /// Metadata for an audio file.
+    struct Result {
+        /// The file's data format.
+        core_audio::StreamDescription dataFormat_;
+        /// The file's channel layout, which may be empty.
+        core_audio::ChannelLayout channelLayout_;
+        /// The length of the file in audio frames.
+        SInt64 frameLength_{0};
+        /// The file's type.
+        AudioFileTypeID fileFormat_{0};
+        /// The exception thrown while probing the file, or nullptr on success.
+        std::exception_ptr error_;
+
+        /// Returns true if the file was probed successfully.
+        [[nodiscard]] explicit operator bool() const noexcept;
+    };
+
+    /// Creates a batch probe using threadCount threads, or one per hardware thread if threadCount is 0.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    explicit BatchProbe(unsigned threadCount = 0);
+
+    // This class is non-copyable
+    BatchProbe(const BatchProbe &) = delete;
+
+    // This class is non-assignable
+    BatchProbe &operator=(const BatchProbe &) = delete;
+
+    /// Stops the threads and releases all associated resources.
+    ~BatchProbe() noexcept;
+
+    /// Returns the number of threads used for probing.
+    [[nodiscard]] unsigned ThreadCount() const noexcept;
+
+    /// Reads the data format, channel layout, frame length, and file type of each file.
+    ///
+    /// Errors are captured in the corresponding result and do not affect other files.
+    /// @param paths The files to probe.
+    /// @return The metadata for each file in the order of paths.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] std::vector<Result> Probe(const std::vector<std::string> &paths);
+
+    /// Reads the data format, channel layout, frame length, and file type of an audio file.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static Result ProbeFile(CFURLRef inURL);
+
+  private:
+    /// The thread pool.
+    std::unique_ptr<detail::WorkStealingPool> pool_;
+};
+
+// MARK: - Implementation -
+
+inline BatchProbe::Result::operator bool() const noexcept { return !error_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
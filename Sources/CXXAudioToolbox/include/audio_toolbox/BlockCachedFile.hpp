@@ -0,0 +1,239 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAudioFile.hpp>
+
+#include <AudioToolbox/AudioFile.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A read-only file with a block cache and background read-ahead, usable as an AudioFile data source.
+///
+/// Reads are served from a small cache of fixed-size blocks. Adjacent missing blocks are read with a single positional
+/// read, and sequential access schedules the following blocks to be read by a pool of worker threads.
+class BlockCachedFile final {
+  public:
+    /// Configuration for a block-cached file.
+    struct Configuration {
+        /// The size of a cache block in bytes.
+        UInt32 blockSize_{64 * 1024};
+        /// The number of blocks in the cache.
+        UInt32 blockCount_{64};
+        /// The number of blocks read ahead of sequential access.
+        UInt32 prefetchBlockCount_{8};
+        /// The number of worker threads performing read-ahead.
+        UInt32 workerCount_{2};
+    };
+
+    /// I/O statistics.
+    struct Statistics {
+        /// The number of read system calls made.
+        UInt64 readCalls_{0};
+        /// The number of bytes read from the file.
+        UInt64 bytesRead_{0};
+        /// The number of bytes requested by clients.
+        UInt64 bytesRequested_{0};
+        /// The number of block lookups satisfied by the cache.
+        UInt64 cacheHits_{0};
+        /// The number of block lookups requiring a read.
+        UInt64 cacheMisses_{0};
+        /// The number of blocks read ahead.
+        UInt64 prefetchedBlocks_{0};
+
+        /// Returns the fraction of block lookups satisfied by the cache.
+        [[nodiscard]] double HitRate() const noexcept;
+    };
+
+    /// Creates a block-cached file with the default configuration.
+    BlockCachedFile();
+
+    /// Creates a block-cached file.
+    /// @throw std::invalid_argument.
+    explicit BlockCachedFile(const Configuration &configuration);
+
+    // This class is non-copyable
+    BlockCachedFile(const BlockCachedFile &) = delete;
+
+    // This class is non-assignable
+    BlockCachedFile &operator=(const BlockCachedFile &) = delete;
+
+    /// Closes the file and releases all associated resources.
+    ~BlockCachedFile() noexcept;
+
+    /// Returns true if a file is open.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Opens the file at path for reading.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void Open(const char *path);
+
+    /// Opens the file specified by a CFURLRef for reading.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void Open(CFURLRef inURL);
+
+    /// Closes the file and empties the cache.
+    void Close() noexcept;
+
+    /// Returns the size of the file in bytes.
+    [[nodiscard]] SInt64 Size() const noexcept;
+
+    /// Reads bytes from the file.
+    /// @param inPosition The offset of the first byte to read.
+    /// @param inByteCount The number of bytes to read.
+    /// @param outBuffer A buffer of at least inByteCount bytes.
+    /// @return The number of bytes read, which is less than inByteCount at end of file.
+    /// @throw std::system_error.
+    std::size_t Read(SInt64 inPosition, std::size_t inByteCount, void *outBuffer);
+
+    /// Opens an audio file reading through the cache.
+    /// @note The cached file must outlive audioFile.
+    /// @throw std::system_error.
+    void OpenAudioFile(CAAudioFile &audioFile, AudioFileTypeID inFileTypeHint = 0);
+
+    /// Returns the I/O statistics.
+    [[nodiscard]] Statistics GetStatistics() const noexcept;
+
+    /// Resets the I/O statistics.
+    void ResetStatistics() noexcept;
+
+    /// An AudioFile_ReadProc reading from a BlockCachedFile passed as inClientData.
+    static OSStatus ReadProc(void *inClientData, SInt64 inPosition, UInt32 requestCount, void *buffer,
+                             UInt32 *actualCount) noexcept;
+
+    /// An AudioFile_GetSizeProc for a BlockCachedFile passed as inClientData.
+    static SInt64 GetSizeProc(void *inClientData) noexcept;
+
+  private:
+    /// The index marking the end of the eviction list.
+    static constexpr UInt32 kNoSlot = UINT32_MAX;
+
+    /// A cache slot.
+    struct Slot {
+        /// The block held by the slot, or -1 if empty.
+        SInt64 block_{-1};
+        /// The number of valid bytes in the block.
+        UInt32 length_{0};
+        /// True if the block is being read.
+        bool loading_{false};
+        /// The number of clients copying from the block.
+        UInt32 readers_{0};
+        /// The next less recently used slot in the eviction list.
+        UInt32 previous_{kNoSlot};
+        /// The next more recently used slot in the eviction list.
+        UInt32 next_{kNoSlot};
+    };
+
+    /// Claims slots for a run of consecutive uncached blocks starting at firstBlock and marks them loading.
+    /// @return The claimed slot indexes.
+    std::vector<UInt32> ClaimRun(SInt64 firstBlock, UInt32 maximumCount);
+
+    /// Reads blocks into claimed slots and marks them ready or empty.
+    /// @return 0 on success or an errno value.
+    int LoadRun(SInt64 firstBlock, const std::vector<UInt32> &slots) noexcept;
+
+    /// Returns the slot holding block or nullptr.
+    Slot *_Nullable FindSlot(SInt64 block) noexcept;
+
+    /// Empties all slots and places them in the eviction list.
+    void ResetSlots() noexcept;
+
+    /// Removes a slot from the eviction list.
+    void Unlink(UInt32 index) noexcept;
+
+    /// Appends a slot to the eviction list as the most recently used.
+    void LinkMostRecent(UInt32 index) noexcept;
+
+    /// Prepends a slot to the eviction list as the least recently used.
+    void LinkLeastRecent(UInt32 index) noexcept;
+
+    /// Performs read-ahead requests.
+    void WorkerThreadEntry() noexcept;
+
+    /// Stops the worker threads.
+    void StopWorkers() noexcept;
+
+    /// The cache configuration.
+    const Configuration configuration_;
+    /// The file descriptor, or -1 if closed.
+    int fd_{-1};
+    /// The size of the file in bytes.
+    SInt64 size_{0};
+
+    /// Block storage.
+    std::unique_ptr<unsigned char[]> arena_;
+    /// Cache slots.
+    std::vector<Slot> slots_;
+    /// Maps block numbers to slot indexes.
+    std::unordered_map<SInt64, UInt32> blockToSlot_;
+    /// The least recently used slot that may be evicted, or kNoSlot.
+    ///
+    /// Slots that are loading or being copied from are not in the eviction list.
+    UInt32 leastRecentlyUsed_{kNoSlot};
+    /// The most recently used slot that may be evicted, or kNoSlot.
+    UInt32 mostRecentlyUsed_{kNoSlot};
+    /// The position following the last client read, used to detect sequential access.
+    SInt64 nextSequentialPosition_{-1};
+
+    /// Protects the cache and the request queue.
+    std::mutex mutex_;
+    /// Signaled when a block finishes loading.
+    std::condition_variable loadedCondition_;
+    /// Signaled when read-ahead is requested or the workers should stop.
+    std::condition_variable workCondition_;
+    /// Pending read-ahead requests as a first block and its claimed slots.
+    std::deque<std::pair<SInt64, std::vector<UInt32>>> requests_;
+    /// True if the workers should stop.
+    bool stopRequested_{false};
+    /// The read-ahead workers.
+    std::vector<std::thread> workers_;
+
+    /// The number of read system calls made.
+    std::atomic_uint64_t readCalls_{0};
+    /// The number of bytes read from the file.
+    std::atomic_uint64_t bytesRead_{0};
+    /// The number of bytes requested by clients.
+    std::atomic_uint64_t bytesRequested_{0};
+    /// The number of block lookups satisfied by the cache.
+    std::atomic_uint64_t cacheHits_{0};
+    /// The number of block lookups requiring a read.
+    std::atomic_uint64_t cacheMisses_{0};
+    /// The number of blocks read ahead.
+    std::atomic_uint64_t prefetchedBlocks_{0};
+};
+
+// MARK: - Implementation -
+
+inline double BlockCachedFile::Statistics::HitRate() const noexcept {
+    const auto lookups = cacheHits_ + cacheMisses_;
+    return lookups ? static_cast<double>(cacheHits_) / static_cast<double>(lookups) : 0;
+}
+
+inline BlockCachedFile::operator bool() const noexcept { return fd_ != -1; }
+
+inline SInt64 BlockCachedFile::Size() const noexcept { return size_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
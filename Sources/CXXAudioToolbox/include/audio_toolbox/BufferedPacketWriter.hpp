@@ -0,0 +1,171 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAudioFile.hpp>
+
+#include <AudioToolbox/AudioFile.h>
+
+#include <chrono>
+#include <memory>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A packet writer that coalesces small writes into large batches.
+///
+/// Packets and packet descriptions are copied into storage allocated when the writer is created and written to the
+/// audio file with a single call to CAAudioFile::WritePackets when the storage is full, when the oldest buffered
+/// packet exceeds the maximum latency, when a write is not contiguous with the buffered packets, or on request.
+///
+/// Batches written because the storage is full end on a multiple of the packet alignment, and the packets following
+/// the last aligned boundary remain buffered. Other flushes write every buffered packet.
+///
+/// The writer has no thread of its own, so the maximum latency is enforced only when packets are written or
+/// FlushIfExpired() is called. Clients that may stop writing for longer than the maximum latency should call
+/// FlushIfExpired() periodically, for example from a timer on the thread that writes packets.
+/// @note This class is not thread-safe.
+class BufferedPacketWriter final {
+  public:
+    /// Creates a buffered packet writer taking ownership of an audio file open for writing.
+    /// @param audioFile An audio file open for writing.
+    /// @param byteCapacity The maximum number of bytes of packet data buffered.
+    /// @param packetCapacity The maximum number of packets buffered.
+    /// @param maximumLatency The maximum time packets are buffered, checked when packets are written and by
+    /// FlushIfExpired().
+    /// @param inUseCache Whether the audio file should cache the written data.
+    /// @param packetAlignment The packet index multiple on which batches written because the storage is full end.
+    /// @throw std::invalid_argument.
+    /// @throw std::bad_alloc.
+    BufferedPacketWriter(CAAudioFile &&audioFile, UInt32 byteCapacity = 1024 * 1024, UInt32 packetCapacity = 16384,
+                         std::chrono::milliseconds maximumLatency = std::chrono::milliseconds{250},
+                         bool inUseCache = false, UInt32 packetAlignment = 1);
+
+    // This class is non-copyable
+    BufferedPacketWriter(const BufferedPacketWriter &) = delete;
+
+    // This class is non-assignable
+    BufferedPacketWriter &operator=(const BufferedPacketWriter &) = delete;
+
+    /// Writes any buffered packets and releases all associated resources.
+    /// @note Errors writing buffered packets are ignored; call Flush() before destruction to observe them.
+    ~BufferedPacketWriter() noexcept;
+
+    /// Writes packets of audio data to the audio file.
+    ///
+    /// Packets contiguous with the buffered packets are appended to them. Otherwise the buffered packets are written
+    /// first so packets reach the file at the requested positions in the order they were submitted. Writes larger
+    /// than the buffer capacity are passed directly to the audio file.
+    /// @param inNumBytes The number of bytes of packet data in inBuffer.
+    /// @param inPacketDescriptions Packet descriptions for inBuffer, or nullptr for formats with constant packet size.
+    /// @param inStartingPacket The packet index of the first packet in inBuffer.
+    /// @param inNumPackets The number of packets in inBuffer.
+    /// @param inBuffer The packet data.
+    /// @throw std::system_error.
+    void WritePackets(UInt32 inNumBytes, const AudioStreamPacketDescription *_Nullable inPacketDescriptions,
+                      SInt64 inStartingPacket, UInt32 inNumPackets, const void *inBuffer);
+
+    /// Writes all buffered packets to the audio file.
+    ///
+    /// If the write fails the packets remain buffered.
+    /// @throw std::system_error.
+    void Flush();
+
+    /// Writes all buffered packets to the audio file if the oldest exceeds the maximum latency.
+    ///
+    /// If the write fails the packets remain buffered.
+    /// @return true if buffered packets were written.
+    /// @throw std::system_error.
+    bool FlushIfExpired();
+
+    /// Returns the number of packets buffered.
+    [[nodiscard]] UInt32 BufferedPacketCount() const noexcept;
+
+    /// Returns the number of bytes of packet data buffered.
+    [[nodiscard]] UInt32 BufferedByteCount() const noexcept;
+
+    /// Returns the packet index following the last packet written or buffered.
+    [[nodiscard]] SInt64 NextPacket() const noexcept;
+
+    /// Returns the packet alignment of batches written because the storage is full.
+    [[nodiscard]] UInt32 PacketAlignment() const noexcept;
+
+    /// Returns the number of calls made to CAAudioFile::WritePackets.
+    [[nodiscard]] UInt64 FileWriteCount() const noexcept;
+
+    /// Returns the managed audio file.
+    /// @note Call Flush() before using the audio file directly.
+    [[nodiscard]] CAAudioFile &AudioFile() noexcept;
+
+  private:
+    /// Returns true if a write of the specified size fits in the remaining capacity.
+    [[nodiscard]] bool Fits(UInt32 byteCount, UInt32 packetCount) const noexcept;
+
+    /// Writes the buffered packets preceding the last packet alignment boundary, or all buffered packets if there is
+    /// no such boundary.
+    /// @throw std::system_error.
+    void FlushAligned();
+
+    /// Writes the first buffered packets and moves the remainder to the start of the storage.
+    /// @param packetCount The number of packets to write.
+    /// @throw std::system_error.
+    void WriteBuffered(UInt32 packetCount);
+
+    /// The managed audio file.
+    CAAudioFile audioFile_;
+    /// The maximum number of bytes of packet data buffered.
+    UInt32 byteCapacity_;
+    /// The maximum number of packets buffered.
+    UInt32 packetCapacity_;
+    /// The maximum time packets are buffered.
+    std::chrono::milliseconds maximumLatency_;
+    /// Whether the audio file should cache the written data.
+    bool useCache_;
+    /// The packet alignment of batches written because the storage is full.
+    UInt32 packetAlignment_;
+
+    /// Packet data storage.
+    std::unique_ptr<unsigned char[]> data_;
+    /// Packet description storage.
+    std::unique_ptr<AudioStreamPacketDescription[]> packetDescriptions_;
+    /// True if the buffered packets have descriptions.
+    bool hasPacketDescriptions_{false};
+    /// The packet index of the first buffered packet.
+    SInt64 startingPacket_{0};
+    /// The number of packets buffered.
+    UInt32 packetCount_{0};
+    /// The number of bytes of packet data buffered.
+    UInt32 byteCount_{0};
+    /// The time the first buffered packet was written, or the last aligned batch was written if packets remained.
+    std::chrono::steady_clock::time_point bufferedTime_;
+    /// The number of calls made to CAAudioFile::WritePackets.
+    UInt64 fileWriteCount_{0};
+};
+
+// MARK: - Implementation -
+
+inline UInt32 BufferedPacketWriter::BufferedPacketCount() const noexcept { return packetCount_; }
+
+inline UInt32 BufferedPacketWriter::BufferedByteCount() const noexcept { return byteCount_; }
+
+inline SInt64 BufferedPacketWriter::NextPacket() const noexcept { return startingPacket_ + packetCount_; }
+
+inline UInt32 BufferedPacketWriter::PacketAlignment() const noexcept { return packetAlignment_; }
+
+inline UInt64 BufferedPacketWriter::FileWriteCount() const noexcept { return fileWriteCount_; }
+
+inline CAAudioFile &BufferedPacketWriter::AudioFile() noexcept { return audioFile_; }
+
+inline bool BufferedPacketWriter::Fits(UInt32 byteCount, UInt32 packetCount) const noexcept {
+    return byteCount <= byteCapacity_ - byteCount_ && packetCount <= packetCapacity_ - packetCount_;
+}
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
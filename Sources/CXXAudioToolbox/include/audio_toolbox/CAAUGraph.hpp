@@ -7,11 +7,15 @@
 
 #pragma once
 
+#include "GraphLatencyAnalysis.hpp"
+#include "GraphSnapshot.hpp"
+
 #include <core_audio/StreamDescription.hpp>
 
 #include <AudioToolbox/AUGraph.h>
 
 #include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -204,15 +208,47 @@ class CAAUGraph final {
     [[nodiscard]] std::vector<AUNodeInteraction> NodeInteractions(AUNode inNode) const;
 
     /// Returns the graph's nodes and their interactions.
+    /// @note This is derived from Snapshot().
     /// @throw std::system_error.
+    /// @throw std::invalid_argument if an interaction refers to an unknown node.
     [[nodiscard]] std::map<AUNode, std::vector<AUNodeInteraction>> NodesAndInteractions() const;
 
-    /// Returns the Audio Unit graph's latency.
-    /// @throw std::system_error..
+    /// Returns the version of the Audio Unit graph's topology.
+    ///
+    /// The version changes whenever nodes, interactions, or graph state are changed through this object or Update()
+    /// is called. Changes made to the managed AUGraph object directly are not tracked.
+    [[nodiscard]] UInt64 TopologyVersion() const noexcept;
+
+    /// Returns a snapshot of the Audio Unit graph's nodes and interactions.
+    ///
+    /// The graph is queried only when the snapshot's version differs from TopologyVersion(); otherwise the cached
+    /// snapshot is returned. Snapshots are immutable and may be retained and read from any thread.
+    ///
+    /// This may be called from several threads at once while the graph is not being changed.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument if an interaction refers to an unknown node.
+    [[nodiscard]] std::shared_ptr<const GraphSnapshot> Snapshot() const;
+
+    /// Returns a topology-aware analysis of the Audio Unit graph's latency and tail time.
+    ///
+    /// The graph's nodes, connections, and node latencies and tail times are read once and the analysis is cached
+    /// until nodes, connections, or graph state are changed through this object or Update() is called. Nodes without
+    /// an Audio Unit, such as sub graphs or nodes of a graph that is not open, have no latency or tail time.
+    ///
+    /// This may be called from several threads at once while the graph is not being changed. Analyses are immutable
+    /// and may be retained and read from any thread; a later analysis never replaces one already returned.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument if the connections form a cycle.
+    [[nodiscard]] std::shared_ptr<const GraphLatencyAnalysis> LatencyAnalysis() const;
+
+    /// Returns the latency of the Audio Unit graph's critical path.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument if the connections form a cycle.
     [[nodiscard]] Float64 Latency() const;
 
-    /// Returns the Audio Unit graph's tail time.
+    /// Returns the tail time of the Audio Unit graph's path with the longest tail.
     /// @throw std::system_error.
+    /// @throw std::invalid_argument if the connections form a cycle.
     [[nodiscard]] Float64 TailTime() const;
 
     /// Returns the managed AUGraph object.
@@ -230,8 +266,25 @@ class CAAUGraph final {
     [[nodiscard]] AUGraph _Nullable release() noexcept;
 
   private:
+    /// Invalidates state derived from the graph's topology.
+    void TopologyChanged() noexcept;
+
     /// The managed AUGraph object.
     AUGraph _Nullable graph_{nullptr};
+    /// Incremented whenever the graph's topology or state may have changed.
+    UInt64 topologyVersion_{0};
+    /// The cached topology snapshot, accessed atomically.
+    mutable std::shared_ptr<const GraphSnapshot> snapshot_;
+    /// A latency analysis and the topology version for which it was computed.
+    struct CachedLatencyAnalysis {
+        /// The topology version.
+        UInt64 version_{0};
+        /// The analysis.
+        GraphLatencyAnalysis analysis_;
+    };
+
+    /// The cached latency analysis, accessed atomically.
+    mutable std::shared_ptr<const CachedLatencyAnalysis> latencyAnalysis_;
 };
 
 // MARK: - Implementation -
@@ -243,14 +296,26 @@ inline CAAUGraph::operator AUGraph const _Nullable() const noexcept { return gra
 inline AUGraph _Nullable CAAUGraph::get() const noexcept { return graph_; }
 
 inline void CAAUGraph::reset(AUGraph _Nullable graph) noexcept {
+    TopologyChanged();
     if (auto old = std::exchange(graph_, graph); old) {
         DisposeAUGraph(old);
     }
 }
 
-inline void CAAUGraph::swap(CAAUGraph &other) noexcept { std::swap(graph_, other.graph_); }
+inline void CAAUGraph::swap(CAAUGraph &other) noexcept {
+    TopologyChanged();
+    other.TopologyChanged();
+    std::swap(graph_, other.graph_);
+}
+
+inline AUGraph _Nullable CAAUGraph::release() noexcept {
+    TopologyChanged();
+    return std::exchange(graph_, nullptr);
+}
+
+inline UInt64 CAAUGraph::TopologyVersion() const noexcept { return topologyVersion_; }
 
-inline AUGraph _Nullable CAAUGraph::release() noexcept { return std::exchange(graph_, nullptr); }
+inline void CAAUGraph::TopologyChanged() noexcept { ++topologyVersion_; }
 
 } /* namespace audio_toolbox */
 
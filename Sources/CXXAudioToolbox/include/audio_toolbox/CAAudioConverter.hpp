@@ -9,6 +9,12 @@
 
 #include <AudioToolbox/AudioConverter.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
 CF_ASSUME_NONNULL_BEGIN
@@ -16,8 +22,76 @@ CF_ASSUME_NONNULL_BEGIN
 namespace audio_toolbox {
 
 /// An AudioConverter wrapper.
+///
+/// Built-in linear PCM kernels may be enabled with SetPCMFastPathEnabled(). Enabled converters created with New()
+/// between interleaved or mono 32-bit float and 16-bit, packed 24-bit, or 32-bit signed integer linear PCM of either
+/// byte order, with the same sample rate and channel count, perform ConvertBuffer with built-in vector kernels instead
+/// of AudioConverter. Enabled converters between linear PCM formats differing only in interleaving perform
+/// ConvertComplexBuffer with pcm_layout::Convert. Setting any converter property disables the kernels.
 class CAAudioConverter final {
   public:
+    /// The result of a request to an input provider.
+    enum class InputResult {
+        /// Input was supplied.
+        data,
+        /// No more input will be supplied.
+        endOfStream,
+        /// Input is not available yet but may be later.
+        noDataYet,
+    };
+
+    /// An input provider supplying data from caller-owned memory without copying.
+    ///
+    /// The converter reads directly from the memory, which must remain valid and unchanged until the input buffer is
+    /// exhausted or no longer used. Each request supplies as many of the remaining packets as the converter asks for.
+    class InputBuffer final {
+      public:
+        /// Creates an input buffer supplying packets from an AudioBufferList.
+        /// @param bufferList The buffers containing the packets.
+        /// @param packetCount The number of packets in the buffers.
+        /// @param packetDescriptions Descriptions of the packets, or nullptr for formats with constant packet size.
+        /// @param endOfStream If true, exhaustion signals end of stream; otherwise it signals no data yet.
+        InputBuffer(const AudioBufferList &bufferList, UInt32 packetCount,
+                    const AudioStreamPacketDescription *_Nullable packetDescriptions = nullptr,
+                    bool endOfStream = true) noexcept;
+
+        /// Creates an input buffer supplying interleaved linear PCM from a contiguous range of samples.
+        /// @param samples A contiguous range, such as an array or std::vector, of samples in the source format.
+        /// @param channelsPerFrame The number of interleaved channels.
+        /// @param endOfStream If true, exhaustion signals end of stream; otherwise it signals no data yet.
+        template <typename Samples,
+                  typename = std::void_t<decltype(std::data(std::declval<const Samples &>())),
+                                         decltype(std::size(std::declval<const Samples &>()))>>
+        InputBuffer(const Samples &samples, UInt32 channelsPerFrame, bool endOfStream = true) noexcept;
+
+        // This class is non-copyable
+        InputBuffer(const InputBuffer &) = delete;
+
+        // This class is non-assignable
+        InputBuffer &operator=(const InputBuffer &) = delete;
+
+        /// Returns the number of packets not yet supplied.
+        [[nodiscard]] UInt32 RemainingPackets() const noexcept;
+
+        /// Supplies up to ioNumberDataPackets packets by pointing ioData at the caller's memory.
+        InputResult operator()(UInt32 &ioNumberDataPackets, AudioBufferList &ioData,
+                               AudioStreamPacketDescription *_Nullable *_Nullable outDataPacketDescription) noexcept;
+
+      private:
+        /// The buffers containing the packets.
+        const AudioBufferList *bufferList_;
+        /// Storage for a single-buffer AudioBufferList.
+        AudioBufferList singleBuffer_{};
+        /// The packet descriptions, or nullptr.
+        const AudioStreamPacketDescription *_Nullable packetDescriptions_;
+        /// The number of packets in the buffers.
+        UInt32 packetCount_;
+        /// The number of packets supplied.
+        UInt32 packetsSupplied_{0};
+        /// True if exhaustion signals end of stream.
+        bool endOfStream_;
+    };
+
     /// Creates an audio converter.
     CAAudioConverter() noexcept = default;
 
@@ -73,6 +147,20 @@ class CAAudioConverter final {
     /// @throw std::system_error.
     void SetProperty(AudioConverterPropertyID inPropertyID, UInt32 inPropertyDataSize, const void *inPropertyData);
 
+    /// Returns the source format passed to New() or NewSpecific().
+    [[nodiscard]] const AudioStreamBasicDescription &SourceFormat() const noexcept;
+
+    /// Returns the destination format passed to New() or NewSpecific().
+    [[nodiscard]] const AudioStreamBasicDescription &DestinationFormat() const noexcept;
+
+    /// Returns true if ConvertBuffer or ConvertComplexBuffer uses a built-in linear PCM kernel.
+    [[nodiscard]] bool UsesPCMFastPath() const noexcept;
+
+    /// Enables or disables the built-in linear PCM kernels for ConvertBuffer and ConvertComplexBuffer.
+    ///
+    /// The kernels are disabled by default.
+    void SetPCMFastPathEnabled(bool enabled) noexcept;
+
     /// Converts data from an input buffer to an output buffer.
     /// @throw std::system_error.
     void ConvertBuffer(UInt32 inInputDataSize, const void *inInputData, UInt32 &ioOutputDataSize, void *outOutputData);
@@ -83,6 +171,26 @@ class CAAudioConverter final {
                            UInt32 &ioOutputDataPacketSize, AudioBufferList *outOutputData,
                            AudioStreamPacketDescription *_Nullable outPacketDescription);
 
+    /// Converts data supplied by an input provider, supporting non-interleaved and packetized formats.
+    ///
+    /// The provider is any callable, such as a lambda or InputBuffer, invocable as
+    /// InputResult(UInt32 &ioNumberDataPackets, AudioBufferList &ioData,
+    /// AudioStreamPacketDescription *_Nullable *_Nullable outDataPacketDescription) with the semantics of an
+    /// AudioConverterComplexInputDataProc. No memory is allocated unless the provider throws.
+    /// @param inputProvider The input provider, which is invoked only during this call.
+    /// @param ioOutputDataPacketSize On input the capacity of outOutputData in packets. On output the number of packets
+    /// produced.
+    /// @param outOutputData The output buffers.
+    /// @param outPacketDescription Descriptions of the output packets, or nullptr for constant packet size formats.
+    /// @return InputResult::noDataYet if conversion stopped because the provider had no data, otherwise
+    /// InputResult::endOfStream if the provider signaled end of stream, otherwise InputResult::data.
+    /// @throw std::system_error.
+    /// @throw Any exception thrown by inputProvider.
+    template <typename InputProvider>
+    InputResult FillComplexBuffer(InputProvider &&inputProvider, UInt32 &ioOutputDataPacketSize,
+                                  AudioBufferList *outOutputData,
+                                  AudioStreamPacketDescription *_Nullable outPacketDescription = nullptr);
+
     /// Converts PCM data from an input buffer list to an output buffer list.
     /// @throw std::system_error.
     void ConvertComplexBuffer(UInt32 inNumberPCMFrames, const AudioBufferList *inInputData,
@@ -105,27 +213,209 @@ class CAAudioConverter final {
     [[nodiscard]] AudioConverterRef _Nullable release() noexcept;
 
   private:
+    /// The status returned to AudioConverter when an input provider has no data yet.
+    static constexpr OSStatus kInputNoDataYet = 'ndy?';
+    /// The status returned to AudioConverter when an input provider throws.
+    static constexpr OSStatus kInputProviderThrew = 'ipt!';
+
+    /// State shared with an input provider trampoline.
+    template <typename InputProvider> struct InputContext {
+        /// The input provider.
+        InputProvider &provider_;
+        /// The last result returned by the provider.
+        InputResult result_{InputResult::data};
+        /// The exception thrown by the provider, if any.
+        std::exception_ptr exception_;
+    };
+
+    /// Throws std::system_error in the AudioConverter error category if result is an error.
+    /// @throw std::system_error.
+    static void ThrowIfError(OSStatus result, const char *operation);
+
+    /// An AudioConverterComplexInputDataProc forwarding to an input provider.
+    template <typename InputProvider>
+    static OSStatus InputTrampoline(AudioConverterRef inAudioConverter, UInt32 *ioNumberDataPackets,
+                                    AudioBufferList *ioData,
+                                    AudioStreamPacketDescription *_Nullable *_Nullable outDataPacketDescription,
+                                    void *_Nullable inUserData) noexcept;
+
+    /// A function converting linear PCM samples.
+    using PCMSampleConverter = void (*)(const void *input, void *output, std::size_t sampleCount);
+
+    /// Forgets the formats of the managed AudioConverter object.
+    void ClearFormats() noexcept;
+
     /// The managed AudioConverter object.
     AudioConverterRef _Nullable converter_{nullptr};
+    /// The source format.
+    AudioStreamBasicDescription sourceFormat_{};
+    /// The destination format.
+    AudioStreamBasicDescription destinationFormat_{};
+    /// The built-in kernel for ConvertBuffer, if any.
+    PCMSampleConverter _Nullable pcmSampleConverter_{nullptr};
+    /// True if the formats differ only in interleaving.
+    bool layoutConversion_{false};
+    /// True if the built-in kernels may be used.
+    bool pcmFastPathEnabled_{false};
 };
 
 // MARK: - Implementation -
 
+inline CAAudioConverter::InputBuffer::InputBuffer(const AudioBufferList &bufferList, UInt32 packetCount,
+                                                  const AudioStreamPacketDescription *_Nullable packetDescriptions,
+                                                  bool endOfStream) noexcept
+    : bufferList_{&bufferList}, packetDescriptions_{packetDescriptions}, packetCount_{packetCount},
+      endOfStream_{endOfStream} {}
+
+template <typename Samples, typename>
+inline CAAudioConverter::InputBuffer::InputBuffer(const Samples &samples, UInt32 channelsPerFrame,
+                                                  bool endOfStream) noexcept
+    : bufferList_{&singleBuffer_}, packetDescriptions_{nullptr},
+      packetCount_{channelsPerFrame ? static_cast<UInt32>(std::size(samples) / channelsPerFrame) : 0},
+      endOfStream_{endOfStream} {
+    using Sample = std::remove_cv_t<std::remove_reference_t<decltype(*std::data(samples))>>;
+    singleBuffer_.mNumberBuffers = 1;
+    singleBuffer_.mBuffers[0].mNumberChannels = channelsPerFrame;
+    singleBuffer_.mBuffers[0].mDataByteSize = static_cast<UInt32>(packetCount_ * channelsPerFrame * sizeof(Sample));
+    singleBuffer_.mBuffers[0].mData = const_cast<Sample *>(std::data(samples));
+}
+
+inline UInt32 CAAudioConverter::InputBuffer::RemainingPackets() const noexcept {
+    return packetCount_ - packetsSupplied_;
+}
+
+inline CAAudioConverter::InputResult CAAudioConverter::InputBuffer::operator()(
+        UInt32 &ioNumberDataPackets, AudioBufferList &ioData,
+        AudioStreamPacketDescription *_Nullable *_Nullable outDataPacketDescription) noexcept {
+    const auto packets = std::min(ioNumberDataPackets, RemainingPackets());
+    ioNumberDataPackets = packets;
+    if (packets == 0) {
+        return endOfStream_ ? InputResult::endOfStream : InputResult::noDataYet;
+    }
+
+    const auto bufferCount = std::min(ioData.mNumberBuffers, bufferList_->mNumberBuffers);
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        const auto &buffer = bufferList_->mBuffers[i];
+        auto &output = ioData.mBuffers[i];
+        output.mNumberChannels = buffer.mNumberChannels;
+        if (packetDescriptions_) {
+            // Packet description offsets are relative to the start of the buffer
+            output.mData = buffer.mData;
+            output.mDataByteSize = buffer.mDataByteSize;
+        } else {
+            const auto bytesPerPacket = buffer.mDataByteSize / packetCount_;
+            output.mData = static_cast<unsigned char *>(buffer.mData) + packetsSupplied_ * bytesPerPacket;
+            output.mDataByteSize = packets * bytesPerPacket;
+        }
+    }
+
+    if (outDataPacketDescription) {
+        *outDataPacketDescription = packetDescriptions_
+                                            ? const_cast<AudioStreamPacketDescription *>(packetDescriptions_) +
+                                                      packetsSupplied_
+                                            : nullptr;
+    }
+
+    packetsSupplied_ += packets;
+    return InputResult::data;
+}
+
+template <typename InputProvider>
+inline CAAudioConverter::InputResult
+CAAudioConverter::FillComplexBuffer(InputProvider &&inputProvider, UInt32 &ioOutputDataPacketSize,
+                                    AudioBufferList *outOutputData,
+                                    AudioStreamPacketDescription *_Nullable outPacketDescription) {
+    using Provider = std::remove_reference_t<InputProvider>;
+    static_assert(std::is_invocable_r_v<InputResult, Provider &, UInt32 &, AudioBufferList &,
+                                        AudioStreamPacketDescription *_Nullable *_Nullable>,
+                  "inputProvider must be invocable as InputResult(UInt32 &, AudioBufferList &, "
+                  "AudioStreamPacketDescription **)");
+
+    InputContext<Provider> context{inputProvider, InputResult::data, {}};
+    const auto result = AudioConverterFillComplexBuffer(converter_, &InputTrampoline<Provider>, &context,
+                                                        &ioOutputDataPacketSize, outOutputData, outPacketDescription);
+    if (context.exception_) {
+        std::rethrow_exception(context.exception_);
+    }
+    if (result == kInputNoDataYet) {
+        return InputResult::noDataYet;
+    }
+    ThrowIfError(result, "AudioConverterFillComplexBuffer");
+    return context.result_ == InputResult::endOfStream ? InputResult::endOfStream : InputResult::data;
+}
+
+template <typename InputProvider>
+inline OSStatus CAAudioConverter::InputTrampoline(
+        AudioConverterRef /*inAudioConverter*/, UInt32 *ioNumberDataPackets, AudioBufferList *ioData,
+        AudioStreamPacketDescription *_Nullable *_Nullable outDataPacketDescription,
+        void *_Nullable inUserData) noexcept {
+    auto &context = *static_cast<InputContext<InputProvider> *>(inUserData);
+    try {
+        context.result_ = std::invoke(context.provider_, *ioNumberDataPackets, *ioData, outDataPacketDescription);
+    } catch (...) {
+        context.exception_ = std::current_exception();
+        *ioNumberDataPackets = 0;
+        return kInputProviderThrew;
+    }
+
+    switch (context.result_) {
+    case InputResult::data:
+        return noErr;
+    case InputResult::endOfStream:
+        *ioNumberDataPackets = 0;
+        return noErr;
+    case InputResult::noDataYet:
+    default:
+        *ioNumberDataPackets = 0;
+        return kInputNoDataYet;
+    }
+}
+
 inline CAAudioConverter::operator bool() const noexcept { return converter_ != nullptr; }
 
 inline CAAudioConverter::operator AudioConverterRef const _Nullable() const noexcept { return converter_; }
 
+inline const AudioStreamBasicDescription &CAAudioConverter::SourceFormat() const noexcept { return sourceFormat_; }
+
+inline const AudioStreamBasicDescription &CAAudioConverter::DestinationFormat() const noexcept {
+    return destinationFormat_;
+}
+
+inline bool CAAudioConverter::UsesPCMFastPath() const noexcept {
+    return pcmFastPathEnabled_ && (pcmSampleConverter_ != nullptr || layoutConversion_);
+}
+
+inline void CAAudioConverter::SetPCMFastPathEnabled(bool enabled) noexcept { pcmFastPathEnabled_ = enabled; }
+
 inline AudioConverterRef _Nullable CAAudioConverter::get() const noexcept { return converter_; }
 
 inline void CAAudioConverter::reset(AudioConverterRef _Nullable converter) noexcept {
+    ClearFormats();
     if (auto old = std::exchange(converter_, converter); old) {
         AudioConverterDispose(old);
     }
 }
 
-inline void CAAudioConverter::swap(CAAudioConverter &other) noexcept { std::swap(converter_, other.converter_); }
+inline void CAAudioConverter::swap(CAAudioConverter &other) noexcept {
+    std::swap(converter_, other.converter_);
+    std::swap(sourceFormat_, other.sourceFormat_);
+    std::swap(destinationFormat_, other.destinationFormat_);
+    std::swap(pcmSampleConverter_, other.pcmSampleConverter_);
+    std::swap(layoutConversion_, other.layoutConversion_);
+    std::swap(pcmFastPathEnabled_, other.pcmFastPathEnabled_);
+}
 
-inline AudioConverterRef _Nullable CAAudioConverter::release() noexcept { return std::exchange(converter_, nullptr); }
+inline AudioConverterRef _Nullable CAAudioConverter::release() noexcept {
+    ClearFormats();
+    return std::exchange(converter_, nullptr);
+}
+
+inline void CAAudioConverter::ClearFormats() noexcept {
+    sourceFormat_ = {};
+    destinationFormat_ = {};
+    pcmSampleConverter_ = nullptr;
+    layoutConversion_ = false;
+}
 
 } /* namespace audio_toolbox */
 
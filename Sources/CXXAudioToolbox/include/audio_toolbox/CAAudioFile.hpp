@@ -132,6 +132,18 @@ class CAAudioFile final {
     /// @throw std::system_error.
     [[nodiscard]] core_audio::StreamDescription DataFormat() const;
 
+    /// Returns the byte offset of the audio data in the file (kAudioFilePropertyDataOffset)
+    /// @throw std::system_error.
+    [[nodiscard]] SInt64 DataOffset() const;
+
+    /// Returns the number of bytes of audio data in the file (kAudioFilePropertyAudioDataByteCount)
+    /// @throw std::system_error.
+    [[nodiscard]] UInt64 AudioDataByteCount() const;
+
+    /// Returns the number of packets of audio data in the file (kAudioFilePropertyAudioDataPacketCount)
+    /// @throw std::system_error.
+    [[nodiscard]] UInt64 AudioDataPacketCount() const;
+
     // MARK: Global Properties
 
     /// Gets the size of a global audio file property.
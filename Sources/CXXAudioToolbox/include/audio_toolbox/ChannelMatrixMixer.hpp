@@ -0,0 +1,163 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AudioFormat.h>
+
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A mixer applying a gain matrix to convert 32-bit float linear PCM between channel layouts.
+///
+/// The matrix has one row per input channel and one column per output channel, the layout used by
+/// kAudioFormatProperty_MatrixMixMap. Matrices with few nonzero gains, such as channel reordering or simple downmixes,
+/// are applied by summing only the contributing inputs of each output; other matrices use a dense kernel. Both
+/// kernels use SIMD instructions where available.
+class ChannelMatrixMixer final {
+  public:
+    /// Returns the mix matrix AudioFormat uses to convert between two channel layouts.
+    /// @param inInputLayout The input channel layout.
+    /// @param inOutputLayout The output channel layout.
+    /// @return A matrix of input channel count rows and output channel count columns in row-major order.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static std::vector<Float32> MatrixForLayouts(const AudioChannelLayout &inInputLayout,
+                                                               const AudioChannelLayout &inOutputLayout);
+
+    /// Creates a mixer.
+    ChannelMatrixMixer() noexcept = default;
+
+    // This class is non-copyable
+    ChannelMatrixMixer(const ChannelMatrixMixer &) = delete;
+
+    // This class is non-assignable
+    ChannelMatrixMixer &operator=(const ChannelMatrixMixer &) = delete;
+
+    /// Move constructor.
+    ChannelMatrixMixer(ChannelMatrixMixer &&other) noexcept = default;
+
+    /// Move assignment operator.
+    ChannelMatrixMixer &operator=(ChannelMatrixMixer &&other) noexcept = default;
+
+    /// Destroys the mixer and releases all associated resources.
+    ~ChannelMatrixMixer() noexcept = default;
+
+    /// Returns true if the mixer has been created.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Creates a new mixer converting between two channel layouts.
+    ///
+    /// Both formats must be native-endian 32-bit float linear PCM with the same sample rate and channel counts matching
+    /// their layouts. The interleaving of the formats may differ.
+    /// @param inSourceFormat The source format.
+    /// @param inSourceLayout The source channel layout.
+    /// @param inDestinationFormat The destination format.
+    /// @param inDestinationLayout The destination channel layout.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void New(const AudioStreamBasicDescription &inSourceFormat, const AudioChannelLayout &inSourceLayout,
+             const AudioStreamBasicDescription &inDestinationFormat, const AudioChannelLayout &inDestinationLayout);
+
+    /// Creates a new mixer applying a matrix.
+    ///
+    /// Both formats must be native-endian 32-bit float linear PCM with the same sample rate. The interleaving of the
+    /// formats may differ.
+    /// @param inSourceFormat The source format.
+    /// @param inDestinationFormat The destination format.
+    /// @param inMatrix A matrix of source channel count rows and destination channel count columns in row-major order.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void New(const AudioStreamBasicDescription &inSourceFormat, const AudioStreamBasicDescription &inDestinationFormat,
+             std::vector<Float32> inMatrix);
+
+    /// Destroys the mixer.
+    void Dispose() noexcept;
+
+    /// Returns the source format.
+    [[nodiscard]] const AudioStreamBasicDescription &SourceFormat() const noexcept;
+
+    /// Returns the destination format.
+    [[nodiscard]] const AudioStreamBasicDescription &DestinationFormat() const noexcept;
+
+    /// Returns the mix matrix.
+    [[nodiscard]] const std::vector<Float32> &Matrix() const noexcept;
+
+    /// Returns true if the matrix is applied with the sparse kernel.
+    [[nodiscard]] bool IsSparse() const noexcept;
+
+    /// Mixes frames from one buffer list into another.
+    ///
+    /// This does not allocate memory. The output buffer sizes are set to the number of bytes written.
+    ///
+    /// Frames may be mixed in place: an output buffer may overlap an input buffer if both begin at the same address,
+    /// in which case the buffer must be large enough for the larger of the two.
+    /// @param inNumberFrames The number of frames to mix.
+    /// @param inInputData The input buffers in the source format.
+    /// @param outOutputData The output buffers in the destination format.
+    /// @throw std::system_error if the buffers are too small or an output buffer overlaps an input buffer at a
+    /// different address.
+    void Process(UInt32 inNumberFrames, const AudioBufferList *inInputData, AudioBufferList *outOutputData);
+
+  private:
+    /// An input channel contributing to an output channel.
+    struct Term {
+        /// The input channel.
+        UInt32 input_;
+        /// The gain applied to the input channel.
+        Float32 gain_;
+    };
+
+    /// Mixes frameCount frames, which must not exceed the block size, starting at frame offset, copying
+    /// non-interleaved input before mixing if copyInput is true.
+    void ProcessBlock(const AudioBufferList *inInputData, AudioBufferList *outOutputData, UInt32 offset,
+                      UInt32 frameCount, bool copyInput) noexcept;
+
+    /// The source format.
+    AudioStreamBasicDescription sourceFormat_{};
+    /// The destination format.
+    AudioStreamBasicDescription destinationFormat_{};
+    /// The mix matrix.
+    std::vector<Float32> matrix_;
+    /// True if the sparse kernel is used.
+    bool sparse_{false};
+
+    /// The nonzero terms of each output channel, ordered by input channel.
+    std::vector<Term> terms_;
+    /// The index in terms_ of the first term of each output channel, followed by the size of terms_.
+    std::vector<UInt32> termOffsets_;
+
+    /// Deinterleaved storage for one block of input and interleaved output.
+    std::vector<float> scratch_;
+    /// Pointers to the deinterleaved input channels of the current block.
+    std::vector<const float *> inputs_;
+    /// Pointers to the deinterleaved output channels of the current block.
+    std::vector<float *> outputs_;
+    /// Channel pointers passed to pcm_layout when interleaving or deinterleaving.
+    std::vector<void *> channels_;
+};
+
+// MARK: - Implementation -
+
+inline ChannelMatrixMixer::operator bool() const noexcept { return !matrix_.empty(); }
+
+inline const AudioStreamBasicDescription &ChannelMatrixMixer::SourceFormat() const noexcept { return sourceFormat_; }
+
+inline const AudioStreamBasicDescription &ChannelMatrixMixer::DestinationFormat() const noexcept {
+    return destinationFormat_;
+}
+
+inline const std::vector<Float32> &ChannelMatrixMixer::Matrix() const noexcept { return matrix_; }
+
+inline bool ChannelMatrixMixer::IsSparse() const noexcept { return sparse_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
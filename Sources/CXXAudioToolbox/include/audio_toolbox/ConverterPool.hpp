@@ -0,0 +1,233 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAudioConverter.hpp>
+
+#include <AudioToolbox/AudioConverter.h>
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A pool of idle audio converters keyed by configuration.
+///
+/// A configuration is the source and destination formats, the codec class descriptions passed to
+/// CAAudioConverter::NewSpecific, and the properties set after creation. Checking out a converter returns an idle
+/// converter with the same configuration if one exists and otherwise creates one. Converters are reset when checked
+/// in so checked out converters are always in their initial state.
+///
+/// Idle converters beyond the capacity, and those idle longer than the maximum idle time, are disposed.
+///
+/// The pool is thread-safe. The pool must outlive all converters checked out from it.
+class ConverterPool final {
+  public:
+    /// A converter property set after creation.
+    struct Property {
+        /// The property ID.
+        AudioConverterPropertyID propertyID_{0};
+        /// The property value.
+        std::vector<unsigned char> data_;
+    };
+
+    /// Pool statistics.
+    struct Statistics {
+        /// The number of checkouts satisfied by an idle converter.
+        UInt64 hits_{0};
+        /// The number of checkouts requiring a new converter.
+        UInt64 misses_{0};
+        /// The number of idle converters disposed to stay within the capacity.
+        UInt64 evictions_{0};
+        /// The number of idle converters disposed after exceeding the maximum idle time.
+        UInt64 expirations_{0};
+        /// The number of idle converters.
+        std::size_t idleCount_{0};
+        /// The number of checked out converters.
+        std::size_t checkedOutCount_{0};
+
+        /// Returns the fraction of checkouts satisfied by an idle converter.
+        [[nodiscard]] double HitRate() const noexcept;
+    };
+
+    /// A converter checked out from a pool, returned to the pool on destruction.
+    class Lease final {
+      public:
+        /// Creates an empty lease.
+        Lease() noexcept = default;
+
+        // This class is non-copyable
+        Lease(const Lease &) = delete;
+
+        // This class is non-assignable
+        Lease &operator=(const Lease &) = delete;
+
+        /// Move constructor.
+        Lease(Lease &&other) noexcept;
+
+        /// Move assignment operator.
+        Lease &operator=(Lease &&other) noexcept;
+
+        /// Checks the converter in to its pool.
+        ~Lease() noexcept;
+
+        /// Returns true if the lease holds a converter.
+        [[nodiscard]] explicit operator bool() const noexcept;
+
+        /// Returns the converter.
+        [[nodiscard]] CAAudioConverter &operator*() noexcept;
+
+        /// Returns the converter.
+        [[nodiscard]] CAAudioConverter *operator->() noexcept;
+
+        /// Disposes the converter instead of returning it to the pool.
+        ///
+        /// Use this for converters left in an unknown state, for example after changing their properties.
+        void Discard() noexcept;
+
+      private:
+        friend class ConverterPool;
+
+        /// The pool the converter is returned to.
+        ConverterPool *_Nullable pool_{nullptr};
+        /// The converter's configuration key.
+        std::string key_;
+        /// The converter.
+        CAAudioConverter converter_;
+    };
+
+    /// Creates a converter pool.
+    /// @param capacity The maximum number of idle converters.
+    /// @param maximumIdleTime The time after which idle converters are disposed, checked on checkout and checkin.
+    explicit ConverterPool(std::size_t capacity = 16,
+                           std::chrono::steady_clock::duration maximumIdleTime = std::chrono::seconds{60}) noexcept;
+
+    // This class is non-copyable
+    ConverterPool(const ConverterPool &) = delete;
+
+    // This class is non-assignable
+    ConverterPool &operator=(const ConverterPool &) = delete;
+
+    /// Disposes all idle converters.
+    ~ConverterPool() noexcept = default;
+
+    /// Checks out a converter for a configuration, creating one if no idle converter matches.
+    /// @param inSourceFormat The source format.
+    /// @param inDestinationFormat The destination format.
+    /// @param inClassDescriptions The codecs to use, or empty to let AudioConverter choose.
+    /// @param inProperties Properties set, in order, on newly created converters.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] Lease Checkout(const AudioStreamBasicDescription &inSourceFormat,
+                                 const AudioStreamBasicDescription &inDestinationFormat,
+                                 const std::vector<AudioClassDescription> &inClassDescriptions = {},
+                                 const std::vector<Property> &inProperties = {});
+
+    /// Resets a checked out converter and returns it to the pool.
+    ///
+    /// Converters that cannot be reset are disposed.
+    void Checkin(Lease &&lease) noexcept;
+
+    /// Disposes idle converters that have exceeded the maximum idle time.
+    void EvictExpired() noexcept;
+
+    /// Disposes all idle converters.
+    void Clear() noexcept;
+
+    /// Returns the pool statistics.
+    [[nodiscard]] Statistics GetStatistics() const;
+
+    /// Resets the hit, miss, eviction, and expiration counts.
+    void ResetStatistics() noexcept;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    /// An idle converter.
+    struct Entry {
+        /// The converter's configuration key.
+        std::string key_;
+        /// The converter.
+        CAAudioConverter converter_;
+        /// The time the converter was checked in.
+        Clock::time_point checkinTime_;
+    };
+
+    /// Moves expired and excess entries to disposed.
+    /// @note mutex_ must be held.
+    void Trim(Clock::time_point now, std::list<Entry> &disposed) noexcept;
+
+    /// The maximum number of idle converters.
+    const std::size_t capacity_;
+    /// The time after which idle converters are disposed.
+    const Clock::duration maximumIdleTime_;
+
+    /// Protects the members below.
+    mutable std::mutex mutex_;
+    /// Idle converters in most recently checked in order.
+    std::list<Entry> entries_;
+    /// Maps configuration keys to idle converters.
+    std::unordered_multimap<std::string, std::list<Entry>::iterator> index_;
+    /// The number of checked out converters.
+    std::size_t checkedOutCount_{0};
+    /// The number of checkouts satisfied by an idle converter.
+    UInt64 hits_{0};
+    /// The number of checkouts requiring a new converter.
+    UInt64 misses_{0};
+    /// The number of idle converters evicted.
+    UInt64 evictions_{0};
+    /// The number of idle converters expired.
+    UInt64 expirations_{0};
+};
+
+// MARK: - Implementation -
+
+inline double ConverterPool::Statistics::HitRate() const noexcept {
+    const auto checkouts = hits_ + misses_;
+    return checkouts ? static_cast<double>(hits_) / static_cast<double>(checkouts) : 0;
+}
+
+inline ConverterPool::Lease::Lease(Lease &&other) noexcept
+    : pool_{std::exchange(other.pool_, nullptr)}, key_{std::move(other.key_)},
+      converter_{std::move(other.converter_)} {}
+
+inline ConverterPool::Lease &ConverterPool::Lease::operator=(Lease &&other) noexcept {
+    if (this != &other) {
+        if (pool_) {
+            pool_->Checkin(std::move(*this));
+        }
+        pool_ = std::exchange(other.pool_, nullptr);
+        key_ = std::move(other.key_);
+        converter_ = std::move(other.converter_);
+    }
+    return *this;
+}
+
+inline ConverterPool::Lease::~Lease() noexcept {
+    if (pool_) {
+        pool_->Checkin(std::move(*this));
+    }
+}
+
+inline ConverterPool::Lease::operator bool() const noexcept { return static_cast<bool>(converter_); }
+
+inline CAAudioConverter &ConverterPool::Lease::operator*() noexcept { return converter_; }
+
+inline CAAudioConverter *ConverterPool::Lease::operator->() noexcept { return &converter_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,148 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAExtAudioFile.hpp>
+
+#include <core_audio/BufferList.hpp>
+#include <core_audio/StreamDescription.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A sequential reader that decodes ahead of the consumer on a background thread.
+///
+/// A dedicated thread calls CAExtAudioFile::Read to fill a pool of buffers allocated when decoding starts. In the
+/// steady state reading a buffer exchanges a pointer and does not decode, copy, or allocate.
+class DecodeAheadReader final {
+  public:
+    /// Creates a decode-ahead reader taking ownership of an open extended audio file.
+    ///
+    /// The client data format must be set before creating the reader and must be linear PCM.
+    /// @param extAudioFile An extended audio file open for reading.
+    /// @param framesPerBuffer The capacity of each buffer in frames.
+    /// @param bufferCount The number of buffers, including the buffer most recently returned to the consumer.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument.
+    DecodeAheadReader(CAExtAudioFile &&extAudioFile, UInt32 framesPerBuffer = 4096, UInt32 bufferCount = 4);
+
+    // This class is non-copyable
+    DecodeAheadReader(const DecodeAheadReader &) = delete;
+
+    // This class is non-assignable
+    DecodeAheadReader &operator=(const DecodeAheadReader &) = delete;
+
+    /// Stops decoding and releases all associated resources.
+    ~DecodeAheadReader() noexcept;
+
+    /// Returns the client data format.
+    [[nodiscard]] const core_audio::StreamDescription &ClientDataFormat() const noexcept;
+
+    /// Starts decoding at the file's current position, discarding any audio already decoded.
+    /// @throw std::bad_alloc.
+    void Start();
+
+    /// Stops decoding.
+    void Stop() noexcept;
+
+    /// Returns the next decoded buffer, waiting until it is available.
+    ///
+    /// The returned buffer remains valid until the next call to Read, Seek, Start, or Stop.
+    /// @param outNumberFrames On exit the number of frames in the returned buffer, or 0 at end of file.
+    /// @return The decoded audio or nullptr at end of file or if decoding is stopped.
+    /// @throw std::logic_error if decoding was never started.
+    /// @throw std::system_error if decoding failed.
+    const AudioBufferList *_Nullable Read(UInt32 &outNumberFrames);
+
+    /// Copies decoded audio into a buffer, waiting until it is available.
+    ///
+    /// The buffer must use the client data format. Audio is copied across decoded buffers as needed to fill it.
+    /// @note Reads of this kind should not be interleaved with pointer reads, which discard partially copied buffers.
+    /// @param buffer Buffer into which the audio data is read. A frame length of 0 indicates end of file.
+    /// @throw std::invalid_argument if the buffer's layout does not match the client data format.
+    /// @throw std::logic_error if decoding was never started.
+    /// @throw std::system_error if decoding failed.
+    void Read(core_audio::BufferList &buffer);
+
+    /// Seeks to a specific frame position and restarts decoding.
+    /// @param inFrameOffset The desired position in sample frames of the file's format.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void Seek(SInt64 inFrameOffset);
+
+    /// Returns the managed extended audio file.
+    /// @note The extended audio file must not be used while decoding is in progress.
+    [[nodiscard]] CAExtAudioFile &ExtAudioFile() noexcept;
+
+  private:
+    struct Buffer;
+
+    /// Decodes buffers until end of file, an error occurs, or decoding is stopped.
+    void DecoderThreadEntry() noexcept;
+
+    /// Returns the current buffer to the free list and takes the next decoded buffer.
+    /// @return false at end of file or if decoding is stopped.
+    /// @throw std::logic_error if decoding was never started.
+    bool AdvanceBuffer();
+
+    /// The managed extended audio file.
+    CAExtAudioFile extAudioFile_;
+    /// The client data format.
+    core_audio::StreamDescription clientDataFormat_;
+    /// The capacity of each buffer in frames.
+    UInt32 framesPerBuffer_;
+    /// The number of buffers, including current_.
+    UInt32 bufferCount_;
+
+    /// The buffer most recently returned to the consumer.
+    std::unique_ptr<Buffer> current_;
+    /// The number of frames in current_ already copied by Read(core_audio::BufferList&).
+    UInt32 currentOffset_{0};
+
+    /// Protects the queues and state below.
+    std::mutex mutex_;
+    /// Signaled when a buffer is decoded or decoding finishes.
+    std::condition_variable readyCondition_;
+    /// Signaled when a buffer is returned to the free list or decoding is stopped.
+    std::condition_variable freeCondition_;
+    /// Buffers decoded but not yet consumed, in file order.
+    std::deque<std::unique_ptr<Buffer>> ready_;
+    /// Buffers available for decoding.
+    std::vector<std::unique_ptr<Buffer>> free_;
+    /// The error that ended decoding, if any.
+    std::exception_ptr error_;
+    /// True if Start() has been called.
+    bool started_{false};
+    /// True if the decoder has reached end of file or failed.
+    bool finished_{true};
+    /// True if the decoder should stop.
+    bool stopRequested_{false};
+    /// The background decoder.
+    std::thread decoderThread_;
+};
+
+// MARK: - Implementation -
+
+inline const core_audio::StreamDescription &DecodeAheadReader::ClientDataFormat() const noexcept {
+    return clientDataFormat_;
+}
+
+inline CAExtAudioFile &DecodeAheadReader::ExtAudioFile() noexcept { return extAudioFile_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,169 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AudioConverter.h>
+
+#include <cstddef>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+class CAExtAudioFile;
+
+/// A dithering quantizer converting 32-bit float linear PCM to signed integer linear PCM.
+///
+/// Each channel has its own pseudorandom generator so dither is uncorrelated between channels. Without noise shaping
+/// samples are quantized with SIMD instructions where available; noise shaping feeds back the quantization error of
+/// each channel and is computed per sample. The output does not depend on how frames are divided between calls.
+///
+/// The stage can be used standalone on buffer lists or placed in front of CAExtAudioFile::Write, in which case the
+/// file's client data format must be the destination format.
+class DitherStage final {
+  public:
+    /// Dither probability density functions.
+    enum class Dither {
+        /// No dither; samples are rounded to the nearest integer.
+        none,
+        /// Rectangular dither of ±½ LSB.
+        rectangular,
+        /// Triangular dither of ±1 LSB.
+        triangular,
+    };
+
+    /// Noise-shaping filters applied to the quantization error.
+    enum class NoiseShaping {
+        /// No noise shaping.
+        none,
+        /// First-order highpass error feedback.
+        firstOrder,
+        /// Lipshitz 5-tap E-weighted filter, designed for 44.1 kHz.
+        lipshitz,
+        /// Wannamaker 9-tap F-weighted filter, designed for 44.1 kHz.
+        wannamaker,
+    };
+
+    /// Creates a dither stage.
+    DitherStage() noexcept = default;
+
+    // This class is non-copyable
+    DitherStage(const DitherStage &) = delete;
+
+    // This class is non-assignable
+    DitherStage &operator=(const DitherStage &) = delete;
+
+    /// Move constructor.
+    DitherStage(DitherStage &&other) noexcept = default;
+
+    /// Move assignment operator.
+    DitherStage &operator=(DitherStage &&other) noexcept = default;
+
+    /// Destroys the dither stage and releases all associated resources.
+    ~DitherStage() noexcept = default;
+
+    /// Returns true if the dither stage has been created.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Creates a new dither stage.
+    ///
+    /// The source format must be native-endian 32-bit float linear PCM. The destination format must be native-endian
+    /// packed signed integer linear PCM of 8, 16, 24, or 32 bits with the same sample rate, channel count, and
+    /// interleaving.
+    /// @param inSourceFormat The source format.
+    /// @param inDestinationFormat The destination format.
+    /// @param dither The dither to add before quantizing.
+    /// @param noiseShaping The noise-shaping filter.
+    /// @param seed The seed from which each channel's generator is derived.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void New(const AudioStreamBasicDescription &inSourceFormat, const AudioStreamBasicDescription &inDestinationFormat,
+             Dither dither = Dither::triangular, NoiseShaping noiseShaping = NoiseShaping::none, UInt32 seed = 0);
+
+    /// Destroys the dither stage.
+    void Dispose() noexcept;
+
+    /// Clears the noise-shaping state and reseeds the generators.
+    void Reset() noexcept;
+
+    /// Returns the source format.
+    [[nodiscard]] const AudioStreamBasicDescription &SourceFormat() const noexcept;
+
+    /// Returns the destination format.
+    [[nodiscard]] const AudioStreamBasicDescription &DestinationFormat() const noexcept;
+
+    /// Returns the dither.
+    [[nodiscard]] Dither DitherType() const noexcept;
+
+    /// Returns the noise-shaping filter.
+    [[nodiscard]] NoiseShaping NoiseShapingType() const noexcept;
+
+    /// Quantizes frames from one buffer list into another.
+    ///
+    /// This does not allocate memory. The output buffer sizes are set to the number of bytes written.
+    /// @param inNumberFrames The number of frames to quantize.
+    /// @param inInputData The input buffers in the source format.
+    /// @param outOutputData The output buffers in the destination format.
+    /// @throw std::system_error if the buffers are too small.
+    void Process(UInt32 inNumberFrames, const AudioBufferList *inInputData, AudioBufferList *outOutputData);
+
+    /// Quantizes frames and writes them to an extended audio file.
+    ///
+    /// Frames are quantized into an internal buffer and written in blocks. This does not allocate memory.
+    /// @param extAudioFile A file open for writing with the destination format as its client data format.
+    /// @param inNumberFrames The number of frames to write.
+    /// @param inInputData The input buffers in the source format.
+    /// @throw std::system_error.
+    void Write(CAExtAudioFile &extAudioFile, UInt32 inNumberFrames, const AudioBufferList *inInputData);
+
+  private:
+    /// Quantizes frameCount frames, which must not exceed the block size, between the given frame offsets.
+    void ProcessBlock(const AudioBufferList *inInputData, UInt32 inputOffset, AudioBufferList *outOutputData,
+                      UInt32 outputOffset, UInt32 frameCount) noexcept;
+
+    /// The source format.
+    AudioStreamBasicDescription sourceFormat_{};
+    /// The destination format.
+    AudioStreamBasicDescription destinationFormat_{};
+    /// The dither.
+    Dither dither_{Dither::triangular};
+    /// The noise-shaping filter.
+    NoiseShaping noiseShaping_{NoiseShaping::none};
+    /// The seed from which each channel's generator is derived.
+    UInt32 seed_{0};
+
+    /// The state of each channel's four-lane xorshift generator.
+    std::vector<UInt32> generators_;
+    /// The last four dither values generated for each channel.
+    std::vector<float> leftoverNoise_;
+    /// The number of unused values at the end of each channel's leftover dither values.
+    std::size_t leftoverNoiseCount_{0};
+    /// The most recent quantization errors of each channel, newest first.
+    std::vector<float> errors_;
+    /// Dither values for one block laid out like the samples in an input buffer.
+    std::vector<float> noise_;
+    /// Storage for the buffer list and samples used by Write.
+    std::vector<unsigned char> writeBuffer_;
+};
+
+// MARK: - Implementation -
+
+inline DitherStage::operator bool() const noexcept { return !generators_.empty(); }
+
+inline const AudioStreamBasicDescription &DitherStage::SourceFormat() const noexcept { return sourceFormat_; }
+
+inline const AudioStreamBasicDescription &DitherStage::DestinationFormat() const noexcept { return destinationFormat_; }
+
+inline DitherStage::Dither DitherStage::DitherType() const noexcept { return dither_; }
+
+inline DitherStage::NoiseShaping DitherStage::NoiseShapingType() const noexcept { return noiseShaping_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
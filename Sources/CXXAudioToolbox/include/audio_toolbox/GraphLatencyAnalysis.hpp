@@ -0,0 +1,75 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AUGraph.h>
+
+#include <map>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A topology-aware analysis of the latency and tail time of an Audio Unit graph.
+///
+/// Latency accumulates along each path from a source node to a sink node, so the latency of a graph is that of its
+/// critical path, the path with the most latency, rather than the sum over all nodes. Where parallel branches merge the
+/// branches with less latency must be delayed to stay aligned; the analysis reports the delay needed on each
+/// connection. Tail times accumulate along paths in the same way.
+///
+/// The analysis operates on a plain description of the topology and does not require a live AUGraph.
+struct GraphLatencyAnalysis {
+    /// The latency and tail time of a node.
+    struct NodeTiming {
+        /// The latency of the node in seconds.
+        Float64 latency_{0};
+        /// The tail time of the node in seconds.
+        Float64 tailTime_{0};
+    };
+
+    /// The topology of a graph.
+    struct Topology {
+        /// The nodes of the graph and their timing.
+        std::map<AUNode, NodeTiming> nodes_;
+        /// The connections between nodes.
+        std::vector<AUNodeConnection> connections_;
+    };
+
+    /// The delay needed on a connection to align it with the other inputs of its destination node.
+    struct Compensation {
+        /// The connection.
+        AUNodeConnection connection_;
+        /// The delay in seconds.
+        Float64 delay_;
+    };
+
+    /// The latency of the critical path in seconds.
+    Float64 latency_{0};
+    /// The tail time of the path with the longest tail in seconds.
+    Float64 tailTime_{0};
+    /// The nodes of the critical path, from source to sink.
+    std::vector<AUNode> criticalPath_;
+    /// The latency of the path with the most latency ending at the output of each node, in seconds.
+    std::map<AUNode, Float64> pathLatency_;
+    /// The tail time of the path with the longest tail ending at the output of each node, in seconds.
+    std::map<AUNode, Float64> pathTailTime_;
+    /// The connections needing delay to align parallel branches, in the order of Topology::connections_.
+    std::vector<Compensation> compensation_;
+
+    /// Analyzes a graph topology.
+    /// @param topology The topology to analyze.
+    /// @return The analysis.
+    /// @throw std::invalid_argument if a connection refers to an unknown node or the connections form a cycle.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] static GraphLatencyAnalysis Analyze(const Topology &topology);
+};
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,143 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AUGraph.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// An immutable snapshot of the nodes and interactions of an Audio Unit graph.
+///
+/// Nodes are stored in ascending order. The interactions, successors, and predecessors of each node are stored
+/// contiguously in flat arrays indexed by per-node offsets, so walking the topology touches no per-node allocations.
+/// The snapshot records the topology version of the graph it was taken from; a snapshot with the same version as the
+/// graph is current.
+class GraphSnapshot final {
+  public:
+    /// A contiguous read-only range of elements.
+    template <typename T> class Range final {
+      public:
+        /// Creates an empty range.
+        constexpr Range() noexcept = default;
+
+        /// Creates a range of elements.
+        constexpr Range(const T *_Nullable first, const T *_Nullable last) noexcept : first_{first}, last_{last} {}
+
+        /// Returns a pointer to the first element.
+        [[nodiscard]] constexpr const T *_Nullable begin() const noexcept { return first_; }
+
+        /// Returns a pointer past the last element.
+        [[nodiscard]] constexpr const T *_Nullable end() const noexcept { return last_; }
+
+        /// Returns the number of elements.
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return static_cast<std::size_t>(last_ - first_); }
+
+        /// Returns true if the range contains no elements.
+        [[nodiscard]] constexpr bool empty() const noexcept { return first_ == last_; }
+
+        /// Returns the element at an index.
+        [[nodiscard]] constexpr const T &operator[](std::size_t index) const noexcept { return first_[index]; }
+
+      private:
+        /// The first element.
+        const T *_Nullable first_{nullptr};
+        /// Past the last element.
+        const T *_Nullable last_{nullptr};
+    };
+
+    /// Creates an empty snapshot.
+    GraphSnapshot() noexcept = default;
+
+    /// Creates a snapshot from a graph's nodes and interactions.
+    /// @param nodes The graph's nodes in any order.
+    /// @param interactions The graph's interactions.
+    /// @param version The topology version of the graph.
+    /// @throw std::invalid_argument if an interaction refers to an unknown node.
+    /// @throw std::bad_alloc.
+    GraphSnapshot(std::vector<AUNode> nodes, std::vector<AUNodeInteraction> interactions, UInt64 version);
+
+    /// Returns the topology version of the graph when the snapshot was taken.
+    [[nodiscard]] UInt64 Version() const noexcept;
+
+    /// Returns the number of nodes.
+    [[nodiscard]] std::size_t NodeCount() const noexcept;
+
+    /// Returns the nodes in ascending order.
+    [[nodiscard]] const std::vector<AUNode> &Nodes() const noexcept;
+
+    /// Returns the index of a node in Nodes() or std::nullopt if the node is not in the snapshot.
+    [[nodiscard]] std::optional<std::size_t> IndexOf(AUNode node) const noexcept;
+
+    /// Returns all interactions in the order reported by the graph.
+    [[nodiscard]] const std::vector<AUNodeInteraction> &Interactions() const noexcept;
+
+    /// Returns the interactions involving the node at an index, either as the source or destination of a connection
+    /// or as the destination of an input callback.
+    [[nodiscard]] Range<AUNodeInteraction> NodeInteractions(std::size_t index) const noexcept;
+
+    /// Returns the indexes of the nodes connected to the outputs of the node at an index.
+    [[nodiscard]] Range<std::size_t> Successors(std::size_t index) const noexcept;
+
+    /// Returns the indexes of the nodes connected to the inputs of the node at an index.
+    [[nodiscard]] Range<std::size_t> Predecessors(std::size_t index) const noexcept;
+
+  private:
+    /// The topology version of the graph.
+    UInt64 version_{0};
+    /// The nodes in ascending order.
+    std::vector<AUNode> nodes_;
+    /// The interactions in the order reported by the graph.
+    std::vector<AUNodeInteraction> interactions_;
+    /// The offsets of each node's interactions in nodeInteractions_.
+    std::vector<std::size_t> nodeInteractionOffsets_;
+    /// The interactions of each node.
+    std::vector<AUNodeInteraction> nodeInteractions_;
+    /// The offsets of each node's successors in successors_.
+    std::vector<std::size_t> successorOffsets_;
+    /// The successor indexes of each node.
+    std::vector<std::size_t> successors_;
+    /// The offsets of each node's predecessors in predecessors_.
+    std::vector<std::size_t> predecessorOffsets_;
+    /// The predecessor indexes of each node.
+    std::vector<std::size_t> predecessors_;
+};
+
+// MARK: - Implementation -
+
+inline UInt64 GraphSnapshot::Version() const noexcept { return version_; }
+
+inline std::size_t GraphSnapshot::NodeCount() const noexcept { return nodes_.size(); }
+
+inline const std::vector<AUNode> &GraphSnapshot::Nodes() const noexcept { return nodes_; }
+
+inline const std::vector<AUNodeInteraction> &GraphSnapshot::Interactions() const noexcept { return interactions_; }
+
+inline GraphSnapshot::Range<AUNodeInteraction> GraphSnapshot::NodeInteractions(std::size_t index) const noexcept {
+    const auto *data = nodeInteractions_.data();
+    return {data + nodeInteractionOffsets_[index], data + nodeInteractionOffsets_[index + 1]};
+}
+
+inline GraphSnapshot::Range<std::size_t> GraphSnapshot::Successors(std::size_t index) const noexcept {
+    const auto *data = successors_.data();
+    return {data + successorOffsets_[index], data + successorOffsets_[index + 1]};
+}
+
+inline GraphSnapshot::Range<std::size_t> GraphSnapshot::Predecessors(std::size_t index) const noexcept {
+    const auto *data = predecessors_.data();
+    return {data + predecessorOffsets_[index], data + predecessorOffsets_[index + 1]};
+}
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
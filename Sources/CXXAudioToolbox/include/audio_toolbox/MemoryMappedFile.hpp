@@ -0,0 +1,128 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAudioFile.hpp>
+
+#include <AudioToolbox/AudioFile.h>
+
+#include <cstddef>
+#include <utility>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A read-only memory-mapped file usable as an AudioFile data source.
+///
+/// The mapping supplies the read and get size callbacks used by CAAudioFile::OpenWithCallbacks. For linear PCM files
+/// the audio data may also be accessed directly in the mapping, avoiding a copy into a client buffer.
+class MemoryMappedFile final {
+  public:
+    /// Creates an empty memory-mapped file.
+    MemoryMappedFile() noexcept = default;
+
+    // This class is non-copyable
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+
+    // This class is non-assignable
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    /// Move constructor.
+    MemoryMappedFile(MemoryMappedFile &&other) noexcept;
+
+    /// Move assignment operator.
+    MemoryMappedFile &operator=(MemoryMappedFile &&other) noexcept;
+
+    /// Unmaps the file and releases all associated resources.
+    ~MemoryMappedFile() noexcept;
+
+    /// Returns true if a file is mapped.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Maps the file at path into memory.
+    /// @throw std::system_error.
+    void Map(const char *path);
+
+    /// Maps the file specified by a CFURLRef into memory.
+    /// @throw std::system_error.
+    void Map(CFURLRef inURL);
+
+    /// Unmaps the file.
+    void Unmap() noexcept;
+
+    /// Returns the beginning of the mapping.
+    [[nodiscard]] const void *_Nullable Data() const noexcept;
+
+    /// Returns the size of the mapping in bytes.
+    [[nodiscard]] SInt64 Size() const noexcept;
+
+    /// Opens an audio file reading from the mapping.
+    /// @note The mapping must outlive audioFile and must not be moved while audioFile is open.
+    /// @throw std::system_error.
+    void OpenAudioFile(CAAudioFile &audioFile, AudioFileTypeID inFileTypeHint = 0);
+
+    /// Returns a pointer to packets of linear PCM audio data in the mapping.
+    ///
+    /// This is a zero-copy alternative to CAAudioFile::ReadPacketData for files having a constant packet size.
+    /// @param audioFile An audio file opened on this mapping.
+    /// @param inStartingPacket The first packet to access.
+    /// @param ioNumPackets On entry the number of packets to access. On exit the number of packets available, which
+    /// is 0 at end of file.
+    /// @param outNumBytes On exit the number of bytes of audio data available at the returned pointer.
+    /// @return A pointer to the packets, or nullptr if ioNumPackets is 0 on exit.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument if the file's data format does not have a constant packet size.
+    const void *_Nullable PCMPacketData(const CAAudioFile &audioFile, SInt64 inStartingPacket, UInt32 &ioNumPackets,
+                                        UInt32 &outNumBytes) const;
+
+    /// An AudioFile_ReadProc reading from a MemoryMappedFile passed as inClientData.
+    static OSStatus ReadProc(void *inClientData, SInt64 inPosition, UInt32 requestCount, void *buffer,
+                             UInt32 *actualCount) noexcept;
+
+    /// An AudioFile_GetSizeProc for a MemoryMappedFile passed as inClientData.
+    static SInt64 GetSizeProc(void *inClientData) noexcept;
+
+    /// Swaps the mapping with the mapping from another memory-mapped file.
+    void swap(MemoryMappedFile &other) noexcept;
+
+  private:
+    /// The beginning of the mapping.
+    void *_Nullable data_{nullptr};
+    /// The size of the mapping in bytes.
+    std::size_t size_{0};
+};
+
+// MARK: - Implementation -
+
+inline MemoryMappedFile::MemoryMappedFile(MemoryMappedFile &&other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+
+inline MemoryMappedFile &MemoryMappedFile::operator=(MemoryMappedFile &&other) noexcept {
+    Unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+inline MemoryMappedFile::~MemoryMappedFile() noexcept { Unmap(); }
+
+inline MemoryMappedFile::operator bool() const noexcept { return data_ != nullptr; }
+
+inline const void *_Nullable MemoryMappedFile::Data() const noexcept { return data_; }
+
+inline SInt64 MemoryMappedFile::Size() const noexcept { return static_cast<SInt64>(size_); }
+
+inline void MemoryMappedFile::swap(MemoryMappedFile &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+}
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
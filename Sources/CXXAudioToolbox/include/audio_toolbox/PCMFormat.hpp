@@ -0,0 +1,552 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AudioConverter.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+namespace detail {
+
+/// True if the native byte order is big-endian.
+inline constexpr bool kNativeBigEndian = (kAudioFormatFlagsNativeEndian & kAudioFormatFlagIsBigEndian) != 0;
+
+} /* namespace detail */
+
+/// Linear PCM sample types.
+enum class PCMSampleType {
+    /// Signed integer samples.
+    signedInteger,
+    /// Floating-point samples.
+    floatingPoint,
+};
+
+/// A description of a packed linear PCM format without its sample rate.
+///
+/// Supported formats are 16-bit, 24-bit, and 32-bit signed integer and 32-bit and 64-bit floating-point samples
+/// occupying their full width in either byte order.
+struct PCMFormatDescriptor {
+    /// The sample type.
+    PCMSampleType sampleType_;
+    /// The number of bits in each sample.
+    UInt32 bitsPerChannel_;
+    /// True if samples are big-endian.
+    bool bigEndian_;
+    /// True if channels are interleaved in a single buffer.
+    bool interleaved_;
+    /// The number of channels.
+    UInt32 channelsPerFrame_;
+
+    /// Returns the descriptor of a format or std::nullopt if the format is not supported.
+    [[nodiscard]] static constexpr std::optional<PCMFormatDescriptor>
+    FromStreamDescription(const AudioStreamBasicDescription &format) noexcept;
+
+    /// Returns true if the descriptor describes a supported format.
+    [[nodiscard]] constexpr bool IsSupported() const noexcept;
+
+    /// Returns the size of one sample in bytes.
+    [[nodiscard]] constexpr UInt32 BytesPerSample() const noexcept;
+
+    /// Returns the size of one frame in each buffer in bytes.
+    [[nodiscard]] constexpr UInt32 BytesPerFrame() const noexcept;
+
+    /// Returns the number of buffers holding the channels.
+    [[nodiscard]] constexpr UInt32 BufferCount() const noexcept;
+
+    /// Returns the stream description of the format at a sample rate.
+    [[nodiscard]] constexpr AudioStreamBasicDescription StreamDescription(Float64 sampleRate) const noexcept;
+
+    /// Returns true if two descriptors describe the same format.
+    [[nodiscard]] constexpr bool operator==(const PCMFormatDescriptor &other) const noexcept;
+
+    /// Returns true if two descriptors describe different formats.
+    [[nodiscard]] constexpr bool operator!=(const PCMFormatDescriptor &other) const noexcept;
+};
+
+/// A packed linear PCM format known at compile time.
+template <PCMSampleType SampleType, UInt32 BitsPerChannel, bool BigEndian, bool Interleaved, UInt32 ChannelsPerFrame>
+struct PCMFormat {
+    /// The descriptor of the format.
+    static constexpr PCMFormatDescriptor kDescriptor{SampleType, BitsPerChannel, BigEndian, Interleaved,
+                                                     ChannelsPerFrame};
+
+    static_assert(kDescriptor.IsSupported(), "Unsupported linear PCM format");
+
+    /// Returns the stream description of the format at a sample rate.
+    [[nodiscard]] static constexpr AudioStreamBasicDescription StreamDescription(Float64 sampleRate) noexcept;
+
+    /// Returns true if format is this format at any sample rate.
+    [[nodiscard]] static constexpr bool Matches(const AudioStreamBasicDescription &format) noexcept;
+};
+
+/// 16-bit signed integer linear PCM.
+template <UInt32 ChannelsPerFrame, bool Interleaved = true, bool BigEndian = detail::kNativeBigEndian>
+using Int16PCMFormat = PCMFormat<PCMSampleType::signedInteger, 16, BigEndian, Interleaved, ChannelsPerFrame>;
+
+/// Packed 24-bit signed integer linear PCM.
+template <UInt32 ChannelsPerFrame, bool Interleaved = true, bool BigEndian = detail::kNativeBigEndian>
+using Int24PCMFormat = PCMFormat<PCMSampleType::signedInteger, 24, BigEndian, Interleaved, ChannelsPerFrame>;
+
+/// 32-bit signed integer linear PCM.
+template <UInt32 ChannelsPerFrame, bool Interleaved = true, bool BigEndian = detail::kNativeBigEndian>
+using Int32PCMFormat = PCMFormat<PCMSampleType::signedInteger, 32, BigEndian, Interleaved, ChannelsPerFrame>;
+
+/// 32-bit floating-point linear PCM.
+template <UInt32 ChannelsPerFrame, bool Interleaved = true, bool BigEndian = detail::kNativeBigEndian>
+using Float32PCMFormat = PCMFormat<PCMSampleType::floatingPoint, 32, BigEndian, Interleaved, ChannelsPerFrame>;
+
+/// 64-bit floating-point linear PCM.
+template <UInt32 ChannelsPerFrame, bool Interleaved = true, bool BigEndian = detail::kNativeBigEndian>
+using Float64PCMFormat = PCMFormat<PCMSampleType::floatingPoint, 64, BigEndian, Interleaved, ChannelsPerFrame>;
+
+namespace detail {
+
+/// Returns the number of frames in an input buffer after checking that the converted frames fit in an output buffer.
+/// @param inputSize The size of the input in bytes, which must be a whole number of frames.
+/// @param inputBytesPerFrame The size of an input frame in bytes.
+/// @param outputCapacity The capacity of the output in bytes.
+/// @param outputBytesPerFrame The size of an output frame in bytes.
+/// @throw std::system_error with kAudioConverterErr_InvalidInputSize or kAudioConverterErr_InvalidOutputSize.
+[[nodiscard]] UInt32 PCMConverterFrameCount(UInt32 inputSize, UInt32 inputBytesPerFrame, UInt32 outputCapacity,
+                                            UInt32 outputBytesPerFrame);
+
+/// Throws if bufferList does not contain bufferCount buffers of at least byteCount bytes.
+/// @throw std::system_error with kAudio_ParamError.
+void ValidatePCMConverterBufferList(const AudioBufferList *bufferList, UInt32 bufferCount, UInt64 byteCount);
+
+/// Converts count 16-bit or 32-bit signed integer samples to 32-bit float with the fastest vector kernel supported by
+/// the processor.
+template <UInt32 IntBits, bool SwapInt, bool SwapFloat>
+void ConvertIntToFloat32(const void *input, void *output, std::size_t count) noexcept;
+
+/// Converts count 32-bit float samples to 16-bit or 32-bit signed integer with the fastest vector kernel supported by
+/// the processor.
+template <UInt32 IntBits, bool SwapFloat, bool SwapInt>
+void ConvertFloat32ToInt(const void *input, void *output, std::size_t count) noexcept;
+
+/// Loads and stores signed integer samples.
+template <UInt32 Bits, bool BigEndian> struct PCMIntegerCodec {
+    static_assert(Bits == 16 || Bits == 24 || Bits == 32);
+
+    using Value = std::int32_t;
+    static constexpr bool isFloat = false;
+    static constexpr std::size_t size = Bits / 8;
+    static constexpr UInt32 bits = Bits;
+    static constexpr bool swap = BigEndian != kNativeBigEndian;
+    static constexpr double scale = static_cast<double>(std::uint32_t{1} << (Bits - 1));
+
+    /// Returns the value of F to which samples are clipped.
+    template <typename F> static constexpr F Maximum() noexcept {
+        if constexpr (Bits == 32 && std::is_same_v<F, float>) {
+            // As in the built-in kernels, 2^31 is not representable as a 32-bit integer, so full scale is corrected to
+            // INT32_MAX after clipping
+            return static_cast<F>(scale);
+        } else {
+            return static_cast<F>(scale - 1);
+        }
+    }
+
+    static Value Load(const unsigned char *p) noexcept {
+        if constexpr (Bits == 24) {
+            std::uint32_t u;
+            if constexpr (BigEndian) {
+                u = (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8);
+            } else {
+                u = (std::uint32_t{p[2]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[0]} << 8);
+            }
+            // Arithmetic shift sign-extends
+            return static_cast<std::int32_t>(u) >> 8;
+        } else if constexpr (Bits == 16) {
+            std::uint16_t u;
+            std::memcpy(&u, p, sizeof u);
+            if constexpr (swap) {
+                u = __builtin_bswap16(u);
+            }
+            return static_cast<std::int16_t>(u);
+        } else {
+            std::uint32_t u;
+            std::memcpy(&u, p, sizeof u);
+            if constexpr (swap) {
+                u = __builtin_bswap32(u);
+            }
+            return static_cast<std::int32_t>(u);
+        }
+    }
+
+    static void Store(unsigned char *p, Value i) noexcept {
+        const auto u = static_cast<std::uint32_t>(i);
+        if constexpr (Bits == 24) {
+            if constexpr (BigEndian) {
+                p[0] = static_cast<unsigned char>(u >> 16);
+                p[1] = static_cast<unsigned char>(u >> 8);
+                p[2] = static_cast<unsigned char>(u);
+            } else {
+                p[0] = static_cast<unsigned char>(u);
+                p[1] = static_cast<unsigned char>(u >> 8);
+                p[2] = static_cast<unsigned char>(u >> 16);
+            }
+        } else if constexpr (Bits == 16) {
+            auto h = static_cast<std::uint16_t>(u);
+            if constexpr (swap) {
+                h = __builtin_bswap16(h);
+            }
+            std::memcpy(p, &h, sizeof h);
+        } else {
+            auto w = u;
+            if constexpr (swap) {
+                w = __builtin_bswap32(w);
+            }
+            std::memcpy(p, &w, sizeof w);
+        }
+    }
+};
+
+/// Loads and stores floating-point samples.
+template <UInt32 Bits, bool BigEndian> struct PCMFloatCodec {
+    static_assert(Bits == 32 || Bits == 64);
+
+    using Value = std::conditional_t<Bits == 32, float, double>;
+    using Word = std::conditional_t<Bits == 32, std::uint32_t, std::uint64_t>;
+    static constexpr bool isFloat = true;
+    static constexpr std::size_t size = Bits / 8;
+    static constexpr bool swap = BigEndian != kNativeBigEndian;
+
+    static Value Load(const unsigned char *p) noexcept {
+        Word u;
+        std::memcpy(&u, p, sizeof u);
+        if constexpr (swap) {
+            if constexpr (Bits == 32) {
+                u = __builtin_bswap32(u);
+            } else {
+                u = __builtin_bswap64(u);
+            }
+        }
+        Value f;
+        std::memcpy(&f, &u, sizeof f);
+        return f;
+    }
+
+    static void Store(unsigned char *p, Value f) noexcept {
+        Word u;
+        std::memcpy(&u, &f, sizeof u);
+        if constexpr (swap) {
+            if constexpr (Bits == 32) {
+                u = __builtin_bswap32(u);
+            } else {
+                u = __builtin_bswap64(u);
+            }
+        }
+        std::memcpy(p, &u, sizeof u);
+    }
+};
+
+/// The codec for samples of a format.
+template <typename Format, UInt32 Bits = Format::kDescriptor.bitsPerChannel_,
+          bool BigEndian = Format::kDescriptor.bigEndian_>
+using PCMCodec = std::conditional_t<Format::kDescriptor.sampleType_ == PCMSampleType::floatingPoint,
+                                    PCMFloatCodec<Bits, BigEndian>, PCMIntegerCodec<Bits, BigEndian>>;
+
+/// Converts one sample value between codecs.
+///
+/// Integer samples are scaled by 2^(bits - 1). Float samples are clipped to the integer range and rounded to nearest,
+/// ties to even, with NaN clipping to the minimum. Narrowing integer conversions discard the low bits.
+template <typename In, typename Out> typename Out::Value ConvertSample(typename In::Value v) noexcept {
+    if constexpr (In::isFloat && Out::isFloat) {
+        return static_cast<typename Out::Value>(v);
+    } else if constexpr (In::isFloat) {
+        using F = typename In::Value;
+        // Adding and subtracting 1.5 * 2^(mantissa bits) rounds exactly below 2^(mantissa bits - 1), so samples wider
+        // than that are rounded in double. Values too large to round exactly are clipped, as is NaN. Unlike
+        // std::nearbyint this needs no library call and vectorizes.
+        using R = std::conditional_t<(Out::bits + 1 <= std::numeric_limits<F>::digits - 1), F, double>;
+        constexpr auto magic = static_cast<R>(std::uint64_t{3} << (std::numeric_limits<R>::digits - 2));
+        constexpr auto minimum = static_cast<R>(-Out::scale);
+        constexpr auto maximum = static_cast<R>(Out::template Maximum<F>());
+        auto s = (static_cast<R>(v) * static_cast<R>(Out::scale) + magic) - magic;
+        s = s > minimum ? s : minimum;
+        s = s < maximum ? s : maximum;
+        if constexpr (maximum == static_cast<R>(Out::scale)) {
+            if (s == maximum) {
+                return INT32_MAX;
+            }
+        }
+        return static_cast<std::int32_t>(s);
+    } else if constexpr (Out::isFloat) {
+        using F = typename Out::Value;
+        constexpr auto scale = static_cast<F>(1 / In::scale);
+        return static_cast<F>(v) * scale;
+    } else if constexpr (In::bits < Out::bits) {
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(v) << (Out::bits - In::bits));
+    } else {
+        return v >> (In::bits - Out::bits);
+    }
+}
+
+/// Converts count contiguous samples between codecs.
+///
+/// Conversions between 32-bit float and 16-bit or 32-bit integer samples use the built-in vector kernels, which
+/// compilers do not match when vectorizing the scalar loop.
+template <typename In, typename Out>
+void ConvertSamples(const unsigned char *input, unsigned char *output, std::size_t count) noexcept {
+    if constexpr (In::isFloat && In::size == 4 && !Out::isFloat && Out::size != 3) {
+        ConvertFloat32ToInt<Out::bits, In::swap, Out::swap>(input, output, count);
+    } else if constexpr (!In::isFloat && In::size != 3 && Out::isFloat && Out::size == 4) {
+        ConvertIntToFloat32<In::bits, In::swap, Out::swap>(input, output, count);
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            Out::Store(output + i * Out::size, ConvertSample<In, Out>(In::Load(input + i * In::size)));
+        }
+    }
+}
+
+} /* namespace detail */
+
+/// A linear PCM converter between two formats known at compile time.
+///
+/// Each pair of formats generates its own conversion loop with the sample codecs, byte swapping, scaling, and channel
+/// count fixed at compile time, so no per-sample or per-buffer dispatch is performed. Runs of samples between 32-bit
+/// float and 16-bit or 32-bit integers call the built-in vector kernels directly; on x86-64 the AVX2 kernels are used
+/// if the processor supports them.
+///
+/// Conversions follow the rules of the built-in CAAudioConverter kernels: integer samples are scaled by 2^(bits - 1)
+/// and float samples are clipped and rounded to nearest, ties to even. Narrowing integer conversions discard the low
+/// bits. The formats may differ in interleaving.
+///
+/// The member functions mirror CAAudioConverter so either can be used where the formats are known statically.
+template <typename Source, typename Destination> class PCMConverter final {
+  public:
+    static_assert(Source::kDescriptor.channelsPerFrame_ == Destination::kDescriptor.channelsPerFrame_,
+                  "Source and destination channel counts must match");
+
+    /// Returns the source format at a sample rate.
+    [[nodiscard]] static constexpr AudioStreamBasicDescription SourceFormat(Float64 sampleRate) noexcept;
+
+    /// Returns the destination format at a sample rate.
+    [[nodiscard]] static constexpr AudioStreamBasicDescription DestinationFormat(Float64 sampleRate) noexcept;
+
+    /// Converts frames between interleaved buffers.
+    /// @param inInputData Interleaved frames in the source format.
+    /// @param outOutputData A buffer for the interleaved frames in the destination format.
+    /// @param inNumberPCMFrames The number of frames to convert.
+    static void Convert(const void *inInputData, void *outOutputData, std::size_t inNumberPCMFrames) noexcept;
+
+    /// Converts data from an input buffer to an output buffer.
+    ///
+    /// Both formats must be interleaved.
+    /// @param inInputDataSize The size of the input in bytes, which must be a whole number of frames.
+    /// @param inInputData The input frames.
+    /// @param ioOutputDataSize On input the capacity of outOutputData in bytes. On output the number of bytes written.
+    /// @param outOutputData The output buffer.
+    /// @throw std::system_error.
+    static void ConvertBuffer(UInt32 inInputDataSize, const void *inInputData, UInt32 &ioOutputDataSize,
+                              void *outOutputData);
+
+    /// Converts PCM data from an input buffer list to an output buffer list.
+    ///
+    /// The output buffer sizes are set to the number of bytes written.
+    /// @param inNumberPCMFrames The number of frames to convert.
+    /// @param inInputData The input buffers in the source format.
+    /// @param outOutputData The output buffers in the destination format.
+    /// @throw std::system_error if the buffers do not match the formats or are too small.
+    static void ConvertComplexBuffer(UInt32 inNumberPCMFrames, const AudioBufferList *inInputData,
+                                     AudioBufferList *outOutputData);
+
+  private:
+    using In = detail::PCMCodec<Source>;
+    using Out = detail::PCMCodec<Destination>;
+
+    static constexpr UInt32 kChannels = Source::kDescriptor.channelsPerFrame_;
+};
+
+// MARK: - Implementation -
+
+constexpr std::optional<PCMFormatDescriptor>
+PCMFormatDescriptor::FromStreamDescription(const AudioStreamBasicDescription &format) noexcept {
+    const auto flags = format.mFormatFlags;
+    if (format.mFormatID != kAudioFormatLinearPCM || format.mFramesPerPacket != 1 ||
+        format.mBytesPerPacket != format.mBytesPerFrame || format.mChannelsPerFrame == 0 ||
+        (flags & kLinearPCMFormatFlagsSampleFractionMask) != 0) {
+        return std::nullopt;
+    }
+
+    const PCMFormatDescriptor descriptor{
+        (flags & kAudioFormatFlagIsFloat) ? PCMSampleType::floatingPoint : PCMSampleType::signedInteger,
+        format.mBitsPerChannel, (flags & kAudioFormatFlagIsBigEndian) != 0,
+        (flags & kAudioFormatFlagIsNonInterleaved) == 0, format.mChannelsPerFrame};
+
+    if (!descriptor.IsSupported() || format.mBytesPerFrame != descriptor.BytesPerFrame() ||
+        (descriptor.sampleType_ == PCMSampleType::signedInteger && !(flags & kAudioFormatFlagIsSignedInteger))) {
+        return std::nullopt;
+    }
+    return descriptor;
+}
+
+constexpr bool PCMFormatDescriptor::IsSupported() const noexcept {
+    if (channelsPerFrame_ == 0) {
+        return false;
+    }
+    if (sampleType_ == PCMSampleType::floatingPoint) {
+        return bitsPerChannel_ == 32 || bitsPerChannel_ == 64;
+    }
+    return bitsPerChannel_ == 16 || bitsPerChannel_ == 24 || bitsPerChannel_ == 32;
+}
+
+constexpr UInt32 PCMFormatDescriptor::BytesPerSample() const noexcept { return bitsPerChannel_ / 8; }
+
+constexpr UInt32 PCMFormatDescriptor::BytesPerFrame() const noexcept {
+    return interleaved_ ? BytesPerSample() * channelsPerFrame_ : BytesPerSample();
+}
+
+constexpr UInt32 PCMFormatDescriptor::BufferCount() const noexcept { return interleaved_ ? 1 : channelsPerFrame_; }
+
+constexpr AudioStreamBasicDescription PCMFormatDescriptor::StreamDescription(Float64 sampleRate) const noexcept {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = sampleRate;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagIsPacked;
+    format.mFormatFlags |=
+            sampleType_ == PCMSampleType::floatingPoint ? kAudioFormatFlagIsFloat : kAudioFormatFlagIsSignedInteger;
+    if (bigEndian_) {
+        format.mFormatFlags |= kAudioFormatFlagIsBigEndian;
+    }
+    if (!interleaved_) {
+        format.mFormatFlags |= kAudioFormatFlagIsNonInterleaved;
+    }
+    format.mBytesPerPacket = BytesPerFrame();
+    format.mFramesPerPacket = 1;
+    format.mBytesPerFrame = BytesPerFrame();
+    format.mChannelsPerFrame = channelsPerFrame_;
+    format.mBitsPerChannel = bitsPerChannel_;
+    return format;
+}
+
+constexpr bool PCMFormatDescriptor::operator==(const PCMFormatDescriptor &other) const noexcept {
+    return sampleType_ == other.sampleType_ && bitsPerChannel_ == other.bitsPerChannel_ &&
+           bigEndian_ == other.bigEndian_ && interleaved_ == other.interleaved_ &&
+           channelsPerFrame_ == other.channelsPerFrame_;
+}
+
+constexpr bool PCMFormatDescriptor::operator!=(const PCMFormatDescriptor &other) const noexcept {
+    return !(*this == other);
+}
+
+template <PCMSampleType SampleType, UInt32 BitsPerChannel, bool BigEndian, bool Interleaved, UInt32 ChannelsPerFrame>
+constexpr AudioStreamBasicDescription
+PCMFormat<SampleType, BitsPerChannel, BigEndian, Interleaved, ChannelsPerFrame>::StreamDescription(
+        Float64 sampleRate) noexcept {
+    return kDescriptor.StreamDescription(sampleRate);
+}
+
+template <PCMSampleType SampleType, UInt32 BitsPerChannel, bool BigEndian, bool Interleaved, UInt32 ChannelsPerFrame>
+constexpr bool PCMFormat<SampleType, BitsPerChannel, BigEndian, Interleaved, ChannelsPerFrame>::Matches(
+        const AudioStreamBasicDescription &format) noexcept {
+    const auto descriptor = PCMFormatDescriptor::FromStreamDescription(format);
+    return descriptor && *descriptor == kDescriptor;
+}
+
+template <typename Source, typename Destination>
+constexpr AudioStreamBasicDescription PCMConverter<Source, Destination>::SourceFormat(Float64 sampleRate) noexcept {
+    return Source::StreamDescription(sampleRate);
+}
+
+template <typename Source, typename Destination>
+constexpr AudioStreamBasicDescription
+PCMConverter<Source, Destination>::DestinationFormat(Float64 sampleRate) noexcept {
+    return Destination::StreamDescription(sampleRate);
+}
+
+template <typename Source, typename Destination>
+inline void PCMConverter<Source, Destination>::Convert(const void *inInputData, void *outOutputData,
+                                                       std::size_t inNumberPCMFrames) noexcept {
+    static_assert(Source::kDescriptor.interleaved_ && Destination::kDescriptor.interleaved_,
+                  "Convert requires interleaved formats");
+    detail::ConvertSamples<In, Out>(static_cast<const unsigned char *>(inInputData),
+                                    static_cast<unsigned char *>(outOutputData), inNumberPCMFrames * kChannels);
+}
+
+template <typename Source, typename Destination>
+inline void PCMConverter<Source, Destination>::ConvertBuffer(UInt32 inInputDataSize, const void *inInputData,
+                                                             UInt32 &ioOutputDataSize, void *outOutputData) {
+    static_assert(Source::kDescriptor.interleaved_ && Destination::kDescriptor.interleaved_,
+                  "ConvertBuffer requires interleaved formats");
+    constexpr auto inputBytesPerFrame = Source::kDescriptor.BytesPerFrame();
+    constexpr auto outputBytesPerFrame = Destination::kDescriptor.BytesPerFrame();
+
+    const auto frameCount =
+            detail::PCMConverterFrameCount(inInputDataSize, inputBytesPerFrame, ioOutputDataSize, outputBytesPerFrame);
+    Convert(inInputData, outOutputData, frameCount);
+    ioOutputDataSize = frameCount * outputBytesPerFrame;
+}
+
+template <typename Source, typename Destination>
+inline void PCMConverter<Source, Destination>::ConvertComplexBuffer(UInt32 inNumberPCMFrames,
+                                                                    const AudioBufferList *inInputData,
+                                                                    AudioBufferList *outOutputData) {
+    constexpr auto inputBuffers = Source::kDescriptor.BufferCount();
+    constexpr auto outputBuffers = Destination::kDescriptor.BufferCount();
+    const auto inputBytes = static_cast<UInt64>(inNumberPCMFrames) * Source::kDescriptor.BytesPerFrame();
+    const auto outputBytes = static_cast<UInt64>(inNumberPCMFrames) * Destination::kDescriptor.BytesPerFrame();
+
+    detail::ValidatePCMConverterBufferList(inInputData, inputBuffers, inputBytes);
+    detail::ValidatePCMConverterBufferList(outOutputData, outputBuffers, outputBytes);
+
+    std::array<const unsigned char *, inputBuffers> inputs;
+    for (UInt32 i = 0; i < inputBuffers; ++i) {
+        inputs[i] = static_cast<const unsigned char *>(inInputData->mBuffers[i].mData);
+    }
+
+    std::array<unsigned char *, outputBuffers> outputs;
+    for (UInt32 i = 0; i < outputBuffers; ++i) {
+        outputs[i] = static_cast<unsigned char *>(outOutputData->mBuffers[i].mData);
+    }
+
+    const std::size_t frameCount = inNumberPCMFrames;
+    if constexpr (inputBuffers == outputBuffers) {
+        // Matching layouts convert each buffer as a run of samples
+        constexpr auto samplesPerFrame = kChannels / inputBuffers;
+        for (UInt32 i = 0; i < inputBuffers; ++i) {
+            detail::ConvertSamples<In, Out>(inputs[i], outputs[i], frameCount * samplesPerFrame);
+        }
+    } else if constexpr (inputBuffers == 1) {
+        // Deinterleave
+        for (std::size_t frame = 0; frame < frameCount; ++frame) {
+            const auto *input = inputs[0] + frame * kChannels * In::size;
+            for (UInt32 channel = 0; channel < kChannels; ++channel) {
+                Out::Store(outputs[channel] + frame * Out::size,
+                           detail::ConvertSample<In, Out>(In::Load(input + channel * In::size)));
+            }
+        }
+    } else {
+        // Interleave
+        for (std::size_t frame = 0; frame < frameCount; ++frame) {
+            auto *output = outputs[0] + frame * kChannels * Out::size;
+            for (UInt32 channel = 0; channel < kChannels; ++channel) {
+                Out::Store(output + channel * Out::size,
+                           detail::ConvertSample<In, Out>(In::Load(inputs[channel] + frame * In::size)));
+            }
+        }
+    }
+
+    for (UInt32 i = 0; i < outputBuffers; ++i) {
+        outOutputData->mBuffers[i].mDataByteSize = static_cast<UInt32>(outputBytes);
+    }
+}
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,57 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AudioConverter.h>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+namespace pcm_layout {
+
+/// Returns true if two formats are linear PCM formats that differ only in interleaving.
+///
+/// Buffers in such formats can be converted with Convert() without changing any sample values. Identical formats
+/// require no conversion and return false.
+[[nodiscard]] bool IsLayoutConversion(const AudioStreamBasicDescription &inSourceFormat,
+                                      const AudioStreamBasicDescription &inDestinationFormat) noexcept;
+
+/// Copies frames between buffer lists, interleaving or deinterleaving samples as required by the formats.
+///
+/// The output buffer sizes are set to the number of bytes written.
+/// @param inSourceFormat The format of inInputData.
+/// @param inDestinationFormat The format of outOutputData.
+/// @param inNumberPCMFrames The number of frames to copy.
+/// @param inInputData The input buffers.
+/// @param outOutputData The output buffers.
+/// @throw std::system_error if the formats are not a layout conversion or the buffers are too small.
+void Convert(const AudioStreamBasicDescription &inSourceFormat, const AudioStreamBasicDescription &inDestinationFormat,
+             UInt32 inNumberPCMFrames, const AudioBufferList *inInputData, AudioBufferList *outOutputData);
+
+/// Interleaves samples from separate channel buffers into a single buffer.
+/// @param inBytesPerSample The size of one sample in bytes.
+/// @param inNumberChannels The number of channels.
+/// @param inNumberPCMFrames The number of frames to interleave.
+/// @param inInputData An array of inNumberChannels pointers to channel buffers.
+/// @param outOutputData A buffer of at least inNumberPCMFrames * inNumberChannels * inBytesPerSample bytes.
+void Interleave(UInt32 inBytesPerSample, UInt32 inNumberChannels, UInt32 inNumberPCMFrames,
+                const void *const *inInputData, void *outOutputData) noexcept;
+
+/// Deinterleaves samples from a single buffer into separate channel buffers.
+/// @param inBytesPerSample The size of one sample in bytes.
+/// @param inNumberChannels The number of channels.
+/// @param inNumberPCMFrames The number of frames to deinterleave.
+/// @param inInputData A buffer of at least inNumberPCMFrames * inNumberChannels * inBytesPerSample bytes.
+/// @param outOutputData An array of inNumberChannels pointers to channel buffers.
+void Deinterleave(UInt32 inBytesPerSample, UInt32 inNumberChannels, UInt32 inNumberPCMFrames, const void *inInputData,
+                  void *const *outOutputData) noexcept;
+
+} /* namespace pcm_layout */
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
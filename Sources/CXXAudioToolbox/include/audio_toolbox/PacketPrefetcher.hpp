@@ -0,0 +1,132 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAudioFile.hpp>
+
+#include <core_audio/StreamDescription.hpp>
+
+#include <AudioToolbox/AudioFile.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A sequential packet reader that reads ahead of the consumer on a background thread.
+///
+/// Packets are read with CAAudioFile::ReadPacketData in fixed-size chunks and held in a bounded queue, so file I/O
+/// overlaps with the consumer's processing. Chunk buffers are allocated when reading starts and recycled thereafter.
+class PacketPrefetcher final {
+  public:
+    /// A range of packets read from the audio file.
+    struct Chunk {
+        /// The packet data, of which the first byteCount_ bytes are valid.
+        std::vector<unsigned char> data_;
+        /// Packet descriptions for data_, of which the first packetCount_ are valid.
+        /// This is empty if the format has a constant packet size.
+        std::vector<AudioStreamPacketDescription> packetDescriptions_;
+        /// The first packet in the chunk.
+        SInt64 startingPacket_{0};
+        /// The number of valid packets in the chunk.
+        UInt32 packetCount_{0};
+        /// The number of valid bytes in data_.
+        UInt32 byteCount_{0};
+    };
+
+    /// Creates a packet prefetcher taking ownership of an open audio file.
+    /// @param audioFile An audio file open for reading.
+    /// @param packetsPerChunk The number of packets read per call to CAAudioFile::ReadPacketData.
+    /// @param chunksInFlight The maximum number of chunks read ahead of the consumer.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument.
+    PacketPrefetcher(CAAudioFile &&audioFile, UInt32 packetsPerChunk = 4096, UInt32 chunksInFlight = 4);
+
+    // This class is non-copyable
+    PacketPrefetcher(const PacketPrefetcher &) = delete;
+
+    // This class is non-assignable
+    PacketPrefetcher &operator=(const PacketPrefetcher &) = delete;
+
+    /// Stops reading and releases all associated resources.
+    ~PacketPrefetcher() noexcept;
+
+    /// Returns the data format of the audio file.
+    [[nodiscard]] const core_audio::StreamDescription &DataFormat() const noexcept;
+
+    /// Starts reading packets, discarding any packets already read.
+    /// @param inStartingPacket The first packet to read.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void Start(SInt64 inStartingPacket = 0);
+
+    /// Stops reading packets.
+    void Stop() noexcept;
+
+    /// Returns the next chunk of packets, waiting until it has been read.
+    ///
+    /// The contents of chunk are exchanged with the next chunk in the queue, and the previous buffers in chunk are
+    /// reused for subsequent reads.
+    /// @return true if chunk contains packets, false at end of file or if reading is stopped.
+    /// @throw std::system_error if the background read failed.
+    bool ReadNext(Chunk &chunk);
+
+    /// Returns the managed audio file.
+    /// @note The audio file must not be used while reading is in progress.
+    [[nodiscard]] CAAudioFile &AudioFile() noexcept;
+
+  private:
+    /// Reads chunks until end of file, an error occurs, or reading is stopped.
+    void ReaderThreadEntry(SInt64 inStartingPacket) noexcept;
+
+    /// The managed audio file.
+    CAAudioFile audioFile_;
+    /// The audio file's data format.
+    core_audio::StreamDescription dataFormat_;
+    /// The number of packets read per chunk.
+    UInt32 packetsPerChunk_;
+    /// The maximum number of chunks read ahead.
+    UInt32 chunksInFlight_;
+    /// The maximum size of a chunk in bytes.
+    UInt32 chunkByteCapacity_{0};
+
+    /// Protects the queues and state below.
+    std::mutex mutex_;
+    /// Signaled when a chunk is queued or reading finishes.
+    std::condition_variable readyCondition_;
+    /// Signaled when a chunk is returned to the free list or reading is stopped.
+    std::condition_variable freeCondition_;
+    /// Chunks read but not yet consumed, in file order.
+    std::deque<Chunk> ready_;
+    /// Chunks available for reading.
+    std::vector<Chunk> free_;
+    /// The error that ended reading, if any.
+    std::exception_ptr error_;
+    /// True if the reader has reached end of file or failed.
+    bool finished_{true};
+    /// True if the reader should stop.
+    bool stopRequested_{false};
+    /// The background reader.
+    std::thread readerThread_;
+};
+
+// MARK: - Implementation -
+
+inline const core_audio::StreamDescription &PacketPrefetcher::DataFormat() const noexcept { return dataFormat_; }
+
+inline CAAudioFile &PacketPrefetcher::AudioFile() noexcept { return audioFile_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,182 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAudioFile.hpp>
+#include <audio_toolbox/MemoryMappedFile.hpp>
+
+#include <utility>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A persistent index of the packet byte offsets and frame positions in an audio file.
+///
+/// An index is built once from an open CAAudioFile and saved to a sidecar file keyed by the identity of the audio
+/// file. Loading a saved index maps the sidecar into memory and does not parse or copy the packet table.
+class PacketTableIndex final {
+  public:
+    /// The identity of an audio file used to detect stale indexes.
+    struct FileIdentity {
+        /// The size of the file in bytes.
+        UInt64 size_{0};
+        /// The modification time of the file in nanoseconds since the epoch.
+        SInt64 modificationTime_{0};
+        /// A hash of the first and last 64 KiB of the file.
+        UInt64 contentHash_{0};
+
+        /// Returns the identity of the file at path.
+        /// @throw std::system_error.
+        [[nodiscard]] static FileIdentity ForFile(const char *path);
+
+        [[nodiscard]] bool operator==(const FileIdentity &other) const noexcept;
+        [[nodiscard]] bool operator!=(const FileIdentity &other) const noexcept;
+    };
+
+    /// Creates an empty packet table index.
+    PacketTableIndex() noexcept = default;
+
+    // This class is non-copyable
+    PacketTableIndex(const PacketTableIndex &) = delete;
+
+    // This class is non-assignable
+    PacketTableIndex &operator=(const PacketTableIndex &) = delete;
+
+    /// Move constructor.
+    PacketTableIndex(PacketTableIndex &&other) noexcept;
+
+    /// Move assignment operator.
+    PacketTableIndex &operator=(PacketTableIndex &&other) noexcept;
+
+    /// Destroys the packet table index and releases all associated resources.
+    ~PacketTableIndex() noexcept = default;
+
+    /// Returns true if the index contains packets.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Builds the index from the packet table of an audio file.
+    /// @param audioFile An open audio file.
+    /// @param identity The identity of the file backing audioFile.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void Build(CAAudioFile &audioFile, const FileIdentity &identity);
+
+    /// Writes the index to a sidecar file at path.
+    /// @throw std::system_error.
+    void Save(const char *path) const;
+
+    /// Loads an index from a sidecar file at path.
+    /// @param path The sidecar file.
+    /// @param identity The identity of the audio file the index must describe.
+    /// @return true if the index was loaded, false if the sidecar does not exist, is malformed, is stale, or was
+    /// written on a host of a different byte order.
+    /// @throw std::system_error.
+    bool Load(const char *path, const FileIdentity &identity);
+
+    /// Removes all packets from the index.
+    void Clear() noexcept;
+
+    /// Returns the identity of the file the index describes.
+    [[nodiscard]] const FileIdentity &Identity() const noexcept;
+
+    /// Returns the number of packets in the index.
+    [[nodiscard]] UInt64 PacketCount() const noexcept;
+
+    /// Returns the number of frames in the indexed packets, including any priming and remainder frames.
+    [[nodiscard]] UInt64 FrameCount() const noexcept;
+
+    /// Returns the offset of a packet relative to the start of the audio data.
+    /// @note inPacket may equal PacketCount(), in which case the size of the audio data is returned.
+    [[nodiscard]] UInt64 ByteOffsetForPacket(UInt64 inPacket) const noexcept;
+
+    /// Returns the first frame of a packet.
+    /// @note inPacket may equal PacketCount(), in which case FrameCount() is returned.
+    [[nodiscard]] UInt64 FrameForPacket(UInt64 inPacket) const noexcept;
+
+    /// Returns the packet containing a frame, or PacketCount() if the frame is past the end of the audio.
+    [[nodiscard]] UInt64 PacketForFrame(UInt64 inFrame) const noexcept;
+
+    /// Fills packet descriptions for a range of packets.
+    ///
+    /// The descriptions are relative to the first packet, matching those returned by CAAudioFile::ReadPacketData.
+    /// @param inStartingPacket The first packet.
+    /// @param ioNumPackets On entry the number of packets to describe. On exit the number of packets described.
+    /// @param outPacketDescriptions An array of at least ioNumPackets packet descriptions.
+    /// @return The number of bytes of audio data in the described packets.
+    UInt64 GetPacketDescriptions(UInt64 inStartingPacket, UInt32 &ioNumPackets,
+                                 AudioStreamPacketDescription *outPacketDescriptions) const noexcept;
+
+  private:
+    /// The identity of the file the index describes.
+    FileIdentity identity_{};
+    /// The number of packets.
+    UInt64 packetCount_{0};
+    /// The number of frames per packet or 0 if variable.
+    UInt32 framesPerPacket_{0};
+    /// Packet byte offsets, with one trailing entry for the end of the audio data.
+    const UInt64 *_Nullable byteOffsets_{nullptr};
+    /// Packet frame positions, with one trailing entry for the end of the audio, or nullptr if framesPerPacket_ != 0.
+    const UInt64 *_Nullable framePositions_{nullptr};
+    /// Storage for a built index.
+    std::vector<UInt64> storage_;
+    /// Storage for a loaded index.
+    MemoryMappedFile mapping_;
+};
+
+// MARK: - Implementation -
+
+inline bool PacketTableIndex::FileIdentity::operator==(const FileIdentity &other) const noexcept {
+    return size_ == other.size_ && modificationTime_ == other.modificationTime_ && contentHash_ == other.contentHash_;
+}
+
+inline bool PacketTableIndex::FileIdentity::operator!=(const FileIdentity &other) const noexcept {
+    return !(*this == other);
+}
+
+inline PacketTableIndex::PacketTableIndex(PacketTableIndex &&other) noexcept
+    : identity_{std::exchange(other.identity_, {})}, packetCount_{std::exchange(other.packetCount_, 0)},
+      framesPerPacket_{std::exchange(other.framesPerPacket_, 0)},
+      byteOffsets_{std::exchange(other.byteOffsets_, nullptr)},
+      framePositions_{std::exchange(other.framePositions_, nullptr)}, storage_{std::move(other.storage_)},
+      mapping_{std::move(other.mapping_)} {}
+
+inline PacketTableIndex &PacketTableIndex::operator=(PacketTableIndex &&other) noexcept {
+    identity_ = std::exchange(other.identity_, {});
+    packetCount_ = std::exchange(other.packetCount_, 0);
+    framesPerPacket_ = std::exchange(other.framesPerPacket_, 0);
+    byteOffsets_ = std::exchange(other.byteOffsets_, nullptr);
+    framePositions_ = std::exchange(other.framePositions_, nullptr);
+    storage_ = std::move(other.storage_);
+    mapping_ = std::move(other.mapping_);
+    return *this;
+}
+
+inline PacketTableIndex::operator bool() const noexcept { return packetCount_ != 0; }
+
+inline const PacketTableIndex::FileIdentity &PacketTableIndex::Identity() const noexcept { return identity_; }
+
+inline UInt64 PacketTableIndex::PacketCount() const noexcept { return packetCount_; }
+
+inline UInt64 PacketTableIndex::FrameCount() const noexcept { return FrameForPacket(packetCount_); }
+
+inline UInt64 PacketTableIndex::ByteOffsetForPacket(UInt64 inPacket) const noexcept {
+    return byteOffsets_ ? byteOffsets_[inPacket] : 0;
+}
+
+inline UInt64 PacketTableIndex::FrameForPacket(UInt64 inPacket) const noexcept {
+    if (framesPerPacket_ != 0) {
+        return inPacket * framesPerPacket_;
+    }
+    return framePositions_ ? framePositions_[inPacket] : 0;
+}
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,95 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/ExtendedAudioFile.h>
+
+#include <memory>
+#include <mutex>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+namespace detail {
+class WorkStealingPool;
+} /* namespace detail */
+
+/// A decoder that decodes segments of a single file concurrently.
+///
+/// The file is divided into segments of consecutive frames. Each worker opens its own CAExtAudioFile, seeks to a
+/// segment, and writes the decoded frames directly to their position in the output. Decoding starts a number of
+/// pre-roll frames before each segment and discards them so codecs with inter-packet state, such as overlapped
+/// transforms or bit reservoirs, have converged by the segment's first frame. With sufficient pre-roll the output is
+/// identical to a sequential decode.
+class ParallelDecoder final {
+  public:
+    /// Creates a parallel decoder.
+    /// @param threadCount The number of threads, or 0 for one per hardware thread.
+    /// @param segmentFrames The number of frames in each segment.
+    /// @param prerollFrames The number of frames decoded and discarded before each segment.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument if segmentFrames is not positive or prerollFrames is negative.
+    /// @throw std::bad_alloc.
+    explicit ParallelDecoder(unsigned threadCount = 0, SInt64 segmentFrames = 1 << 20, SInt64 prerollFrames = 8192);
+
+    // This class is non-copyable
+    ParallelDecoder(const ParallelDecoder &) = delete;
+
+    // This class is non-assignable
+    ParallelDecoder &operator=(const ParallelDecoder &) = delete;
+
+    /// Stops the threads and releases all associated resources.
+    ~ParallelDecoder() noexcept;
+
+    /// Returns the number of threads used for decoding.
+    [[nodiscard]] unsigned ThreadCount() const noexcept;
+
+    /// Returns the number of frames in each segment.
+    [[nodiscard]] SInt64 SegmentFrames() const noexcept;
+
+    /// Returns the number of frames decoded and discarded before each segment.
+    [[nodiscard]] SInt64 PrerollFrames() const noexcept;
+
+    /// Decodes an entire file.
+    ///
+    /// The client data format must be linear PCM with the same sample rate as the file so frame positions in the file
+    /// and the output coincide. The buffers must have the layout implied by the client data format, and
+    /// CAExtAudioFile::FrameLength gives the number of frames required. Concurrent calls are serialized.
+    /// @param inURL The file to decode.
+    /// @param inClientDataFormat The format of the decoded audio.
+    /// @param ioBufferList On input buffers with capacity for the file's frames. On output the buffer sizes are set to
+    /// the number of bytes decoded.
+    /// @return The number of frames decoded.
+    /// @throw std::system_error, with std::errc::invalid_argument if the client data format or buffer list is
+    /// unsuitable.
+    /// @throw std::runtime_error if the file's frames do not match its reported length.
+    /// @throw std::bad_alloc.
+    SInt64 Decode(CFURLRef inURL, const AudioStreamBasicDescription &inClientDataFormat,
+                  AudioBufferList *ioBufferList);
+
+  private:
+    /// The thread pool.
+    std::unique_ptr<detail::WorkStealingPool> pool_;
+    /// The number of frames in each segment.
+    const SInt64 segmentFrames_;
+    /// The number of frames decoded and discarded before each segment.
+    const SInt64 prerollFrames_;
+    /// Serializes calls to Decode.
+    std::mutex decodeMutex_;
+};
+
+// MARK: - Implementation -
+
+inline SInt64 ParallelDecoder::SegmentFrames() const noexcept { return segmentFrames_; }
+
+inline SInt64 ParallelDecoder::PrerollFrames() const noexcept { return prerollFrames_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
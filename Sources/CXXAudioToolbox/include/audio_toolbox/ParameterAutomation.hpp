@@ -0,0 +1,137 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAUGraph.hpp>
+
+#include <AudioToolbox/AudioUnit.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// Sample-accurate parameter automation for the nodes of a running Audio Unit graph.
+///
+/// Each automated node has a bounded multiple-producer, single-consumer queue of timestamped parameter events,
+/// allocated when the automation is created. Any number of threads may schedule events without locking or blocking;
+/// scheduling is wait-free, and events that do not fit in a node's queue are dropped and counted.
+///
+/// The queues are drained on the render thread by a pre-render notification registered with the graph. Events due
+/// within a render slice are passed to the node's Audio Unit with AudioUnitScheduleParameters at the corresponding
+/// buffer offset. Events due in later slices are held until then, and events whose time has passed are applied at
+/// the start of the next slice.
+///
+/// Event times are sample times in the timeline of the graph's output, as reported to render notifications.
+/// @note The graph must outlive the automation, and the automated nodes' Audio Units must not change while it exists.
+class ParameterAutomation final {
+  public:
+    /// A parameter change.
+    struct Event {
+        /// The sample time at which to apply the change.
+        Float64 sampleTime_{0};
+        /// The parameter.
+        AudioUnitParameterID parameter_{0};
+        /// The parameter's scope.
+        AudioUnitScope scope_{kAudioUnitScope_Global};
+        /// The parameter's element.
+        AudioUnitElement element_{0};
+        /// The new parameter value.
+        AudioUnitParameterValue value_{0};
+    };
+
+    /// Automation statistics.
+    struct Statistics {
+        /// The number of events accepted by Schedule().
+        UInt64 scheduled_{0};
+        /// The number of events dropped by Schedule() because a queue was full.
+        UInt64 overflows_{0};
+        /// The number of events passed to an Audio Unit.
+        UInt64 applied_{0};
+        /// The number of events applied after their sample time had passed.
+        UInt64 late_{0};
+        /// The number of calls to AudioUnitScheduleParameters that failed.
+        UInt64 errors_{0};
+    };
+
+    /// Creates parameter automation for nodes of a graph and registers its render notification.
+    /// @param graph An open Audio Unit graph.
+    /// @param nodes The nodes to automate.
+    /// @param capacity The capacity of each node's queue in events, rounded up to a power of two.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument if capacity is 0 or greater than 2^31, or if a node has no Audio Unit.
+    /// @throw std::bad_alloc.
+    ParameterAutomation(CAAUGraph &graph, const std::vector<AUNode> &nodes, UInt32 capacity = 1024);
+
+    // This class is non-copyable
+    ParameterAutomation(const ParameterAutomation &) = delete;
+
+    // This class is non-assignable
+    ParameterAutomation &operator=(const ParameterAutomation &) = delete;
+
+    /// Removes the render notification and releases all associated resources.
+    ~ParameterAutomation() noexcept;
+
+    /// Returns the capacity of each node's queue in events.
+    [[nodiscard]] UInt32 Capacity() const noexcept;
+
+    /// Schedules a parameter change for a node.
+    ///
+    /// This function is wait-free and may be called from any number of threads concurrently.
+    /// @param node The node.
+    /// @param event The parameter change.
+    /// @return true if the event was queued, false if the node is not automated or its queue is full.
+    bool Schedule(AUNode node, const Event &event) noexcept;
+
+    /// Returns the automation statistics.
+    [[nodiscard]] Statistics GetStatistics() const noexcept;
+
+  private:
+    struct NodeQueue;
+
+    /// The render notification.
+    static OSStatus RenderNotify(void *inRefCon, AudioUnitRenderActionFlags *ioActionFlags,
+                                 const AudioTimeStamp *inTimeStamp, UInt32 inBusNumber, UInt32 inNumberFrames,
+                                 AudioBufferList *_Nullable ioData) noexcept;
+
+    /// Applies the events due within a render slice.
+    void Render(Float64 sampleTime, UInt32 frameCount) noexcept;
+
+    /// The graph.
+    CAAUGraph &graph_;
+    /// The capacity of each node's queue in events.
+    UInt32 capacity_;
+    /// The automated nodes in ascending order.
+    std::vector<AUNode> nodes_;
+    /// The queue for each node in nodes_.
+    std::vector<std::unique_ptr<NodeQueue>> queues_;
+
+    /// The number of events accepted by Schedule().
+    alignas(64) std::atomic_uint64_t scheduled_{0};
+    /// The number of events dropped by Schedule().
+    std::atomic_uint64_t overflows_{0};
+
+    /// The number of events passed to an Audio Unit, modified only by the render thread.
+    alignas(64) std::atomic_uint64_t applied_{0};
+    /// The number of events applied late, modified only by the render thread.
+    std::atomic_uint64_t late_{0};
+    /// The number of failed calls to AudioUnitScheduleParameters, modified only by the render thread.
+    std::atomic_uint64_t errors_{0};
+};
+
+// MARK: - Implementation -
+
+inline UInt32 ParameterAutomation::Capacity() const noexcept { return capacity_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
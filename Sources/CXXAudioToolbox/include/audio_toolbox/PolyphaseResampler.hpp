@@ -0,0 +1,183 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <AudioToolbox/AudioConverter.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+namespace detail {
+struct PolyphaseFilterBank;
+} /* namespace detail */
+
+/// A polyphase windowed-sinc sample rate converter for 32-bit float linear PCM.
+///
+/// The resampler presents the same pull interface as CAAudioConverter::FillComplexBuffer. The input callback receives
+/// nullptr in place of an AudioConverterRef. Input and output are aligned so output time zero corresponds to input time
+/// zero, and after the input callback signals end of stream by returning zero packets the output contains exactly
+/// ceil(input frames * output rate / input rate) frames.
+///
+/// Filter banks are computed once per quality and rate pair and shared by all resamplers in the process. The process
+/// retains at most 32 filter banks, evicting banks no resampler is using to make room.
+class PolyphaseResampler final {
+  public:
+    /// Filter quality tiers, trading passband width and stopband attenuation for speed.
+    ///
+    /// The stopband begins at the lower of the two Nyquist frequencies, so aliases and images are attenuated by at
+    /// least the tier's stopband attenuation.
+    enum class Quality {
+        /// 16 taps per phase, at least 60 dB stopband attenuation.
+        low,
+        /// 32 taps per phase, at least 85 dB stopband attenuation.
+        medium,
+        /// 64 taps per phase, at least 100 dB stopband attenuation.
+        high,
+        /// 128 taps per phase, at least 130 dB stopband attenuation.
+        maximum,
+    };
+
+    /// Computes and caches the filter banks for conversions between 44.1, 48, and 96 kHz.
+    /// @throw std::bad_alloc.
+    static void PrecomputeCommonFilterBanks(Quality quality);
+
+    /// Creates a resampler.
+    PolyphaseResampler() noexcept = default;
+
+    // This class is non-copyable
+    PolyphaseResampler(const PolyphaseResampler &) = delete;
+
+    // This class is non-assignable
+    PolyphaseResampler &operator=(const PolyphaseResampler &) = delete;
+
+    /// Move constructor.
+    PolyphaseResampler(PolyphaseResampler &&other) noexcept = default;
+
+    /// Move assignment operator.
+    PolyphaseResampler &operator=(PolyphaseResampler &&other) noexcept = default;
+
+    /// Destroys the resampler and releases all associated resources.
+    ~PolyphaseResampler() noexcept = default;
+
+    /// Returns true if the resampler has been created.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Creates a new resampler.
+    ///
+    /// Both formats must be native-endian 32-bit float linear PCM with the same channel count and interleaving and
+    /// whole-number sample rates. The source rate may be at most 64 times the destination rate.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void New(const AudioStreamBasicDescription &inSourceFormat, const AudioStreamBasicDescription &inDestinationFormat,
+             Quality quality = Quality::high);
+
+    /// Destroys the resampler.
+    void Dispose() noexcept;
+
+    /// Discards buffered input and returns the resampler to its initial state.
+    void Reset() noexcept;
+
+    /// Returns the source format.
+    [[nodiscard]] const AudioStreamBasicDescription &SourceFormat() const noexcept;
+
+    /// Returns the destination format.
+    [[nodiscard]] const AudioStreamBasicDescription &DestinationFormat() const noexcept;
+
+    /// Returns the quality.
+    [[nodiscard]] Quality FilterQuality() const noexcept;
+
+    /// Returns the number of filter taps per phase.
+    [[nodiscard]] UInt32 FilterLength() const noexcept;
+
+    /// Converts data supplied by an input callback function.
+    ///
+    /// If the callback returns an error the frames produced so far are stored in outOutputData and
+    /// ioOutputDataPacketSize before the error is thrown.
+    /// @param inInputDataProc A callback supplying input data.
+    /// @param inInputDataProcUserData A value passed to inInputDataProc.
+    /// @param ioOutputDataPacketSize On input the capacity of outOutputData in frames. On output the number of frames
+    /// produced, which is less than the capacity only at end of stream or if the callback returned an error.
+    /// @param outOutputData The output buffers.
+    /// @param outPacketDescription Ignored; present for compatibility with CAAudioConverter.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    void FillComplexBuffer(AudioConverterComplexInputDataProc inInputDataProc, void *_Nullable inInputDataProcUserData,
+                           UInt32 &ioOutputDataPacketSize, AudioBufferList *outOutputData,
+                           AudioStreamPacketDescription *_Nullable outPacketDescription = nullptr);
+
+  private:
+    /// Requests input from inInputDataProc and appends it to the history.
+    OSStatus PullInput(AudioConverterComplexInputDataProc inInputDataProc, void *_Nullable inInputDataProcUserData,
+                       UInt32 outputFrames);
+
+    /// Appends frameCount frames of silence to the history.
+    void AppendSilence(std::size_t frameCount);
+
+    /// Makes room in the history for frameCount frames and returns the index at which to write them.
+    std::size_t ReserveHistory(std::size_t frameCount);
+
+    /// Produces up to frameCount frames from the history into outOutputData starting at frame offset.
+    UInt32 Render(AudioBufferList *outOutputData, UInt32 offset, UInt32 frameCount) noexcept;
+
+    /// The source format.
+    AudioStreamBasicDescription sourceFormat_{};
+    /// The destination format.
+    AudioStreamBasicDescription destinationFormat_{};
+    /// The quality.
+    Quality quality_{Quality::high};
+    /// The filter bank.
+    std::shared_ptr<const detail::PolyphaseFilterBank> filterBank_;
+    /// The upsampling factor.
+    UInt64 upsampling_{1};
+    /// The downsampling factor.
+    UInt64 downsampling_{1};
+
+    /// Deinterleaved input samples for each channel.
+    std::vector<std::vector<float>> history_;
+    /// The number of valid frames in history_.
+    std::size_t historyFrames_{0};
+    /// The index in history_ of the first sample in the filter window for the next output frame.
+    std::size_t historyIndex_{0};
+    /// The phase of the next output frame in units of 1 / upsampling_ input frames.
+    UInt64 phase_{0};
+
+    /// True if the input callback has signaled end of stream.
+    bool endOfStream_{false};
+    /// The total number of input frames received.
+    UInt64 inputFrames_{0};
+    /// The total number of output frames produced.
+    UInt64 outputFrames_{0};
+    /// The total number of output frames to produce once end of stream is reached.
+    UInt64 outputFrameLimit_{0};
+
+    /// Storage for the AudioBufferList passed to the input callback.
+    std::vector<unsigned char> inputBufferList_;
+    /// Channel pointers used when deinterleaving input.
+    std::vector<void *> channelPointers_;
+};
+
+// MARK: - Implementation -
+
+inline PolyphaseResampler::operator bool() const noexcept { return filterBank_ != nullptr; }
+
+inline const AudioStreamBasicDescription &PolyphaseResampler::SourceFormat() const noexcept { return sourceFormat_; }
+
+inline const AudioStreamBasicDescription &PolyphaseResampler::DestinationFormat() const noexcept {
+    return destinationFormat_;
+}
+
+inline PolyphaseResampler::Quality PolyphaseResampler::FilterQuality() const noexcept { return quality_; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
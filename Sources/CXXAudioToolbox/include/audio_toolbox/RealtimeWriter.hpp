@@ -0,0 +1,207 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAExtAudioFile.hpp>
+
+#include <core_audio/StreamDescription.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A writer accepting audio from a realtime thread and passing it to a sink on a background thread.
+///
+/// Audio is copied into a single-producer, single-consumer ring of frames allocated when the writer is created.
+/// Writing does not allocate, lock, or block, and audio that does not fit in the ring is dropped and counted.
+/// A background thread periodically passes the buffered audio to the sink without copying.
+///
+/// Write() counts an underrun when the producer falls behind real time, that is when it is called after the audio
+/// previously written would have finished playing at the format's sample rate. Pausing the producer therefore counts
+/// an underrun when writing resumes.
+///
+/// If the sink throws, draining stops, subsequent writes are dropped, and the exception is rethrown by the next call
+/// to Stop() or CheckError(). FailedFramePosition() identifies the first frame that was not written.
+class RealtimeWriter final {
+  public:
+    /// A function receiving audio from the ring.
+    using Sink = std::function<void(UInt32 inNumberFrames, const AudioBufferList *ioData)>;
+
+    /// Writer statistics.
+    struct Statistics {
+        /// The number of frames accepted by Write().
+        UInt64 framesWritten_{0};
+        /// The number of frames passed to the sink.
+        UInt64 framesDrained_{0};
+        /// The number of calls to Write() that dropped frames.
+        UInt64 overruns_{0};
+        /// The number of frames dropped by Write().
+        UInt64 droppedFrames_{0};
+        /// The number of calls to Write() that arrived after the audio previously written would have finished
+        /// playing, indicating the producer fell behind real time.
+        UInt64 underruns_{0};
+        /// The maximum number of frames held by the ring.
+        UInt32 highWaterMark_{0};
+    };
+
+    /// Creates a realtime writer.
+    /// @param format The format of the audio, which must be linear PCM.
+    /// @param capacity The capacity of the ring in frames.
+    /// @param sink The function receiving audio on the background thread.
+    /// @param drainInterval The interval at which the background thread drains the ring.
+    /// @throw std::invalid_argument.
+    /// @throw std::bad_alloc.
+    RealtimeWriter(const AudioStreamBasicDescription &format, UInt32 capacity, Sink sink,
+                   std::chrono::milliseconds drainInterval = std::chrono::milliseconds{10});
+
+    /// Creates a realtime writer draining to an extended audio file.
+    ///
+    /// The audio format is the extended audio file's client data format.
+    /// @note The extended audio file must outlive the writer.
+    /// @param extAudioFile An extended audio file open for writing.
+    /// @param capacity The capacity of the ring in frames.
+    /// @param drainInterval The interval at which the background thread drains the ring.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument.
+    /// @throw std::bad_alloc.
+    explicit RealtimeWriter(CAExtAudioFile &extAudioFile, UInt32 capacity = 32768,
+                            std::chrono::milliseconds drainInterval = std::chrono::milliseconds{10});
+
+    // This class is non-copyable
+    RealtimeWriter(const RealtimeWriter &) = delete;
+
+    // This class is non-assignable
+    RealtimeWriter &operator=(const RealtimeWriter &) = delete;
+
+    /// Stops draining and releases all associated resources.
+    /// @note Sink errors are ignored; call Stop() before destruction to observe them.
+    ~RealtimeWriter() noexcept;
+
+    /// Returns the audio format.
+    [[nodiscard]] const core_audio::StreamDescription &Format() const noexcept;
+
+    /// Returns the capacity of the ring in frames.
+    [[nodiscard]] UInt32 Capacity() const noexcept;
+
+    /// Starts draining the ring on a background thread.
+    ///
+    /// This function has no effect while the background thread is draining. If the sink failed, the exception it
+    /// threw is reported here if it was not already, and the next call resumes draining at the first frame that was
+    /// not written.
+    /// @throw std::system_error.
+    /// @throw Any unreported exception thrown by the sink.
+    void Start();
+
+    /// Drains the audio in the ring and stops the background thread.
+    /// @throw Any exception thrown by the sink.
+    void Stop();
+
+    /// Copies audio into the ring.
+    ///
+    /// This function is realtime-safe and must only be called from a single thread at a time.
+    /// @param inNumberFrames The number of frames to write.
+    /// @param ioData The audio to write, which must be in the writer's format.
+    /// @return The number of frames written, which is less than inNumberFrames if the ring is full or the sink failed.
+    UInt32 Write(UInt32 inNumberFrames, const AudioBufferList *ioData) noexcept;
+
+    /// Returns true if the sink failed.
+    ///
+    /// This function is realtime-safe.
+    [[nodiscard]] bool Failed() const noexcept;
+
+    /// Rethrows the exception thrown by the sink, if any.
+    /// @throw Any exception thrown by the sink.
+    void CheckError();
+
+    /// Returns the position, counted in frames written, of the first frame not written because the sink failed.
+    /// @note The position is only meaningful if Failed() returns true.
+    [[nodiscard]] UInt64 FailedFramePosition() const noexcept;
+
+    /// Returns the writer statistics.
+    [[nodiscard]] Statistics GetStatistics() const noexcept;
+
+  private:
+    /// Periodically drains the ring until stopped or the sink fails.
+    void DrainThreadEntry() noexcept;
+
+    /// Passes the audio in the ring to the sink.
+    /// @return false if the sink failed.
+    bool Drain() noexcept;
+
+    /// The audio format.
+    core_audio::StreamDescription format_;
+    /// The capacity of the ring in frames.
+    UInt32 capacity_;
+    /// The function receiving audio.
+    Sink sink_;
+    /// The interval at which the ring is drained.
+    std::chrono::milliseconds drainInterval_;
+
+    /// The number of buffers in the audio format.
+    UInt32 bufferCount_{0};
+    /// Ring storage for each buffer, capacity_ frames apiece.
+    std::unique_ptr<unsigned char[]> storage_;
+    /// Storage for the buffer list passed to the sink.
+    std::unique_ptr<unsigned char[]> drainListStorage_;
+
+    /// The total number of frames written to the ring, modified only by the producer.
+    alignas(64) std::atomic_uint64_t writePosition_{0};
+    /// The maximum number of frames held by the ring, modified only by the producer.
+    std::atomic_uint32_t highWaterMark_{0};
+    /// The number of calls to Write() that dropped frames.
+    std::atomic_uint64_t overruns_{0};
+    /// The number of frames dropped by Write().
+    std::atomic_uint64_t droppedFrames_{0};
+    /// The number of calls to Write() that found the producer behind real time.
+    std::atomic_uint64_t underruns_{0};
+    /// True if Write() has been called with audio, modified only by the producer.
+    bool streaming_{false};
+    /// The time at which the audio written so far would finish playing, modified only by the producer.
+    std::chrono::steady_clock::time_point streamDeadline_;
+
+    /// The total number of frames read from the ring, modified only by the consumer.
+    alignas(64) std::atomic_uint64_t readPosition_{0};
+    /// True if the sink failed.
+    std::atomic_bool failed_{false};
+    /// The position of the first frame not written because the sink failed, published by failed_.
+    UInt64 failedFramePosition_{0};
+
+    /// Protects the state below.
+    std::mutex mutex_;
+    /// Signaled when the drain thread should stop.
+    std::condition_variable stopCondition_;
+    /// True if the drain thread should stop.
+    bool stopRequested_{false};
+    /// The exception thrown by the sink and not yet reported, if any.
+    std::exception_ptr error_;
+    /// The background drain thread.
+    std::thread drainThread_;
+};
+
+// MARK: - Implementation -
+
+inline const core_audio::StreamDescription &RealtimeWriter::Format() const noexcept { return format_; }
+
+inline UInt32 RealtimeWriter::Capacity() const noexcept { return capacity_; }
+
+inline bool RealtimeWriter::Failed() const noexcept { return failed_.load(std::memory_order_acquire); }
+
+inline UInt64 RealtimeWriter::FailedFramePosition() const noexcept { return Failed() ? failedFramePosition_ : 0; }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,131 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAUGraph.hpp>
+
+#include <AudioToolbox/AudioUnit.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+/// A render notification dispatcher fanning out to any number of observers.
+///
+/// A single render notification is registered with an Audio Unit graph or Audio Unit, so the cost of a render cycle
+/// through AudioToolbox does not grow with the number of observers. Observers are called in the order they were
+/// added, and only for the render phases they requested.
+///
+/// The observer list is read-copy-update: adding or removing an observer publishes a new list and waits for render
+/// calls still reading the previous list to finish before freeing it. Render calls never lock, block, or allocate.
+class RenderNotifyDispatcher final {
+  public:
+    /// A function receiving render notifications.
+    ///
+    /// Observers are called on the render thread and must be realtime-safe and must not throw.
+    using Observer = std::function<void(AudioUnitRenderActionFlags inActionFlags, const AudioTimeStamp &inTimeStamp,
+                                        UInt32 inBusNumber, UInt32 inNumberFrames,
+                                        AudioBufferList *_Nullable ioData)>;
+
+    /// An identifier for an observer.
+    using ObserverID = UInt64;
+
+    /// The render phases delivered to observers by default.
+    static constexpr AudioUnitRenderActionFlags kAllPhases =
+            kAudioUnitRenderAction_PreRender | kAudioUnitRenderAction_PostRender;
+
+    /// Creates a dispatcher for an Audio Unit graph's render notifications.
+    /// @note The graph must outlive the dispatcher.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    explicit RenderNotifyDispatcher(CAAUGraph &graph);
+
+    /// Creates a dispatcher for an Audio Unit's render notifications.
+    /// @note The Audio Unit must outlive the dispatcher.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    explicit RenderNotifyDispatcher(AudioUnit audioUnit);
+
+    // This class is non-copyable
+    RenderNotifyDispatcher(const RenderNotifyDispatcher &) = delete;
+
+    // This class is non-assignable
+    RenderNotifyDispatcher &operator=(const RenderNotifyDispatcher &) = delete;
+
+    /// Removes the render notification and releases all associated resources.
+    ~RenderNotifyDispatcher() noexcept;
+
+    /// Adds an observer.
+    ///
+    /// The observer receives render calls beginning after this function returns.
+    /// @note This function may block briefly and must not be called from an observer.
+    /// @param observer The observer.
+    /// @param phases The render phases to deliver, a combination of kAudioUnitRenderAction_PreRender and
+    /// kAudioUnitRenderAction_PostRender.
+    /// @return An identifier for the observer.
+    /// @throw std::invalid_argument if observer is empty or phases selects no render phase.
+    /// @throw std::bad_alloc.
+    ObserverID AddObserver(Observer observer, AudioUnitRenderActionFlags phases = kAllPhases);
+
+    /// Removes an observer.
+    ///
+    /// The observer is not running and will not be called once this function returns.
+    /// @note This function may block briefly and must not be called from an observer.
+    /// @param observerID The identifier of the observer.
+    /// @return true if the observer was removed, false if observerID does not identify an observer.
+    /// @throw std::bad_alloc.
+    bool RemoveObserver(ObserverID observerID);
+
+    /// Returns the number of observers.
+    [[nodiscard]] std::size_t ObserverCount() const noexcept;
+
+  private:
+    struct ObserverList;
+
+    /// The render notification.
+    static OSStatus RenderNotify(void *inRefCon, AudioUnitRenderActionFlags *ioActionFlags,
+                                 const AudioTimeStamp *inTimeStamp, UInt32 inBusNumber, UInt32 inNumberFrames,
+                                 AudioBufferList *_Nullable ioData) noexcept;
+
+    /// Publishes an observer list and frees the previous list once no render call is reading it.
+    void Publish(ObserverList *list) noexcept;
+
+    /// The graph, if the dispatcher was created for a graph.
+    CAAUGraph *_Nullable graph_{nullptr};
+    /// The Audio Unit, if the dispatcher was created for an Audio Unit.
+    AudioUnit _Nullable audioUnit_{nullptr};
+
+    /// Serializes changes to the observer list.
+    std::mutex mutex_;
+    /// The identifier of the next observer.
+    ObserverID nextObserverID_{1};
+    /// The current observer list.
+    std::atomic<ObserverList *> observers_{nullptr};
+    /// The number of observers in the current list.
+    std::atomic_size_t observerCount_{0};
+
+    /// The reader epoch, whose low bit selects the reader count used by new render calls.
+    alignas(64) std::atomic_uint32_t epoch_{0};
+    /// The number of render calls reading the observer list in each epoch.
+    std::atomic_uint32_t readers_[2]{};
+};
+
+// MARK: - Implementation -
+
+inline std::size_t RenderNotifyDispatcher::ObserverCount() const noexcept {
+    return observerCount_.load(std::memory_order_relaxed);
+}
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
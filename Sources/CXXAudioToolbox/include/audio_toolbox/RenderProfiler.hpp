@@ -0,0 +1,152 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAUGraph.hpp>
+#include <audio_toolbox/RenderNotifyDispatcher.hpp>
+#include <audio_toolbox/TimingHistogram.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+namespace detail {
+class RenderCycleTimer;
+} /* namespace detail */
+
+/// A profiler measuring the render time of each node of an Audio Unit graph.
+///
+/// Each profiled node's pre- and post-render notifications are timestamped. Because nodes render their inputs from
+/// within their own render calls, a node's time excludes the time spent rendering other profiled nodes. Render times
+/// are recorded in a histogram per node, and the duration of each render cycle of the graph is compared with the
+/// duration of the audio it renders to detect deadline misses. At the end of each cycle the node that took the most
+/// time is noted.
+///
+/// Measurement runs on the render thread and does not allocate, lock, or block. Reports may be requested from any
+/// other thread or delivered periodically by a background thread.
+/// @note The graph and the profiled nodes' Audio Units must outlive the profiler, and the graph must be rendered
+/// by one thread at a time.
+class RenderProfiler final {
+  public:
+    /// The render statistics of a node.
+    struct NodeReport {
+        /// The node.
+        AUNode node_{0};
+        /// The node's render times, excluding time spent rendering other profiled nodes.
+        TimingHistogram::Snapshot renderTime_;
+        /// The number of cycles in which the node took the most time.
+        UInt64 slowestCycles_{0};
+        /// The number of cycles missing the deadline in which the node took the most time.
+        UInt64 slowestMissedCycles_{0};
+    };
+
+    /// Profiler statistics.
+    struct Report {
+        /// The render times of the graph's cycles.
+        TimingHistogram::Snapshot cycleTime_;
+        /// The number of cycles that took longer than the duration of the audio they rendered.
+        UInt64 deadlineMisses_{0};
+        /// The statistics of each profiled node.
+        std::vector<NodeReport> nodes_;
+        /// The node most often slowest in cycles missing the deadline, or in any cycle if none missed it.
+        std::optional<AUNode> slowestNode_;
+        /// The node that took the most time in the most recent cycle missing the deadline.
+        std::optional<AUNode> lastMissSlowestNode_;
+    };
+
+    /// A function receiving periodic reports.
+    using Reporter = std::function<void(const Report &report)>;
+
+    /// Creates a profiler for every node of a graph that has an Audio Unit.
+    /// @param graph An open Audio Unit graph.
+    /// @param sampleRate The sample rate at which the graph renders, used to compute render deadlines.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument if sampleRate is not positive.
+    /// @throw std::bad_alloc.
+    RenderProfiler(CAAUGraph &graph, Float64 sampleRate);
+
+    /// Creates a profiler for nodes of a graph.
+    /// @param graph An open Audio Unit graph.
+    /// @param nodes The nodes to profile.
+    /// @param sampleRate The sample rate at which the graph renders, used to compute render deadlines.
+    /// @throw std::system_error.
+    /// @throw std::invalid_argument if sampleRate is not positive or a node has no Audio Unit.
+    /// @throw std::bad_alloc.
+    RenderProfiler(CAAUGraph &graph, const std::vector<AUNode> &nodes, Float64 sampleRate);
+
+    // This class is non-copyable
+    RenderProfiler(const RenderProfiler &) = delete;
+
+    // This class is non-assignable
+    RenderProfiler &operator=(const RenderProfiler &) = delete;
+
+    /// Stops reporting, removes the render notifications, and releases all associated resources.
+    /// @note Reporter errors are ignored; call Stop() before destruction to observe them.
+    ~RenderProfiler() noexcept;
+
+    /// Returns the profiler statistics accumulated since the profiler was created.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] Report GetReport() const;
+
+    /// Starts passing reports to a function on a background thread.
+    /// @param reporter The function receiving reports.
+    /// @param interval The interval between reports.
+    /// @throw std::invalid_argument if reporter is empty.
+    /// @throw std::system_error.
+    /// @throw Any unreported exception thrown by the previous reporter.
+    void Start(Reporter reporter, std::chrono::milliseconds interval = std::chrono::milliseconds{1000});
+
+    /// Stops the background thread.
+    /// @throw Any exception thrown by the reporter.
+    void Stop();
+
+  private:
+    /// Passes reports to the reporter until stopped or the reporter throws.
+    void ReporterThreadEntry() noexcept;
+
+    /// The sample rate of the graph.
+    Float64 sampleRate_;
+    /// The profiled nodes in ascending order.
+    std::vector<AUNode> nodes_;
+    /// The render times of the profiled nodes, indexed as nodes_, and of the graph's cycles.
+    std::unique_ptr<detail::RenderCycleTimer> timer_;
+
+    /// Notifications for the graph's render cycles.
+    std::unique_ptr<RenderNotifyDispatcher> graphDispatcher_;
+    /// Notifications for each profiled node's render calls, indexed as nodes_.
+    std::vector<std::unique_ptr<RenderNotifyDispatcher>> nodeDispatchers_;
+
+    /// Protects the state below.
+    std::mutex mutex_;
+    /// Signaled when the reporter thread should stop.
+    std::condition_variable stopCondition_;
+    /// True if the reporter thread should stop.
+    bool stopRequested_{false};
+    /// The function receiving reports.
+    Reporter reporter_;
+    /// The interval between reports.
+    std::chrono::milliseconds interval_{0};
+    /// The exception thrown by the reporter and not yet reported, if any.
+    std::exception_ptr error_;
+    /// The background reporter thread.
+    std::thread reporterThread_;
+};
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
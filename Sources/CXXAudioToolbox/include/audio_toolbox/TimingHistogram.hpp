@@ -0,0 +1,138 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace audio_toolbox {
+
+/// A histogram of durations with logarithmic buckets of bounded relative error.
+///
+/// Durations are recorded in nanoseconds. Durations below 32 ns are counted exactly, and larger durations fall into
+/// buckets 1/32 of a power of two wide, so reported values are within about 3% of the recorded values. Durations of
+/// 2^40 ns (about 18 minutes) or more are counted in the last bucket.
+///
+/// Recording does not allocate, lock, or block and may run concurrently with GetSnapshot().
+class TimingHistogram final {
+  public:
+    /// The number of bits of precision in each bucket.
+    static constexpr unsigned kSubBucketBits = 5;
+    /// The number of bits in the largest distinct duration.
+    static constexpr unsigned kMaxValueBits = 40;
+    /// The number of buckets.
+    static constexpr std::size_t kBucketCount = std::size_t{kMaxValueBits - kSubBucketBits + 1} << kSubBucketBits;
+
+    /// A copy of a histogram's counts.
+    class Snapshot final {
+      public:
+        /// Creates an empty snapshot.
+        Snapshot() noexcept = default;
+
+        /// Returns the number of durations recorded.
+        [[nodiscard]] std::uint64_t Count() const noexcept;
+
+        /// Returns the largest duration recorded.
+        [[nodiscard]] std::chrono::nanoseconds Max() const noexcept;
+
+        /// Returns the mean of the durations recorded.
+        [[nodiscard]] std::chrono::nanoseconds Mean() const noexcept;
+
+        /// Returns the duration at or below which a percentage of recorded durations fall.
+        /// @param percentile A percentage between 0 and 100.
+        /// @return The duration, or zero if no durations were recorded.
+        [[nodiscard]] std::chrono::nanoseconds ValueAtPercentile(double percentile) const noexcept;
+
+      private:
+        friend class TimingHistogram;
+
+        /// The count of each bucket.
+        std::vector<std::uint64_t> counts_;
+        /// The number of durations.
+        std::uint64_t count_{0};
+        /// The sum of the durations in nanoseconds.
+        std::uint64_t sum_{0};
+        /// The largest duration in nanoseconds.
+        std::uint64_t max_{0};
+    };
+
+    /// Creates an empty histogram.
+    TimingHistogram() noexcept = default;
+
+    // This class is non-copyable
+    TimingHistogram(const TimingHistogram &) = delete;
+
+    // This class is non-assignable
+    TimingHistogram &operator=(const TimingHistogram &) = delete;
+
+    /// Records a duration.
+    ///
+    /// This function is realtime-safe and must only be called from a single thread at a time. Negative durations are
+    /// recorded as zero.
+    void Record(std::chrono::nanoseconds duration) noexcept;
+
+    /// Returns a copy of the histogram's counts.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] Snapshot GetSnapshot() const;
+
+    /// Returns the index of the bucket counting a duration in nanoseconds.
+    [[nodiscard]] static std::size_t BucketIndex(std::uint64_t value) noexcept;
+
+    /// Returns the largest duration in nanoseconds counted by a bucket, which is unbounded for the last bucket.
+    [[nodiscard]] static std::uint64_t BucketUpperBound(std::size_t index) noexcept;
+
+  private:
+    /// The count of each bucket.
+    std::atomic_uint64_t counts_[kBucketCount]{};
+    /// The sum of the durations in nanoseconds.
+    std::atomic_uint64_t sum_{0};
+    /// The largest duration in nanoseconds.
+    std::atomic_uint64_t max_{0};
+};
+
+// MARK: - Implementation -
+
+inline std::uint64_t TimingHistogram::Snapshot::Count() const noexcept { return count_; }
+
+inline std::chrono::nanoseconds TimingHistogram::Snapshot::Max() const noexcept {
+    return std::chrono::nanoseconds{max_};
+}
+
+inline std::chrono::nanoseconds TimingHistogram::Snapshot::Mean() const noexcept {
+    return std::chrono::nanoseconds{count_ ? sum_ / count_ : 0};
+}
+
+inline void TimingHistogram::Record(std::chrono::nanoseconds duration) noexcept {
+    const auto value = duration.count() > 0 ? static_cast<std::uint64_t>(duration.count()) : std::uint64_t{0};
+    // Only one thread records, so plain loads and stores suffice and avoid locked read-modify-write instructions
+    auto &count = counts_[BucketIndex(value)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value > max_.load(std::memory_order_relaxed)) {
+        max_.store(value, std::memory_order_relaxed);
+    }
+}
+
+inline std::size_t TimingHistogram::BucketIndex(std::uint64_t value) noexcept {
+    constexpr auto subBucketCount = std::uint64_t{1} << kSubBucketBits;
+    if (value < subBucketCount) {
+        return static_cast<std::size_t>(value);
+    }
+    if (value >= (std::uint64_t{1} << kMaxValueBits)) {
+        return kBucketCount - 1;
+    }
+
+    const auto msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+    const auto shift = msb - kSubBucketBits;
+    return static_cast<std::size_t>(((std::uint64_t{shift} + 1) << kSubBucketBits) + (value >> shift) - subBucketCount);
+}
+
+} /* namespace audio_toolbox */
@@ -0,0 +1,184 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <core_audio/ChannelLayout.hpp>
+#include <core_audio/StreamDescription.hpp>
+
+#include <AudioToolbox/AudioFile.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+CF_ASSUME_NONNULL_BEGIN
+
+namespace audio_toolbox {
+
+namespace detail {
+class WorkStealingPool;
+} /* namespace detail */
+
+/// A parallel audio file transcoder.
+///
+/// Each job reads a file with CAExtAudioFile and writes it to a new file in another format. Jobs run on a
+/// work-stealing thread pool that persists for the lifetime of the engine, and each worker reuses its sample buffer
+/// across jobs.
+class TranscodeEngine final {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// A file to transcode.
+    struct Job {
+        /// The path of the file to read.
+        std::string sourcePath_;
+        /// The path of the file to create, replacing any existing file.
+        std::string destinationPath_;
+        /// The type of the file to create.
+        AudioFileTypeID fileType_{0};
+        /// The data format of the file to create.
+        core_audio::StreamDescription format_;
+        /// The channel layout of the file to create, which may be empty.
+        core_audio::ChannelLayout channelLayout_;
+    };
+
+    /// The outcome of a job.
+    struct Result {
+        /// The number of frames read from the source file.
+        SInt64 framesTranscoded_{0};
+        /// The time spent on the job.
+        Clock::duration elapsed_{};
+        /// The exception thrown while transcoding, or nullptr on success.
+        std::exception_ptr error_;
+
+        /// Returns true if the job succeeded.
+        [[nodiscard]] explicit operator bool() const noexcept;
+
+        /// Returns the job's throughput in frames per second.
+        [[nodiscard]] double FramesPerSecond() const noexcept;
+    };
+
+    /// The progress of a call to Transcode.
+    struct Progress {
+        /// The number of jobs submitted.
+        std::size_t jobCount_{0};
+        /// The number of jobs finished, including failed jobs.
+        std::size_t jobsFinished_{0};
+        /// The number of jobs that failed.
+        std::size_t jobsFailed_{0};
+        /// The number of frames read from source files so far.
+        UInt64 framesTranscoded_{0};
+        /// The time since Transcode was called.
+        Clock::duration elapsed_{};
+
+        /// Returns the overall throughput in frames per second.
+        [[nodiscard]] double FramesPerSecond() const noexcept;
+    };
+
+    /// A function called on a worker thread after each job finishes; calls are serialized.
+    using ProgressCallback = std::function<void(const Progress &progress, std::size_t jobIndex, const Result &result)>;
+
+    /// Creates a transcode engine.
+    /// @param threadCount The number of threads, or 0 for one per hardware thread.
+    /// @param bufferFrames The number of frames read and written at a time.
+    /// @throw std::system_error.
+    /// @throw std::bad_alloc.
+    explicit TranscodeEngine(unsigned threadCount = 0, UInt32 bufferFrames = 4096);
+
+    // This class is non-copyable
+    TranscodeEngine(const TranscodeEngine &) = delete;
+
+    // This class is non-assignable
+    TranscodeEngine &operator=(const TranscodeEngine &) = delete;
+
+    /// Stops the threads and releases all associated resources.
+    ~TranscodeEngine() noexcept;
+
+    /// Returns the number of threads used for transcoding.
+    [[nodiscard]] unsigned ThreadCount() const noexcept;
+
+    /// Transcodes files and waits for all jobs to finish.
+    ///
+    /// Errors are captured in the corresponding result and do not affect other jobs. The destination file of a failed
+    /// job is removed. Concurrent calls are serialized.
+    /// @param jobs The files to transcode.
+    /// @param progressCallback An optional function called after each job finishes.
+    /// @return The outcome of each job in the order of jobs.
+    /// @throw std::bad_alloc.
+    [[nodiscard]] std::vector<Result> Transcode(const std::vector<Job> &jobs,
+                                                const ProgressCallback &progressCallback = {});
+
+    /// Returns the progress of the current or most recent call to Transcode.
+    ///
+    /// This may be called from any thread.
+    [[nodiscard]] Progress GetProgress() const noexcept;
+
+    /// Requests that the current call to Transcode stop early.
+    ///
+    /// Running jobs stop after their current buffer and unstarted jobs are skipped; both fail with
+    /// std::errc::operation_canceled. A request made while no call is in progress applies to the next call. This may
+    /// be called from any thread.
+    void Cancel() noexcept;
+
+  private:
+    /// Transcodes one file using buffer for samples.
+    SInt64 TranscodeFile(const Job &job, std::vector<float> &buffer);
+
+    /// The thread pool.
+    std::unique_ptr<detail::WorkStealingPool> pool_;
+    /// The number of frames read and written at a time.
+    const UInt32 bufferFrames_;
+    /// Sample buffers indexed by worker.
+    std::vector<std::vector<float>> buffers_;
+
+    /// Serializes calls to Transcode.
+    std::mutex transcodeMutex_;
+    /// Serializes progress callbacks.
+    std::mutex callbackMutex_;
+
+    /// The number of jobs in the current call to Transcode.
+    std::atomic<std::size_t> jobCount_{0};
+    /// The number of jobs finished.
+    std::atomic<std::size_t> jobsFinished_{0};
+    /// The number of jobs failed.
+    std::atomic<std::size_t> jobsFailed_{0};
+    /// The number of frames read from source files.
+    std::atomic<UInt64> framesTranscoded_{0};
+    /// The time Transcode was called, in Clock ticks.
+    std::atomic<Clock::rep> startTime_{0};
+    /// The time the last job finished, in Clock ticks, or 0 while jobs are running.
+    std::atomic<Clock::rep> finishTime_{0};
+    /// True if Cancel was called.
+    std::atomic<bool> cancelRequested_{false};
+};
+
+// MARK: - Implementation -
+
+inline TranscodeEngine::Result::operator bool() const noexcept { return !error_; }
+
+inline double TranscodeEngine::Result::FramesPerSecond() const noexcept {
+    const auto seconds = std::chrono::duration<double>(elapsed_).count();
+    return seconds > 0 ? static_cast<double>(framesTranscoded_) / seconds : 0;
+}
+
+inline double TranscodeEngine::Progress::FramesPerSecond() const noexcept {
+    const auto seconds = std::chrono::duration<double>(elapsed_).count();
+    return seconds > 0 ? static_cast<double>(framesTranscoded_) / seconds : 0;
+}
+
+inline void TranscodeEngine::Cancel() noexcept { cancelRequested_.store(true, std::memory_order_relaxed); }
+
+} /* namespace audio_toolbox */
+
+CF_ASSUME_NONNULL_END
@@ -0,0 +1,151 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/AudioFileInfoCacheTests.hpp"
+
+#include "Expect.hpp"
+
+#include "MemoTable.hpp"
+
+#include <audio_toolbox/AudioFileInfoCache.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::AudioFileInfoCache;
+using audio_toolbox::detail::MemoTable;
+
+/// A table mapping integers to their doubles.
+using DoublingTable = MemoTable<int, int>;
+
+} /* namespace */
+
+bool test_support::AudioFileInfoCacheReturnsCachedValues() noexcept {
+    return detail::Run("AudioFileInfoCacheReturnsCachedValues", [](const char *scenario) {
+        AudioFileInfoCache::Invalidate();
+
+        const auto readable = AudioFileInfoCache::ReadableTypes();
+        const auto writable = AudioFileInfoCache::WritableTypes();
+        if (AudioFileInfoCache::ReadableTypes() != readable || AudioFileInfoCache::WritableTypes() != writable) {
+            return detail::Fail(scenario, "Repeated queries did not return the cached value");
+        }
+
+        AudioFileInfoCache::Invalidate();
+        const auto requeried = AudioFileInfoCache::ReadableTypes();
+        if (requeried == readable || *requeried != *readable) {
+            return detail::Fail(scenario, "A query after invalidation did not return a new, equal value");
+        }
+        return true;
+    });
+}
+
+bool test_support::AudioFileInfoCacheEvictsOldestValue() noexcept {
+    return detail::Run("AudioFileInfoCacheEvictsOldestValue", [](const char *scenario) {
+        constexpr auto capacity = static_cast<int>(DoublingTable::kCapacity);
+        DoublingTable table;
+
+        auto computeCount = 0;
+        const auto get = [&](int key) {
+            return table.Get(key, [&] {
+                ++computeCount;
+                return key * 2;
+            });
+        };
+
+        const auto first = get(0);
+        for (auto key = 1; key < capacity + 10; ++key) {
+            get(key);
+        }
+
+        // Only the ten oldest values make room for the ten values inserted while full
+        if (table.Size() != DoublingTable::kCapacity || computeCount != capacity + 10) {
+            return detail::Fail(scenario, "The table did not stay full while inserting");
+        }
+        for (auto key = 0; key < capacity + 10; ++key) {
+            if (static_cast<bool>(table.Find(key)) != (key >= 10)) {
+                return detail::Fail(scenario, "A value other than the oldest was evicted");
+            }
+        }
+
+        // An evicted value remains valid and is recomputed on the next query
+        if (*first != 0 || *get(0) != 0 || computeCount != capacity + 11 || table.Find(10)) {
+            return detail::Fail(scenario, "An evicted value was not recomputed in place of the oldest value");
+        }
+
+        table.Clear();
+        if (table.Size() != 0 || table.Find(20)) {
+            return detail::Fail(scenario, "Clear() did not discard the values");
+        }
+        return true;
+    });
+}
+
+bool test_support::AudioFileInfoCacheComputesWithoutLocking() noexcept {
+    return detail::Run("AudioFileInfoCacheComputesWithoutLocking", [](const char *scenario) {
+        DoublingTable table;
+
+        // A computation that queries the same table would deadlock if the table were locked
+        const auto value = table.Get(1, [&] { return *table.Get(2, [] { return 4; }) - 2; });
+        if (*value != 2 || *table.Find(2) != 4 || table.Size() != 2) {
+            return detail::Fail(scenario, "A nested query did not insert both values");
+        }
+
+        try {
+            (void)table.Get(3, []() -> int { throw std::runtime_error("Computation failed"); });
+            return detail::Fail(scenario, "An exception thrown by a computation was not propagated");
+        } catch (const std::runtime_error &) {
+        }
+        if (table.Find(3) || table.Size() != 2) {
+            return detail::Fail(scenario, "A failed computation inserted a value");
+        }
+        return true;
+    });
+}
+
+bool test_support::AudioFileInfoCacheSupportsConcurrentUse() noexcept {
+    return detail::Run("AudioFileInfoCacheSupportsConcurrentUse", [](const char *scenario) {
+        DoublingTable table;
+
+        // Twice as many keys as the capacity keep insertions, evictions, and lookups interleaved
+        constexpr auto keyCount = static_cast<int>(DoublingTable::kCapacity) * 2;
+        std::atomic_bool mismatch{false};
+        std::atomic_bool stop{false};
+
+        std::vector<std::thread> threads;
+        for (auto i = 0; i < 4; ++i) {
+            threads.emplace_back([&, i] {
+                for (auto n = 0; n < 20'000; ++n) {
+                    const auto key = (n * 7 + i * 13) % keyCount;
+                    if (*table.Get(key, [key] { return key * 2; }) != key * 2) {
+                        mismatch = true;
+                    }
+                }
+            });
+        }
+        std::thread clearer{[&] {
+            while (!stop) {
+                table.Clear();
+                std::this_thread::yield();
+            }
+        }};
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        stop = true;
+        clearer.join();
+
+        if (mismatch || table.Size() > DoublingTable::kCapacity) {
+            return detail::Fail(scenario, "Concurrent queries returned incorrect values");
+        }
+        return true;
+    });
+}
@@ -0,0 +1,165 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/AudioFormatPropertyCacheTests.hpp"
+
+#include "Expect.hpp"
+
+#include <audio_toolbox/AudioFormatPropertyCache.hpp>
+#include <audio_toolbox/CAAudioFormat.hpp>
+
+#include <vector>
+
+namespace {
+
+using audio_toolbox::AudioFormatPropertyCache;
+
+/// Returns the value of a property without a specifier as AudioFormat reports it.
+std::vector<AudioFormatID> GetFormatIDs(AudioFormatPropertyID inPropertyID) {
+    auto size = audio_toolbox::CAAudioFormat::GetPropertyInfo(inPropertyID, 0, nullptr);
+    std::vector<AudioFormatID> formatIDs(size / sizeof(AudioFormatID));
+    audio_toolbox::CAAudioFormat::GetProperty(inPropertyID, 0, nullptr, size, formatIDs.data());
+    formatIDs.resize(size / sizeof(AudioFormatID));
+    return formatIDs;
+}
+
+/// Returns the value of a property without a specifier from a cache.
+std::vector<AudioFormatID> GetCachedFormatIDs(AudioFormatPropertyCache &cache, AudioFormatPropertyID inPropertyID) {
+    auto size = cache.GetPropertyInfo(inPropertyID, 0, nullptr);
+    std::vector<AudioFormatID> formatIDs(size / sizeof(AudioFormatID));
+    cache.GetProperty(inPropertyID, 0, nullptr, size, formatIDs.data());
+    formatIDs.resize(size / sizeof(AudioFormatID));
+    return formatIDs;
+}
+
+} /* namespace */
+
+bool test_support::AudioFormatPropertyCacheCachesValues() noexcept {
+    return detail::Run("AudioFormatPropertyCacheCachesValues", [](const char *scenario) {
+        AudioFormatPropertyCache cache;
+
+        const auto expected = GetFormatIDs(kAudioFormatProperty_DecodeFormatIDs);
+        if (cache.DecodeFormatIDs() != expected || cache.DecodeFormatIDs() != expected ||
+            GetCachedFormatIDs(cache, kAudioFormatProperty_DecodeFormatIDs) != expected) {
+            return detail::Fail(scenario, "A cached value does not match AudioFormat");
+        }
+
+        // The first lookup misses; the second, the size query, and the value query hit
+        auto statistics = cache.GetStatistics();
+        if (statistics.misses_ != 1 || statistics.hits_ != 3 || statistics.HitRate() != 0.75) {
+            return detail::Fail(scenario, "Repeated lookups were not counted as hits");
+        }
+
+        // Properties that are not cached are passed through
+        AudioStreamBasicDescription format{};
+        format.mFormatID = kAudioFormatLinearPCM;
+        format.mSampleRate = 44'100;
+        format.mChannelsPerFrame = 2;
+        UInt32 size = sizeof format;
+        cache.GetProperty(kAudioFormatProperty_FormatInfo, 0, nullptr, size, &format);
+        statistics = cache.GetStatistics();
+        if (AudioFormatPropertyCache::IsCacheable(kAudioFormatProperty_FormatInfo) || statistics.bypasses_ != 1) {
+            return detail::Fail(scenario, "A property that is not cached was not passed through");
+        }
+
+        cache.ResetStatistics();
+        cache.Clear();
+        statistics = cache.GetStatistics();
+        if (statistics.hits_ != 0 || statistics.misses_ != 0 || statistics.bypasses_ != 0 || statistics.size_ != 0) {
+            return detail::Fail(scenario, "The statistics or values were not reset");
+        }
+        return true;
+    });
+}
+
+bool test_support::AudioFormatPropertyCacheQueriesSizesOnMisses() noexcept {
+    return detail::Run("AudioFormatPropertyCacheQueriesSizesOnMisses", [](const char *scenario) {
+        AudioFormatPropertyCache cache;
+
+        const auto size = cache.GetPropertyInfo(kAudioFormatProperty_EncodeFormatIDs, 0, nullptr);
+        if (size != audio_toolbox::CAAudioFormat::GetPropertyInfo(kAudioFormatProperty_EncodeFormatIDs, 0, nullptr)) {
+            return detail::Fail(scenario, "The size does not match AudioFormat");
+        }
+        auto statistics = cache.GetStatistics();
+        if (statistics.misses_ != 1 || statistics.size_ != 0) {
+            return detail::Fail(scenario, "A size query for a value not cached fetched the value");
+        }
+
+        // Once the value is cached its size is answered from the cache
+        const auto formatIDs = cache.EncodeFormatIDs();
+        if (cache.GetPropertyInfo(kAudioFormatProperty_EncodeFormatIDs, 0, nullptr) != size ||
+            formatIDs.size() * sizeof(AudioFormatID) != size) {
+            return detail::Fail(scenario, "The cached size does not match AudioFormat");
+        }
+        statistics = cache.GetStatistics();
+        if (statistics.misses_ != 2 || statistics.hits_ != 1 || statistics.size_ == 0) {
+            return detail::Fail(scenario, "A size query for a cached value was not a hit");
+        }
+        return true;
+    });
+}
+
+bool test_support::AudioFormatPropertyCacheCopiesPartialValues() noexcept {
+    return detail::Run("AudioFormatPropertyCacheCopiesPartialValues", [](const char *scenario) {
+        AudioFormatPropertyCache cache;
+
+        const auto expected = GetFormatIDs(kAudioFormatProperty_DecodeFormatIDs);
+        if (expected.size() < 2) {
+            return detail::Fail(scenario, "AudioFormat reports fewer than two decoders");
+        }
+
+        // Both the lookup that fetches the value and the one that finds it cached copy the leading portion
+        for (auto i = 0; i < 2; ++i) {
+            AudioFormatID formatIDs[2]{};
+            UInt32 size = sizeof(AudioFormatID);
+            cache.GetProperty(kAudioFormatProperty_DecodeFormatIDs, 0, nullptr, size, formatIDs);
+            if (size != sizeof(AudioFormatID) || formatIDs[0] != expected[0] || formatIDs[1] != 0) {
+                return detail::Fail(scenario, "A small buffer did not receive the leading portion of the value");
+            }
+        }
+
+        // Without a buffer the size of the value is reported
+        UInt32 size = 0;
+        cache.GetProperty(kAudioFormatProperty_DecodeFormatIDs, 0, nullptr, size, nullptr);
+        if (size != expected.size() * sizeof(AudioFormatID)) {
+            return detail::Fail(scenario, "The size of the value was not reported without a buffer");
+        }
+        return true;
+    });
+}
+
+bool test_support::AudioFormatPropertyCacheEvictsLeastRecentlyUsed() noexcept {
+    return detail::Run("AudioFormatPropertyCacheEvictsLeastRecentlyUsed", [](const char *scenario) {
+        // Room for both lists of format IDs but not a third value
+        const auto encodeSize = GetFormatIDs(kAudioFormatProperty_EncodeFormatIDs).size() * sizeof(AudioFormatID);
+        const auto decodeSize = GetFormatIDs(kAudioFormatProperty_DecodeFormatIDs).size() * sizeof(AudioFormatID);
+        AudioFormatPropertyCache cache{encodeSize + decodeSize + 2 * sizeof(AudioFormatPropertyID)};
+
+        (void)cache.EncodeFormatIDs();
+        (void)cache.DecodeFormatIDs();
+        (void)cache.EncodeFormatIDs();
+        if (cache.GetStatistics().evictions_ != 0) {
+            return detail::Fail(scenario, "A value was evicted while within the capacity");
+        }
+
+        // The decode list is the least recently used
+        UInt32 isVBR = 0;
+        UInt32 size = sizeof isVBR;
+        AudioStreamBasicDescription format{};
+        format.mFormatID = kAudioFormatMPEG4AAC;
+        cache.GetProperty(kAudioFormatProperty_FormatIsVBR, sizeof format, &format, size, &isVBR);
+
+        cache.ResetStatistics();
+        (void)cache.EncodeFormatIDs();
+        (void)cache.DecodeFormatIDs();
+        const auto statistics = cache.GetStatistics();
+        if (statistics.hits_ != 1 || statistics.misses_ != 1 || statistics.size_ > encodeSize + decodeSize + 8) {
+            return detail::Fail(scenario, "The least recently used value was not evicted");
+        }
+        return true;
+    });
+}
@@ -0,0 +1,126 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/BatchProbeTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/BatchProbe.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::BatchProbe;
+
+/// A file written for probing.
+struct ProbedFile {
+    /// The file name.
+    const char *name_;
+    /// The file type.
+    AudioFileTypeID fileType_;
+    /// The number of channels.
+    UInt32 channelCount_;
+    /// True if the file contains 16-bit integer rather than AAC audio.
+    bool pcm_;
+};
+
+/// The files written for probing.
+constexpr ProbedFile kFiles[] = {
+        {"stereo.caf", kAudioFileCAFType, 2, true},
+        {"mono.aiff", kAudioFileAIFFType, 1, true},
+        {"stereo.m4a", kAudioFileM4AType, 2, false},
+};
+
+/// Writes the files for probing, each a different length, and returns the paths of copies enough to keep every
+/// thread busy.
+std::vector<std::string> WriteFiles(const test_support::detail::TemporaryDirectory &directory, std::size_t copies) {
+    std::vector<std::string> paths;
+    for (std::size_t i = 0; i < copies; ++i) {
+        for (const auto &file : kFiles) {
+            const auto path = directory.Path((std::to_string(i) + "-" + file.name_).c_str());
+            const auto format = file.pcm_ ? test_support::detail::MakeInt16Format(44'100, file.channelCount_, true)
+                                          : test_support::detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100,
+                                                                                       file.channelCount_);
+            test_support::detail::WriteTestFile(path, file.fileType_, format, 1'000 * (i + 1));
+            paths.push_back(path);
+        }
+    }
+    return paths;
+}
+
+/// Returns true if a result describes the file written by WriteFiles at index.
+bool Matches(const BatchProbe::Result &result, std::size_t index) {
+    const auto &file = kFiles[index % std::size(kFiles)];
+    const auto copy = index / std::size(kFiles);
+    return result && result.fileFormat_ == file.fileType_ &&
+           result.dataFormat_.mFormatID == (file.pcm_ ? kAudioFormatLinearPCM : kAudioFormatMPEG4AAC) &&
+           result.dataFormat_.mChannelsPerFrame == file.channelCount_ &&
+           result.frameLength_ == static_cast<SInt64>(1'000 * (copy + 1));
+}
+
+} /* namespace */
+
+bool test_support::BatchProbeProbesFilesInOrder() noexcept {
+    return detail::Run("BatchProbeProbesFilesInOrder", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto paths = WriteFiles(directory, 8);
+
+        for (const auto threadCount : {1U, 4U}) {
+            BatchProbe probe{threadCount};
+            if (probe.ThreadCount() != threadCount) {
+                return detail::Fail(scenario, "The probe does not have the requested number of threads");
+            }
+
+            const auto results = probe.Probe(paths);
+            if (results.size() != paths.size()) {
+                return detail::Fail(scenario, "The probe did not return one result per file");
+            }
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                if (!Matches(results[i], i)) {
+                    return detail::Fail(scenario, "A result does not describe the file at its index");
+                }
+            }
+
+            if (!probe.Probe({}).empty()) {
+                return detail::Fail(scenario, "Probing no files returned results");
+            }
+        }
+        return true;
+    });
+}
+
+bool test_support::BatchProbeCapturesErrors() noexcept {
+    return detail::Run("BatchProbeCapturesErrors", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        auto paths = WriteFiles(directory, 1);
+
+        const auto garbage = directory.Path("garbage.caf");
+        if (auto file = std::fopen(garbage.c_str(), "wb")) {
+            std::fputs("Not an audio file", file);
+            std::fclose(file);
+        }
+
+        paths.insert(paths.begin() + 1, directory.Path("missing.caf"));
+        paths.push_back(garbage);
+
+        BatchProbe probe{2};
+        const auto results = probe.Probe(paths);
+        if (results.size() != paths.size() || results[1] || results.back()) {
+            return detail::Fail(scenario, "Errors were not captured in the results of unreadable files");
+        }
+        if (!Matches(results[0], 0) || !Matches(results[2], 1) || !Matches(results[3], 2)) {
+            return detail::Fail(scenario, "An error affected the results of other files");
+        }
+        return true;
+    });
+}
@@ -0,0 +1,238 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/BlockCachedFileTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/BlockCachedFile.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::BlockCachedFile;
+
+/// The cache block size used by the tests.
+constexpr UInt32 kBlockSize = 4096;
+
+/// Writes a file of pseudorandom bytes, returning its contents.
+std::vector<unsigned char> WriteRandomFile(const std::string &path, std::size_t size) {
+    std::vector<unsigned char> contents(size);
+    std::mt19937 generator{static_cast<std::mt19937::result_type>(size)};
+    for (auto &byte : contents) {
+        byte = static_cast<unsigned char>(generator());
+    }
+
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> file{std::fopen(path.c_str(), "wb"), &std::fclose};
+    if (!file || std::fwrite(contents.data(), 1, size, file.get()) != size) {
+        throw std::system_error(errno, std::generic_category(), "fwrite");
+    }
+    return contents;
+}
+
+/// Returns a configuration with the test block size.
+BlockCachedFile::Configuration MakeConfiguration(UInt32 blockCount, UInt32 prefetchBlockCount, UInt32 workerCount) {
+    BlockCachedFile::Configuration configuration;
+    configuration.blockSize_ = kBlockSize;
+    configuration.blockCount_ = blockCount;
+    configuration.prefetchBlockCount_ = prefetchBlockCount;
+    configuration.workerCount_ = workerCount;
+    return configuration;
+}
+
+/// Returns true if a read through the cache matches the file contents.
+bool ReadMatches(BlockCachedFile &file, const std::vector<unsigned char> &contents, SInt64 position,
+                 std::size_t byteCount) {
+    std::vector<unsigned char> buffer(byteCount);
+    const auto bytesRead = file.Read(position, byteCount, buffer.data());
+    const auto expected = position < static_cast<SInt64>(contents.size())
+                                  ? std::min(byteCount, contents.size() - static_cast<std::size_t>(position))
+                                  : 0;
+    return bytesRead == expected && std::memcmp(buffer.data(), contents.data() + position, bytesRead) == 0;
+}
+
+} /* namespace */
+
+bool test_support::BlockCachedFileMatchesFile() noexcept {
+    return detail::Run("BlockCachedFileMatchesFile", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("random.bin");
+        // A size that is not a multiple of the block size leaves a short final block
+        const auto contents = WriteRandomFile(path, 250 * kBlockSize + 1234);
+        const auto size = static_cast<SInt64>(contents.size());
+
+        for (const auto workerCount : {0U, 1U, 4U}) {
+            BlockCachedFile file{MakeConfiguration(16, 4, workerCount)};
+            file.Open(path.c_str());
+            if (file.Size() != size) {
+                return detail::Fail(scenario, "The file size is incorrect");
+            }
+
+            // Sequential reads of sizes unrelated to the block size
+            for (SInt64 position = 0; position < size;) {
+                const auto byteCount = std::size_t{1000} + static_cast<std::size_t>(position % 7919);
+                if (!ReadMatches(file, contents, position, byteCount)) {
+                    return detail::Fail(scenario, "A sequential read does not match the file");
+                }
+                position += static_cast<SInt64>(byteCount);
+            }
+
+            // Random reads, including reads spanning more blocks than the cache holds and reads past the end
+            std::mt19937 generator{workerCount};
+            std::uniform_int_distribution<SInt64> positions{0, size + kBlockSize};
+            std::uniform_int_distribution<std::size_t> byteCounts{1, 20 * kBlockSize};
+            for (auto i = 0; i < 500; ++i) {
+                if (!ReadMatches(file, contents, positions(generator), byteCounts(generator))) {
+                    return detail::Fail(scenario, "A random read does not match the file");
+                }
+            }
+
+            if (!ReadMatches(file, contents, size - 1, 100) || !ReadMatches(file, contents, size, 100)) {
+                return detail::Fail(scenario, "A read at the end of the file is incorrect");
+            }
+
+            const auto statistics = file.GetStatistics();
+            if (statistics.cacheHits_ == 0 || statistics.cacheMisses_ == 0 ||
+                statistics.bytesRead_ < static_cast<UInt64>(size)) {
+                return detail::Fail(scenario, "The statistics do not reflect the reads");
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::BlockCachedFileSupportsConcurrentReads() noexcept {
+    return detail::Run("BlockCachedFileSupportsConcurrentReads", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("random.bin");
+        const auto contents = WriteRandomFile(path, 64 * kBlockSize + 99);
+        const auto size = static_cast<SInt64>(contents.size());
+
+        BlockCachedFile file{MakeConfiguration(6, 2, 2)};
+        file.Open(path.c_str());
+
+        constexpr auto threadCount = 8;
+        std::atomic_bool failed{false};
+        std::vector<std::thread> threads;
+        for (auto t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                try {
+                    std::mt19937 generator{static_cast<std::mt19937::result_type>(t)};
+                    std::uniform_int_distribution<SInt64> positions{0, size - 1};
+                    std::uniform_int_distribution<std::size_t> byteCounts{1, 3 * kBlockSize};
+                    for (auto i = 0; i < 2000 && !failed.load(); ++i) {
+                        // Half the threads read sequentially to exercise read-ahead
+                        const auto position = t % 2 ? positions(generator) : (i * SInt64{1500}) % size;
+                        if (!ReadMatches(file, contents, position, byteCounts(generator))) {
+                            failed.store(true);
+                        }
+                    }
+                } catch (...) {
+                    failed.store(true);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (failed.load()) {
+            return detail::Fail(scenario, "A concurrent read does not match the file");
+        }
+        return true;
+    });
+}
+
+bool test_support::BlockCachedFileKeepsPrefetchedBlocks() noexcept {
+    return detail::Run("BlockCachedFileKeepsPrefetchedBlocks", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("random.bin");
+        const auto contents = WriteRandomFile(path, 64 * kBlockSize);
+
+        constexpr UInt32 prefetchBlockCount = 4;
+        BlockCachedFile file{MakeConfiguration(8, prefetchBlockCount, 1)};
+        file.Open(path.c_str());
+
+        // Reading blocks 0 and 1 in order reads blocks 2 through 5 ahead
+        if (!ReadMatches(file, contents, 0, kBlockSize) || !ReadMatches(file, contents, kBlockSize, kBlockSize)) {
+            return detail::Fail(scenario, "A sequential read does not match the file");
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (file.GetStatistics().prefetchedBlocks_ < prefetchBlockCount) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return detail::Fail(scenario, "Blocks were not read ahead");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // Fill the two empty slots and evict one more; blocks 0 and 1 were used before the read-ahead finished
+        for (const auto block : {20, 30, 40}) {
+            if (!ReadMatches(file, contents, block * SInt64{kBlockSize}, kBlockSize)) {
+                return detail::Fail(scenario, "A random read does not match the file");
+            }
+        }
+
+        file.ResetStatistics();
+        for (SInt64 block = 2; block < 2 + prefetchBlockCount; ++block) {
+            if (!ReadMatches(file, contents, block * kBlockSize, kBlockSize)) {
+                return detail::Fail(scenario, "A read of a block read ahead does not match the file");
+            }
+        }
+        if (file.GetStatistics().cacheMisses_ != 0) {
+            return detail::Fail(scenario, "A block read ahead was evicted before blocks used earlier");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::BlockCachedFileRejectsInvalidUse() noexcept {
+    return detail::Run("BlockCachedFileRejectsInvalidUse", [](const char *scenario) {
+        for (const auto &configuration : {MakeConfiguration(1, 0, 0), MakeConfiguration(8, 8, 1)}) {
+            try {
+                BlockCachedFile file{configuration};
+                return detail::Fail(scenario, "An invalid configuration was accepted");
+            } catch (const std::invalid_argument &) {
+            }
+        }
+
+        BlockCachedFile file;
+        unsigned char byte;
+        try {
+            file.Read(0, 1, &byte);
+            return detail::Fail(scenario, "A read of a closed file did not throw");
+        } catch (const std::system_error &) {
+        }
+
+        detail::TemporaryDirectory directory;
+        try {
+            file.Open(directory.Path("missing.bin").c_str());
+            return detail::Fail(scenario, "Opening a missing file did not throw");
+        } catch (const std::system_error &e) {
+            if (e.code() != std::errc::no_such_file_or_directory) {
+                return detail::Fail(scenario, "Opening a missing file threw an unexpected error");
+            }
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,182 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/BufferedPacketWriterTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/BufferedPacketWriter.hpp>
+#include <audio_toolbox/CAAudioFile.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::BufferedPacketWriter;
+using audio_toolbox::CAAudioFile;
+
+/// The format of the packets written by the tests.
+const auto kFormat = test_support::detail::MakeInt16Format(44'100, 2, false);
+
+/// Returns packet data for a range of packets that depends only on each byte's position in the file.
+std::vector<unsigned char> MakePackets(SInt64 startingPacket, UInt32 packetCount) {
+    std::vector<unsigned char> data(static_cast<std::size_t>(packetCount) * kFormat.mBytesPerPacket);
+    const auto startingByte = static_cast<std::size_t>(startingPacket) * kFormat.mBytesPerPacket;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>((startingByte + i) * 7);
+    }
+    return data;
+}
+
+/// Creates a writer for a new CAF file.
+BufferedPacketWriter MakeWriter(const std::string &path, UInt32 packetCapacity, std::chrono::milliseconds latency,
+                                UInt32 packetAlignment = 1) {
+    const auto url = test_support::detail::CreateURL(path);
+    CAAudioFile file;
+    file.CreateWithURL(url.get(), kAudioFileCAFType, kFormat, kAudioFileFlags_EraseFile);
+    return BufferedPacketWriter{std::move(file), packetCapacity * kFormat.mBytesPerPacket, packetCapacity, latency,
+                                false, packetAlignment};
+}
+
+/// Writes packets to a writer.
+void Write(BufferedPacketWriter &writer, SInt64 startingPacket, UInt32 packetCount) {
+    const auto data = MakePackets(startingPacket, packetCount);
+    writer.WritePackets(static_cast<UInt32>(data.size()), nullptr, startingPacket, packetCount, data.data());
+}
+
+/// Returns true if a file contains packetCount packets matching MakePackets.
+bool FileMatches(const std::string &path, UInt32 packetCount) {
+    const auto url = test_support::detail::CreateURL(path);
+    CAAudioFile file;
+    file.OpenURL(url.get(), kAudioFileReadPermission, kAudioFileCAFType);
+    if (file.AudioDataPacketCount() != packetCount) {
+        return false;
+    }
+
+    const auto expected = MakePackets(0, packetCount);
+    std::vector<unsigned char> actual(expected.size());
+    auto byteCount = static_cast<UInt32>(actual.size());
+    auto count = packetCount;
+    file.ReadPacketData(false, byteCount, nullptr, 0, count, actual.data());
+    return count == packetCount && actual == expected;
+}
+
+} /* namespace */
+
+bool test_support::BufferedPacketWriterCoalescesWrites() noexcept {
+    return detail::Run("BufferedPacketWriterCoalescesWrites", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("coalesced.caf");
+
+        constexpr UInt32 packetCount = 1000;
+        {
+            auto writer = MakeWriter(path, 256, std::chrono::minutes{1});
+            for (SInt64 packet = 0; packet < packetCount; ++packet) {
+                Write(writer, packet, 1);
+            }
+            if (writer.FileWriteCount() != packetCount / 256 || writer.BufferedPacketCount() != packetCount % 256) {
+                return detail::Fail(scenario, "Writes were not coalesced into full batches");
+            }
+            writer.Flush();
+            if (writer.FileWriteCount() != packetCount / 256 + 1 || writer.BufferedPacketCount() != 0 ||
+                writer.NextPacket() != packetCount) {
+                return detail::Fail(scenario, "Flush did not write the buffered packets");
+            }
+            writer.AudioFile().Close();
+        }
+
+        if (!FileMatches(path, packetCount)) {
+            return detail::Fail(scenario, "The file does not contain the written packets");
+        }
+        return true;
+    });
+}
+
+bool test_support::BufferedPacketWriterAlignsBatches() noexcept {
+    return detail::Run("BufferedPacketWriterAlignsBatches", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("aligned.caf");
+
+        {
+            auto writer = MakeWriter(path, 10, std::chrono::minutes{1}, 4);
+
+            // Filling the storage writes packets 0 through 7 and keeps 8 and 9
+            for (SInt64 packet = 0; packet < 10; ++packet) {
+                Write(writer, packet, 1);
+            }
+            if (writer.FileWriteCount() != 1 || writer.BufferedPacketCount() != 2 || writer.NextPacket() != 10) {
+                return detail::Fail(scenario, "A full batch did not end on the packet alignment");
+            }
+
+            // A write that does not fit makes room with an aligned batch ending at packet 10
+            Write(writer, 10, 9);
+            if (writer.FileWriteCount() != 2 || writer.BufferedPacketCount() != 9 || writer.NextPacket() != 19) {
+                return detail::Fail(scenario, "A write that did not fit was not preceded by an aligned batch");
+            }
+
+            // A write larger than the storage is written directly after an aligned batch ending at packet 16 and the
+            // packets following it
+            Write(writer, 19, 25);
+            if (writer.FileWriteCount() != 5 || writer.BufferedPacketCount() != 0 || writer.NextPacket() != 44) {
+                return detail::Fail(scenario, "An oversized write was not written directly");
+            }
+
+            // A write that is not contiguous writes the buffered packets first
+            Write(writer, 44, 3);
+            Write(writer, 47, 2);
+            Write(writer, 44, 5);
+            if (writer.FileWriteCount() != 6 || writer.BufferedPacketCount() != 5) {
+                return detail::Fail(scenario, "A non-contiguous write did not write the buffered packets first");
+            }
+
+            writer.Flush();
+            writer.AudioFile().Close();
+        }
+
+        if (!FileMatches(path, 49)) {
+            return detail::Fail(scenario, "The file does not contain the written packets");
+        }
+        return true;
+    });
+}
+
+bool test_support::BufferedPacketWriterMeasuresRemainingLatency() noexcept {
+    return detail::Run("BufferedPacketWriterMeasuresRemainingLatency", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("latency.caf");
+
+        constexpr std::chrono::milliseconds latency{400};
+        auto writer = MakeWriter(path, 10, latency, 4);
+
+        Write(writer, 0, 3);
+        std::this_thread::sleep_for(latency * 3 / 4);
+
+        // Filling the storage writes packets 0 through 7 and keeps 8 and 9
+        Write(writer, 3, 7);
+        if (writer.BufferedPacketCount() != 2) {
+            return detail::Fail(scenario, "A full batch did not end on the packet alignment");
+        }
+
+        // The first packets were buffered longer than the latency ago, but the remaining packets were not
+        std::this_thread::sleep_for(latency * 3 / 8);
+        if (writer.FlushIfExpired() || writer.BufferedPacketCount() != 2) {
+            return detail::Fail(scenario, "Packets remaining after an aligned batch were written early");
+        }
+
+        std::this_thread::sleep_for(latency * 3 / 4);
+        if (!writer.FlushIfExpired() || writer.BufferedPacketCount() != 0) {
+            return detail::Fail(scenario, "Expired packets were not written");
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,298 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/ChannelMatrixMixerTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/ChannelMatrixMixer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::ChannelMatrixMixer;
+
+/// The sample rate of the mixed signals.
+constexpr Float64 kSampleRate = 44'100;
+
+/// The number of frames mixed, spanning several internal blocks and ending with a partial block.
+constexpr UInt32 kFrameCount = 1'500;
+
+/// Deinterleaved samples of each channel.
+using Channels = std::vector<std::vector<float>>;
+
+/// Returns a float format with channels channels, interleaved or not.
+AudioStreamBasicDescription MakeFormat(UInt32 channels, bool interleaved) noexcept {
+    const auto format = test_support::detail::MakeFloatFormat(kSampleRate, channels);
+    return interleaved ? format : test_support::detail::MakeNonInterleaved(format);
+}
+
+/// Returns the number of buffers in a buffer list for format.
+UInt32 BufferCount(const AudioStreamBasicDescription &format) noexcept {
+    return (format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0 ? format.mChannelsPerFrame : 1;
+}
+
+/// Returns a matrix of inputs rows and outputs columns with every gain nonzero.
+std::vector<Float32> MakeDenseMatrix(UInt32 inputs, UInt32 outputs) {
+    std::vector<Float32> matrix(static_cast<std::size_t>(inputs) * outputs);
+    for (std::size_t i = 0; i < matrix.size(); ++i) {
+        matrix[i] = .1f * static_cast<float>(i % 7 + 1) - .05f * static_cast<float>(i % 3);
+    }
+    return matrix;
+}
+
+/// Returns a matrix of inputs rows and outputs columns with few nonzero gains.
+std::vector<Float32> MakeSparseMatrix(UInt32 inputs, UInt32 outputs) {
+    std::vector<Float32> matrix(static_cast<std::size_t>(inputs) * outputs);
+    // Each output but the last, which is silent, takes one input alternately at unity and half gain
+    for (UInt32 output = 0; output + 1 < outputs; ++output) {
+        matrix[(output * 3 + 1) % inputs * outputs + output] = output % 2 != 0 ? .5f : 1.f;
+    }
+    // The last input is also mixed into the first output
+    matrix[(inputs - 1) * outputs] += .25f;
+    return matrix;
+}
+
+/// Returns the reference mix of kFrameCount frames of the test signal in double precision.
+Channels MixReference(UInt32 inputs, UInt32 outputs, const std::vector<Float32> &matrix) {
+    Channels mixed(outputs, std::vector<float>(kFrameCount));
+    for (UInt32 output = 0; output < outputs; ++output) {
+        for (UInt32 frame = 0; frame < kFrameCount; ++frame) {
+            double sum = 0;
+            for (UInt32 input = 0; input < inputs; ++input) {
+                sum += static_cast<double>(test_support::detail::TestSignal(frame, input, kSampleRate)) *
+                       matrix[input * outputs + output];
+            }
+            mixed[output][frame] = static_cast<float>(sum);
+        }
+    }
+    return mixed;
+}
+
+/// Mixes kFrameCount frames of the test signal and returns the output.
+/// @param mixer The mixer.
+/// @param outputPlacement For each output buffer, the index of the input buffer it begins at, or -1 for separate
+/// memory.
+Channels Mix(ChannelMatrixMixer &mixer, const std::vector<int> &outputPlacement) {
+    const auto &source = mixer.SourceFormat();
+    const auto &destination = mixer.DestinationFormat();
+    const auto inputChannelsPerBuffer = source.mChannelsPerFrame / BufferCount(source);
+    const auto outputChannelsPerBuffer = destination.mChannelsPerFrame / BufferCount(destination);
+
+    // Every buffer is large enough to hold input or output
+    const auto floatsPerFrame = std::max(source.mBytesPerFrame, destination.mBytesPerFrame) / sizeof(float);
+    Channels storage(BufferCount(source) + BufferCount(destination),
+                     std::vector<float>(kFrameCount * floatsPerFrame));
+
+    test_support::detail::BufferList input{BufferCount(source)};
+    for (UInt32 i = 0; i < BufferCount(source); ++i) {
+        for (UInt32 frame = 0; frame < kFrameCount; ++frame) {
+            for (UInt32 c = 0; c < inputChannelsPerBuffer; ++c) {
+                storage[i][frame * inputChannelsPerBuffer + c] =
+                        test_support::detail::TestSignal(frame, i * inputChannelsPerBuffer + c, kSampleRate);
+            }
+        }
+        input.Set(i, storage[i].data(), kFrameCount * source.mBytesPerFrame, inputChannelsPerBuffer);
+    }
+
+    test_support::detail::BufferList output{BufferCount(destination)};
+    for (UInt32 i = 0; i < BufferCount(destination); ++i) {
+        auto &buffer = outputPlacement[i] < 0 ? storage[BufferCount(source) + i] : storage[outputPlacement[i]];
+        output.Set(i, buffer.data(), static_cast<UInt32>(buffer.size() * sizeof(float)), outputChannelsPerBuffer);
+    }
+
+    mixer.Process(kFrameCount, input.get(), output.get());
+
+    Channels mixed(destination.mChannelsPerFrame, std::vector<float>(kFrameCount));
+    for (UInt32 i = 0; i < BufferCount(destination); ++i) {
+        if (output.get()->mBuffers[i].mDataByteSize != kFrameCount * destination.mBytesPerFrame) {
+            throw std::logic_error("The output buffer sizes do not match the frames mixed");
+        }
+        const auto *samples = static_cast<const float *>(output.get()->mBuffers[i].mData);
+        for (UInt32 frame = 0; frame < kFrameCount; ++frame) {
+            for (UInt32 c = 0; c < outputChannelsPerBuffer; ++c) {
+                mixed[i * outputChannelsPerBuffer + c][frame] = samples[frame * outputChannelsPerBuffer + c];
+            }
+        }
+    }
+    return mixed;
+}
+
+/// Returns true if two sets of channels differ by no more than tolerance.
+bool Matches(const Channels &a, const Channels &b, float tolerance) noexcept {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t c = 0; c < a.size(); ++c) {
+        for (std::size_t i = 0; i < a[c].size(); ++i) {
+            if (!(std::abs(a[c][i] - b[c][i]) <= tolerance)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} /* namespace */
+
+bool test_support::ChannelMatrixMixerMatchesReference() noexcept {
+    return detail::Run("ChannelMatrixMixerMatchesReference", [](const char *scenario) {
+        const struct {
+            UInt32 inputs_;
+            UInt32 outputs_;
+        } channelCounts[] = {{1, 2}, {2, 1}, {6, 2}, {2, 6}, {8, 8}, {3, 5}};
+
+        for (const auto &[inputs, outputs] : channelCounts) {
+            for (const auto sparse : {false, true}) {
+                const auto matrix = sparse ? MakeSparseMatrix(inputs, outputs) : MakeDenseMatrix(inputs, outputs);
+                const auto expected = MixReference(inputs, outputs, matrix);
+
+                for (const auto sourceInterleaved : {true, false}) {
+                    for (const auto destinationInterleaved : {true, false}) {
+                        ChannelMatrixMixer mixer;
+                        mixer.New(MakeFormat(inputs, sourceInterleaved), MakeFormat(outputs, destinationInterleaved),
+                                  matrix);
+                        if (mixer.IsSparse() != sparse) {
+                            return detail::Fail(scenario, "The wrong kernel was selected for the matrix");
+                        }
+
+                        const auto mixed = Mix(mixer, std::vector<int>(outputs, -1));
+                        if (!Matches(mixed, expected, 1e-5f)) {
+                            return detail::Fail(scenario, "The mixed samples differ from the reference mix");
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::ChannelMatrixMixerMixesInPlace() noexcept {
+    return detail::Run("ChannelMatrixMixerMixesInPlace", [](const char *scenario) {
+        const struct {
+            UInt32 inputs_;
+            bool sourceInterleaved_;
+            UInt32 outputs_;
+            bool destinationInterleaved_;
+            std::vector<int> outputPlacement_;
+        } cases[] = {
+                // Output frames smaller than, equal to, and larger than input frames in one buffer
+                {6, true, 2, true, {0}},
+                {4, true, 4, true, {0}},
+                {2, true, 6, true, {0}},
+                // Channels mixed in place and into each other's buffers
+                {2, false, 2, false, {0, 1}},
+                {2, false, 2, false, {1, 0}},
+                {3, false, 2, false, {2, -1}},
+                // Interleaving changed in place
+                {2, true, 2, false, {0, -1}},
+                {2, false, 3, true, {1}},
+        };
+
+        for (const auto &testCase : cases) {
+            for (const auto sparse : {false, true}) {
+                ChannelMatrixMixer mixer;
+                const auto matrix = sparse ? MakeSparseMatrix(testCase.inputs_, testCase.outputs_)
+                                           : MakeDenseMatrix(testCase.inputs_, testCase.outputs_);
+                mixer.New(MakeFormat(testCase.inputs_, testCase.sourceInterleaved_),
+                          MakeFormat(testCase.outputs_, testCase.destinationInterleaved_), matrix);
+
+                const auto expected = Mix(mixer, std::vector<int>(testCase.outputPlacement_.size(), -1));
+                if (Mix(mixer, testCase.outputPlacement_) != expected) {
+                    return detail::Fail(scenario, "Mixing in place differs from mixing into separate buffers");
+                }
+            }
+        }
+
+        // Output beginning partway into input cannot be mixed
+        ChannelMatrixMixer mixer;
+        mixer.New(MakeFormat(2, true), MakeFormat(2, true), MakeDenseMatrix(2, 2));
+        std::vector<float> samples(2 * kFrameCount + 1);
+        detail::BufferList input{1};
+        input.Set(0, samples.data(), 2 * kFrameCount * sizeof(float), 2);
+        detail::BufferList output{1};
+        output.Set(0, samples.data() + 1, 2 * kFrameCount * sizeof(float), 2);
+        try {
+            mixer.Process(kFrameCount, input.get(), output.get());
+            return detail::Fail(scenario, "Partially overlapping buffers were accepted");
+        } catch (const std::system_error &) {
+        }
+
+        return true;
+    });
+}
+
+bool test_support::ChannelMatrixMixerRejectsInvalidArguments() noexcept {
+    return detail::Run("ChannelMatrixMixerRejectsInvalidArguments", [](const char *scenario) {
+        const auto stereo = MakeFormat(2, true);
+        auto resampled = stereo;
+        resampled.mSampleRate = 48'000;
+
+        const struct {
+            AudioStreamBasicDescription source_;
+            AudioStreamBasicDescription destination_;
+            std::vector<Float32> matrix_;
+        } invalidCases[] = {
+                {detail::MakeInt16Format(kSampleRate, 2, false), stereo, MakeDenseMatrix(2, 2)},
+                {stereo, detail::MakeInt16Format(kSampleRate, 2, false), MakeDenseMatrix(2, 2)},
+                {stereo, resampled, MakeDenseMatrix(2, 2)},
+                {stereo, stereo, MakeDenseMatrix(2, 3)},
+                {stereo, stereo, {}},
+        };
+
+        ChannelMatrixMixer mixer;
+        for (const auto &invalidCase : invalidCases) {
+            try {
+                mixer.New(invalidCase.source_, invalidCase.destination_, invalidCase.matrix_);
+                return detail::Fail(scenario, "An unsupported format or matrix was accepted");
+            } catch (const std::system_error &) {
+            }
+            if (mixer) {
+                return detail::Fail(scenario, "A failed creation created the mixer");
+            }
+        }
+
+        std::vector<float> samples(4 * kFrameCount);
+        detail::BufferList input{1};
+        input.Set(0, samples.data(), 2 * kFrameCount * sizeof(float), 2);
+        try {
+            detail::BufferList output{1};
+            output.Set(0, samples.data() + 2 * kFrameCount, 2 * kFrameCount * sizeof(float), 2);
+            mixer.Process(kFrameCount, input.get(), output.get());
+            return detail::Fail(scenario, "A mixer that was not created mixed frames");
+        } catch (const std::system_error &) {
+        }
+
+        mixer.New(stereo, MakeFormat(2, false), MakeDenseMatrix(2, 2));
+        const struct {
+            UInt32 bufferCount_;
+            UInt32 byteSize_;
+        } invalidBuffers[] = {{1, kFrameCount * sizeof(float)}, {2, kFrameCount * sizeof(float) - 1}};
+        for (const auto &invalidBuffer : invalidBuffers) {
+            detail::BufferList output{invalidBuffer.bufferCount_};
+            for (UInt32 i = 0; i < invalidBuffer.bufferCount_; ++i) {
+                output.Set(i, samples.data() + (2 + i) * kFrameCount, invalidBuffer.byteSize_);
+            }
+            try {
+                mixer.Process(kFrameCount, input.get(), output.get());
+                return detail::Fail(scenario, "An unsuitable buffer list was accepted");
+            } catch (const std::system_error &) {
+            }
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,150 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/ConverterPoolTests.hpp"
+
+#include "Expect.hpp"
+
+#include <audio_toolbox/ConverterPool.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Returns a native-endian interleaved stereo linear PCM format.
+AudioStreamBasicDescription MakeFormat(bool isFloat) {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = 44100;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = isFloat ? kAudioFormatFlagsNativeFloatPacked
+                                  : kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked;
+    format.mBitsPerChannel = isFloat ? 32 : 16;
+    format.mChannelsPerFrame = 2;
+    format.mBytesPerFrame = format.mBitsPerChannel / 8 * format.mChannelsPerFrame;
+    format.mFramesPerPacket = 1;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    return format;
+}
+
+/// Returns a property setting a UInt32 value.
+audio_toolbox::ConverterPool::Property MakeProperty(AudioConverterPropertyID propertyID, UInt32 value) {
+    audio_toolbox::ConverterPool::Property property;
+    property.propertyID_ = propertyID;
+    property.data_.resize(sizeof value);
+    std::memcpy(property.data_.data(), &value, sizeof value);
+    return property;
+}
+
+} /* namespace */
+
+bool test_support::ConverterPoolSupportsConcurrentCheckouts() noexcept {
+    return detail::Run("ConverterPoolSupportsConcurrentCheckouts", [](const char *scenario) {
+        constexpr unsigned threadCount = 8;
+        constexpr unsigned iterations = 200;
+        constexpr std::size_t capacity = 4;
+
+        audio_toolbox::ConverterPool pool{capacity};
+        const auto int16 = MakeFormat(false);
+        const auto float32 = MakeFormat(true);
+
+        std::atomic_bool failed{false};
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                try {
+                    for (unsigned i = 0; i < iterations && !failed; ++i) {
+                        // Alternate between configurations so converters are both reused and created
+                        const auto toFloat = (i + t) % 2 == 0;
+                        auto lease = pool.Checkout(toFloat ? int16 : float32, toFloat ? float32 : int16);
+
+                        const SInt16 samples[] = {0, 16384, -16384, -32768};
+                        const Float32 values[] = {0, 0.5f, -0.5f, -1};
+                        unsigned char output[sizeof values];
+                        UInt32 outputSize = toFloat ? sizeof values : sizeof samples;
+                        if (toFloat) {
+                            lease->ConvertBuffer(sizeof samples, samples, outputSize, output);
+                        } else {
+                            lease->ConvertBuffer(sizeof values, values, outputSize, output);
+                        }
+
+                        const auto *expected = toFloat ? static_cast<const void *>(values) : samples;
+                        if (outputSize != (toFloat ? sizeof values : sizeof samples) ||
+                            std::memcmp(output, expected, outputSize) != 0) {
+                            failed = true;
+                        }
+                    }
+                } catch (...) {
+                    failed = true;
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (failed) {
+            return detail::Fail(scenario, "A pooled converter failed or converted incorrectly");
+        }
+
+        const auto statistics = pool.GetStatistics();
+        if (statistics.checkedOutCount_ != 0) {
+            return detail::Fail(scenario, "Converters remain checked out");
+        }
+        if (statistics.hits_ + statistics.misses_ != threadCount * iterations) {
+            return detail::Fail(scenario, "The hit and miss counts do not account for every checkout");
+        }
+        if (statistics.hits_ == 0) {
+            return detail::Fail(scenario, "No checkout reused a pooled converter");
+        }
+        if (statistics.idleCount_ > capacity) {
+            return detail::Fail(scenario, "The pool holds more idle converters than its capacity");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::ConverterPoolDiscardsPartiallyConfiguredConverters() noexcept {
+    return detail::Run("ConverterPoolDiscardsPartiallyConfiguredConverters", [](const char *scenario) {
+        audio_toolbox::ConverterPool pool;
+        const auto int16 = MakeFormat(false);
+        const auto float32 = MakeFormat(true);
+
+        // The first property is valid and the second is not supported by any converter
+        const std::vector<audio_toolbox::ConverterPool::Property> properties = {
+                MakeProperty(kAudioConverterSampleRateConverterQuality, kAudioConverterQuality_Max),
+                MakeProperty('!prp', 0),
+        };
+
+        try {
+            auto lease = pool.Checkout(int16, float32, {}, properties);
+            return detail::Fail(scenario, "Setting an unsupported property succeeded");
+        } catch (const std::system_error &) {
+        }
+
+        const auto statistics = pool.GetStatistics();
+        if (statistics.checkedOutCount_ != 0) {
+            return detail::Fail(scenario, "The failed checkout remains checked out");
+        }
+        if (statistics.idleCount_ != 0) {
+            return detail::Fail(scenario, "The partially configured converter was pooled");
+        }
+
+        // A later checkout with the same configuration fails again instead of receiving the pooled converter
+        try {
+            auto lease = pool.Checkout(int16, float32, {}, properties);
+            return detail::Fail(scenario, "A partially configured converter was checked out");
+        } catch (const std::system_error &) {
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,262 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/DecodeAheadReaderTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/CAExtAudioFile.hpp>
+#include <audio_toolbox/DecodeAheadReader.hpp>
+
+#include <core_audio/BufferList.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::CAExtAudioFile;
+using audio_toolbox::DecodeAheadReader;
+
+/// The number of frames in each test file.
+constexpr UInt32 kFrameCount = 44'100;
+/// The number of channels in each test file.
+constexpr UInt32 kChannelCount = 2;
+
+/// Creates the test files, returning their paths.
+std::vector<std::string> CreateTestFiles(const test_support::detail::TemporaryDirectory &directory) {
+    const auto pcmPath = directory.Path("pcm.caf");
+    const auto aacPath = directory.Path("aac.m4a");
+    test_support::detail::WriteTestFile(pcmPath, kAudioFileCAFType,
+                                        test_support::detail::MakeInt16Format(44'100, kChannelCount, false),
+                                        kFrameCount);
+    test_support::detail::WriteTestFile(
+            aacPath, kAudioFileM4AType,
+            test_support::detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, kChannelCount), kFrameCount);
+    return {pcmPath, aacPath};
+}
+
+/// Returns a non-interleaved 32-bit float linear PCM format.
+AudioStreamBasicDescription MakeNonInterleavedFloatFormat(Float64 sampleRate, UInt32 channels) noexcept {
+    auto format = test_support::detail::MakeFloatFormat(sampleRate, channels);
+    format.mFormatFlags |= kAudioFormatFlagIsNonInterleaved;
+    format.mBytesPerFrame = sizeof(float);
+    format.mBytesPerPacket = sizeof(float);
+    return format;
+}
+
+/// Opens an extended audio file with a client data format.
+CAExtAudioFile OpenExtAudioFile(const std::string &path, const AudioStreamBasicDescription &clientFormat) {
+    const auto url = test_support::detail::CreateURL(path);
+    CAExtAudioFile file;
+    file.OpenURL(url.get());
+    file.SetClientDataFormat(clientFormat);
+    return file;
+}
+
+/// Appends frames from a buffer list to interleaved samples.
+void AppendFrames(std::vector<float> &samples, const AudioBufferList &bufferList, UInt32 frameCount) {
+    const auto offset = samples.size();
+    samples.resize(offset + static_cast<std::size_t>(frameCount) * kChannelCount);
+    if (bufferList.mNumberBuffers == 1) {
+        std::memcpy(samples.data() + offset, bufferList.mBuffers[0].mData, frameCount * kChannelCount * sizeof(float));
+        return;
+    }
+    for (UInt32 channel = 0; channel < bufferList.mNumberBuffers; ++channel) {
+        const auto *data = static_cast<const float *>(bufferList.mBuffers[channel].mData);
+        for (UInt32 frame = 0; frame < frameCount; ++frame) {
+            samples[offset + static_cast<std::size_t>(frame) * kChannelCount + channel] = data[frame];
+        }
+    }
+}
+
+/// Returns the samples of a decoded file.
+std::vector<float> DecodeReference(const std::string &path) {
+    const auto clientFormat = test_support::detail::MakeFloatFormat(44'100, kChannelCount);
+    const auto bytes = test_support::detail::DecodeFile(path, clientFormat);
+    std::vector<float> samples(bytes.size() / sizeof(float));
+    std::memcpy(samples.data(), bytes.data(), samples.size() * sizeof(float));
+    return samples;
+}
+
+} /* namespace */
+
+bool test_support::DecodeAheadReaderMatchesExtAudioFile() noexcept {
+    return detail::Run("DecodeAheadReaderMatchesExtAudioFile", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        for (const auto &path : CreateTestFiles(directory)) {
+            const auto expected = DecodeReference(path);
+
+            const AudioStreamBasicDescription clientFormats[] = {detail::MakeFloatFormat(44'100, kChannelCount),
+                                                                 MakeNonInterleavedFloatFormat(44'100, kChannelCount)};
+            for (const auto &clientFormat : clientFormats) {
+                const std::pair<UInt32, UInt32> configurations[] = {{1024, 1}, {333, 2}, {4096, 4}};
+                for (const auto &[framesPerBuffer, bufferCount] : configurations) {
+                    DecodeAheadReader reader{OpenExtAudioFile(path, clientFormat), framesPerBuffer, bufferCount};
+                    reader.Start();
+
+                    std::vector<float> actual;
+                    UInt32 frameCount;
+                    while (const auto *bufferList = reader.Read(frameCount)) {
+                        if (frameCount == 0 || frameCount > framesPerBuffer) {
+                            return detail::Fail(scenario, "A decoded buffer is empty or exceeds its capacity");
+                        }
+                        AppendFrames(actual, *bufferList, frameCount);
+                    }
+                    if (actual != expected) {
+                        return detail::Fail(scenario, "Pointer reads do not match ExtAudioFileRead");
+                    }
+
+                    // A capacity unrelated to the buffer size copies across decoded buffers
+                    reader.Seek(0);
+                    core_audio::BufferList buffer;
+                    if (!buffer.allocate(clientFormat, 1000)) {
+                        throw std::bad_alloc();
+                    }
+                    actual.clear();
+                    for (;;) {
+                        reader.Read(buffer);
+                        if (buffer.frameLength() == 0) {
+                            break;
+                        }
+                        AppendFrames(actual, *static_cast<AudioBufferList *>(buffer), buffer.frameLength());
+                    }
+                    if (actual != expected) {
+                        return detail::Fail(scenario, "Buffer list reads do not match ExtAudioFileRead");
+                    }
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::DecodeAheadReaderSeeks() noexcept {
+    return detail::Run("DecodeAheadReaderSeeks", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = CreateTestFiles(directory).front();
+        const auto expected = DecodeReference(path);
+        const auto clientFormat = detail::MakeFloatFormat(44'100, kChannelCount);
+
+        DecodeAheadReader reader{OpenExtAudioFile(path, clientFormat), 512, 3};
+        reader.Start();
+
+        for (const auto frame : {UInt32{12'345}, UInt32{7}, kFrameCount - 100, UInt32{0}}) {
+            reader.Seek(frame);
+            UInt32 frameCount;
+            const auto *bufferList = reader.Read(frameCount);
+            if (!bufferList || frameCount != std::min(512U, kFrameCount - frame)) {
+                return detail::Fail(scenario, "A seek did not restart decoding");
+            }
+            if (std::memcmp(bufferList->mBuffers[0].mData, expected.data() + frame * kChannelCount,
+                            frameCount * clientFormat.mBytesPerFrame) != 0) {
+                return detail::Fail(scenario, "Decoding did not restart at the requested frame");
+            }
+        }
+
+        reader.Seek(kFrameCount);
+        UInt32 frameCount;
+        if (reader.Read(frameCount) || frameCount != 0) {
+            return detail::Fail(scenario, "Audio was returned after seeking to the end of the file");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::DecodeAheadReaderBoundsDecodedBuffers() noexcept {
+    return detail::Run("DecodeAheadReaderBoundsDecodedBuffers", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = CreateTestFiles(directory).front();
+        const auto clientFormat = detail::MakeFloatFormat(44'100, kChannelCount);
+
+        constexpr UInt32 framesPerBuffer = 1000;
+        for (const auto bufferCount : {1U, 2U, 5U}) {
+            DecodeAheadReader reader{OpenExtAudioFile(path, clientFormat), framesPerBuffer, bufferCount};
+            reader.Start();
+
+            // Give the decoder ample time to fill every buffer, then stop it so the file position may be read
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            reader.Stop();
+            if (reader.ExtAudioFile().Tell() != static_cast<SInt64>(bufferCount * framesPerBuffer)) {
+                return detail::Fail(scenario, "The number of buffers decoded ahead is not the buffer count");
+            }
+
+            // The buffer held by the consumer is not available to the decoder
+            reader.ExtAudioFile().Seek(0);
+            reader.Start();
+            UInt32 frameCount;
+            if (!reader.Read(frameCount)) {
+                return detail::Fail(scenario, "No audio was decoded");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            reader.Stop();
+            if (reader.ExtAudioFile().Tell() != static_cast<SInt64>(bufferCount * framesPerBuffer)) {
+                return detail::Fail(scenario, "The buffer held by the consumer was not counted");
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::DecodeAheadReaderRejectsMismatchedBuffers() noexcept {
+    return detail::Run("DecodeAheadReaderRejectsMismatchedBuffers", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = CreateTestFiles(directory).front();
+        const auto clientFormat = detail::MakeFloatFormat(44'100, kChannelCount);
+
+        DecodeAheadReader reader{OpenExtAudioFile(path, clientFormat)};
+
+        core_audio::BufferList buffer;
+        if (!buffer.allocate(clientFormat, 1024)) {
+            throw std::bad_alloc();
+        }
+        try {
+            reader.Read(buffer);
+            return detail::Fail(scenario, "A read before starting did not throw");
+        } catch (const std::logic_error &e) {
+            if (dynamic_cast<const std::invalid_argument *>(&e)) {
+                return detail::Fail(scenario, "A matching buffer was rejected");
+            }
+        }
+
+        reader.Start();
+        const AudioStreamBasicDescription mismatchedFormats[] = {
+                detail::MakeFloatFormat(44'100, 1), detail::MakeFloatFormat(44'100, kChannelCount + 1),
+                MakeNonInterleavedFloatFormat(44'100, kChannelCount),
+                detail::MakeInt16Format(44'100, kChannelCount, false)};
+        for (const auto &format : mismatchedFormats) {
+            core_audio::BufferList mismatched;
+            if (!mismatched.allocate(format, 1024)) {
+                throw std::bad_alloc();
+            }
+            try {
+                reader.Read(mismatched);
+                return detail::Fail(scenario, "A buffer in a different format was accepted");
+            } catch (const std::invalid_argument &) {
+            }
+        }
+
+        reader.Read(buffer);
+        if (buffer.frameLength() != 1024) {
+            return detail::Fail(scenario, "A matching buffer was not filled after rejecting mismatched buffers");
+        }
+
+        return true;
+    });
+}
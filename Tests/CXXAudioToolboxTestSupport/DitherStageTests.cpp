@@ -0,0 +1,298 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/DitherStageTests.hpp"
+
+#include "DitherKernels.hpp"
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/CAExtAudioFile.hpp>
+#include <audio_toolbox/DitherStage.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::DitherStage;
+using Dither = DitherStage::Dither;
+using NoiseShaping = DitherStage::NoiseShaping;
+
+/// The sample rate of the quantized signals.
+constexpr Float64 kSampleRate = 44'100;
+
+/// Returns a native-endian packed signed integer linear PCM format of bits bits, optionally non-interleaved.
+AudioStreamBasicDescription MakeIntFormat(UInt32 bits, UInt32 channels, bool nonInterleaved) noexcept {
+    auto format = test_support::detail::MakeInt16Format(kSampleRate, channels, kAudioFormatFlagsNativeEndian != 0);
+    format.mBitsPerChannel = bits;
+    format.mBytesPerFrame = bits / 8 * channels;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    return nonInterleaved ? test_support::detail::MakeNonInterleaved(format) : format;
+}
+
+/// Quantized samples in separate buffers for each buffer of a format.
+struct Output {
+    /// The samples of each buffer.
+    std::vector<std::vector<unsigned char>> buffers_;
+    /// The buffer list describing the samples from the current frame onward.
+    test_support::detail::BufferList bufferList_;
+
+    /// Creates storage for frameCount frames of a format.
+    Output(const AudioStreamBasicDescription &format, UInt32 frameCount)
+        : buffers_((format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0 ? format.mChannelsPerFrame : 1,
+                   std::vector<unsigned char>(static_cast<std::size_t>(frameCount) * format.mBytesPerFrame)),
+          bufferList_{static_cast<UInt32>(buffers_.size())} {}
+
+    /// Points the buffer list at the samples from frame onward.
+    AudioBufferList *At(UInt32 frame, UInt32 bytesPerFrame) noexcept {
+        for (UInt32 i = 0; i < buffers_.size(); ++i) {
+            const auto offset = static_cast<std::size_t>(frame) * bytesPerFrame;
+            bufferList_.Set(i, buffers_[i].data() + offset, static_cast<UInt32>(buffers_[i].size() - offset));
+        }
+        return bufferList_.get();
+    }
+};
+
+/// Input samples in separate buffers for each buffer of a float format.
+struct Input {
+    /// The samples of each buffer.
+    std::vector<std::vector<float>> buffers_;
+    /// The buffer list describing the samples from the current frame onward.
+    test_support::detail::BufferList bufferList_;
+
+    /// Creates frameCount frames of the test signal at gain in a float format.
+    Input(const AudioStreamBasicDescription &format, UInt32 frameCount, float gain)
+        : buffers_((format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0 ? format.mChannelsPerFrame : 1),
+          bufferList_{static_cast<UInt32>(buffers_.size())} {
+        const auto channelsPerBuffer = format.mChannelsPerFrame / static_cast<UInt32>(buffers_.size());
+        for (UInt32 i = 0; i < buffers_.size(); ++i) {
+            auto &buffer = buffers_[i];
+            buffer.resize(static_cast<std::size_t>(frameCount) * channelsPerBuffer);
+            for (std::size_t j = 0; j < buffer.size(); ++j) {
+                const auto channel = i * channelsPerBuffer + static_cast<UInt32>(j % channelsPerBuffer);
+                buffer[j] = gain * test_support::detail::TestSignal(j / channelsPerBuffer, channel, kSampleRate);
+            }
+        }
+    }
+
+    /// Points the buffer list at the samples from frame onward.
+    AudioBufferList *At(UInt32 frame, UInt32 channelsPerBuffer) noexcept {
+        for (UInt32 i = 0; i < buffers_.size(); ++i) {
+            const auto offset = static_cast<std::size_t>(frame) * channelsPerBuffer;
+            bufferList_.Set(i, buffers_[i].data() + offset,
+                            static_cast<UInt32>((buffers_[i].size() - offset) * sizeof(float)));
+        }
+        return bufferList_.get();
+    }
+};
+
+/// Returns the integer sample of a width at index i of a buffer.
+std::int64_t LoadSample(const unsigned char *buffer, UInt32 width, std::size_t i) noexcept {
+    // The sample is copied to the most significant bytes and sign-extended by an arithmetic shift
+    std::int32_t value = 0;
+    const auto offset = kAudioFormatFlagsNativeEndian != 0 ? 0 : 4 - width;
+    std::memcpy(reinterpret_cast<unsigned char *>(&value) + offset, buffer + i * width, width);
+    return value >> (32 - 8 * width);
+}
+
+} /* namespace */
+
+bool test_support::DitherStageNoiseMatchesScalar() noexcept {
+    return detail::Run("DitherStageNoiseMatchesScalar", [](const char *scenario) {
+        using audio_toolbox::detail::kDitherGeneratorLanes;
+
+        for (const auto triangular : {false, true}) {
+            for (const std::size_t stride : {1, 2, 6}) {
+                for (const std::size_t count : {0, 4, 8, 12, 64, 516}) {
+                    UInt32 vectorState[kDitherGeneratorLanes] = {1, 0x9e3779b9, 0x85ebca6b, 0xffffffff};
+                    UInt32 scalarState[kDitherGeneratorLanes];
+                    std::copy(std::begin(vectorState), std::end(vectorState), std::begin(scalarState));
+
+                    // Values between those stored are left untouched
+                    std::vector<float> vectorNoise(count * stride + 1, 7.f);
+                    std::vector<float> scalarNoise(vectorNoise);
+                    audio_toolbox::detail::GenerateDitherNoise(vectorState, triangular, vectorNoise.data(), count,
+                                                               stride);
+                    audio_toolbox::detail::GenerateDitherNoiseScalar(scalarState, triangular, scalarNoise.data(), count,
+                                                                     stride);
+
+                    if (std::memcmp(vectorNoise.data(), scalarNoise.data(), vectorNoise.size() * sizeof(float)) != 0 ||
+                        !std::equal(std::begin(vectorState), std::end(vectorState), std::begin(scalarState))) {
+                        return detail::Fail(scenario, "The vector generator differs from the portable generator");
+                    }
+
+                    const auto limit = triangular ? 1.f : .5f;
+                    for (std::size_t i = 0; i < vectorNoise.size(); ++i) {
+                        const auto value = vectorNoise[i];
+                        const auto stored = i % stride == 0 && i < count * stride;
+                        if (stored ? value < -limit || value >= limit : value != 7.f) {
+                            return detail::Fail(scenario, "A dither value is out of range or misplaced");
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::DitherStageIsIndependentOfCallSize() noexcept {
+    return detail::Run("DitherStageIsIndependentOfCallSize", [](const char *scenario) {
+        constexpr UInt32 frameCount = 3'000;
+        // Call sizes that are not multiples of the generator lanes, and larger than the internal block
+        constexpr UInt32 callSizes[] = {1, 3, 2, 5, 7, 513, 1'030, 6};
+
+        const AudioStreamBasicDescription destinationFormats[] = {
+                MakeIntFormat(16, 2, false),
+                MakeIntFormat(24, 3, true),
+                MakeIntFormat(32, 1, false),
+                MakeIntFormat(8, 6, false),
+        };
+
+        for (const auto &destinationFormat : destinationFormats) {
+            auto sourceFormat = detail::MakeFloatFormat(kSampleRate, destinationFormat.mChannelsPerFrame);
+            const auto nonInterleaved = (destinationFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+            if (nonInterleaved) {
+                sourceFormat = detail::MakeNonInterleaved(sourceFormat);
+            }
+            const auto channelsPerBuffer = nonInterleaved ? 1 : sourceFormat.mChannelsPerFrame;
+
+            for (const auto dither : {Dither::none, Dither::rectangular, Dither::triangular}) {
+                for (const auto noiseShaping : {NoiseShaping::none, NoiseShaping::wannamaker}) {
+                    Input input{sourceFormat, frameCount, .5f};
+
+                    DitherStage whole;
+                    whole.New(sourceFormat, destinationFormat, dither, noiseShaping, 42);
+                    Output expected{destinationFormat, frameCount};
+                    whole.Process(frameCount, input.At(0, channelsPerBuffer),
+                                  expected.At(0, destinationFormat.mBytesPerFrame));
+
+                    DitherStage split;
+                    split.New(sourceFormat, destinationFormat, dither, noiseShaping, 42);
+                    Output actual{destinationFormat, frameCount};
+                    for (UInt32 frame = 0, call = 0; frame < frameCount; ++call) {
+                        const auto count = std::min(callSizes[call % std::size(callSizes)], frameCount - frame);
+                        split.Process(count, input.At(frame, channelsPerBuffer),
+                                      actual.At(frame, destinationFormat.mBytesPerFrame));
+                        frame += count;
+                    }
+
+                    if (actual.buffers_ != expected.buffers_) {
+                        return detail::Fail(scenario, "The samples depend on how frames are divided between calls");
+                    }
+
+                    // Resetting restarts the sequence
+                    split.Reset();
+                    Output repeated{destinationFormat, frameCount};
+                    split.Process(frameCount, input.At(0, channelsPerBuffer),
+                                  repeated.At(0, destinationFormat.mBytesPerFrame));
+                    if (repeated.buffers_ != expected.buffers_) {
+                        return detail::Fail(scenario, "Resetting did not restart the dither sequence");
+                    }
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::DitherStageClipsToFullScale() noexcept {
+    return detail::Run("DitherStageClipsToFullScale", [](const char *scenario) {
+        const auto nan = std::numeric_limits<float>::quiet_NaN();
+        constexpr auto frameCount = 20;
+
+        for (const auto bits : {8U, 16U, 24U, 32U}) {
+            const auto width = bits / 8;
+            const auto maximum = (std::int64_t{1} << (bits - 1)) - 1;
+            const auto minimum = -(std::int64_t{1} << (bits - 1));
+            // NaN would drive the noise-shaping filter, so it is only quantized without noise shaping
+            const struct {
+                float input_;
+                std::int64_t expected_;
+                bool shaped_;
+            } cases[] = {
+                    {1.f, maximum, true},  {-1.f, minimum, true}, {2.f, maximum, true},
+                    {-2.f, minimum, true}, {.5f, (maximum + 1) / 2, true}, {nan, minimum, false},
+            };
+
+            for (const auto noiseShaping : {NoiseShaping::none, NoiseShaping::firstOrder}) {
+                const auto sourceFormat = detail::MakeFloatFormat(kSampleRate, 1);
+                const auto destinationFormat = MakeIntFormat(bits, 1, false);
+                DitherStage stage;
+                stage.New(sourceFormat, destinationFormat, Dither::none, noiseShaping);
+
+                for (const auto &testCase : cases) {
+                    if (noiseShaping != NoiseShaping::none && !testCase.shaped_) {
+                        continue;
+                    }
+
+                    // Enough samples for the vector kernels and their scalar tails
+                    std::vector<float> input(frameCount, testCase.input_);
+                    std::vector<unsigned char> output(frameCount * width);
+                    detail::BufferList inputList{1};
+                    inputList.Set(0, input.data(), static_cast<UInt32>(input.size() * sizeof(float)));
+                    detail::BufferList outputList{1};
+                    outputList.Set(0, output.data(), static_cast<UInt32>(output.size()));
+                    stage.Process(frameCount, inputList.get(), outputList.get());
+
+                    for (std::size_t i = 0; i < frameCount; ++i) {
+                        if (LoadSample(output.data(), width, i) != testCase.expected_) {
+                            return detail::Fail(scenario, "A sample was not clipped to the integer range");
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::DitherStageWritesFiles() noexcept {
+    return detail::Run("DitherStageWritesFiles", [](const char *scenario) {
+        // More frames than the internal block, ending with a partial block
+        constexpr UInt32 frameCount = 2'000;
+        const auto sourceFormat = detail::MakeFloatFormat(kSampleRate, 2);
+        const auto destinationFormat = MakeIntFormat(16, 2, false);
+        Input input{sourceFormat, frameCount, .5f};
+
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("dithered.caf");
+        {
+            const auto url = detail::CreateURL(path);
+            audio_toolbox::CAExtAudioFile file;
+            file.CreateWithURL(url.get(), kAudioFileCAFType, destinationFormat, nullptr, kAudioFileFlags_EraseFile);
+            file.SetClientDataFormat(destinationFormat);
+
+            DitherStage stage;
+            stage.New(sourceFormat, destinationFormat, Dither::triangular, NoiseShaping::lipshitz, 7);
+            stage.Write(file, 999, input.At(0, 2));
+            stage.Write(file, frameCount - 999, input.At(999, 2));
+            file.Dispose();
+        }
+
+        DitherStage stage;
+        stage.New(sourceFormat, destinationFormat, Dither::triangular, NoiseShaping::lipshitz, 7);
+        Output expected{destinationFormat, frameCount};
+        stage.Process(frameCount, input.At(0, 2), expected.At(0, destinationFormat.mBytesPerFrame));
+
+        if (detail::DecodeFile(path, destinationFormat) != expected.buffers_[0]) {
+            return detail::Fail(scenario, "The written samples differ from the quantized samples");
+        }
+
+        return true;
+    });
+}
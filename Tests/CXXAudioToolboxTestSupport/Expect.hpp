@@ -0,0 +1,37 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <cstdio>
+#include <exception>
+
+namespace test_support {
+namespace detail {
+
+/// Reports a failed expectation and returns false.
+inline bool Fail(const char *scenario, const char *description) noexcept {
+    std::fprintf(stderr, "%s: %s\n", scenario, description);
+    return false;
+}
+
+/// Runs a scenario, reporting an escaping exception as a failure.
+/// @param scenario The name of the scenario.
+/// @param body A callable receiving the name of the scenario and returning true if the scenario passed.
+/// @return true if the scenario passed.
+template <typename Body> bool Run(const char *scenario, Body &&body) noexcept {
+    try {
+        return body(scenario);
+    } catch (const std::exception &e) {
+        return Fail(scenario, e.what());
+    } catch (...) {
+        return Fail(scenario, "Unknown exception");
+    }
+}
+
+} /* namespace detail */
+} /* namespace test_support */
@@ -0,0 +1,216 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/GraphLatencyAnalysisTests.hpp"
+
+#include "Expect.hpp"
+
+#include <audio_toolbox/GraphLatencyAnalysis.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::GraphLatencyAnalysis;
+using Topology = GraphLatencyAnalysis::Topology;
+
+/// Returns a connection between the first output and input of two nodes.
+AUNodeConnection Connect(AUNode source, AUNode destination, UInt32 destinationInput = 0) noexcept {
+    return {source, 0, destination, destinationInput};
+}
+
+/// Returns true if two connections join the same output and input.
+bool IsSameConnection(const AUNodeConnection &a, const AUNodeConnection &b) noexcept {
+    return a.sourceNode == b.sourceNode && a.sourceOutputNumber == b.sourceOutputNumber && a.destNode == b.destNode &&
+           a.destInputNumber == b.destInputNumber;
+}
+
+/// Returns true if analyzing topology throws std::invalid_argument.
+bool IsRejected(const Topology &topology) {
+    try {
+        [[maybe_unused]] const auto analysis = GraphLatencyAnalysis::Analyze(topology);
+    } catch (const std::invalid_argument &) {
+        return true;
+    }
+    return false;
+}
+
+} /* namespace */
+
+bool test_support::GraphLatencyAnalysisFindsCriticalPath() noexcept {
+    return detail::Run("GraphLatencyAnalysisFindsCriticalPath", [](const char *scenario) {
+        // The source 9 splits into branches 7 and 5 that merge at 3 before the output 1; 8 feeds a shorter chain to 2.
+        // Node keys decrease along each path so key order is not a topological order.
+        Topology topology;
+        topology.nodes_ = {{9, {1, .5}}, {7, {10, 0}}, {5, {2, 2}}, {3, {1, 0}},
+                           {1, {0, .25}}, {8, {4, 0}}, {2, {1, 0}}};
+        topology.connections_ = {Connect(3, 1), Connect(7, 3), Connect(5, 3, 1),
+                                 Connect(8, 2), {9, 1, 5, 0}, Connect(9, 7)};
+
+        const auto analysis = GraphLatencyAnalysis::Analyze(topology);
+
+        const std::map<AUNode, Float64> pathLatency{{1, 12}, {2, 5}, {3, 12}, {5, 3}, {7, 11}, {8, 4}, {9, 1}};
+        const std::map<AUNode, Float64> pathTailTime{{1, 2.75}, {2, 0}, {3, 2.5}, {5, 2.5}, {7, .5}, {8, 0}, {9, .5}};
+        if (analysis.pathLatency_ != pathLatency || analysis.pathTailTime_ != pathTailTime) {
+            return detail::Fail(scenario, "The path latencies or tail times are incorrect");
+        }
+        if (analysis.latency_ != 12 || analysis.tailTime_ != 2.75) {
+            return detail::Fail(scenario, "The graph latency or tail time is incorrect");
+        }
+        if (analysis.criticalPath_ != std::vector<AUNode>{9, 7, 3, 1}) {
+            return detail::Fail(scenario, "The critical path is incorrect");
+        }
+        const auto &compensation = analysis.compensation_;
+        if (compensation.size() != 1 || !IsSameConnection(compensation[0].connection_, Connect(5, 3, 1)) ||
+            compensation[0].delay_ != 8) {
+            return detail::Fail(scenario, "The compensation is incorrect");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::GraphLatencyAnalysisMatchesLongestPaths() noexcept {
+    return detail::Run("GraphLatencyAnalysisMatchesLongestPaths", [](const char *scenario) {
+        constexpr std::size_t nodeCount = 40;
+        std::mt19937 generator{21};
+
+        for (auto trial = 0; trial < 50; ++trial) {
+            // Nodes are created in topological order with shuffled keys
+            std::vector<AUNode> keys(nodeCount);
+            std::iota(keys.begin(), keys.end(), 100);
+            std::shuffle(keys.begin(), keys.end(), generator);
+
+            // Multiples of 1/64 sum exactly
+            std::uniform_int_distribution<int> sixtyFourths{0, 64};
+            std::bernoulli_distribution isConnected{.1};
+            Topology topology;
+            std::vector<GraphLatencyAnalysis::NodeTiming> timing(nodeCount);
+            std::vector<std::vector<std::size_t>> predecessors(nodeCount);
+            std::vector<bool> hasSuccessor(nodeCount, false);
+            for (std::size_t i = 0; i < nodeCount; ++i) {
+                timing[i] = {sixtyFourths(generator) / 64., sixtyFourths(generator) / 64.};
+                topology.nodes_[keys[i]] = timing[i];
+                for (std::size_t j = 0; j < i; ++j) {
+                    if (isConnected(generator)) {
+                        topology.connections_.push_back(
+                                Connect(keys[j], keys[i], static_cast<UInt32>(predecessors[i].size())));
+                        predecessors[i].push_back(j);
+                        hasSuccessor[j] = true;
+                    }
+                }
+            }
+            std::shuffle(topology.connections_.begin(), topology.connections_.end(), generator);
+
+            std::vector<Float64> inputLatency(nodeCount, 0);
+            std::vector<Float64> latency(nodeCount);
+            std::vector<Float64> tailTime(nodeCount);
+            for (std::size_t i = 0; i < nodeCount; ++i) {
+                auto inputTailTime = 0.;
+                for (const auto j : predecessors[i]) {
+                    inputLatency[i] = std::max(inputLatency[i], latency[j]);
+                    inputTailTime = std::max(inputTailTime, tailTime[j]);
+                }
+                latency[i] = inputLatency[i] + timing[i].latency_;
+                tailTime[i] = inputTailTime + timing[i].tailTime_;
+            }
+
+            const auto analysis = GraphLatencyAnalysis::Analyze(topology);
+
+            for (std::size_t i = 0; i < nodeCount; ++i) {
+                if (analysis.pathLatency_.at(keys[i]) != latency[i] ||
+                    analysis.pathTailTime_.at(keys[i]) != tailTime[i]) {
+                    return detail::Fail(scenario, "A path latency or tail time differs from the longest path");
+                }
+            }
+            if (analysis.latency_ != *std::max_element(latency.begin(), latency.end()) ||
+                analysis.tailTime_ != *std::max_element(tailTime.begin(), tailTime.end())) {
+                return detail::Fail(scenario, "The graph latency or tail time differs from the longest path");
+            }
+
+            // The critical path runs from a node without inputs to a node without outputs along connections, and its
+            // latencies sum to the graph latency
+            const auto &path = analysis.criticalPath_;
+            std::map<AUNode, std::size_t> indexOf;
+            for (std::size_t i = 0; i < nodeCount; ++i) {
+                indexOf[keys[i]] = i;
+            }
+            auto pathLatency = 0.;
+            for (std::size_t k = 0; k < path.size(); ++k) {
+                const auto i = indexOf.at(path[k]);
+                const auto &inputs = predecessors[i];
+                if ((k == 0 && !inputs.empty()) ||
+                    (k > 0 && std::find(inputs.begin(), inputs.end(), indexOf.at(path[k - 1])) == inputs.end())) {
+                    return detail::Fail(scenario, "The critical path does not follow the connections");
+                }
+                pathLatency += timing[i].latency_;
+            }
+            if (path.empty() || hasSuccessor[indexOf.at(path.back())] || pathLatency != analysis.latency_) {
+                return detail::Fail(scenario, "The critical path does not span the graph latency");
+            }
+
+            // Each delayed connection delivers its input at the same time as the latest input of its destination
+            std::vector<GraphLatencyAnalysis::Compensation> compensation;
+            for (const auto &connection : topology.connections_) {
+                const auto delay =
+                        inputLatency[indexOf.at(connection.destNode)] - latency[indexOf.at(connection.sourceNode)];
+                if (delay > 0) {
+                    compensation.push_back({connection, delay});
+                }
+            }
+            if (!std::equal(compensation.begin(), compensation.end(), analysis.compensation_.begin(),
+                            analysis.compensation_.end(), [](const auto &a, const auto &b) {
+                                return IsSameConnection(a.connection_, b.connection_) && a.delay_ == b.delay_;
+                            })) {
+                return detail::Fail(scenario, "The compensation differs from the longest path");
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::GraphLatencyAnalysisRejectsInvalidTopologies() noexcept {
+    return detail::Run("GraphLatencyAnalysisRejectsInvalidTopologies", [](const char *scenario) {
+        Topology cycle;
+        cycle.nodes_ = {{1, {}}, {2, {}}, {3, {}}, {4, {}}};
+        cycle.connections_ = {Connect(1, 2), Connect(2, 3), Connect(3, 4), Connect(3, 2, 1)};
+        if (!IsRejected(cycle)) {
+            return detail::Fail(scenario, "A cycle reachable from a source was accepted");
+        }
+
+        Topology selfConnection;
+        selfConnection.nodes_ = {{1, {}}, {2, {}}};
+        selfConnection.connections_ = {Connect(1, 2), Connect(2, 2, 1)};
+        if (!IsRejected(selfConnection)) {
+            return detail::Fail(scenario, "A self-connection was accepted");
+        }
+
+        Topology unknownNodes;
+        unknownNodes.nodes_ = {{1, {}}, {2, {}}};
+        for (const auto &connection : {Connect(1, 3), Connect(0, 2)}) {
+            unknownNodes.connections_ = {connection};
+            if (!IsRejected(unknownNodes)) {
+                return detail::Fail(scenario, "A connection to an unknown node was accepted");
+            }
+        }
+
+        const auto empty = GraphLatencyAnalysis::Analyze({});
+        if (empty.latency_ != 0 || empty.tailTime_ != 0 || !empty.criticalPath_.empty() ||
+            !empty.pathLatency_.empty() || !empty.compensation_.empty()) {
+            return detail::Fail(scenario, "An empty topology has latency");
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,222 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/GraphSnapshotTests.hpp"
+
+#include "Expect.hpp"
+
+#include <audio_toolbox/CAAUGraph.hpp>
+#include <audio_toolbox/GraphSnapshot.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::GraphSnapshot;
+
+/// Returns a connection interaction.
+AUNodeInteraction MakeConnection(AUNode source, UInt32 output, AUNode destination, UInt32 input) noexcept {
+    AUNodeInteraction interaction{};
+    interaction.nodeInteractionType = kAUNodeInteraction_Connection;
+    interaction.nodeInteraction.connection = {source, output, destination, input};
+    return interaction;
+}
+
+/// Returns an input callback interaction.
+AUNodeInteraction MakeInputCallback(AUNode destination, UInt32 input) noexcept {
+    AUNodeInteraction interaction{};
+    interaction.nodeInteractionType = kAUNodeInteraction_InputCallback;
+    interaction.nodeInteraction.inputCallback.destNode = destination;
+    interaction.nodeInteraction.inputCallback.destInputNumber = input;
+    return interaction;
+}
+
+/// Returns true if two interactions are of the same type between the same nodes, outputs, and inputs.
+bool IsSameInteraction(const AUNodeInteraction &a, const AUNodeInteraction &b) noexcept {
+    if (a.nodeInteractionType != b.nodeInteractionType) {
+        return false;
+    }
+    if (a.nodeInteractionType == kAUNodeInteraction_Connection) {
+        const auto &x = a.nodeInteraction.connection;
+        const auto &y = b.nodeInteraction.connection;
+        return x.sourceNode == y.sourceNode && x.sourceOutputNumber == y.sourceOutputNumber &&
+               x.destNode == y.destNode && x.destInputNumber == y.destInputNumber;
+    }
+    const auto &x = a.nodeInteraction.inputCallback;
+    const auto &y = b.nodeInteraction.inputCallback;
+    return x.destNode == y.destNode && x.destInputNumber == y.destInputNumber &&
+           x.cback.inputProc == y.cback.inputProc && x.cback.inputProcRefCon == y.cback.inputProcRefCon;
+}
+
+/// Returns true if a range holds the expected interactions in order.
+bool Equals(GraphSnapshot::Range<AUNodeInteraction> range, const std::vector<AUNodeInteraction> &expected) noexcept {
+    return std::equal(range.begin(), range.end(), expected.begin(), expected.end(), IsSameInteraction);
+}
+
+/// Returns true if a range holds the expected node indexes in order.
+bool Equals(GraphSnapshot::Range<std::size_t> range, const std::vector<std::size_t> &expected) noexcept {
+    return std::equal(range.begin(), range.end(), expected.begin(), expected.end());
+}
+
+/// Returns true if creating a snapshot throws std::invalid_argument.
+bool IsRejected(std::vector<AUNode> nodes, std::vector<AUNodeInteraction> interactions) {
+    try {
+        GraphSnapshot snapshot{std::move(nodes), std::move(interactions), 1};
+    } catch (const std::invalid_argument &) {
+        return true;
+    }
+    return false;
+}
+
+/// Adds an Apple Audio Unit node to a graph.
+AUNode AddNode(audio_toolbox::CAAUGraph &graph, OSType type, OSType subType) {
+    AudioComponentDescription description{};
+    description.componentType = type;
+    description.componentSubType = subType;
+    description.componentManufacturer = kAudioUnitManufacturer_Apple;
+    return graph.AddNode(&description);
+}
+
+/// An input callback rendering nothing.
+OSStatus RenderNothing(void *inRefCon, AudioUnitRenderActionFlags *ioActionFlags, const AudioTimeStamp *inTimeStamp,
+                       UInt32 inBusNumber, UInt32 inNumberFrames, AudioBufferList *ioData) {
+    return noErr;
+}
+
+} /* namespace */
+
+bool test_support::GraphSnapshotGroupsInteractionsByNode() noexcept {
+    return detail::Run("GraphSnapshotGroupsInteractionsByNode", [](const char *scenario) {
+        const std::vector<AUNodeInteraction> interactions{
+                MakeConnection(10, 0, 20, 0), MakeInputCallback(10, 0),     MakeConnection(20, 0, 30, 0),
+                MakeConnection(10, 1, 30, 1), MakeConnection(30, 0, 30, 2), MakeInputCallback(30, 3),
+        };
+        const GraphSnapshot snapshot{{30, 10, 20, 10, 40}, interactions, 7};
+
+        if (snapshot.Version() != 7 || snapshot.Nodes() != std::vector<AUNode>{10, 20, 30, 40}) {
+            return detail::Fail(scenario, "The nodes were not sorted and deduplicated");
+        }
+        if (snapshot.IndexOf(30) != 2 || snapshot.IndexOf(25) || snapshot.IndexOf(50)) {
+            return detail::Fail(scenario, "IndexOf did not locate the nodes");
+        }
+        if (!std::equal(snapshot.Interactions().begin(), snapshot.Interactions().end(), interactions.begin(),
+                        interactions.end(), IsSameInteraction)) {
+            return detail::Fail(scenario, "The interactions were not kept in the order reported");
+        }
+
+        // A self-connection is listed once for its node but is both a successor and a predecessor
+        const std::vector<std::vector<AUNodeInteraction>> nodeInteractions{
+                {interactions[0], interactions[1], interactions[3]},
+                {interactions[0], interactions[2]},
+                {interactions[2], interactions[3], interactions[4], interactions[5]},
+                {},
+        };
+        const std::vector<std::vector<std::size_t>> successors{{1, 2}, {2}, {2}, {}};
+        const std::vector<std::vector<std::size_t>> predecessors{{}, {0}, {1, 0, 2}, {}};
+        for (std::size_t i = 0; i < snapshot.NodeCount(); ++i) {
+            if (!Equals(snapshot.NodeInteractions(i), nodeInteractions[i])) {
+                return detail::Fail(scenario, "A node's interactions are incorrect");
+            }
+            if (!Equals(snapshot.Successors(i), successors[i]) || !Equals(snapshot.Predecessors(i), predecessors[i])) {
+                return detail::Fail(scenario, "A node's successors or predecessors are incorrect");
+            }
+        }
+
+        const GraphSnapshot empty{{}, {}, 0};
+        if (empty.NodeCount() != 0 || !empty.Interactions().empty()) {
+            return detail::Fail(scenario, "An empty snapshot has nodes or interactions");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::GraphSnapshotRejectsUnknownNodes() noexcept {
+    return detail::Run("GraphSnapshotRejectsUnknownNodes", [](const char *scenario) {
+        for (const auto &interaction :
+             {MakeConnection(3, 0, 1, 0), MakeConnection(1, 0, 3, 0), MakeInputCallback(3, 0)}) {
+            if (!IsRejected({1, 2}, {MakeConnection(1, 0, 2, 0), interaction})) {
+                return detail::Fail(scenario, "An interaction with an unknown node was accepted");
+            }
+        }
+        return true;
+    });
+}
+
+bool test_support::GraphSnapshotIsCachedByVersion() noexcept {
+    return detail::Run("GraphSnapshotIsCachedByVersion", [](const char *scenario) {
+        audio_toolbox::CAAUGraph graph;
+        graph.New();
+        const auto mixer = AddNode(graph, kAudioUnitType_Mixer, kAudioUnitSubType_MultiChannelMixer);
+        const auto output = AddNode(graph, kAudioUnitType_Output, kAudioUnitSubType_GenericOutput);
+        graph.Open();
+
+        const auto unconnected = graph.Snapshot();
+        if (graph.Snapshot() != unconnected || unconnected->Version() != graph.TopologyVersion()) {
+            return detail::Fail(scenario, "An unchanged graph was queried again");
+        }
+        if (unconnected->NodeCount() != 2 || !unconnected->Interactions().empty()) {
+            return detail::Fail(scenario, "The snapshot does not describe the graph");
+        }
+
+        graph.ConnectNodeInput(mixer, 0, output, 0);
+        const auto connected = graph.Snapshot();
+        if (connected == unconnected || connected->Version() == unconnected->Version()) {
+            return detail::Fail(scenario, "A connection did not change the topology version");
+        }
+        const auto mixerIndex = *connected->IndexOf(mixer);
+        const auto outputIndex = *connected->IndexOf(output);
+        if (!Equals(connected->Successors(mixerIndex), {outputIndex}) || !unconnected->Interactions().empty()) {
+            return detail::Fail(scenario, "The connection was not captured in a new snapshot");
+        }
+
+        AURenderCallbackStruct callback{&RenderNothing, nullptr};
+        graph.SetNodeInputCallback(mixer, 1, &callback);
+        const auto snapshot = graph.Snapshot();
+        if (snapshot == connected || snapshot->NodeInteractions(mixerIndex).size() != 2) {
+            return detail::Fail(scenario, "The input callback was not captured in a new snapshot");
+        }
+
+        const auto nodesAndInteractions = graph.NodesAndInteractions();
+        if (nodesAndInteractions.size() != snapshot->NodeCount()) {
+            return detail::Fail(scenario, "NodesAndInteractions does not list every node");
+        }
+        for (std::size_t i = 0; i < snapshot->NodeCount(); ++i) {
+            const auto it = nodesAndInteractions.find(snapshot->Nodes()[i]);
+            if (it == nodesAndInteractions.end() || !Equals(snapshot->NodeInteractions(i), it->second)) {
+                return detail::Fail(scenario, "NodesAndInteractions differs from the snapshot");
+            }
+        }
+
+        // Concurrent readers of an unchanged graph share the cached snapshot
+        std::atomic_bool shared{true};
+        std::vector<std::thread> threads;
+        for (auto t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (auto i = 0; i < 100; ++i) {
+                    if (graph.Snapshot() != snapshot) {
+                        shared = false;
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        if (!shared) {
+            return detail::Fail(scenario, "A concurrent reader did not receive the cached snapshot");
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,263 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/InputProviderTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/CAAudioConverter.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::CAAudioConverter;
+using InputResult = CAAudioConverter::InputResult;
+
+/// The number of channels converted.
+constexpr UInt32 kChannels = 2;
+
+/// An exception thrown by an input provider.
+struct ProviderError final {
+    /// A value identifying the exception.
+    int value_;
+};
+
+/// Returns interleaved float samples that convert exactly to the 16-bit integers returned by ExpectedSample().
+std::vector<float> MakeSamples(UInt32 frameCount) {
+    std::vector<float> samples(static_cast<std::size_t>(frameCount) * kChannels);
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<float>(static_cast<int>(i % 2000) - 1000) / 32768;
+    }
+    return samples;
+}
+
+/// Returns the 16-bit integer sample i of the output.
+SInt16 ExpectedSample(std::size_t i) noexcept { return static_cast<SInt16>(static_cast<int>(i % 2000) - 1000); }
+
+/// Returns a converter from interleaved float to native-endian interleaved 16-bit integer samples.
+CAAudioConverter MakeConverter() {
+    CAAudioConverter converter;
+    converter.New(test_support::detail::MakeFloatFormat(44'100, kChannels),
+                  test_support::detail::MakeInt16Format(44'100, kChannels, kAudioFormatFlagsNativeEndian != 0));
+    return converter;
+}
+
+/// Output buffers for 16-bit integer samples.
+struct Output {
+    /// The samples.
+    std::vector<SInt16> samples_;
+    /// The buffer list describing the unused samples.
+    AudioBufferList bufferList_{};
+
+    /// Points the buffer list at the samples from frame onward and returns the number of frames they hold.
+    UInt32 Prepare(UInt32 frame) noexcept {
+        bufferList_.mNumberBuffers = 1;
+        bufferList_.mBuffers[0].mNumberChannels = kChannels;
+        bufferList_.mBuffers[0].mData = samples_.data() + static_cast<std::size_t>(frame) * kChannels;
+        bufferList_.mBuffers[0].mDataByteSize =
+                static_cast<UInt32>((samples_.size() - static_cast<std::size_t>(frame) * kChannels) * sizeof(SInt16));
+        return static_cast<UInt32>(samples_.size() / kChannels) - frame;
+    }
+
+    /// Returns true if the first frameCount frames hold the expected samples.
+    bool Matches(UInt32 frameCount) const noexcept {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(frameCount) * kChannels; ++i) {
+            if (samples_[i] != ExpectedSample(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} /* namespace */
+
+bool test_support::InputProviderSuppliesBuffersWithoutCopying() noexcept {
+    return detail::Run("InputProviderSuppliesBuffersWithoutCopying", [](const char *scenario) {
+        // Packets from a buffer list are supplied in place, with descriptions advancing with the supplied packets
+        std::vector<unsigned char> packets(64);
+        AudioStreamPacketDescription descriptions[4];
+        for (SInt64 i = 0; i < 4; ++i) {
+            descriptions[i] = {i * 16, 0, 16};
+        }
+        AudioBufferList bufferList{1, {{1, static_cast<UInt32>(packets.size()), packets.data()}}};
+        CAAudioConverter::InputBuffer buffer{bufferList, 4, descriptions, false};
+
+        AudioBufferList ioData{1, {{0, 0, nullptr}}};
+        AudioStreamPacketDescription *packetDescriptions = nullptr;
+        UInt32 packetCount = 3;
+        if (buffer(packetCount, ioData, &packetDescriptions) != InputResult::data || packetCount != 3 ||
+            ioData.mBuffers[0].mData != packets.data() || packetDescriptions != descriptions) {
+            return detail::Fail(scenario, "The first packets were not supplied in place");
+        }
+        packetCount = 3;
+        if (buffer(packetCount, ioData, &packetDescriptions) != InputResult::data || packetCount != 1 ||
+            ioData.mBuffers[0].mData != packets.data() || packetDescriptions != descriptions + 3 ||
+            buffer.RemainingPackets() != 0) {
+            return detail::Fail(scenario, "The remaining packet was not supplied in place");
+        }
+        packetCount = 3;
+        if (buffer(packetCount, ioData, &packetDescriptions) != InputResult::noDataYet || packetCount != 0) {
+            return detail::Fail(scenario, "An exhausted buffer did not report no data yet");
+        }
+
+        // Packets from a range of samples are supplied at their offset in the range
+        const auto samples = MakeSamples(10);
+        CAAudioConverter::InputBuffer range{samples, kChannels};
+        packetCount = 4;
+        if (range(packetCount, ioData, nullptr) != InputResult::data || packetCount != 4 ||
+            ioData.mBuffers[0].mData != samples.data() ||
+            ioData.mBuffers[0].mDataByteSize != 4 * kChannels * sizeof(float)) {
+            return detail::Fail(scenario, "The first frames of the range were not supplied in place");
+        }
+        packetCount = 100;
+        if (range(packetCount, ioData, nullptr) != InputResult::data || packetCount != 6 ||
+            ioData.mBuffers[0].mData != samples.data() + 4 * kChannels ||
+            ioData.mBuffers[0].mDataByteSize != 6 * kChannels * sizeof(float)) {
+            return detail::Fail(scenario, "The remaining frames of the range were not supplied in place");
+        }
+        packetCount = 100;
+        if (range(packetCount, ioData, nullptr) != InputResult::endOfStream || packetCount != 0) {
+            return detail::Fail(scenario, "An exhausted range did not report end of stream");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::InputProviderConvertsToEndOfStream() noexcept {
+    return detail::Run("InputProviderConvertsToEndOfStream", [](const char *scenario) {
+        constexpr UInt32 frameCount = 1000;
+        const auto samples = MakeSamples(frameCount);
+        auto converter = MakeConverter();
+
+        // The converter reads the caller's samples directly
+        CAAudioConverter::InputBuffer buffer{samples, kChannels};
+        auto copied = false;
+        auto provider = [&](UInt32 &ioNumberDataPackets, AudioBufferList &ioData,
+                            AudioStreamPacketDescription *_Nullable *_Nullable outDataPacketDescription) {
+            const auto result = buffer(ioNumberDataPackets, ioData, outDataPacketDescription);
+            const auto *data = static_cast<const float *>(ioData.mBuffers[0].mData);
+            if (ioNumberDataPackets > 0 &&
+                (data < samples.data() || data + ioNumberDataPackets * kChannels > samples.data() + samples.size())) {
+                copied = true;
+            }
+            return result;
+        };
+
+        // Output smaller than the input requires several calls, each resuming where the last stopped
+        Output output{std::vector<SInt16>(static_cast<std::size_t>(frameCount + 10) * kChannels)};
+        UInt32 converted = 0;
+        auto result = InputResult::data;
+        while (result == InputResult::data) {
+            auto packetCount = std::min<UInt32>(300, output.Prepare(converted));
+            result = converter.FillComplexBuffer(provider, packetCount, &output.bufferList_);
+            converted += packetCount;
+            if (result == InputResult::data && packetCount == 0) {
+                return detail::Fail(scenario, "Conversion stopped without reaching end of stream");
+            }
+        }
+
+        if (result != InputResult::endOfStream) {
+            return detail::Fail(scenario, "End of stream was not reported");
+        }
+        if (copied) {
+            return detail::Fail(scenario, "The converter was supplied memory outside the caller's samples");
+        }
+        if (converted != frameCount || !output.Matches(frameCount)) {
+            return detail::Fail(scenario, "The converted samples differ from the input");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::InputProviderStopsWhenNoDataYet() noexcept {
+    return detail::Run("InputProviderStopsWhenNoDataYet", [](const char *scenario) {
+        constexpr UInt32 frameCount = 600;
+        const auto samples = MakeSamples(frameCount);
+        const std::vector<float> first(samples.begin(), samples.begin() + 250 * kChannels);
+        const std::vector<float> second(samples.begin() + 250 * kChannels, samples.end());
+        auto converter = MakeConverter();
+
+        // Running out of input before the output is full stops conversion with a result instead of an exception
+        Output output{std::vector<SInt16>(static_cast<std::size_t>(frameCount) * kChannels)};
+        CAAudioConverter::InputBuffer firstBuffer{first, kChannels, false};
+        auto packetCount = output.Prepare(0);
+        InputResult result;
+        try {
+            result = converter.FillComplexBuffer(firstBuffer, packetCount, &output.bufferList_);
+        } catch (const std::system_error &) {
+            return detail::Fail(scenario, "No data yet was reported as an error");
+        }
+        if (result != InputResult::noDataYet || packetCount != 250 || firstBuffer.RemainingPackets() != 0) {
+            return detail::Fail(scenario, "No data yet did not return the packets converted so far");
+        }
+
+        // Conversion resumes with the next input
+        auto converted = packetCount;
+        CAAudioConverter::InputBuffer secondBuffer{second, kChannels};
+        packetCount = output.Prepare(converted);
+        result = converter.FillComplexBuffer(secondBuffer, packetCount, &output.bufferList_);
+        converted += packetCount;
+        if (result == InputResult::noDataYet || converted != frameCount || !output.Matches(frameCount)) {
+            return detail::Fail(scenario, "Conversion did not resume after no data yet");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::InputProviderRethrowsExceptions() noexcept {
+    return detail::Run("InputProviderRethrowsExceptions", [](const char *scenario) {
+        const auto samples = MakeSamples(100);
+        auto converter = MakeConverter();
+        Output output{std::vector<SInt16>(static_cast<std::size_t>(200) * kChannels)};
+
+        // The provider's exception, not an AudioConverter error, reaches the caller after some input was supplied
+        CAAudioConverter::InputBuffer buffer{samples, kChannels};
+        auto calls = 0;
+        auto provider = [&](UInt32 &ioNumberDataPackets, AudioBufferList &ioData,
+                            AudioStreamPacketDescription *_Nullable *_Nullable outDataPacketDescription) {
+            if (++calls > 1) {
+                throw ProviderError{42};
+            }
+            ioNumberDataPackets = std::min<UInt32>(ioNumberDataPackets, 50);
+            return buffer(ioNumberDataPackets, ioData, outDataPacketDescription);
+        };
+
+        auto packetCount = output.Prepare(0);
+        try {
+            static_cast<void>(converter.FillComplexBuffer(provider, packetCount, &output.bufferList_));
+            return detail::Fail(scenario, "The provider's exception was not rethrown");
+        } catch (const ProviderError &error) {
+            if (error.value_ != 42) {
+                return detail::Fail(scenario, "A different exception was rethrown");
+            }
+        } catch (const std::system_error &) {
+            return detail::Fail(scenario, "The provider's exception was reported as an AudioConverter error");
+        }
+
+        // Standard exceptions keep their type
+        auto throwing = [](UInt32 &, AudioBufferList &, AudioStreamPacketDescription *_Nullable *_Nullable)
+                -> InputResult { throw std::out_of_range{"provider"}; };
+        packetCount = output.Prepare(0);
+        try {
+            static_cast<void>(converter.FillComplexBuffer(throwing, packetCount, &output.bufferList_));
+            return detail::Fail(scenario, "The standard exception was not rethrown");
+        } catch (const std::out_of_range &) {
+        }
+
+        return true;
+    });
+}
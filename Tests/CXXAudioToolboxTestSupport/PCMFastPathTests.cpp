@@ -0,0 +1,337 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/PCMFastPathTests.hpp"
+
+#include "Expect.hpp"
+
+#include <audio_toolbox/CAAudioConverter.hpp>
+
+#include <AudioToolbox/AudioConverter.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// A linear PCM sample format.
+struct SampleFormat {
+    /// The number of bits per sample.
+    UInt32 bits_;
+    /// True for float samples, false for signed integer samples.
+    bool float_;
+    /// True for big-endian samples.
+    bool bigEndian_;
+};
+
+/// The sample formats supported by the built-in kernels.
+constexpr SampleFormat kSampleFormats[] = {
+        {16, false, false}, {16, false, true}, {24, false, false}, {24, false, true},
+        {32, false, false}, {32, false, true}, {32, true, false},  {32, true, true},
+};
+
+/// Returns a packed linear PCM format.
+AudioStreamBasicDescription MakeFormat(const SampleFormat &sampleFormat, UInt32 channels, bool interleaved) {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = 44100;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagIsPacked;
+    format.mFormatFlags |= sampleFormat.float_ ? kAudioFormatFlagIsFloat : kAudioFormatFlagIsSignedInteger;
+    if (sampleFormat.bigEndian_) {
+        format.mFormatFlags |= kAudioFormatFlagIsBigEndian;
+    }
+    if (!interleaved) {
+        format.mFormatFlags |= kAudioFormatFlagIsNonInterleaved;
+    }
+    format.mBytesPerFrame = sampleFormat.bits_ / 8 * (interleaved ? channels : 1);
+    format.mFramesPerPacket = 1;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    format.mChannelsPerFrame = channels;
+    format.mBitsPerChannel = sampleFormat.bits_;
+    return format;
+}
+
+/// Returns the number of bytes per sample of a format.
+std::size_t BytesPerSample(const AudioStreamBasicDescription &format) noexcept { return format.mBitsPerChannel / 8; }
+
+/// Returns the value of the sample at index in a buffer of format: integer samples are unscaled.
+double ReadSample(const std::vector<unsigned char> &buffer, std::size_t index,
+                  const AudioStreamBasicDescription &format) {
+    const auto bytesPerSample = BytesPerSample(format);
+    const auto bigEndian = (format.mFormatFlags & kAudioFormatFlagIsBigEndian) != 0;
+
+    UInt32 bits = 0;
+    for (std::size_t i = 0; i < bytesPerSample; ++i) {
+        const auto byte = buffer[index * bytesPerSample + (bigEndian ? i : bytesPerSample - 1 - i)];
+        bits = (bits << 8) | byte;
+    }
+
+    if (format.mFormatFlags & kAudioFormatFlagIsFloat) {
+        Float32 value;
+        std::memcpy(&value, &bits, sizeof value);
+        return value;
+    }
+
+    // Sign-extend from the sample width
+    const auto shift = 32 - 8 * static_cast<UInt32>(bytesPerSample);
+    return static_cast<SInt32>(bits << shift) >> shift;
+}
+
+/// Writes the sample at index in a buffer of format: integer values are unscaled.
+void WriteSample(std::vector<unsigned char> &buffer, std::size_t index, const AudioStreamBasicDescription &format,
+                 double value) {
+    const auto bytesPerSample = BytesPerSample(format);
+    const auto bigEndian = (format.mFormatFlags & kAudioFormatFlagIsBigEndian) != 0;
+
+    UInt32 bits;
+    if (format.mFormatFlags & kAudioFormatFlagIsFloat) {
+        const auto sample = static_cast<Float32>(value);
+        std::memcpy(&bits, &sample, sizeof bits);
+    } else {
+        bits = static_cast<UInt32>(static_cast<SInt32>(value));
+    }
+
+    for (std::size_t i = 0; i < bytesPerSample; ++i) {
+        buffer[index * bytesPerSample + (bigEndian ? bytesPerSample - 1 - i : i)] =
+                static_cast<unsigned char>(bits >> (8 * i));
+    }
+}
+
+/// Returns a buffer of random samples of format, including full-scale and slightly out of range float samples.
+std::vector<unsigned char> MakeInput(const AudioStreamBasicDescription &format, std::size_t sampleCount) {
+    std::vector<unsigned char> buffer(sampleCount * BytesPerSample(format));
+    std::mt19937 generator{static_cast<std::mt19937::result_type>(format.mFormatFlags ^ format.mBitsPerChannel)};
+
+    const auto isFloat = (format.mFormatFlags & kAudioFormatFlagIsFloat) != 0;
+    const auto fullScale = std::ldexp(1.0, static_cast<int>(format.mBitsPerChannel) - 1);
+    std::uniform_real_distribution<double> floatDistribution{-1.05, 1.05};
+    std::uniform_int_distribution<SInt64> intDistribution{static_cast<SInt64>(-fullScale),
+                                                          static_cast<SInt64>(fullScale) - 1};
+
+    for (std::size_t i = 0; i < sampleCount; ++i) {
+        auto value = isFloat ? floatDistribution(generator) : static_cast<double>(intDistribution(generator));
+        // The first samples are the extremes of the range
+        if (i < 3) {
+            value = isFloat ? std::array<double, 3>{-1.0, 1.0, 0.0}[i]
+                            : std::array<double, 3>{-fullScale, fullScale - 1, 0.0}[i];
+        }
+        WriteSample(buffer, i, format, value);
+    }
+    return buffer;
+}
+
+/// Converts a buffer with CAAudioConverter::ConvertBuffer and with AudioConverterConvertBuffer and compares the
+/// results. Float samples may differ by one unit in the last place at full scale and integer samples by one.
+bool CompareWithAudioConverter(const char *scenario, const AudioStreamBasicDescription &source,
+                               const AudioStreamBasicDescription &destination, std::size_t frameCount) {
+    audio_toolbox::CAAudioConverter converter;
+    converter.New(source, destination);
+    converter.SetPCMFastPathEnabled(true);
+    if (!converter.UsesPCMFastPath()) {
+        return test_support::detail::Fail(scenario, "The built-in kernels were not used");
+    }
+
+    audio_toolbox::CAAudioConverter reference;
+    reference.New(source, destination);
+
+    const auto nonInterleaved = (source.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+    const auto channelsPerBuffer = nonInterleaved ? 1 : source.mChannelsPerFrame;
+    const auto sampleCount = frameCount * channelsPerBuffer;
+    const auto input = MakeInput(source, sampleCount);
+
+    const auto outputSize = static_cast<UInt32>(frameCount * destination.mBytesPerFrame);
+    std::vector<unsigned char> output(outputSize);
+    std::vector<unsigned char> expected(outputSize);
+
+    auto size = outputSize;
+    converter.ConvertBuffer(static_cast<UInt32>(input.size()), input.data(), size, output.data());
+    if (size != outputSize) {
+        return test_support::detail::Fail(scenario, "ConvertBuffer produced the wrong size");
+    }
+
+    auto expectedSize = outputSize;
+    const auto result = AudioConverterConvertBuffer(reference.get(), static_cast<UInt32>(input.size()), input.data(),
+                                                    &expectedSize, expected.data());
+    if (result != noErr || expectedSize != outputSize) {
+        return test_support::detail::Fail(scenario, "AudioConverterConvertBuffer failed");
+    }
+
+    const auto tolerance = (destination.mFormatFlags & kAudioFormatFlagIsFloat) ? std::ldexp(1.0, -23) : 1.0;
+    for (std::size_t i = 0; i < sampleCount; ++i) {
+        const auto value = ReadSample(output, i, destination);
+        const auto expectedValue = ReadSample(expected, i, destination);
+        if (!(std::fabs(value - expectedValue) <= tolerance)) {
+            return test_support::detail::Fail(scenario, "A converted sample differs from AudioConverter");
+        }
+    }
+
+    return true;
+}
+
+} /* namespace */
+
+bool test_support::PCMFastPathMatchesAudioConverter() noexcept {
+    return detail::Run("PCMFastPathMatchesAudioConverter", [](const char *scenario) {
+        for (const auto &sourceFormat : kSampleFormats) {
+            for (const auto &destinationFormat : kSampleFormats) {
+                if (sourceFormat.float_ == destinationFormat.float_) {
+                    continue;
+                }
+                // An odd frame count exercises the scalar tail of the vector kernels
+                if (!CompareWithAudioConverter(scenario, MakeFormat(sourceFormat, 2, true),
+                                               MakeFormat(destinationFormat, 2, true), 1021)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+}
+
+bool test_support::PCMFastPathHandlesNonInterleavedFormats() noexcept {
+    return detail::Run("PCMFastPathHandlesNonInterleavedFormats", [](const char *scenario) {
+        constexpr SampleFormat int16{16, false, false};
+        constexpr SampleFormat float32{32, true, false};
+
+        // Mono formats hold every channel in one buffer regardless of interleaving
+        if (!CompareWithAudioConverter(scenario, MakeFormat(int16, 1, false), MakeFormat(float32, 1, false), 1021)) {
+            return false;
+        }
+
+        // A non-interleaved stereo buffer holds a single channel, half the samples of an interleaved frame count
+        audio_toolbox::CAAudioConverter converter;
+        converter.New(MakeFormat(int16, 2, false), MakeFormat(float32, 2, false));
+        converter.SetPCMFastPathEnabled(true);
+        if (converter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "The built-in kernels were used for a non-interleaved stereo format");
+        }
+
+        constexpr UInt32 frameCount = 512;
+        constexpr unsigned char guard = 0xA5;
+        const std::vector<unsigned char> input(frameCount * sizeof(SInt16));
+        std::vector<unsigned char> output(frameCount * sizeof(Float32) * 2, guard);
+
+        // AudioConverter may reject the buffer; it must not write past the output size it was given
+        UInt32 size = frameCount * sizeof(Float32);
+        try {
+            converter.ConvertBuffer(static_cast<UInt32>(input.size()), input.data(), size, output.data());
+        } catch (...) {
+        }
+        if (!std::all_of(output.begin() + frameCount * sizeof(Float32), output.end(),
+                         [](unsigned char byte) { return byte == guard; })) {
+            return detail::Fail(scenario, "ConvertBuffer wrote past the end of the output buffer");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PCMFastPathReportsUsage() noexcept {
+    return detail::Run("PCMFastPathReportsUsage", [](const char *scenario) {
+        constexpr SampleFormat int16{16, false, false};
+        constexpr SampleFormat int32{32, false, false};
+        constexpr SampleFormat float32{32, true, false};
+
+        audio_toolbox::CAAudioConverter converter;
+        converter.New(MakeFormat(int16, 2, true), MakeFormat(float32, 2, true));
+        if (converter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "Reported before being enabled");
+        }
+
+        converter.SetPCMFastPathEnabled(true);
+        if (!converter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "Not reported for int16 to float32");
+        }
+        converter.SetPCMFastPathEnabled(false);
+        if (converter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "Reported while disabled");
+        }
+        converter.SetPCMFastPathEnabled(true);
+
+        // Setting a property disables the kernels whether or not AudioConverter accepts it
+        const UInt32 primeMethod = kConverterPrimeMethod_None;
+        try {
+            converter.SetProperty(kAudioConverterPrimeMethod, sizeof primeMethod, &primeMethod);
+        } catch (...) {
+        }
+        if (converter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "Reported after setting a property");
+        }
+
+        audio_toolbox::CAAudioConverter integerConverter;
+        integerConverter.New(MakeFormat(int16, 2, true), MakeFormat(int32, 2, true));
+        integerConverter.SetPCMFastPathEnabled(true);
+        if (integerConverter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "Reported for int16 to int32");
+        }
+
+        auto resampled = MakeFormat(float32, 2, true);
+        resampled.mSampleRate = 48000;
+        audio_toolbox::CAAudioConverter resamplingConverter;
+        resamplingConverter.New(MakeFormat(int16, 2, true), resampled);
+        resamplingConverter.SetPCMFastPathEnabled(true);
+        if (resamplingConverter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "Reported for a sample rate conversion");
+        }
+
+        audio_toolbox::CAAudioConverter layoutConverter;
+        layoutConverter.New(MakeFormat(float32, 2, true), MakeFormat(float32, 2, false));
+        layoutConverter.SetPCMFastPathEnabled(true);
+        if (!layoutConverter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "Not reported for an interleaving conversion");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PCMFastPathClipsAtFullScale() noexcept {
+    return detail::Run("PCMFastPathClipsAtFullScale", [](const char *scenario) {
+        constexpr SampleFormat float32{32, true, false};
+        // Full scale and beyond clip to the integer extremes, as AudioConverter does
+        constexpr std::array<double, 6> values{1.0, 1.5, HUGE_VAL, -1.0, -1.5, 0.5};
+
+        for (const auto &sampleFormat : kSampleFormats) {
+            if (sampleFormat.float_) {
+                continue;
+            }
+            const auto source = MakeFormat(float32, 1, true);
+            const auto destination = MakeFormat(sampleFormat, 1, true);
+
+            audio_toolbox::CAAudioConverter converter;
+            converter.New(source, destination);
+            converter.SetPCMFastPathEnabled(true);
+
+            // An odd sample count exercises the vector kernels and their scalar tail
+            constexpr std::size_t sampleCount = 1021;
+            std::vector<unsigned char> input(sampleCount * BytesPerSample(source));
+            for (std::size_t i = 0; i < sampleCount; ++i) {
+                WriteSample(input, i, source, values[i % values.size()]);
+            }
+
+            auto size = static_cast<UInt32>(sampleCount * BytesPerSample(destination));
+            std::vector<unsigned char> output(size);
+            converter.ConvertBuffer(static_cast<UInt32>(input.size()), input.data(), size, output.data());
+
+            const auto fullScale = std::ldexp(1.0, static_cast<int>(sampleFormat.bits_) - 1);
+            const std::array<double, 6> expected{fullScale - 1, fullScale - 1, fullScale - 1,
+                                                 -fullScale,    -fullScale,    fullScale / 2};
+            for (std::size_t i = 0; i < sampleCount; ++i) {
+                if (ReadSample(output, i, destination) != expected[i % expected.size()]) {
+                    return detail::Fail(scenario, "A sample was not clipped to the integer range");
+                }
+            }
+        }
+
+        return true;
+    });
+}
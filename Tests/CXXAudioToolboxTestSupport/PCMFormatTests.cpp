@@ -0,0 +1,428 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/PCMFormatTests.hpp"
+
+#include "Expect.hpp"
+#include "PCMKernels.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/PCMFormat.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::PCMConverter;
+using audio_toolbox::PCMFormat;
+using audio_toolbox::PCMFormatDescriptor;
+using audio_toolbox::PCMSampleType;
+
+/// The number of frames converted, which is not a multiple of any vector width.
+constexpr UInt32 kFrameCount = 1027;
+
+/// The sample rate of the stream descriptions.
+constexpr Float64 kSampleRate = 44'100;
+
+/// Interleaved stereo signed integer samples.
+template <UInt32 Bits, bool BigEndian>
+using IntegerFormat = PCMFormat<PCMSampleType::signedInteger, Bits, BigEndian, true, 2>;
+
+/// Interleaved stereo 32-bit float samples.
+template <bool BigEndian> using FloatFormat = audio_toolbox::Float32PCMFormat<2, true, BigEndian>;
+
+/// The non-interleaved variant of a format.
+template <typename Format>
+using NonInterleavedFormat = PCMFormat<Format::kDescriptor.sampleType_, Format::kDescriptor.bitsPerChannel_,
+                                       Format::kDescriptor.bigEndian_, false, Format::kDescriptor.channelsPerFrame_>;
+
+static_assert(audio_toolbox::Int16PCMFormat<2>::kDescriptor.BytesPerFrame() == 4);
+static_assert(audio_toolbox::Int24PCMFormat<2, false>::kDescriptor.BufferCount() == 2);
+static_assert(audio_toolbox::Float32PCMFormat<1>::Matches(audio_toolbox::Float32PCMFormat<1>::StreamDescription(48e3)));
+
+/// Reverses the bytes of each sample of size bytes if bigEndian differs from the native byte order.
+void ToByteOrder(std::vector<unsigned char> &samples, std::size_t size, bool bigEndian) {
+    if (bigEndian != audio_toolbox::detail::kNativeBigEndian) {
+        for (auto i = samples.begin(); i != samples.end(); i += size) {
+            std::reverse(i, i + size);
+        }
+    }
+}
+
+/// Returns float samples covering clipping, rounding ties, and non-finite values, followed by random samples.
+std::vector<float> MakeFloatSamples(std::size_t count) {
+    constexpr auto infinity = std::numeric_limits<float>::infinity();
+    std::vector<float> samples{0.f,
+                               -0.f,
+                               1.f,
+                               -1.f,
+                               std::nextafter(1.f, 0.f),
+                               std::nextafter(-1.f, 0.f),
+                               std::nextafter(1.f, 2.f),
+                               std::nextafter(-1.f, -2.f),
+                               2.f,
+                               -2.f,
+                               infinity,
+                               -infinity,
+                               std::numeric_limits<float>::quiet_NaN(),
+                               std::numeric_limits<float>::denorm_min(),
+                               .5f / 32768,
+                               1.5f / 32768,
+                               -2.5f / 32768,
+                               .5f / 8388608,
+                               -1.5f / 8388608,
+                               .5f / 2147483648.f};
+    std::mt19937 generator{20};
+    std::uniform_real_distribution<float> distribution{-1.1f, 1.1f};
+    while (samples.size() < count) {
+        samples.push_back(distribution(generator));
+    }
+    samples.resize(count);
+    return samples;
+}
+
+/// Returns kFrameCount frames of random samples in Format, including float samples beyond full scale.
+template <typename Format> std::vector<unsigned char> MakeInput() {
+    constexpr auto descriptor = Format::kDescriptor;
+    const auto count = static_cast<std::size_t>(kFrameCount) * descriptor.channelsPerFrame_;
+    std::vector<unsigned char> input(count * descriptor.BytesPerSample());
+    if constexpr (descriptor.sampleType_ == PCMSampleType::floatingPoint) {
+        const auto samples = MakeFloatSamples(count);
+        std::memcpy(input.data(), samples.data(), input.size());
+        ToByteOrder(input, descriptor.BytesPerSample(), descriptor.bigEndian_);
+    } else {
+        // Every bit pattern is a valid integer sample
+        std::mt19937 generator{descriptor.bitsPerChannel_};
+        std::generate(input.begin(), input.end(), [&generator] { return static_cast<unsigned char>(generator()); });
+        // Begin with both extremes
+        const auto size = descriptor.BytesPerSample();
+        std::fill(input.begin(), input.begin() + size, 0xff);
+        std::fill(input.begin() + size, input.begin() + 2 * size, 0);
+        const auto high = descriptor.bigEndian_ ? 0 : size - 1;
+        input[high] = 0x7f;
+        input[size + high] = 0x80;
+    }
+    return input;
+}
+
+/// Returns a name for a format such as "Int16 BE".
+template <typename Format> std::string FormatName() {
+    constexpr auto descriptor = Format::kDescriptor;
+    return std::string{descriptor.sampleType_ == PCMSampleType::floatingPoint ? "Float" : "Int"} +
+           std::to_string(descriptor.bitsPerChannel_) + (descriptor.bigEndian_ ? " BE" : " LE");
+}
+
+/// Compares PCMConverter with the vector and scalar built-in kernels for a pair of formats.
+template <typename Source, typename Destination> bool CompareWithKernels(const char *scenario) {
+    const auto source = Source::StreamDescription(kSampleRate);
+    const auto destination = Destination::StreamDescription(kSampleRate);
+    const auto pair = FormatName<Source>() + " to " + FormatName<Destination>();
+
+    const auto vector = audio_toolbox::detail::SelectPCMSampleConverter(source, destination);
+    const auto scalar = audio_toolbox::detail::SelectScalarPCMSampleConverter(source, destination);
+    if (!vector || !scalar) {
+        return test_support::detail::Fail(scenario, ("No built-in kernel for " + pair).c_str());
+    }
+
+    auto input = MakeInput<Source>();
+    const auto outputSize = kFrameCount * destination.mBytesPerFrame;
+    std::vector<unsigned char> expected(outputSize);
+    std::vector<unsigned char> expectedScalar(outputSize);
+    vector(input.data(), expected.data(), kFrameCount * source.mChannelsPerFrame);
+    scalar(input.data(), expectedScalar.data(), kFrameCount * source.mChannelsPerFrame);
+    if (expected != expectedScalar) {
+        return test_support::detail::Fail(scenario, ("The built-in kernels differ for " + pair).c_str());
+    }
+
+    // The guard byte detects writes past the converted frames
+    std::vector<unsigned char> output(outputSize + 1, 0xa5);
+    auto ioOutputDataSize = static_cast<UInt32>(output.size());
+    PCMConverter<Source, Destination>::ConvertBuffer(static_cast<UInt32>(input.size()), input.data(),
+                                                     ioOutputDataSize, output.data());
+    if (ioOutputDataSize != outputSize || output.back() != 0xa5 ||
+        !std::equal(expected.begin(), expected.end(), output.begin())) {
+        return test_support::detail::Fail(scenario, ("PCMConverter differs from the kernels for " + pair).c_str());
+    }
+
+    // Deinterleaving converts each sample separately instead of calling the kernels
+    const auto bytesPerSample = Destination::kDescriptor.BytesPerSample();
+    std::vector<unsigned char> left(kFrameCount * bytesPerSample);
+    std::vector<unsigned char> right(kFrameCount * bytesPerSample);
+    test_support::detail::BufferList inputList{1};
+    inputList.Set(0, input.data(), static_cast<UInt32>(input.size()), 2);
+    test_support::detail::BufferList outputList{2};
+    outputList.Set(0, left.data(), static_cast<UInt32>(left.size()));
+    outputList.Set(1, right.data(), static_cast<UInt32>(right.size()));
+    PCMConverter<Source, NonInterleavedFormat<Destination>>::ConvertComplexBuffer(kFrameCount, inputList.get(),
+                                                                                   outputList.get());
+    for (std::size_t frame = 0; frame < kFrameCount; ++frame) {
+        const auto sample = expected.begin() + 2 * frame * bytesPerSample;
+        if (!std::equal(sample, sample + bytesPerSample, left.begin() + frame * bytesPerSample) ||
+            !std::equal(sample + bytesPerSample, sample + 2 * bytesPerSample, right.begin() + frame * bytesPerSample)) {
+            return test_support::detail::Fail(scenario,
+                                              ("Deinterleaving differs from the kernels for " + pair).c_str());
+        }
+    }
+    return true;
+}
+
+/// Compares conversions from float to integer and back for each byte order of both formats.
+template <UInt32 Bits> bool CompareIntegerWidth(const char *scenario) {
+    return CompareWithKernels<FloatFormat<false>, IntegerFormat<Bits, false>>(scenario) &&
+           CompareWithKernels<FloatFormat<false>, IntegerFormat<Bits, true>>(scenario) &&
+           CompareWithKernels<FloatFormat<true>, IntegerFormat<Bits, false>>(scenario) &&
+           CompareWithKernels<FloatFormat<true>, IntegerFormat<Bits, true>>(scenario) &&
+           CompareWithKernels<IntegerFormat<Bits, false>, FloatFormat<false>>(scenario) &&
+           CompareWithKernels<IntegerFormat<Bits, false>, FloatFormat<true>>(scenario) &&
+           CompareWithKernels<IntegerFormat<Bits, true>, FloatFormat<false>>(scenario) &&
+           CompareWithKernels<IntegerFormat<Bits, true>, FloatFormat<true>>(scenario);
+}
+
+/// Converts native-endian samples and returns the native-endian results.
+template <typename Source, typename Destination, typename In, typename Out>
+std::vector<Out> Convert(const std::vector<In> &input) {
+    static_assert(Source::kDescriptor.channelsPerFrame_ == 1);
+    std::vector<Out> output(input.size());
+    PCMConverter<Source, Destination>::Convert(input.data(), output.data(), input.size());
+    return output;
+}
+
+/// Returns true if ConvertBuffer throws std::system_error with code.
+template <typename Converter>
+bool ConvertBufferThrows(UInt32 inputSize, UInt32 outputSize, OSStatus code) {
+    std::vector<unsigned char> input(inputSize);
+    std::vector<unsigned char> output(outputSize);
+    try {
+        Converter::ConvertBuffer(inputSize, input.data(), outputSize, output.data());
+    } catch (const std::system_error &e) {
+        return e.code().value() == code;
+    }
+    return false;
+}
+
+} /* namespace */
+
+bool test_support::PCMFormatDescriptorsRoundTrip() noexcept {
+    return detail::Run("PCMFormatDescriptorsRoundTrip", [](const char *scenario) {
+        for (const auto sampleType : {PCMSampleType::signedInteger, PCMSampleType::floatingPoint}) {
+            for (const UInt32 bits : {16, 24, 32, 64}) {
+                for (const auto bigEndian : {false, true}) {
+                    for (const auto interleaved : {false, true}) {
+                        for (const UInt32 channels : {1, 2, 6}) {
+                            const PCMFormatDescriptor descriptor{sampleType, bits, bigEndian, interleaved, channels};
+                            const auto format = descriptor.StreamDescription(kSampleRate);
+                            const auto roundTrip = PCMFormatDescriptor::FromStreamDescription(format);
+                            if (descriptor.IsSupported() != roundTrip.has_value()) {
+                                return detail::Fail(scenario, "A stream description was not classified correctly");
+                            }
+                            if (roundTrip && (*roundTrip != descriptor || format.mSampleRate != kSampleRate ||
+                                              format.mBytesPerFrame != descriptor.BytesPerFrame())) {
+                                return detail::Fail(scenario, "A descriptor did not round-trip");
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        const auto int16 = detail::MakeInt16Format(kSampleRate, 2, false);
+        if (!audio_toolbox::Int16PCMFormat<2, true, false>::Matches(int16) ||
+            audio_toolbox::Int16PCMFormat<2, true, true>::Matches(int16) ||
+            audio_toolbox::Int16PCMFormat<1, true, false>::Matches(int16)) {
+            return detail::Fail(scenario, "Matches did not compare the byte order and channel count");
+        }
+
+        auto unsignedInt = int16;
+        unsignedInt.mFormatFlags &= ~kAudioFormatFlagIsSignedInteger;
+        auto unpacked = int16;
+        unpacked.mBytesPerFrame = unpacked.mBytesPerPacket = 6;
+        auto fixedPoint = int16;
+        fixedPoint.mFormatFlags |= 8 << kLinearPCMFormatFlagsSampleFractionShift;
+        auto noChannels = int16;
+        noChannels.mChannelsPerFrame = 0;
+        auto packetized = int16;
+        packetized.mFramesPerPacket = 2;
+        packetized.mBytesPerPacket = 8;
+        const auto compressed = detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, kSampleRate, 2);
+        for (const auto &format : {unsignedInt, unpacked, fixedPoint, noChannels, packetized, compressed}) {
+            if (PCMFormatDescriptor::FromStreamDescription(format)) {
+                return detail::Fail(scenario, "An unsupported stream description was accepted");
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PCMConverterMatchesBuiltInKernels() noexcept {
+    return detail::Run("PCMConverterMatchesBuiltInKernels", [](const char *scenario) {
+        return CompareIntegerWidth<16>(scenario) && CompareIntegerWidth<24>(scenario) &&
+               CompareIntegerWidth<32>(scenario);
+    });
+}
+
+bool test_support::PCMConverterClipsAtFullScale() noexcept {
+    return detail::Run("PCMConverterClipsAtFullScale", [](const char *scenario) {
+        using Float32Mono = audio_toolbox::Float32PCMFormat<1>;
+        using Float64Mono = audio_toolbox::Float64PCMFormat<1>;
+        using Int16Mono = audio_toolbox::Int16PCMFormat<1>;
+        using Int32Mono = audio_toolbox::Int32PCMFormat<1>;
+
+        const std::vector<float> floats{1.f, 2.f, std::nextafter(1.f, 0.f), -1.f, -2.f,
+                                        std::numeric_limits<float>::quiet_NaN()};
+        const std::vector<std::int32_t> expected32{INT32_MAX, INT32_MAX, 2147483520, INT32_MIN, INT32_MIN, INT32_MIN};
+        if (Convert<Float32Mono, Int32Mono, float, std::int32_t>(floats) != expected32) {
+            return detail::Fail(scenario, "Float32 samples were not clipped to the Int32 range");
+        }
+        const std::vector<std::int16_t> expected16{INT16_MAX, INT16_MAX, INT16_MAX, INT16_MIN, INT16_MIN, INT16_MIN};
+        if (Convert<Float32Mono, Int16Mono, float, std::int16_t>(floats) != expected16) {
+            return detail::Fail(scenario, "Float32 samples were not clipped to the Int16 range");
+        }
+
+        const std::vector<double> doubles{1., 2., std::nextafter(1., 0.), -1., -2.,
+                                          std::numeric_limits<double>::quiet_NaN()};
+        const std::vector<std::int32_t> expected64{INT32_MAX, INT32_MAX, INT32_MAX, INT32_MIN, INT32_MIN, INT32_MIN};
+        if (Convert<Float64Mono, Int32Mono, double, std::int32_t>(doubles) != expected64) {
+            return detail::Fail(scenario, "Float64 samples were not clipped to the Int32 range");
+        }
+
+        // Packed 24-bit samples are converted by the generic loop rather than a built-in kernel
+        std::vector<unsigned char> int24(3 * floats.size());
+        PCMConverter<Float32Mono, audio_toolbox::Int24PCMFormat<1>>::Convert(floats.data(), int24.data(),
+                                                                             floats.size());
+        ToByteOrder(int24, 3, !audio_toolbox::detail::kNativeBigEndian);
+        const std::vector<unsigned char> expected24{0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xff,
+                                                    0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0x00};
+        if (int24 != expected24) {
+            return detail::Fail(scenario, "Float32 samples were not clipped to the Int24 range");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PCMConverterConvertsBufferLists() noexcept {
+    return detail::Run("PCMConverterConvertsBufferLists", [](const char *scenario) {
+        using Interleaved = audio_toolbox::Int16PCMFormat<2>;
+        using NonInterleaved = audio_toolbox::Float32PCMFormat<2, false>;
+
+        std::vector<std::int16_t> samples(2 * kFrameCount);
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            samples[i] = static_cast<std::int16_t>(i * 97 - 32768);
+        }
+        std::vector<float> expected(samples.size());
+        PCMConverter<Interleaved, audio_toolbox::Float32PCMFormat<2>>::Convert(samples.data(), expected.data(),
+                                                                              kFrameCount);
+
+        std::vector<float> left(kFrameCount + 1);
+        std::vector<float> right(kFrameCount + 1);
+        detail::BufferList input{1};
+        input.Set(0, samples.data(), static_cast<UInt32>(samples.size() * sizeof(std::int16_t)), 2);
+        detail::BufferList output{2};
+        output.Set(0, left.data(), static_cast<UInt32>(left.size() * sizeof(float)));
+        output.Set(1, right.data(), static_cast<UInt32>(right.size() * sizeof(float)));
+        PCMConverter<Interleaved, NonInterleaved>::ConvertComplexBuffer(kFrameCount, input.get(), output.get());
+        for (UInt32 frame = 0; frame < kFrameCount; ++frame) {
+            if (left[frame] != expected[2 * frame] || right[frame] != expected[2 * frame + 1]) {
+                return detail::Fail(scenario, "Deinterleaved samples differ from interleaved conversion");
+            }
+        }
+        for (UInt32 i = 0; i < 2; ++i) {
+            if (output.get()->mBuffers[i].mDataByteSize != kFrameCount * sizeof(float)) {
+                return detail::Fail(scenario, "The output buffer sizes were not set to the bytes written");
+            }
+        }
+
+        std::vector<std::int16_t> roundTrip(samples.size());
+        detail::BufferList interleaved{1};
+        interleaved.Set(0, roundTrip.data(), static_cast<UInt32>(roundTrip.size() * sizeof(std::int16_t)), 2);
+        PCMConverter<NonInterleaved, Interleaved>::ConvertComplexBuffer(kFrameCount, output.get(), interleaved.get());
+        if (roundTrip != samples) {
+            return detail::Fail(scenario, "Interleaving did not restore the original samples");
+        }
+
+        // Narrowing keeps the high bits of each sample
+        std::vector<unsigned char> wide(3 * kFrameCount);
+        for (std::size_t i = 0; i < wide.size(); ++i) {
+            wide[i] = static_cast<unsigned char>(i * 31);
+        }
+        std::vector<std::int16_t> narrow(kFrameCount);
+        detail::BufferList wideList{1};
+        wideList.Set(0, wide.data(), static_cast<UInt32>(wide.size()));
+        detail::BufferList narrowList{1};
+        narrowList.Set(0, narrow.data(), static_cast<UInt32>(narrow.size() * sizeof(std::int16_t)));
+        PCMConverter<audio_toolbox::Int24PCMFormat<1, false, false>,
+                     audio_toolbox::Int16PCMFormat<1, false>>::ConvertComplexBuffer(kFrameCount, wideList.get(),
+                                                                                    narrowList.get());
+        for (UInt32 frame = 0; frame < kFrameCount; ++frame) {
+            const auto expectedSample = static_cast<std::int16_t>(wide[3 * frame + 1] | (wide[3 * frame + 2] << 8));
+            if (narrow[frame] != expectedSample) {
+                return detail::Fail(scenario, "Narrowing did not keep the high bits");
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PCMConverterRejectsInvalidBuffers() noexcept {
+    return detail::Run("PCMConverterRejectsInvalidBuffers", [](const char *scenario) {
+        using Converter = PCMConverter<audio_toolbox::Int16PCMFormat<2>, audio_toolbox::Float32PCMFormat<2>>;
+
+        if (!ConvertBufferThrows<Converter>(4 * kFrameCount + 2, 8 * kFrameCount + 8,
+                                            kAudioConverterErr_InvalidInputSize)) {
+            return detail::Fail(scenario, "A partial input frame was accepted");
+        }
+        if (!ConvertBufferThrows<Converter>(4 * kFrameCount, 8 * kFrameCount - 1,
+                                            kAudioConverterErr_InvalidOutputSize)) {
+            return detail::Fail(scenario, "An undersized output buffer was accepted");
+        }
+
+        using ComplexConverter =
+                PCMConverter<audio_toolbox::Int16PCMFormat<2>, audio_toolbox::Float32PCMFormat<2, false>>;
+        std::vector<std::int16_t> samples(2 * kFrameCount);
+        std::vector<float> output(2 * kFrameCount);
+        detail::BufferList input{1};
+        input.Set(0, samples.data(), static_cast<UInt32>(samples.size() * sizeof(std::int16_t)), 2);
+
+        const struct {
+            UInt32 bufferCount_;
+            UInt32 byteSize_;
+            bool data_;
+        } invalidBuffers[] = {
+                {1, 2 * kFrameCount * sizeof(float), true},
+                {2, kFrameCount * sizeof(float) - 1, true},
+                {2, kFrameCount * sizeof(float), false},
+        };
+        for (const auto &invalidBuffer : invalidBuffers) {
+            detail::BufferList outputList{invalidBuffer.bufferCount_};
+            for (UInt32 i = 0; i < invalidBuffer.bufferCount_; ++i) {
+                outputList.Set(i, invalidBuffer.data_ ? output.data() + i * kFrameCount : nullptr,
+                               invalidBuffer.byteSize_);
+            }
+            try {
+                ComplexConverter::ConvertComplexBuffer(kFrameCount, input.get(), outputList.get());
+                return detail::Fail(scenario, "An unsuitable buffer list was accepted");
+            } catch (const std::system_error &e) {
+                if (e.code().value() != kAudio_ParamError) {
+                    return detail::Fail(scenario, "An unsuitable buffer list was not reported as kAudio_ParamError");
+                }
+            }
+        }
+
+        return true;
+    });
+}
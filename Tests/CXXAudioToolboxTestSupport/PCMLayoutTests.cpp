@@ -0,0 +1,196 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/PCMLayoutTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/CAAudioConverter.hpp>
+#include <audio_toolbox/PCMLayout.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+namespace pcm_layout = audio_toolbox::pcm_layout;
+
+/// Returns count random bytes.
+std::vector<unsigned char> MakeBytes(std::size_t count, unsigned seed) {
+    std::vector<unsigned char> bytes(count);
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<int> distribution{0, 255};
+    for (auto &byte : bytes) {
+        byte = static_cast<unsigned char>(distribution(generator));
+    }
+    return bytes;
+}
+
+/// Returns true if each channel holds the samples of its channel in an interleaved buffer.
+bool MatchesInterleaved(const std::vector<unsigned char> &interleaved,
+                        const std::vector<std::vector<unsigned char>> &channels, std::size_t bytesPerSample) {
+    const auto channelCount = channels.size();
+    for (std::size_t c = 0; c < channelCount; ++c) {
+        for (std::size_t f = 0; f * bytesPerSample < channels[c].size(); ++f) {
+            if (std::memcmp(channels[c].data() + f * bytesPerSample,
+                            interleaved.data() + (f * channelCount + c) * bytesPerSample, bytesPerSample) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} /* namespace */
+
+bool test_support::PCMLayoutRoundTripsEveryChannelCount() noexcept {
+    return detail::Run("PCMLayoutRoundTripsEveryChannelCount", [](const char *scenario) {
+        // Frame counts below, at, and above the vector block sizes exercise the kernels and their scalar tails
+        for (const auto bytesPerSample : {1U, 2U, 3U, 4U, 5U, 8U}) {
+            for (UInt32 channelCount = 1; channelCount <= 10; ++channelCount) {
+                for (const auto frameCount : {1U, 7U, 8U, 1021U}) {
+                    const auto interleaved =
+                            MakeBytes(static_cast<std::size_t>(frameCount) * channelCount * bytesPerSample,
+                                      bytesPerSample * 100 + channelCount);
+
+                    std::vector<std::vector<unsigned char>> channels(
+                            channelCount, std::vector<unsigned char>(frameCount * bytesPerSample));
+                    std::vector<void *> pointers;
+                    for (auto &channel : channels) {
+                        pointers.push_back(channel.data());
+                    }
+
+                    pcm_layout::Deinterleave(bytesPerSample, channelCount, frameCount, interleaved.data(),
+                                             pointers.data());
+                    if (!MatchesInterleaved(interleaved, channels, bytesPerSample)) {
+                        return detail::Fail(scenario, "Deinterleave produced the wrong samples");
+                    }
+
+                    std::vector<unsigned char> output(interleaved.size());
+                    pcm_layout::Interleave(bytesPerSample, channelCount, frameCount, pointers.data(), output.data());
+                    if (output != interleaved) {
+                        return detail::Fail(scenario, "Interleave did not restore the deinterleaved samples");
+                    }
+                }
+            }
+        }
+        return true;
+    });
+}
+
+bool test_support::PCMLayoutConvertsBufferLists() noexcept {
+    return detail::Run("PCMLayoutConvertsBufferLists", [](const char *scenario) {
+        // More channels than are kept on the stack exercise the allocated channel pointers
+        for (const auto channelCount : {6U, 8U, 40U}) {
+            constexpr UInt32 frameCount = 333;
+            const auto interleavedFormat = detail::MakeFloatFormat(44'100, channelCount);
+            const auto channelFormat = detail::MakeNonInterleaved(interleavedFormat);
+            const auto channelSize = frameCount * static_cast<UInt32>(sizeof(float));
+
+            auto interleaved = MakeBytes(static_cast<std::size_t>(channelSize) * channelCount, channelCount);
+            detail::BufferList interleavedList{1};
+            interleavedList.Set(0, interleaved.data(), static_cast<UInt32>(interleaved.size()), channelCount);
+
+            std::vector<std::vector<unsigned char>> channels(channelCount, std::vector<unsigned char>(channelSize));
+            detail::BufferList channelList{channelCount};
+            for (UInt32 c = 0; c < channelCount; ++c) {
+                channelList.Set(c, channels[c].data(), channelSize);
+            }
+
+            pcm_layout::Convert(interleavedFormat, channelFormat, frameCount, interleavedList.get(),
+                                channelList.get());
+            if (!MatchesInterleaved(interleaved, channels, sizeof(float))) {
+                return detail::Fail(scenario, "Deinterleaving produced the wrong samples");
+            }
+            for (UInt32 c = 0; c < channelCount; ++c) {
+                if (channelList.get()->mBuffers[c].mDataByteSize != channelSize) {
+                    return detail::Fail(scenario, "A channel buffer size was not set");
+                }
+            }
+
+            std::vector<unsigned char> output(interleaved.size());
+            detail::BufferList outputList{1};
+            outputList.Set(0, output.data(), static_cast<UInt32>(output.size()), channelCount);
+            pcm_layout::Convert(channelFormat, interleavedFormat, frameCount, channelList.get(), outputList.get());
+            if (output != interleaved || outputList.get()->mBuffers[0].mDataByteSize != output.size()) {
+                return detail::Fail(scenario, "Interleaving did not restore the deinterleaved samples");
+            }
+
+            // A buffer too small for the frames is rejected before anything is written
+            channelList.Set(channelCount - 1, channels.back().data(), channelSize - 1);
+            try {
+                pcm_layout::Convert(interleavedFormat, channelFormat, frameCount, interleavedList.get(),
+                                    channelList.get());
+                return detail::Fail(scenario, "An undersized buffer was accepted");
+            } catch (const std::system_error &) {
+            }
+        }
+
+        // Identical formats are not a layout conversion
+        const auto format = detail::MakeFloatFormat(44'100, 2);
+        std::vector<float> samples(4);
+        detail::BufferList input{1};
+        detail::BufferList output{1};
+        input.Set(0, samples.data(), sizeof(float) * 4, 2);
+        output.Set(0, samples.data(), sizeof(float) * 4, 2);
+        try {
+            pcm_layout::Convert(format, format, 2, input.get(), output.get());
+            return detail::Fail(scenario, "Identical formats were converted");
+        } catch (const std::system_error &) {
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PCMLayoutIdentifiesLayoutConversions() noexcept {
+    return detail::Run("PCMLayoutIdentifiesLayoutConversions", [](const char *scenario) {
+        const auto interleaved = detail::MakeFloatFormat(44'100, 6);
+        const auto nonInterleaved = detail::MakeNonInterleaved(interleaved);
+
+        if (!pcm_layout::IsLayoutConversion(interleaved, nonInterleaved) ||
+            !pcm_layout::IsLayoutConversion(nonInterleaved, interleaved)) {
+            return detail::Fail(scenario, "Formats differing only in interleaving were not a layout conversion");
+        }
+        if (pcm_layout::IsLayoutConversion(interleaved, interleaved) ||
+            pcm_layout::IsLayoutConversion(nonInterleaved, nonInterleaved)) {
+            return detail::Fail(scenario, "Identical formats were a layout conversion");
+        }
+        if (pcm_layout::IsLayoutConversion(detail::MakeInt16Format(44'100, 6, false), nonInterleaved)) {
+            return detail::Fail(scenario, "Formats with different samples were a layout conversion");
+        }
+        auto resampled = nonInterleaved;
+        resampled.mSampleRate = 48'000;
+        if (pcm_layout::IsLayoutConversion(interleaved, resampled)) {
+            return detail::Fail(scenario, "Formats with different sample rates were a layout conversion");
+        }
+
+        // CAAudioConverter reroutes ConvertComplexBuffer only for layout conversions and only when enabled
+        audio_toolbox::CAAudioConverter converter;
+        converter.New(interleaved, nonInterleaved);
+        if (converter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "The built-in kernels were used before being enabled");
+        }
+        converter.SetPCMFastPathEnabled(true);
+        if (!converter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "The built-in kernels were not used for a layout conversion");
+        }
+
+        audio_toolbox::CAAudioConverter identityConverter;
+        identityConverter.New(interleaved, interleaved);
+        identityConverter.SetPCMFastPathEnabled(true);
+        if (identityConverter.UsesPCMFastPath()) {
+            return detail::Fail(scenario, "The built-in kernels were used for identical formats");
+        }
+
+        return true;
+    });
+}
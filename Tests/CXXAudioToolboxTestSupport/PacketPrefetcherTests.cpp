@@ -0,0 +1,176 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/PacketPrefetcherTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/CAAudioFile.hpp>
+#include <audio_toolbox/PacketPrefetcher.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::CAAudioFile;
+using audio_toolbox::PacketPrefetcher;
+
+/// The number of frames in each test file.
+constexpr UInt32 kFrameCount = 44'100;
+
+/// Opens an audio file for reading.
+CAAudioFile OpenAudioFile(const std::string &path) {
+    const auto url = test_support::detail::CreateURL(path);
+    CAAudioFile file;
+    file.OpenURL(url.get(), kAudioFileReadPermission, 0);
+    return file;
+}
+
+/// Creates the test files, returning their paths.
+std::vector<std::string> CreateTestFiles(const test_support::detail::TemporaryDirectory &directory) {
+    const auto pcmPath = directory.Path("pcm.caf");
+    const auto aacPath = directory.Path("aac.m4a");
+    test_support::detail::WriteTestFile(pcmPath, kAudioFileCAFType,
+                                        test_support::detail::MakeInt16Format(44'100, 2, false), kFrameCount);
+    test_support::detail::WriteTestFile(
+            aacPath, kAudioFileM4AType, test_support::detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, 2),
+            kFrameCount);
+    return {pcmPath, aacPath};
+}
+
+/// Returns true if a chunk matches the packets read directly from an audio file.
+bool ChunkMatchesFile(const PacketPrefetcher::Chunk &chunk, CAAudioFile &file) {
+    UInt32 maximumPacketSize;
+    UInt32 size = sizeof maximumPacketSize;
+    file.GetProperty(kAudioFilePropertyMaximumPacketSize, size, &maximumPacketSize);
+
+    std::vector<unsigned char> data(static_cast<std::size_t>(maximumPacketSize) * chunk.packetCount_);
+    std::vector<AudioStreamPacketDescription> descriptions(chunk.packetCount_);
+    auto byteCount = static_cast<UInt32>(data.size());
+    auto packetCount = chunk.packetCount_;
+    const auto hasPacketDescriptions = !chunk.packetDescriptions_.empty();
+    file.ReadPacketData(false, byteCount, hasPacketDescriptions ? descriptions.data() : nullptr,
+                        chunk.startingPacket_, packetCount, data.data());
+
+    if (packetCount != chunk.packetCount_ || byteCount != chunk.byteCount_ ||
+        std::memcmp(data.data(), chunk.data_.data(), byteCount) != 0) {
+        return false;
+    }
+    for (UInt32 i = 0; hasPacketDescriptions && i < packetCount; ++i) {
+        const auto &expected = descriptions[i];
+        const auto &actual = chunk.packetDescriptions_[i];
+        if (expected.mStartOffset != actual.mStartOffset || expected.mDataByteSize != actual.mDataByteSize ||
+            expected.mVariableFramesInPacket != actual.mVariableFramesInPacket) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} /* namespace */
+
+bool test_support::PacketPrefetcherMatchesReadPacketData() noexcept {
+    return detail::Run("PacketPrefetcherMatchesReadPacketData", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        for (const auto &path : CreateTestFiles(directory)) {
+            auto reference = OpenAudioFile(path);
+            const auto packetCount = static_cast<SInt64>(reference.AudioDataPacketCount());
+
+            const std::pair<UInt32, UInt32> configurations[] = {{1, 1}, {7, 2}, {64, 4}, {4096, 3}};
+            for (const auto &[packetsPerChunk, chunksInFlight] : configurations) {
+                PacketPrefetcher prefetcher{OpenAudioFile(path), packetsPerChunk, chunksInFlight};
+                prefetcher.Start();
+
+                PacketPrefetcher::Chunk chunk;
+                SInt64 nextPacket = 0;
+                while (prefetcher.ReadNext(chunk)) {
+                    if (chunk.startingPacket_ != nextPacket || chunk.packetCount_ == 0 ||
+                        chunk.packetCount_ > packetsPerChunk) {
+                        return detail::Fail(scenario, "Chunks are not contiguous or exceed the chunk size");
+                    }
+                    if (!ChunkMatchesFile(chunk, reference)) {
+                        return detail::Fail(scenario, "A chunk does not match ReadPacketData");
+                    }
+                    nextPacket += chunk.packetCount_;
+                }
+
+                if (nextPacket != packetCount) {
+                    return detail::Fail(scenario, "The chunks do not cover the file");
+                }
+                if (prefetcher.ReadNext(chunk)) {
+                    return detail::Fail(scenario, "A chunk was returned after end of file");
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PacketPrefetcherRestarts() noexcept {
+    return detail::Run("PacketPrefetcherRestarts", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        for (const auto &path : CreateTestFiles(directory)) {
+            auto reference = OpenAudioFile(path);
+            const auto packetCount = static_cast<SInt64>(reference.AudioDataPacketCount());
+
+            PacketPrefetcher prefetcher{OpenAudioFile(path), 5, 3};
+            PacketPrefetcher::Chunk chunk;
+
+            // Restart repeatedly while chunks are queued, including at and past the end of the file
+            for (const auto startingPacket : {SInt64{0}, packetCount / 2, SInt64{3}, packetCount - 1, packetCount}) {
+                prefetcher.Start(startingPacket);
+                if (startingPacket == packetCount) {
+                    if (prefetcher.ReadNext(chunk)) {
+                        return detail::Fail(scenario, "A chunk was returned when starting at end of file");
+                    }
+                    continue;
+                }
+                for (auto i = 0; i < 2 && startingPacket + i * 5 < packetCount; ++i) {
+                    if (!prefetcher.ReadNext(chunk) || chunk.startingPacket_ != startingPacket + i * 5) {
+                        return detail::Fail(scenario, "A restarted prefetcher did not resume at the requested packet");
+                    }
+                    if (!ChunkMatchesFile(chunk, reference)) {
+                        return detail::Fail(scenario, "A chunk does not match ReadPacketData");
+                    }
+                }
+            }
+
+            prefetcher.Start(1);
+            prefetcher.Stop();
+            if (prefetcher.ReadNext(chunk)) {
+                return detail::Fail(scenario, "A chunk was returned after stopping");
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PacketPrefetcherRejectsInvalidArguments() noexcept {
+    return detail::Run("PacketPrefetcherRejectsInvalidArguments", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = CreateTestFiles(directory).front();
+
+        const std::pair<UInt32, UInt32> configurations[] = {{0, 1}, {1, 0}, {UINT32_MAX, 1}};
+        for (const auto &[packetsPerChunk, chunksInFlight] : configurations) {
+            try {
+                PacketPrefetcher prefetcher{OpenAudioFile(path), packetsPerChunk, chunksInFlight};
+                return detail::Fail(scenario, "Invalid arguments were accepted");
+            } catch (const std::invalid_argument &) {
+            }
+        }
+
+        return true;
+    });
+}
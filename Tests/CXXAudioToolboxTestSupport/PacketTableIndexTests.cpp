@@ -0,0 +1,261 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/PacketTableIndexTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/CAAudioFile.hpp>
+#include <audio_toolbox/PacketTableIndex.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using audio_toolbox::CAAudioFile;
+using audio_toolbox::PacketTableIndex;
+
+/// The number of frames in each test file.
+constexpr UInt32 kFrameCount = 44'100;
+
+/// The size of a sidecar header.
+constexpr off_t kSidecarHeaderSize = 48;
+/// The offset of the byte-order marker in a sidecar header.
+constexpr long kByteOrderMarkOffset = 44;
+
+/// Opens an audio file for reading.
+CAAudioFile OpenAudioFile(const std::string &path) {
+    const auto url = test_support::detail::CreateURL(path);
+    CAAudioFile file;
+    file.OpenURL(url.get(), kAudioFileReadPermission, 0);
+    return file;
+}
+
+/// Builds an index of an audio file.
+PacketTableIndex BuildIndex(const std::string &path) {
+    auto file = OpenAudioFile(path);
+    PacketTableIndex index;
+    index.Build(file, PacketTableIndex::FileIdentity::ForFile(path.c_str()));
+    return index;
+}
+
+/// Returns true if two packet descriptions are equal.
+bool operator==(const AudioStreamPacketDescription &lhs, const AudioStreamPacketDescription &rhs) noexcept {
+    return lhs.mStartOffset == rhs.mStartOffset && lhs.mDataByteSize == rhs.mDataByteSize &&
+           lhs.mVariableFramesInPacket == rhs.mVariableFramesInPacket;
+}
+
+/// Compares the packet descriptions of an index against those read from the file it describes.
+bool MatchesPacketDescriptions(const char *scenario, const PacketTableIndex &index, const std::string &path) {
+    auto file = OpenAudioFile(path);
+    const auto format = file.DataFormat();
+    if (format.mBytesPerPacket != 0) {
+        // Constant bit rate audio has no packet descriptions, so compare byte offsets only
+        for (UInt64 packet = 0; packet <= index.PacketCount(); ++packet) {
+            if (index.ByteOffsetForPacket(packet) != packet * format.mBytesPerPacket) {
+                return test_support::detail::Fail(scenario, "A packet byte offset is incorrect");
+            }
+        }
+        return true;
+    }
+
+    UInt32 maximumPacketSize;
+    UInt32 size = sizeof maximumPacketSize;
+    file.GetProperty(kAudioFilePropertyMaximumPacketSize, size, &maximumPacketSize);
+
+    // Deliberately unaligned with the end of the file to exercise a short final read
+    constexpr UInt32 packetsPerRead = 37;
+    std::vector<unsigned char> data(static_cast<std::size_t>(maximumPacketSize) * packetsPerRead);
+    std::vector<AudioStreamPacketDescription> expected(packetsPerRead);
+    std::vector<AudioStreamPacketDescription> actual(packetsPerRead);
+
+    for (UInt64 packet = 0; packet < index.PacketCount(); packet += packetsPerRead) {
+        auto byteCount = static_cast<UInt32>(data.size());
+        auto expectedCount = packetsPerRead;
+        file.ReadPacketData(false, byteCount, expected.data(), static_cast<SInt64>(packet), expectedCount, data.data());
+
+        auto actualCount = packetsPerRead;
+        const auto actualByteCount = index.GetPacketDescriptions(packet, actualCount, actual.data());
+        if (actualCount != expectedCount || actualByteCount != byteCount) {
+            return test_support::detail::Fail(scenario, "The number of described packets or bytes is incorrect");
+        }
+        for (UInt32 i = 0; i < actualCount; ++i) {
+            if (!(actual[i] == expected[i])) {
+                return test_support::detail::Fail(scenario, "A packet description does not match ReadPacketData");
+            }
+        }
+    }
+
+    auto count = packetsPerRead;
+    if (index.GetPacketDescriptions(index.PacketCount(), count, actual.data()) != 0 || count != 0) {
+        return test_support::detail::Fail(scenario, "Packets past the end of the audio were described");
+    }
+    return true;
+}
+
+/// Returns true if two indexes describe the same packets.
+bool IndexesMatch(const PacketTableIndex &lhs, const PacketTableIndex &rhs) noexcept {
+    if (lhs.Identity() != rhs.Identity() || lhs.PacketCount() != rhs.PacketCount() ||
+        lhs.FrameCount() != rhs.FrameCount()) {
+        return false;
+    }
+    for (UInt64 packet = 0; packet <= lhs.PacketCount(); ++packet) {
+        if (lhs.ByteOffsetForPacket(packet) != rhs.ByteOffsetForPacket(packet) ||
+            lhs.FrameForPacket(packet) != rhs.FrameForPacket(packet)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Overwrites bytes of a file at an offset.
+void Patch(const std::string &path, long offset, const void *data, std::size_t size) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> file{std::fopen(path.c_str(), "r+b"), &std::fclose};
+    if (!file || std::fseek(file.get(), offset, SEEK_SET) != 0 || std::fwrite(data, size, 1, file.get()) != 1) {
+        throw std::system_error(errno, std::generic_category(), "fwrite");
+    }
+}
+
+/// Truncates a file to a size.
+void Truncate(const std::string &path, off_t size) {
+    if (::truncate(path.c_str(), size) != 0) {
+        throw std::system_error(errno, std::generic_category(), "truncate");
+    }
+}
+
+} /* namespace */
+
+bool test_support::PacketTableIndexRoundTrips() noexcept {
+    return detail::Run("PacketTableIndexRoundTrips", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto pcmPath = directory.Path("pcm.caf");
+        const auto aacPath = directory.Path("aac.m4a");
+        detail::WriteTestFile(pcmPath, kAudioFileCAFType, detail::MakeInt16Format(44'100, 2, false), kFrameCount);
+        detail::WriteTestFile(aacPath, kAudioFileM4AType, detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, 2),
+                              kFrameCount);
+
+        for (const auto &path : {pcmPath, aacPath}) {
+            const auto built = BuildIndex(path);
+            if (!built || built.FrameCount() < kFrameCount) {
+                return detail::Fail(scenario, "A built index does not cover the audio");
+            }
+            if (!MatchesPacketDescriptions(scenario, built, path)) {
+                return false;
+            }
+
+            const auto sidecarPath = path + ".index";
+            built.Save(sidecarPath.c_str());
+
+            PacketTableIndex loaded;
+            if (!loaded.Load(sidecarPath.c_str(), PacketTableIndex::FileIdentity::ForFile(path.c_str()))) {
+                return detail::Fail(scenario, "A saved index was not loaded");
+            }
+            if (!IndexesMatch(built, loaded)) {
+                return detail::Fail(scenario, "A loaded index differs from the saved index");
+            }
+            if (!MatchesPacketDescriptions(scenario, loaded, path)) {
+                return false;
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PacketTableIndexRejectsInvalidSidecars() noexcept {
+    return detail::Run("PacketTableIndexRejectsInvalidSidecars", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("aac.m4a");
+        const auto sidecarPath = directory.Path("aac.m4a.index");
+        detail::WriteTestFile(path, kAudioFileM4AType, detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, 2),
+                              kFrameCount);
+        const auto identity = PacketTableIndex::FileIdentity::ForFile(path.c_str());
+
+        PacketTableIndex index;
+        if (index.Load(sidecarPath.c_str(), identity)) {
+            return detail::Fail(scenario, "A missing sidecar was loaded");
+        }
+
+        BuildIndex(path).Save(sidecarPath.c_str());
+
+        auto stale = identity;
+        ++stale.modificationTime_;
+        if (index.Load(sidecarPath.c_str(), stale)) {
+            return detail::Fail(scenario, "A sidecar with a different modification time was loaded");
+        }
+        stale = identity;
+        stale.contentHash_ ^= 1;
+        if (index.Load(sidecarPath.c_str(), stale)) {
+            return detail::Fail(scenario, "A sidecar with a different content hash was loaded");
+        }
+        if (index) {
+            return detail::Fail(scenario, "A rejected sidecar left packets in the index");
+        }
+
+        // A sidecar written on a host of the other byte order reads its byte-order marker swapped
+        const UInt32 swappedByteOrderMark = 0x04030201;
+        Patch(sidecarPath, kByteOrderMarkOffset, &swappedByteOrderMark, sizeof swappedByteOrderMark);
+        if (index.Load(sidecarPath.c_str(), identity)) {
+            return detail::Fail(scenario, "A sidecar in the other byte order was loaded");
+        }
+
+        BuildIndex(path).Save(sidecarPath.c_str());
+        if (!index.Load(sidecarPath.c_str(), identity)) {
+            return detail::Fail(scenario, "A rewritten sidecar was not loaded");
+        }
+        index.Clear();
+
+        Truncate(sidecarPath, kSidecarHeaderSize + sizeof(UInt64));
+        if (index.Load(sidecarPath.c_str(), identity)) {
+            return detail::Fail(scenario, "A truncated sidecar was loaded");
+        }
+        Truncate(sidecarPath, 16);
+        if (index.Load(sidecarPath.c_str(), identity)) {
+            return detail::Fail(scenario, "A sidecar shorter than its header was loaded");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PacketTableIndexMapsFramesToPackets() noexcept {
+    return detail::Run("PacketTableIndexMapsFramesToPackets", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto pcmPath = directory.Path("pcm.caf");
+        const auto aacPath = directory.Path("aac.m4a");
+        detail::WriteTestFile(pcmPath, kAudioFileCAFType, detail::MakeInt16Format(44'100, 1, true), kFrameCount);
+        detail::WriteTestFile(aacPath, kAudioFileM4AType, detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, 1),
+                              kFrameCount);
+
+        for (const auto &path : {pcmPath, aacPath}) {
+            const auto index = BuildIndex(path);
+            for (UInt64 packet = 0; packet < index.PacketCount(); ++packet) {
+                const auto first = index.FrameForPacket(packet);
+                const auto last = index.FrameForPacket(packet + 1) - 1;
+                if (index.PacketForFrame(first) != packet || index.PacketForFrame(last) != packet ||
+                    index.PacketForFrame(first + (last - first) / 2) != packet) {
+                    return detail::Fail(scenario, "A frame does not map to the packet containing it");
+                }
+            }
+            if (index.PacketForFrame(index.FrameCount()) != index.PacketCount() ||
+                index.PacketForFrame(UINT64_MAX) != index.PacketCount()) {
+                return detail::Fail(scenario, "A frame past the end of the audio does not map to PacketCount()");
+            }
+        }
+
+        return true;
+    });
+}
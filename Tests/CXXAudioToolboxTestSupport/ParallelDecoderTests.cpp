@@ -0,0 +1,170 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/ParallelDecoderTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/ParallelDecoder.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::ParallelDecoder;
+
+/// The number of frames in the decoded files.
+constexpr UInt32 kFrameCount = 100'000;
+
+/// The number of channels in the decoded files.
+constexpr UInt32 kChannels = 2;
+
+/// Decodes a file with a parallel decoder into a buffer of capacity frames in a client format and returns the bytes
+/// decoded, interleaving non-interleaved output so it compares with a sequential decode.
+std::vector<unsigned char> DecodeInParallel(ParallelDecoder &decoder, const std::string &path,
+                                            const AudioStreamBasicDescription &clientFormat, UInt32 capacity) {
+    const auto nonInterleaved = (clientFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0;
+    const auto bufferCount = nonInterleaved ? clientFormat.mChannelsPerFrame : 1;
+    const auto bufferSize = capacity * clientFormat.mBytesPerFrame;
+
+    std::vector<std::vector<unsigned char>> buffers(bufferCount, std::vector<unsigned char>(bufferSize));
+    test_support::detail::BufferList bufferList{bufferCount};
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        bufferList.Set(i, buffers[i].data(), bufferSize, nonInterleaved ? 1 : clientFormat.mChannelsPerFrame);
+    }
+
+    const auto url = test_support::detail::CreateURL(path);
+    const auto frames = static_cast<std::size_t>(decoder.Decode(url.get(), clientFormat, bufferList.get()));
+    for (UInt32 i = 0; i < bufferCount; ++i) {
+        if (bufferList.get()->mBuffers[i].mDataByteSize != frames * clientFormat.mBytesPerFrame) {
+            throw std::logic_error("The buffer sizes do not match the frames decoded");
+        }
+    }
+    if (!nonInterleaved) {
+        buffers[0].resize(frames * clientFormat.mBytesPerFrame);
+        return buffers[0];
+    }
+
+    const auto sampleSize = clientFormat.mBytesPerFrame;
+    std::vector<unsigned char> interleaved(frames * sampleSize * bufferCount);
+    for (std::size_t frame = 0; frame < frames; ++frame) {
+        for (UInt32 channel = 0; channel < bufferCount; ++channel) {
+            std::memcpy(interleaved.data() + (frame * bufferCount + channel) * sampleSize,
+                        buffers[channel].data() + frame * sampleSize, sampleSize);
+        }
+    }
+    return interleaved;
+}
+
+} /* namespace */
+
+bool test_support::ParallelDecoderMatchesSequentialDecode() noexcept {
+    return detail::Run("ParallelDecoderMatchesSequentialDecode", [](const char *scenario) {
+        struct Case {
+            /// The file name.
+            const char *name_;
+            /// The file type.
+            AudioFileTypeID fileType_;
+            /// The file data format.
+            AudioStreamBasicDescription format_;
+            /// The pre-roll lengths to decode with.
+            std::vector<SInt64> prerollFrames_;
+        };
+        // AAC packets depend on their predecessors, so only sufficient pre-roll reproduces a sequential decode
+        const Case cases[] = {
+                {"pcm.caf", kAudioFileCAFType, detail::MakeInt16Format(44'100, kChannels, false), {0, 1, 4096}},
+                {"aac.m4a", kAudioFileM4AType, detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, kChannels),
+                 {4096, 8192}},
+        };
+        const auto interleaved = detail::MakeFloatFormat(44'100, kChannels);
+        const AudioStreamBasicDescription clientFormats[] = {interleaved, detail::MakeNonInterleaved(interleaved)};
+
+        // Segments shorter than, equal to, and not dividing the file, and longer than the file
+        constexpr SInt64 segmentSizes[] = {1'000, 4'096, 33'333, kFrameCount, 2 * kFrameCount};
+
+        detail::TemporaryDirectory directory;
+        for (const auto &testCase : cases) {
+            const auto path = directory.Path(testCase.name_);
+            detail::WriteTestFile(path, testCase.fileType_, testCase.format_, kFrameCount);
+
+            const auto sequential = detail::DecodeFile(path, interleaved);
+            const auto capacity = static_cast<UInt32>(sequential.size() / interleaved.mBytesPerFrame);
+
+            for (const auto &clientFormat : clientFormats) {
+                for (const auto threadCount : {1U, 4U}) {
+                    for (const auto segmentFrames : segmentSizes) {
+                        for (const auto prerollFrames : testCase.prerollFrames_) {
+                            ParallelDecoder decoder{threadCount, segmentFrames, prerollFrames};
+                            const auto parallel = DecodeInParallel(decoder, path, clientFormat, capacity);
+                            if (parallel.size() != sequential.size() ||
+                                std::memcmp(parallel.data(), sequential.data(), sequential.size()) != 0) {
+                                return detail::Fail(scenario, "The parallel decode differs from the sequential decode");
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::ParallelDecoderRejectsInvalidArguments() noexcept {
+    return detail::Run("ParallelDecoderRejectsInvalidArguments", [](const char *scenario) {
+        for (const auto &[segmentFrames, prerollFrames] : {std::pair<SInt64, SInt64>{0, 0}, {-1, 0}, {1, -1}}) {
+            try {
+                ParallelDecoder decoder{1, segmentFrames, prerollFrames};
+                return detail::Fail(scenario, "Invalid segment or pre-roll lengths were accepted");
+            } catch (const std::invalid_argument &) {
+            }
+        }
+
+        detail::TemporaryDirectory directory;
+        const auto path = directory.Path("pcm.caf");
+        detail::WriteTestFile(path, kAudioFileCAFType, detail::MakeInt16Format(44'100, kChannels, false), 1'000);
+        const auto clientFormat = detail::MakeFloatFormat(44'100, kChannels);
+
+        auto resampled = clientFormat;
+        resampled.mSampleRate = 48'000;
+        const struct {
+            AudioStreamBasicDescription clientFormat_;
+            UInt32 capacity_;
+        } invalidCases[] = {
+                {detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, kChannels), 1'000},
+                {detail::MakeNonInterleaved(clientFormat), 1'000},
+                {resampled, 1'000},
+                {clientFormat, 999},
+        };
+
+        // The buffer list always has one interleaved buffer, which does not suit a non-interleaved format
+        const auto url = detail::CreateURL(path);
+        std::vector<float> samples(1'000 * kChannels);
+        ParallelDecoder decoder{2, 100, 10};
+        for (const auto &invalidCase : invalidCases) {
+            detail::BufferList bufferList{1};
+            bufferList.Set(0, samples.data(), invalidCase.capacity_ * clientFormat.mBytesPerFrame, kChannels);
+            try {
+                static_cast<void>(decoder.Decode(url.get(), invalidCase.clientFormat_, bufferList.get()));
+                return detail::Fail(scenario, "An unsuitable client data format or buffer list was accepted");
+            } catch (const std::system_error &e) {
+                if (e.code() != std::make_error_code(std::errc::invalid_argument)) {
+                    return detail::Fail(scenario, "An unsuitable argument was reported with the wrong error");
+                }
+            }
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,286 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/ParameterAutomationTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/CAAUGraph.hpp>
+#include <audio_toolbox/ParameterAutomation.hpp>
+
+#include "ParameterEventQueue.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Returns an event changing a global parameter.
+audio_toolbox::ParameterAutomation::Event MakeEvent(Float64 sampleTime) {
+    audio_toolbox::ParameterAutomation::Event event;
+    event.sampleTime_ = sampleTime;
+    event.value_ = 1;
+    return event;
+}
+
+/// Returns true if a parameter event is an immediate change of value at bufferOffset.
+bool IsImmediate(const AudioUnitParameterEvent &event, UInt32 bufferOffset, AudioUnitParameterValue value) noexcept {
+    return event.eventType == kParameterEvent_Immediate && event.eventValues.immediate.bufferOffset == bufferOffset &&
+           event.eventValues.immediate.value == value;
+}
+
+} /* namespace */
+
+bool test_support::ParameterAutomationCountsOverflows() noexcept {
+    return detail::Run("ParameterAutomationCountsOverflows", [](const char *scenario) {
+        audio_toolbox::CAAUGraph graph;
+        const auto node = detail::MakeGenericOutputGraph(graph);
+
+        // The capacity is rounded up to a power of two
+        audio_toolbox::ParameterAutomation automation{graph, {node}, 5};
+        if (automation.Capacity() != 8) {
+            return detail::Fail(scenario, "The capacity was not rounded up to a power of two");
+        }
+
+        for (UInt32 i = 0; i < automation.Capacity(); ++i) {
+            if (!automation.Schedule(node, MakeEvent(i))) {
+                return detail::Fail(scenario, "An event was rejected before the queue was full");
+            }
+        }
+        for (UInt32 i = 0; i < 3; ++i) {
+            if (automation.Schedule(node, MakeEvent(i))) {
+                return detail::Fail(scenario, "An event was accepted by a full queue");
+            }
+        }
+
+        // Events for nodes that are not automated are rejected without counting as overflows
+        if (automation.Schedule(node + 1, MakeEvent(0))) {
+            return detail::Fail(scenario, "An event was accepted for a node that is not automated");
+        }
+
+        const auto statistics = automation.GetStatistics();
+        if (statistics.scheduled_ != automation.Capacity() || statistics.overflows_ != 3) {
+            return detail::Fail(scenario, "The scheduled and overflow counts are incorrect");
+        }
+        if (statistics.applied_ != 0) {
+            return detail::Fail(scenario, "Events were applied without rendering");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::ParameterAutomationBoundsConcurrentProducers() noexcept {
+    return detail::Run("ParameterAutomationBoundsConcurrentProducers", [](const char *scenario) {
+        constexpr unsigned threadCount = 8;
+        constexpr unsigned eventsPerThread = 1000;
+        constexpr UInt32 capacity = 256;
+
+        audio_toolbox::CAAUGraph graph;
+        const auto node = detail::MakeGenericOutputGraph(graph);
+        audio_toolbox::ParameterAutomation automation{graph, {node}, capacity};
+
+        std::atomic_uint64_t accepted{0};
+        std::atomic_uint64_t rejected{0};
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                for (unsigned i = 0; i < eventsPerThread; ++i) {
+                    if (automation.Schedule(node, MakeEvent(t * eventsPerThread + i))) {
+                        accepted.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        rejected.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (accepted != capacity || rejected != threadCount * eventsPerThread - capacity) {
+            return detail::Fail(scenario, "The queue did not accept exactly its capacity");
+        }
+
+        const auto statistics = automation.GetStatistics();
+        if (statistics.scheduled_ != accepted || statistics.overflows_ != rejected) {
+            return detail::Fail(scenario, "The statistics do not match the results of Schedule()");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::ParameterAutomationSplitsDueEvents() noexcept {
+    return detail::Run("ParameterAutomationSplitsDueEvents", [](const char *scenario) {
+        using audio_toolbox::detail::SplitDueEvents;
+
+        // The slice spans sample times [1000, 1512)
+        std::vector<audio_toolbox::ParameterAutomation::Event> events;
+        for (const auto sampleTime :
+             {990., 1000., 1512., 1511.5, std::numeric_limits<Float64>::quiet_NaN(), 2000., 1200.9}) {
+            events.push_back(MakeEvent(sampleTime));
+            events.back().value_ = static_cast<AudioUnitParameterValue>(events.size());
+        }
+        events[1].parameter_ = 7;
+        events[1].scope_ = kAudioUnitScope_Input;
+        events[1].element_ = 3;
+
+        std::vector<AudioUnitParameterEvent> parameterEvents(events.size());
+        const auto split = SplitDueEvents(events.data(), static_cast<UInt32>(events.size()), 1000, 512,
+                                          parameterEvents.data());
+        if (split.due_ != 5 || split.held_ != 2 || split.late_ != 2) {
+            return detail::Fail(scenario, "The events were not split into due, held, and late events");
+        }
+
+        // Late events, including NaN sample times, are applied at the start of the slice
+        if (!IsImmediate(parameterEvents[0], 0, 1) || !IsImmediate(parameterEvents[1], 0, 2) ||
+            !IsImmediate(parameterEvents[2], 511, 4) || !IsImmediate(parameterEvents[3], 0, 5) ||
+            !IsImmediate(parameterEvents[4], 200, 7)) {
+            return detail::Fail(scenario, "The due events or their buffer offsets are incorrect");
+        }
+        const auto &parameterEvent = parameterEvents[1];
+        if (parameterEvent.parameter != 7 || parameterEvent.scope != kAudioUnitScope_Input ||
+            parameterEvent.element != 3) {
+            return detail::Fail(scenario, "The parameter, scope, or element was not copied");
+        }
+        if (events[0].sampleTime_ != 1512 || events[1].sampleTime_ != 2000) {
+            return detail::Fail(scenario, "The held events were not moved to the start in order");
+        }
+
+        // 0.7 + 3 rounds up, so the last event before the end of the slice is at offset 3 before clamping
+        const Float64 sampleTime = .7;
+        auto lastFrame = MakeEvent(std::nextafter(sampleTime + 3, 0.));
+        AudioUnitParameterEvent clamped;
+        const auto clampedSplit = SplitDueEvents(&lastFrame, 1, sampleTime, 3, &clamped);
+        if (clampedSplit.due_ != 1 || !IsImmediate(clamped, 2, 1)) {
+            return detail::Fail(scenario, "The buffer offset was not clamped to the last frame");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::ParameterEventQueueReusesSlots() noexcept {
+    return detail::Run("ParameterEventQueueReusesSlots", [](const char *scenario) {
+        constexpr UInt32 capacity = 4;
+        audio_toolbox::detail::ParameterEventQueue queue{capacity};
+        AudioUnitParameterEvent parameterEvents[capacity];
+
+        // Each round advances the tickets by less than the capacity so the slots in use wrap around
+        AudioUnitParameterValue next = 0;
+        AudioUnitParameterValue expected = 0;
+        for (auto round = 0; round < 25; ++round) {
+            for (auto i = 0; i < 3; ++i) {
+                auto event = MakeEvent(0);
+                event.value_ = next++;
+                if (!queue.Push(event)) {
+                    return detail::Fail(scenario, "An event was rejected by a queue with space");
+                }
+            }
+            queue.Drain();
+            const auto split = queue.Split(0, 1, parameterEvents);
+            if (split.due_ != 3 || queue.PendingCount() != 0) {
+                return detail::Fail(scenario, "The queued events were not drained");
+            }
+            for (UInt32 i = 0; i < split.due_; ++i) {
+                if (!IsImmediate(parameterEvents[i], 0, expected++)) {
+                    return detail::Fail(scenario, "A reused slot returned the wrong event");
+                }
+            }
+        }
+
+        // Space is released only as events are drained, and draining stops when the pending list is full
+        for (UInt32 i = 0; i < capacity; ++i) {
+            queue.Push(MakeEvent(0));
+        }
+        if (queue.Push(MakeEvent(0))) {
+            return detail::Fail(scenario, "An event was accepted by a full queue");
+        }
+        queue.Drain();
+        for (UInt32 i = 0; i < capacity; ++i) {
+            if (!queue.Push(MakeEvent(1))) {
+                return detail::Fail(scenario, "Draining did not release space in the queue");
+            }
+        }
+        queue.Drain();
+        if (queue.PendingCount() != capacity || queue.Push(MakeEvent(2))) {
+            return detail::Fail(scenario, "The pending list exceeded its capacity");
+        }
+        if (queue.Split(0, 1, parameterEvents).due_ != capacity) {
+            return detail::Fail(scenario, "The pending events were not due");
+        }
+        queue.Drain();
+        if (queue.PendingCount() != capacity || queue.Split(0, 1, parameterEvents).held_ != capacity) {
+            return detail::Fail(scenario, "Events due in a later slice were not held");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::ParameterEventQueueDrainsConcurrentProducers() noexcept {
+    return detail::Run("ParameterEventQueueDrainsConcurrentProducers", [](const char *scenario) {
+        constexpr unsigned threadCount = 4;
+        constexpr unsigned eventsPerThread = 20000;
+        constexpr UInt32 capacity = 64;
+
+        audio_toolbox::detail::ParameterEventQueue queue{capacity};
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                for (unsigned i = 0; i < eventsPerThread;) {
+                    auto event = MakeEvent(0);
+                    event.element_ = t;
+                    event.value_ = static_cast<AudioUnitParameterValue>(i);
+                    if (queue.Push(event)) {
+                        ++i;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        // Each producer's events are drained exactly once and in the order they were queued
+        AudioUnitParameterEvent parameterEvents[capacity];
+        std::vector<unsigned> received(threadCount, 0);
+        bool ordered = true;
+        for (unsigned total = 0; total < threadCount * eventsPerThread;) {
+            queue.Drain();
+            const auto split = queue.Split(0, 1, parameterEvents);
+            for (UInt32 i = 0; i < split.due_; ++i) {
+                const auto &parameterEvent = parameterEvents[i];
+                if (parameterEvent.element >= threadCount) {
+                    ordered = false;
+                    continue;
+                }
+                auto &count = received[parameterEvent.element];
+                ordered = ordered && parameterEvent.eventValues.immediate.value == static_cast<float>(count);
+                ++count;
+            }
+            total += split.due_;
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (!ordered) {
+            return detail::Fail(scenario, "Events were drained out of order, duplicated, or lost");
+        }
+        queue.Drain();
+        if (queue.PendingCount() != 0) {
+            return detail::Fail(scenario, "Events were drained more than once");
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,308 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/PolyphaseResamplerTests.hpp"
+
+#include "Expect.hpp"
+
+#include <audio_toolbox/PolyphaseResampler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Quality = audio_toolbox::PolyphaseResampler::Quality;
+
+constexpr double kPi = 3.14159265358979323846;
+
+/// Returns a native-endian interleaved 32-bit float linear PCM format.
+AudioStreamBasicDescription MakeFormat(Float64 sampleRate, UInt32 channels) {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = sampleRate;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagsNativeFloatPacked;
+    format.mBytesPerFrame = sizeof(float) * channels;
+    format.mFramesPerPacket = 1;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    format.mChannelsPerFrame = channels;
+    format.mBitsPerChannel = 32;
+    return format;
+}
+
+/// Input supplied to a resampler from a buffer of interleaved samples.
+struct Source {
+    /// The interleaved samples.
+    std::vector<float> samples_;
+    /// The number of channels.
+    UInt32 channels_{1};
+    /// The index of the next frame to supply.
+    std::size_t position_{0};
+
+    /// Supplies up to *ioNumberDataPackets frames and signals end of stream once all frames are supplied.
+    static OSStatus InputProc(AudioConverterRef, UInt32 *ioNumberDataPackets, AudioBufferList *ioData,
+                              AudioStreamPacketDescription *_Nullable *_Nullable, void *inUserData) noexcept {
+        auto &source = *static_cast<Source *>(inUserData);
+        const auto frames = source.samples_.size() / source.channels_;
+        const auto frameCount = std::min<std::size_t>(*ioNumberDataPackets, frames - source.position_);
+
+        ioData->mBuffers[0].mData = source.samples_.data() + source.position_ * source.channels_;
+        ioData->mBuffers[0].mDataByteSize = static_cast<UInt32>(frameCount * source.channels_ * sizeof(float));
+        *ioNumberDataPackets = static_cast<UInt32>(frameCount);
+
+        source.position_ += frameCount;
+        return noErr;
+    }
+};
+
+/// Resamples all of a source's frames, requesting at most chunkFrames frames per call, and returns the output.
+std::vector<float> Resample(audio_toolbox::PolyphaseResampler &resampler, Source &source, UInt32 chunkFrames) {
+    const auto channels = resampler.DestinationFormat().mChannelsPerFrame;
+    std::vector<float> output;
+    std::vector<float> chunk(static_cast<std::size_t>(chunkFrames) * channels);
+
+    for (;;) {
+        AudioBufferList bufferList{};
+        bufferList.mNumberBuffers = 1;
+        bufferList.mBuffers[0].mNumberChannels = channels;
+        bufferList.mBuffers[0].mData = chunk.data();
+        bufferList.mBuffers[0].mDataByteSize = static_cast<UInt32>(chunk.size() * sizeof(float));
+
+        auto frameCount = chunkFrames;
+        resampler.FillComplexBuffer(Source::InputProc, &source, frameCount, &bufferList);
+        output.insert(output.end(), chunk.begin(), chunk.begin() + frameCount * channels);
+        if (frameCount < chunkFrames) {
+            return output;
+        }
+    }
+}
+
+/// Returns a sine wave of frequency hertz sampled at sampleRate.
+std::vector<float> MakeSine(double frequency, double sampleRate, std::size_t frameCount) {
+    std::vector<float> samples(frameCount);
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        samples[i] = static_cast<float>(0.5 * std::sin(2 * kPi * frequency * static_cast<double>(i) / sampleRate));
+    }
+    return samples;
+}
+
+/// Returns the stopband attenuation a quality tier guarantees, in decibels.
+double StopbandAttenuation(Quality quality) noexcept {
+    switch (quality) {
+    case Quality::low:
+        return 60;
+    case Quality::medium:
+        return 85;
+    case Quality::high:
+        return 100;
+    case Quality::maximum:
+        return 130;
+    }
+    return 0;
+}
+
+/// Resamples a sine wave of amplitude 0.5 and returns the output, excluding frames whose filter window extends past
+/// either end of the input.
+std::vector<float> ResampleSine(double frequency, Float64 from, Float64 to, Quality quality) {
+    audio_toolbox::PolyphaseResampler resampler;
+    resampler.New(MakeFormat(from, 1), MakeFormat(to, 1), quality);
+
+    Source source;
+    source.samples_ = MakeSine(frequency, from, static_cast<std::size_t>(from / 2));
+    auto output = Resample(resampler, source, 4096);
+
+    const auto edge = static_cast<std::size_t>(resampler.FilterLength() * to / from) + 1;
+    output.erase(output.end() - static_cast<std::ptrdiff_t>(edge), output.end());
+    output.erase(output.begin(), output.begin() + static_cast<std::ptrdiff_t>(edge));
+    return output;
+}
+
+/// Returns the power of the difference between samples and the least-squares fit of a sine wave of frequency hertz
+/// sampled at sampleRate relative to the power of the fit, in decibels.
+double THDPlusN(const std::vector<float> &samples, double frequency, double sampleRate) noexcept {
+    const auto omega = 2 * kPi * frequency / sampleRate;
+
+    double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const auto s = std::sin(omega * static_cast<double>(i));
+        const auto c = std::cos(omega * static_cast<double>(i));
+        ss += s * s;
+        sc += s * c;
+        cc += c * c;
+        ys += samples[i] * s;
+        yc += samples[i] * c;
+    }
+    const auto determinant = ss * cc - sc * sc;
+    const auto a = (ys * cc - yc * sc) / determinant;
+    const auto b = (yc * ss - ys * sc) / determinant;
+
+    double signal = 0, residual = 0;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const auto fit = a * std::sin(omega * static_cast<double>(i)) + b * std::cos(omega * static_cast<double>(i));
+        signal += fit * fit;
+        residual += (samples[i] - fit) * (samples[i] - fit);
+    }
+    return 10 * std::log10(residual / signal);
+}
+
+/// Returns the power of samples relative to a sine wave of amplitude 0.5, in decibels.
+double RelativePower(const std::vector<float> &samples) noexcept {
+    double power = 0;
+    for (const auto sample : samples) {
+        power += static_cast<double>(sample) * sample;
+    }
+    return 10 * std::log10(power / static_cast<double>(samples.size()) / 0.125);
+}
+
+} /* namespace */
+
+bool test_support::PolyphaseResamplerPreservesSine() noexcept {
+    return detail::Run("PolyphaseResamplerPreservesSine", [](const char *scenario) {
+        struct Case {
+            Float64 from_;
+            Float64 to_;
+            Quality quality_;
+            /// The largest permitted difference from the ideal sine wave.
+            double tolerance_;
+        };
+        constexpr Case cases[] = {
+                {44100, 48000, Quality::low, 2e-3},
+                {44100, 48000, Quality::high, 5e-5},
+                {48000, 44100, Quality::medium, 5e-4},
+                {48000, 44100, Quality::maximum, 1e-5},
+                {96000, 44100, Quality::high, 5e-5},
+                {44100, 96000, Quality::high, 5e-5},
+        };
+        constexpr double frequency = 1000;
+
+        for (const auto &testCase : cases) {
+            audio_toolbox::PolyphaseResampler resampler;
+            resampler.New(MakeFormat(testCase.from_, 1), MakeFormat(testCase.to_, 1), testCase.quality_);
+
+            Source source;
+            source.samples_ = MakeSine(frequency, testCase.from_, static_cast<std::size_t>(testCase.from_ / 2));
+            const auto output = Resample(resampler, source, 4096);
+
+            // Output time zero is input time zero, so the output matches a sine wave sampled at the new rate except
+            // where the filter window extends past either end of the input
+            const auto expected = MakeSine(frequency, testCase.to_, output.size());
+            const auto edge = static_cast<std::size_t>(resampler.FilterLength() * testCase.to_ / testCase.from_) + 1;
+            double maximumError = 0;
+            for (std::size_t i = edge; i + edge < output.size(); ++i) {
+                maximumError = std::max(maximumError, std::fabs(static_cast<double>(output[i]) - expected[i]));
+            }
+            if (!(maximumError <= testCase.tolerance_)) {
+                return detail::Fail(scenario, "The resampled sine wave differs from the ideal sine wave");
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PolyphaseResamplerProducesExpectedLength() noexcept {
+    return detail::Run("PolyphaseResamplerProducesExpectedLength", [](const char *scenario) {
+        constexpr std::pair<UInt64, UInt64> rates[] = {
+                {44100, 48000}, {48000, 44100}, {96000, 44100}, {44100, 96000}, {48000, 48000}, {48000, 8000},
+        };
+        constexpr std::size_t lengths[] = {0, 1, 7, 1000, 12345};
+        constexpr UInt32 chunkSizes[] = {1, 511, 4096};
+
+        for (const auto &[from, to] : rates) {
+            for (const auto length : lengths) {
+                for (const auto chunkFrames : chunkSizes) {
+                    audio_toolbox::PolyphaseResampler resampler;
+                    resampler.New(MakeFormat(static_cast<Float64>(from), 2), MakeFormat(static_cast<Float64>(to), 2),
+                                  Quality::low);
+
+                    Source source;
+                    source.channels_ = 2;
+                    source.samples_.assign(length * 2, 0.25f);
+                    const auto output = Resample(resampler, source, chunkFrames);
+
+                    const auto expected = (length * to + from - 1) / from;
+                    if (output.size() != expected * 2) {
+                        return detail::Fail(scenario, "The output length differs from the expected length");
+                    }
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PolyphaseResamplerRejectsExtremeRatios() noexcept {
+    return detail::Run("PolyphaseResamplerRejectsExtremeRatios", [](const char *scenario) {
+        audio_toolbox::PolyphaseResampler resampler;
+        try {
+            resampler.New(MakeFormat(4294967295.0, 1), MakeFormat(1, 1));
+            return detail::Fail(scenario, "An extreme downsampling ratio was accepted");
+        } catch (const std::system_error &) {
+        }
+        if (resampler) {
+            return detail::Fail(scenario, "A rejected resampler was created");
+        }
+
+        // The largest permitted ratio and extreme upsampling are accepted
+        resampler.New(MakeFormat(64 * 8000, 1), MakeFormat(8000, 1), Quality::low);
+        resampler.New(MakeFormat(1, 1), MakeFormat(4294967295.0, 1), Quality::low);
+        return static_cast<bool>(resampler);
+    });
+}
+
+bool test_support::PolyphaseResamplerMeetsTHDPlusN() noexcept {
+    return detail::Run("PolyphaseResamplerMeetsTHDPlusN", [](const char *scenario) {
+        // Images and aliases of passband tones fall in the stopband, so distortion and noise are bounded by the
+        // stopband attenuation. 48001 Hz requires interpolated phases.
+        constexpr std::pair<Float64, Float64> rates[] = {{44100, 48000}, {48000, 44100}, {44100, 48001}};
+        constexpr double frequencies[] = {1000, 5000, 10000};
+
+        for (const auto quality : {Quality::low, Quality::medium, Quality::high, Quality::maximum}) {
+            for (const auto &[from, to] : rates) {
+                for (const auto frequency : frequencies) {
+                    const auto output = ResampleSine(frequency, from, to, quality);
+                    if (!(THDPlusN(output, frequency, to) <= -StopbandAttenuation(quality))) {
+                        return detail::Fail(scenario, "THD+N exceeds the stopband attenuation of the quality tier");
+                    }
+                }
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::PolyphaseResamplerMeetsStopbandAttenuation() noexcept {
+    return detail::Run("PolyphaseResamplerMeetsStopbandAttenuation", [](const char *scenario) {
+        // Tones from just above the output Nyquist frequency to just below the input Nyquist frequency
+        struct Case {
+            Float64 from_;
+            Float64 to_;
+            double frequency_;
+        };
+        constexpr Case cases[] = {
+                {48000, 44100, 22100}, {48000, 44100, 23000}, {48000, 44100, 23900}, {96000, 44100, 22100},
+                {96000, 44100, 30000}, {96000, 44100, 47000}, {96000, 48000, 24100}, {96000, 48000, 40000},
+        };
+
+        for (const auto quality : {Quality::low, Quality::medium, Quality::high, Quality::maximum}) {
+            for (const auto &testCase : cases) {
+                const auto output = ResampleSine(testCase.frequency_, testCase.from_, testCase.to_, quality);
+                if (!(RelativePower(output) <= -StopbandAttenuation(quality))) {
+                    return detail::Fail(scenario, "A stopband tone is attenuated less than the quality tier permits");
+                }
+            }
+        }
+
+        return true;
+    });
+}
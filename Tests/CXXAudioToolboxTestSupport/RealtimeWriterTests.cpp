@@ -0,0 +1,271 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/RealtimeWriterTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/RealtimeWriter.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::RealtimeWriter;
+
+/// A non-interleaved buffer list referring to caller-owned channel data.
+class ChannelList final {
+  public:
+    explicit ChannelList(UInt32 channelCount)
+        : storage_(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * channelCount) {
+        List()->mNumberBuffers = channelCount;
+    }
+
+    /// Points the buffers at frameCount frames of each channel starting at frame.
+    AudioBufferList *Refer(std::vector<std::vector<float>> &channels, std::size_t frame, UInt32 frameCount) {
+        for (UInt32 i = 0; i < List()->mNumberBuffers; ++i) {
+            List()->mBuffers[i] = AudioBuffer{1, static_cast<UInt32>(frameCount * sizeof(float)),
+                                              channels[i].data() + frame};
+        }
+        return List();
+    }
+
+  private:
+    AudioBufferList *List() noexcept { return reinterpret_cast<AudioBufferList *>(storage_.data()); }
+
+    std::vector<unsigned char> storage_;
+};
+
+/// Returns a non-interleaved 32-bit float format.
+AudioStreamBasicDescription MakeNonInterleavedFormat(Float64 sampleRate, UInt32 channels) noexcept {
+    auto format = test_support::detail::MakeFloatFormat(sampleRate, channels);
+    format.mFormatFlags |= kAudioFormatFlagIsNonInterleaved;
+    format.mBytesPerFrame = sizeof(float);
+    format.mBytesPerPacket = sizeof(float);
+    return format;
+}
+
+/// Returns distinct channel data whose samples are exactly representable.
+std::vector<std::vector<float>> MakeChannels(UInt32 channelCount, std::size_t frameCount) {
+    std::vector<std::vector<float>> channels(channelCount, std::vector<float>(frameCount));
+    for (UInt32 i = 0; i < channelCount; ++i) {
+        for (std::size_t frame = 0; frame < frameCount; ++frame) {
+            channels[i][frame] = static_cast<float>(frame) + 0.5f * static_cast<float>(i);
+        }
+    }
+    return channels;
+}
+
+/// A sink appending the audio it receives to channel data, optionally failing.
+struct CollectingSink {
+    explicit CollectingSink(UInt32 channelCount) : channels_(channelCount) {}
+
+    void operator()(UInt32 inNumberFrames, const AudioBufferList *ioData) {
+        if (failAfter_ && channels_[0].size() + inNumberFrames > failAfter_) {
+            throw std::runtime_error("Sink failed");
+        }
+        for (UInt32 i = 0; i < ioData->mNumberBuffers; ++i) {
+            const auto samples = static_cast<const float *>(ioData->mBuffers[i].mData);
+            channels_[i].insert(channels_[i].end(), samples, samples + inNumberFrames);
+        }
+    }
+
+    /// The audio received.
+    std::vector<std::vector<float>> channels_;
+    /// The number of frames after which the sink throws, or 0 if it never does.
+    std::atomic<std::size_t> failAfter_{0};
+};
+
+/// Waits up to one second for a condition to become true.
+template <typename Condition> bool WaitFor(Condition &&condition) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+}
+
+} /* namespace */
+
+bool test_support::RealtimeWriterStreamsToSink() noexcept {
+    return detail::Run("RealtimeWriterStreamsToSink", [](const char *scenario) {
+        constexpr UInt32 channelCount = 2;
+        constexpr std::size_t frameCount = 200'000;
+        auto channels = MakeChannels(channelCount, frameCount);
+
+        // The ring capacity is not a multiple of the write sizes so writes and drains wrap at every offset
+        auto sink = std::make_shared<CollectingSink>(channelCount);
+        RealtimeWriter writer{MakeNonInterleavedFormat(44'100, channelCount), 257,
+                              [sink](UInt32 inNumberFrames, const AudioBufferList *ioData) {
+                                  (*sink)(inNumberFrames, ioData);
+                              },
+                              std::chrono::milliseconds{1}};
+        writer.Start();
+
+        // The producer retries the frames not written, so every frame passes through the ring exactly once
+        UInt64 partialWrites = 0;
+        UInt64 shortfall = 0;
+        ChannelList list{channelCount};
+        for (std::size_t frame = 0, write = 0; frame < frameCount; ++write) {
+            const auto count = static_cast<UInt32>(std::min<std::size_t>(1 + write * 31 % 97, frameCount - frame));
+            const auto written = writer.Write(count, list.Refer(channels, frame, count));
+            if (written < count) {
+                ++partialWrites;
+                shortfall += count - written;
+                std::this_thread::yield();
+            }
+            frame += written;
+        }
+
+        writer.Stop();
+
+        if (sink->channels_ != channels) {
+            return detail::Fail(scenario, "The sink did not receive the written audio");
+        }
+
+        const auto statistics = writer.GetStatistics();
+        if (statistics.framesWritten_ != frameCount || statistics.framesDrained_ != frameCount) {
+            return detail::Fail(scenario, "The frame counts do not match the audio written");
+        }
+        if (statistics.overruns_ != partialWrites || statistics.droppedFrames_ != shortfall) {
+            return detail::Fail(scenario, "The overrun counts do not match the partial writes");
+        }
+        if (statistics.highWaterMark_ == 0 || statistics.highWaterMark_ > writer.Capacity()) {
+            return detail::Fail(scenario, "The high-water mark is outside the ring capacity");
+        }
+        return true;
+    });
+}
+
+bool test_support::RealtimeWriterCountsOverruns() noexcept {
+    return detail::Run("RealtimeWriterCountsOverruns", [](const char *scenario) {
+        const auto sink = [](UInt32, const AudioBufferList *) {};
+
+        auto channels = MakeChannels(1, 150);
+        ChannelList list{1};
+        RealtimeWriter writer{MakeNonInterleavedFormat(44'100, 1), 100, sink};
+
+        if (writer.Write(60, list.Refer(channels, 0, 60)) != 60 ||
+            writer.Write(90, list.Refer(channels, 60, 90)) != 40 ||
+            writer.Write(10, list.Refer(channels, 100, 10)) != 0) {
+            return detail::Fail(scenario, "Writes were not truncated to the ring capacity");
+        }
+
+        const auto statistics = writer.GetStatistics();
+        if (statistics.framesWritten_ != 100 || statistics.overruns_ != 2 || statistics.droppedFrames_ != 60 ||
+            statistics.highWaterMark_ != 100) {
+            return detail::Fail(scenario, "The overrun counts do not match the truncated writes");
+        }
+
+        auto compressed = detail::MakeCompressedFormat(kAudioFormatMPEG4AAC, 44'100, 2);
+        const auto rejects = [&](auto &&construct) {
+            try {
+                construct();
+            } catch (const std::invalid_argument &) {
+                return true;
+            }
+            return false;
+        };
+        if (!rejects([&] { RealtimeWriter{compressed, 100, sink}; }) ||
+            !rejects([&] { RealtimeWriter{MakeNonInterleavedFormat(44'100, 1), 0, sink}; }) ||
+            !rejects([&] { RealtimeWriter{MakeNonInterleavedFormat(44'100, 1), 100, RealtimeWriter::Sink{}}; })) {
+            return detail::Fail(scenario, "Invalid arguments were accepted");
+        }
+        return true;
+    });
+}
+
+bool test_support::RealtimeWriterCountsUnderruns() noexcept {
+    return detail::Run("RealtimeWriterCountsUnderruns", [](const char *scenario) {
+        // Ten frames at 1 kHz last ten milliseconds
+        auto channels = MakeChannels(1, 100);
+        ChannelList list{1};
+        RealtimeWriter writer{MakeNonInterleavedFormat(1'000, 1), 1'000, [](UInt32, const AudioBufferList *) {},
+                              std::chrono::milliseconds{1}};
+
+        // Draining an empty ring is not an underrun
+        writer.Start();
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        if (writer.GetStatistics().underruns_ != 0) {
+            return detail::Fail(scenario, "An idle writer counted underruns");
+        }
+
+        // Writing faster than real time is not an underrun
+        for (std::size_t frame = 0; frame < 50; frame += 10) {
+            writer.Write(10, list.Refer(channels, frame, 10));
+        }
+        if (writer.GetStatistics().underruns_ != 0) {
+            return detail::Fail(scenario, "A producer ahead of real time counted underruns");
+        }
+
+        // Resuming long after the written audio finished is one underrun, after which the producer is in time again
+        std::this_thread::sleep_for(std::chrono::milliseconds{200});
+        writer.Write(10, list.Refer(channels, 50, 10));
+        writer.Write(10, list.Refer(channels, 60, 10));
+        if (writer.GetStatistics().underruns_ != 1) {
+            return detail::Fail(scenario, "A producer behind real time did not count one underrun");
+        }
+
+        writer.Stop();
+        return true;
+    });
+}
+
+bool test_support::RealtimeWriterPropagatesSinkErrors() noexcept {
+    return detail::Run("RealtimeWriterPropagatesSinkErrors", [](const char *scenario) {
+        auto channels = MakeChannels(1, 200);
+        ChannelList list{1};
+        auto sink = std::make_shared<CollectingSink>(1);
+        sink->failAfter_ = 150;
+        RealtimeWriter writer{MakeNonInterleavedFormat(44'100, 1), 1'000,
+                              [sink](UInt32 inNumberFrames, const AudioBufferList *ioData) {
+                                  (*sink)(inNumberFrames, ioData);
+                              },
+                              std::chrono::milliseconds{1}};
+
+        writer.Write(100, list.Refer(channels, 0, 100));
+        writer.Start();
+        if (!WaitFor([&] { return writer.GetStatistics().framesDrained_ == 100; })) {
+            return detail::Fail(scenario, "The ring was not drained");
+        }
+
+        writer.Write(100, list.Refer(channels, 100, 100));
+        if (!WaitFor([&] { return writer.Failed(); }) || writer.FailedFramePosition() != 100) {
+            return detail::Fail(scenario, "The sink failure was not reported at the first frame not written");
+        }
+        if (writer.Write(10, list.Refer(channels, 0, 10)) != 0 || writer.GetStatistics().droppedFrames_ != 10) {
+            return detail::Fail(scenario, "A write after the sink failed was not dropped");
+        }
+
+        try {
+            writer.Stop();
+            return detail::Fail(scenario, "Stop() did not rethrow the sink error");
+        } catch (const std::runtime_error &) {
+        }
+        writer.CheckError();
+
+        // Draining resumes at the first frame not written
+        sink->failAfter_ = 0;
+        writer.Start();
+        writer.Stop();
+        if (sink->channels_ != channels || writer.GetStatistics().framesDrained_ != 200) {
+            return detail::Fail(scenario, "Draining did not resume at the first frame not written");
+        }
+        return true;
+    });
+}
@@ -0,0 +1,105 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/RenderNotifyDispatcherTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/RenderNotifyDispatcher.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+bool test_support::RenderNotifyDispatcherSupportsConcurrentChanges() noexcept {
+    return detail::Run("RenderNotifyDispatcherSupportsConcurrentChanges", [](const char *scenario) {
+        constexpr unsigned mutatorCount = 3;
+        constexpr unsigned iterations = 500;
+
+        detail::SilentOutput output;
+        audio_toolbox::RenderNotifyDispatcher dispatcher{output.Get()};
+
+        std::atomic_uint64_t persistentCalls{0};
+        dispatcher.AddObserver([&persistentCalls](AudioUnitRenderActionFlags, const AudioTimeStamp &, UInt32, UInt32,
+                                                  AudioBufferList *_Nullable) {
+            persistentCalls.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        std::atomic_bool stop{false};
+        std::atomic_bool renderFailed{false};
+        std::atomic_bool calledAfterRemoval{false};
+
+        std::thread renderThread{[&] {
+            Float64 sampleTime = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (!output.Render(sampleTime)) {
+                    renderFailed = true;
+                    return;
+                }
+                sampleTime += detail::SilentOutput::kSliceFrames;
+            }
+        }};
+
+        std::vector<std::thread> mutators;
+        std::atomic_bool mutatorFailed{false};
+        for (unsigned m = 0; m < mutatorCount; ++m) {
+            mutators.emplace_back([&] {
+                try {
+                    for (unsigned i = 0; i < iterations; ++i) {
+                        // The observer owns its flag so a call after its list is freed is reported by sanitizers
+                        auto removed = std::make_shared<std::atomic_bool>(false);
+                        const auto phases = i % 2 ? kAudioUnitRenderAction_PreRender
+                                                  : audio_toolbox::RenderNotifyDispatcher::kAllPhases;
+                        const auto observerID = dispatcher.AddObserver(
+                                [removed, &calledAfterRemoval](AudioUnitRenderActionFlags, const AudioTimeStamp &,
+                                                               UInt32, UInt32, AudioBufferList *_Nullable) {
+                                    if (removed->load(std::memory_order_acquire)) {
+                                        calledAfterRemoval = true;
+                                    }
+                                },
+                                phases);
+
+                        std::this_thread::yield();
+
+                        if (!dispatcher.RemoveObserver(observerID) || dispatcher.RemoveObserver(observerID)) {
+                            mutatorFailed = true;
+                        }
+                        removed->store(true, std::memory_order_release);
+                    }
+                } catch (...) {
+                    mutatorFailed = true;
+                }
+            });
+        }
+        for (auto &mutator : mutators) {
+            mutator.join();
+        }
+
+        stop = true;
+        renderThread.join();
+
+        if (renderFailed) {
+            return detail::Fail(scenario, "AudioUnitRender failed");
+        }
+        if (mutatorFailed) {
+            return detail::Fail(scenario, "Adding or removing an observer failed");
+        }
+        if (calledAfterRemoval) {
+            return detail::Fail(scenario, "An observer was called after RemoveObserver() returned");
+        }
+        if (persistentCalls == 0) {
+            return detail::Fail(scenario, "The persistent observer was never called");
+        }
+        if (dispatcher.ObserverCount() != 1) {
+            return detail::Fail(scenario, "The observer count does not match the remaining observers");
+        }
+
+        return true;
+    });
+}
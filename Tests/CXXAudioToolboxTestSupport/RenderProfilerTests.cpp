@@ -0,0 +1,156 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/RenderProfilerTests.hpp"
+
+#include "Expect.hpp"
+
+#include "RenderCycleTimer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace {
+
+using audio_toolbox::detail::RenderCycleTimer;
+using std::chrono::microseconds;
+
+/// Returns the time a number of microseconds after an arbitrary origin.
+RenderCycleTimer::Clock::time_point At(int us) noexcept {
+    return RenderCycleTimer::Clock::time_point{} + microseconds{us};
+}
+
+/// Returns true if a node's render times have a count, maximum, and mean.
+bool HasRenderTimes(const RenderCycleTimer &timer, std::size_t index, std::uint64_t count, int maxUs, int meanUs) {
+    const auto snapshot = timer.Node(index).renderTime_.GetSnapshot();
+    return snapshot.Count() == count && snapshot.Max() == microseconds{maxUs} &&
+           snapshot.Mean() == microseconds{meanUs};
+}
+
+/// Returns true if a node was slowest in a number of cycles and of cycles missing the deadline.
+bool WasSlowest(const RenderCycleTimer &timer, std::size_t index, std::uint64_t cycles, std::uint64_t missedCycles) {
+    const auto &statistics = timer.Node(index);
+    return statistics.slowestCycles_ == cycles && statistics.slowestMissedCycles_ == missedCycles;
+}
+
+} /* namespace */
+
+bool test_support::RenderProfilerAttributesSelfTime() noexcept {
+    return detail::Run("RenderProfilerAttributesSelfTime", [](const char *scenario) {
+        // The timer holds a histogram per node, so it is not placed on the stack
+        const auto timer = std::make_unique<RenderCycleTimer>(3);
+
+        // Node 0 pulls node 1, which pulls node 2, and then pulls node 2 again directly
+        timer->BeginCycle(microseconds{100}, At(0));
+        timer->BeginNode(0, At(1));
+        timer->BeginNode(1, At(2));
+        timer->BeginNode(2, At(3));
+        timer->EndNode(1, At(5));
+        timer->EndNode(2, At(7));
+        timer->EndNode(1, At(9));
+        timer->BeginNode(2, At(10));
+        timer->EndNode(2, At(12));
+        timer->EndNode(0, At(20));
+        timer->EndCycle(At(21));
+
+        // Node 0 took 19 us less the 7 us of node 1 and the 2 us of node 2 rendered within it
+        if (!HasRenderTimes(*timer, 0, 1, 10, 10) || !HasRenderTimes(*timer, 1, 1, 3, 3) ||
+            !HasRenderTimes(*timer, 2, 2, 4, 3)) {
+            return detail::Fail(scenario, "A node's render time includes nested render calls");
+        }
+        const auto cycleTime = timer->CycleTime().GetSnapshot();
+        if (cycleTime.Count() != 1 || cycleTime.Max() != microseconds{21}) {
+            return detail::Fail(scenario, "The cycle time is incorrect");
+        }
+        if (!WasSlowest(*timer, 0, 1, 0) || !WasSlowest(*timer, 1, 0, 0) || !WasSlowest(*timer, 2, 0, 0)) {
+            return detail::Fail(scenario, "The slowest node is incorrect");
+        }
+
+        // Render calls nested more deeply than the number of nodes are counted but not timed, and a post-render
+        // notification without a render call in progress is ignored
+        timer->EndNode(0, At(30));
+        timer->BeginCycle(microseconds{100}, At(30));
+        for (auto i = 0; i < 4; ++i) {
+            timer->BeginNode(static_cast<std::size_t>(i % 3), At(31 + i));
+        }
+        timer->EndNode(0, At(40));
+        timer->EndNode(2, At(42));
+        timer->EndNode(1, At(44));
+        timer->EndNode(0, At(55));
+        timer->EndCycle(At(56));
+
+        if (!HasRenderTimes(*timer, 0, 2, 12, 11) || !HasRenderTimes(*timer, 1, 2, 3, 3) ||
+            !HasRenderTimes(*timer, 2, 3, 9, 5)) {
+            return detail::Fail(scenario, "A render call nested too deeply was timed");
+        }
+        if (timer->CycleTime().GetSnapshot().Count() != 2 || !WasSlowest(*timer, 0, 2, 0)) {
+            return detail::Fail(scenario, "The cycle was not recorded");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::RenderProfilerDetectsDeadlineMisses() noexcept {
+    return detail::Run("RenderProfilerDetectsDeadlineMisses", [](const char *scenario) {
+        const auto timer = std::make_unique<RenderCycleTimer>(3);
+
+        // A post-render notification outside a cycle is ignored
+        timer->EndCycle(At(0));
+        if (timer->CycleTime().GetSnapshot().Count() != 0) {
+            return detail::Fail(scenario, "A cycle was recorded without a pre-render notification");
+        }
+
+        // Node 1 makes the cycle miss its deadline
+        timer->BeginCycle(microseconds{10}, At(0));
+        timer->BeginNode(0, At(0));
+        timer->BeginNode(1, At(1));
+        timer->EndNode(1, At(9));
+        timer->EndNode(0, At(11));
+        timer->EndCycle(At(12));
+        if (timer->DeadlineMisses() != 1 || timer->LastMissSlowestNode() != std::optional<std::size_t>{1} ||
+            !WasSlowest(*timer, 1, 1, 1)) {
+            return detail::Fail(scenario, "A missed deadline was not attributed to the slowest node");
+        }
+
+        // The head node finishes after the graph's post-render notification, which ends the cycle then
+        timer->BeginCycle(microseconds{10}, At(100));
+        timer->BeginNode(0, At(100));
+        timer->BeginNode(2, At(101));
+        timer->EndNode(2, At(103));
+        timer->EndCycle(At(104));
+        if (timer->CycleTime().GetSnapshot().Count() != 1) {
+            return detail::Fail(scenario, "The cycle ended while the head node was rendering");
+        }
+        timer->EndNode(0, At(115));
+        const auto cycleTime = timer->CycleTime().GetSnapshot();
+        if (cycleTime.Count() != 2 || cycleTime.Max() != microseconds{15}) {
+            return detail::Fail(scenario, "The cycle did not end with the head node");
+        }
+        if (timer->DeadlineMisses() != 2 || timer->LastMissSlowestNode() != std::optional<std::size_t>{0} ||
+            !WasSlowest(*timer, 0, 1, 1)) {
+            return detail::Fail(scenario, "The late head node was not noted as slowest");
+        }
+
+        // A cycle within its deadline is not a miss and does not replace the last miss
+        timer->BeginCycle(microseconds{10}, At(200));
+        timer->BeginNode(0, At(200));
+        timer->BeginNode(2, At(201));
+        timer->EndNode(2, At(206));
+        timer->EndNode(0, At(207));
+        timer->EndCycle(At(208));
+        if (timer->DeadlineMisses() != 2 || timer->LastMissSlowestNode() != std::optional<std::size_t>{0} ||
+            !WasSlowest(*timer, 2, 1, 0)) {
+            return detail::Fail(scenario, "A cycle within its deadline was counted as a miss");
+        }
+
+        return true;
+    });
+}
@@ -0,0 +1,122 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/TimingHistogramTests.hpp"
+
+#include "Expect.hpp"
+
+#include <audio_toolbox/TimingHistogram.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+
+namespace {
+
+using audio_toolbox::TimingHistogram;
+
+/// The number of exactly counted durations.
+constexpr std::uint64_t kExactCount = std::uint64_t{1} << TimingHistogram::kSubBucketBits;
+
+} /* namespace */
+
+bool test_support::TimingHistogramBucketsAreContiguous() noexcept {
+    return detail::Run("TimingHistogramBucketsAreContiguous", [](const char *scenario) {
+        for (std::uint64_t value = 0; value < kExactCount; ++value) {
+            if (TimingHistogram::BucketIndex(value) != value || TimingHistogram::BucketUpperBound(value) != value) {
+                return detail::Fail(scenario, "A small duration is not counted exactly");
+            }
+        }
+
+        // Each bucket begins one past the end of the previous bucket
+        std::uint64_t lowerBound = 0;
+        for (std::size_t i = 0; i < TimingHistogram::kBucketCount - 1; ++i) {
+            const auto upperBound = TimingHistogram::BucketUpperBound(i);
+            if (upperBound < lowerBound) {
+                return detail::Fail(scenario, "A bucket's upper bound precedes its lower bound");
+            }
+            if (TimingHistogram::BucketIndex(lowerBound) != i || TimingHistogram::BucketIndex(upperBound) != i) {
+                return detail::Fail(scenario, "A bucket's bounds are not counted in the bucket");
+            }
+            if (TimingHistogram::BucketIndex(upperBound + 1) != i + 1) {
+                return detail::Fail(scenario, "The duration after a bucket's upper bound is not in the next bucket");
+            }
+            if (lowerBound >= kExactCount && (upperBound - lowerBound + 1) * kExactCount > lowerBound) {
+                return detail::Fail(scenario, "A bucket is wider than the documented relative error");
+            }
+            lowerBound = upperBound + 1;
+        }
+
+        const auto lastBucket = TimingHistogram::kBucketCount - 1;
+        if (TimingHistogram::BucketIndex(lowerBound) != lastBucket ||
+            TimingHistogram::BucketIndex(std::uint64_t{1} << TimingHistogram::kMaxValueBits) != lastBucket ||
+            TimingHistogram::BucketIndex(std::numeric_limits<std::uint64_t>::max()) != lastBucket) {
+            return detail::Fail(scenario, "A very large duration is not counted in the last bucket");
+        }
+        if (TimingHistogram::BucketUpperBound(lastBucket) != std::numeric_limits<std::uint64_t>::max()) {
+            return detail::Fail(scenario, "The last bucket is bounded");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::TimingHistogramReportsPercentiles() noexcept {
+    return detail::Run("TimingHistogramReportsPercentiles", [](const char *scenario) {
+        // The histogram is large, so it is not placed on the stack
+        const auto histogram = std::make_unique<TimingHistogram>();
+
+        const auto empty = histogram->GetSnapshot();
+        if (empty.Count() != 0 || empty.Mean().count() != 0 || empty.ValueAtPercentile(50).count() != 0) {
+            return detail::Fail(scenario, "An empty histogram reports durations");
+        }
+
+        constexpr std::uint64_t durationCount = 1000;
+        for (std::uint64_t i = 1; i <= durationCount; ++i) {
+            histogram->Record(std::chrono::nanoseconds{i});
+        }
+
+        auto snapshot = histogram->GetSnapshot();
+        if (snapshot.Count() != durationCount || snapshot.Max().count() != durationCount ||
+            snapshot.Mean().count() != (durationCount + 1) / 2) {
+            return detail::Fail(scenario, "The count, maximum, or mean is incorrect");
+        }
+
+        // A percentile is reported as the upper bound of its bucket, capped at the maximum
+        for (const auto percentile : {0.0, 1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+            const auto exact =
+                    std::max(std::uint64_t{1}, static_cast<std::uint64_t>(std::ceil(percentile * durationCount / 100)));
+            const auto reported = static_cast<std::uint64_t>(snapshot.ValueAtPercentile(percentile).count());
+            if (reported < exact || (reported - exact) * kExactCount > exact) {
+                return detail::Fail(scenario, "A percentile is outside the bucket error");
+            }
+        }
+        if (snapshot.ValueAtPercentile(100).count() != durationCount) {
+            return detail::Fail(scenario, "The 100th percentile is not the maximum");
+        }
+
+        // Negative durations are recorded as zero and very large durations are reported exactly as the maximum
+        const auto large = std::chrono::nanoseconds{std::chrono::hours{1}};
+        histogram->Record(std::chrono::nanoseconds{-5});
+        histogram->Record(large);
+        snapshot = histogram->GetSnapshot();
+        if (snapshot.Count() != durationCount + 2 || snapshot.Max() != large ||
+            snapshot.ValueAtPercentile(100) != large) {
+            return detail::Fail(scenario, "A very large duration is not reported as the maximum");
+        }
+        if (snapshot.ValueAtPercentile(0).count() != 0) {
+            return detail::Fail(scenario, "A negative duration was not recorded as zero");
+        }
+
+        return true;
+    });
+}
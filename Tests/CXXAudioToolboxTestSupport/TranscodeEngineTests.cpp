@@ -0,0 +1,198 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/TranscodeEngineTests.hpp"
+
+#include "Expect.hpp"
+#include "test_support/Fixtures.hpp"
+
+#include <audio_toolbox/TranscodeEngine.hpp>
+
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using audio_toolbox::TranscodeEngine;
+
+/// The number of frames in source file index.
+UInt32 FrameCount(std::size_t index) noexcept { return static_cast<UInt32>(1'000 + 777 * index); }
+
+/// Writes count 16-bit source files of different lengths and channel counts and returns jobs converting each to a
+/// big-endian 16-bit AIFF file.
+std::vector<TranscodeEngine::Job> MakeJobs(const test_support::detail::TemporaryDirectory &directory,
+                                           std::size_t count) {
+    std::vector<TranscodeEngine::Job> jobs;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto channels = static_cast<UInt32>(1 + i % 2);
+        const auto sourcePath = directory.Path((std::to_string(i) + ".caf").c_str());
+        test_support::detail::WriteTestFile(sourcePath, kAudioFileCAFType,
+                                            test_support::detail::MakeInt16Format(44'100, channels, false),
+                                            FrameCount(i));
+
+        TranscodeEngine::Job job;
+        job.sourcePath_ = sourcePath;
+        job.destinationPath_ = directory.Path((std::to_string(i) + ".aiff").c_str());
+        job.fileType_ = kAudioFileAIFFType;
+        job.format_ = test_support::detail::MakeInt16Format(44'100, channels, true);
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+/// Returns true if a job's destination file holds the same samples as its source file.
+bool Transcoded(const TranscodeEngine::Job &job) {
+    const auto clientFormat = test_support::detail::MakeFloatFormat(44'100, job.format_.mChannelsPerFrame);
+    return test_support::detail::DecodeFile(job.destinationPath_, clientFormat) ==
+           test_support::detail::DecodeFile(job.sourcePath_, clientFormat);
+}
+
+/// Returns true if result failed with error code.
+bool FailedWith(const TranscodeEngine::Result &result, std::errc code) noexcept {
+    if (result) {
+        return false;
+    }
+    try {
+        std::rethrow_exception(result.error_);
+    } catch (const std::system_error &e) {
+        return e.code() == std::make_error_code(code);
+    } catch (...) {
+        return false;
+    }
+}
+
+} /* namespace */
+
+bool test_support::TranscodeEngineTranscodesFilesInOrder() noexcept {
+    return detail::Run("TranscodeEngineTranscodesFilesInOrder", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto jobs = MakeJobs(directory, 12);
+
+        for (const auto threadCount : {1U, 4U}) {
+            // Buffers smaller than the files make each job read and write several times
+            TranscodeEngine engine{threadCount, 512};
+            if (engine.ThreadCount() != threadCount) {
+                return detail::Fail(scenario, "The engine did not use the requested number of threads");
+            }
+
+            // Callbacks are serialized, so the reports need no lock
+            std::vector<int> reports(jobs.size());
+            const auto results = engine.Transcode(jobs, [&reports](const TranscodeEngine::Progress &,
+                                                                   std::size_t jobIndex,
+                                                                   const TranscodeEngine::Result &) {
+                ++reports[jobIndex];
+            });
+
+            if (results.size() != jobs.size() || reports != std::vector<int>(jobs.size(), 1)) {
+                return detail::Fail(scenario, "Not every job was reported once");
+            }
+
+            UInt64 frames = 0;
+            for (std::size_t i = 0; i < jobs.size(); ++i) {
+                if (!results[i] || results[i].framesTranscoded_ != FrameCount(i) || !Transcoded(jobs[i])) {
+                    return detail::Fail(scenario, "A file was not transcoded");
+                }
+                frames += FrameCount(i);
+            }
+
+            const auto progress = engine.GetProgress();
+            if (progress.jobsFinished_ != jobs.size() || progress.jobsFailed_ != 0 ||
+                progress.framesTranscoded_ != frames) {
+                return detail::Fail(scenario, "The final progress does not account for every job");
+            }
+        }
+
+        return true;
+    });
+}
+
+bool test_support::TranscodeEngineCapturesErrors() noexcept {
+    return detail::Run("TranscodeEngineCapturesErrors", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        auto jobs = MakeJobs(directory, 4);
+        jobs[1].sourcePath_ = directory.Path("missing.caf");
+
+        TranscodeEngine engine{2};
+        const auto results = engine.Transcode(jobs);
+
+        if (results[1] || !results[1].error_) {
+            return detail::Fail(scenario, "A missing source file did not fail its job");
+        }
+        for (const auto i : {0, 2, 3}) {
+            if (!results[i] || !Transcoded(jobs[i])) {
+                return detail::Fail(scenario, "A failed job affected another job");
+            }
+        }
+        if (engine.GetProgress().jobsFailed_ != 1) {
+            return detail::Fail(scenario, "The failed job was not counted");
+        }
+
+        return true;
+    });
+}
+
+bool test_support::TranscodeEngineCancels() noexcept {
+    return detail::Run("TranscodeEngineCancels", [](const char *scenario) {
+        detail::TemporaryDirectory directory;
+        const auto jobs = MakeJobs(directory, 4);
+
+        // With one thread jobs run one at a time, so canceling from the first callback skips every other job
+        TranscodeEngine engine{1};
+        auto canceled = false;
+        const auto cancelAfterFirstJob = [&engine, &canceled](const TranscodeEngine::Progress &, std::size_t,
+                                                              const TranscodeEngine::Result &) {
+            if (!canceled) {
+                engine.Cancel();
+                canceled = true;
+            }
+        };
+        auto results = engine.Transcode(jobs, cancelAfterFirstJob);
+
+        std::size_t finished = 0;
+        for (std::size_t i = 0; i < jobs.size(); ++i) {
+            if (results[i]) {
+                if (!Transcoded(jobs[i])) {
+                    return detail::Fail(scenario, "The job that finished was not transcoded");
+                }
+                ++finished;
+            } else if (!FailedWith(results[i], std::errc::operation_canceled) ||
+                       ::access(jobs[i].destinationPath_.c_str(), F_OK) == 0) {
+                return detail::Fail(scenario, "A job after the request was not canceled");
+            }
+        }
+        if (finished != 1) {
+            return detail::Fail(scenario, "Jobs started after the request");
+        }
+
+        // The request ends with the call it applied to
+        results = engine.Transcode(jobs);
+        for (std::size_t i = 0; i < jobs.size(); ++i) {
+            if (!results[i]) {
+                return detail::Fail(scenario, "A request affected a later call");
+            }
+        }
+
+        // A request made between calls applies to the next call
+        engine.Cancel();
+        results = engine.Transcode(jobs);
+        for (const auto &result : results) {
+            if (!FailedWith(result, std::errc::operation_canceled)) {
+                return detail::Fail(scenario, "A request made between calls was lost");
+            }
+        }
+        results = engine.Transcode(jobs);
+        if (!results[0]) {
+            return detail::Fail(scenario, "A request made between calls affected a second call");
+        }
+
+        return true;
+    });
+}
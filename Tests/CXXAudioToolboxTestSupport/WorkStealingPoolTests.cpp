@@ -0,0 +1,145 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#include "test_support/WorkStealingPoolTests.hpp"
+
+#include "Expect.hpp"
+
+#include "WorkStealingPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using audio_toolbox::detail::WorkStealingPool;
+
+} /* namespace */
+
+bool test_support::WorkStealingPoolRunsEveryTask() noexcept {
+    return detail::Run("WorkStealingPoolRunsEveryTask", [](const char *scenario) {
+        WorkStealingPool pool{4};
+        if (pool.ThreadCount() != 4 || WorkStealingPool{}.ThreadCount() == 0) {
+            return detail::Fail(scenario, "The pool does not have the requested number of workers");
+        }
+
+        constexpr std::size_t taskCount = 10'000;
+        std::vector<std::atomic_uint> runs(taskCount);
+        std::atomic_bool invalidWorker{false};
+        for (auto round = 0; round < 3; ++round) {
+            for (std::size_t i = 0; i < taskCount; ++i) {
+                pool.Submit([&, i](unsigned worker) {
+                    if (worker >= 4) {
+                        invalidWorker = true;
+                    }
+                    runs[i].fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            pool.Wait();
+
+            for (const auto &count : runs) {
+                if (count.load(std::memory_order_relaxed) != static_cast<unsigned>(round + 1)) {
+                    return detail::Fail(scenario, "A task did not run exactly once before Wait() returned");
+                }
+            }
+        }
+
+        if (invalidWorker) {
+            return detail::Fail(scenario, "A task received an invalid worker index");
+        }
+        return true;
+    });
+}
+
+bool test_support::WorkStealingPoolStealsQueuedTasks() noexcept {
+    return detail::Run("WorkStealingPoolStealsQueuedTasks", [](const char *scenario) {
+        WorkStealingPool pool{2};
+
+        // Tasks are queued round-robin, so half of the short tasks share a queue with the blocking task. They can
+        // only complete while it blocks if the other worker steals them.
+        constexpr unsigned shortTaskCount = 100;
+        std::atomic_uint completed{0};
+        std::atomic_bool stolen{true};
+        pool.Submit([&](unsigned) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+            while (completed.load() < shortTaskCount) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    stolen = false;
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        });
+        for (unsigned i = 0; i < shortTaskCount; ++i) {
+            pool.Submit([&](unsigned) { completed.fetch_add(1); });
+        }
+        pool.Wait();
+
+        if (!stolen || completed != shortTaskCount) {
+            return detail::Fail(scenario, "Tasks queued for a busy worker were not stolen");
+        }
+        return true;
+    });
+}
+
+bool test_support::WorkStealingPoolWaitsForNestedTasks() noexcept {
+    return detail::Run("WorkStealingPoolWaitsForNestedTasks", [](const char *scenario) {
+        WorkStealingPool pool{3};
+
+        // Each task submits two children until the tree is eight levels deep, and every other task throws
+        std::atomic_uint completed{0};
+        std::function<void(unsigned, unsigned)> spawn = [&](unsigned depth, unsigned index) {
+            if (depth < 8) {
+                pool.Submit([&, depth, index](unsigned) { spawn(depth + 1, index * 2); });
+                pool.Submit([&, depth, index](unsigned) { spawn(depth + 1, index * 2 + 1); });
+            }
+            completed.fetch_add(1);
+            if (index % 2 != 0) {
+                throw std::runtime_error("Task failed");
+            }
+        };
+
+        pool.Submit([&](unsigned) { spawn(0, 0); });
+        pool.Wait();
+
+        if (completed != (1U << 9) - 1) {
+            return detail::Fail(scenario, "Wait() returned before tasks submitted by tasks completed");
+        }
+
+        pool.Submit([&](unsigned) { completed.fetch_add(1); });
+        pool.Wait();
+        if (completed != 1U << 9) {
+            return detail::Fail(scenario, "The pool stopped running tasks after exceptions");
+        }
+        return true;
+    });
+}
+
+bool test_support::WorkStealingPoolCompletesTasksOnDestruction() noexcept {
+    return detail::Run("WorkStealingPoolCompletesTasksOnDestruction", [](const char *scenario) {
+        std::atomic_uint completed{0};
+        {
+            WorkStealingPool pool{2};
+            for (auto i = 0; i < 50; ++i) {
+                pool.Submit([&](unsigned) {
+                    std::this_thread::sleep_for(std::chrono::microseconds{200});
+                    completed.fetch_add(1);
+                });
+            }
+        }
+
+        if (completed != 50) {
+            return detail::Fail(scenario, "Queued tasks were not completed when the pool was destroyed");
+        }
+        return true;
+    });
+}
@@ -0,0 +1,24 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if repeated queries return the cached value until the cache is invalidated.
+bool AudioFileInfoCacheReturnsCachedValues() noexcept;
+
+/// Returns true if a full table evicts only its oldest value to make room.
+bool AudioFileInfoCacheEvictsOldestValue() noexcept;
+
+/// Returns true if values are computed without holding a lock and failed computations insert nothing.
+bool AudioFileInfoCacheComputesWithoutLocking() noexcept;
+
+/// Returns true if concurrent lookups, insertions, and invalidation return correct values.
+bool AudioFileInfoCacheSupportsConcurrentUse() noexcept;
+
+} /* namespace test_support */
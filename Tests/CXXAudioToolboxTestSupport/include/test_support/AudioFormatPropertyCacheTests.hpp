@@ -0,0 +1,24 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if cached values match AudioFormat and repeated lookups are counted as hits.
+bool AudioFormatPropertyCacheCachesValues() noexcept;
+
+/// Returns true if size queries for values not cached neither fetch nor cache the value.
+bool AudioFormatPropertyCacheQueriesSizesOnMisses() noexcept;
+
+/// Returns true if a buffer smaller than a cached value receives its leading portion and the copied size.
+bool AudioFormatPropertyCacheCopiesPartialValues() noexcept;
+
+/// Returns true if the least recently used values are evicted to stay within the capacity.
+bool AudioFormatPropertyCacheEvictsLeastRecentlyUsed() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,18 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if probing a batch of files returns their metadata in input order.
+bool BatchProbeProbesFilesInOrder() noexcept;
+
+/// Returns true if errors probing a file are captured in its result without affecting the other files.
+bool BatchProbeCapturesErrors() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,24 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if sequential, random, block-spanning, and past-the-end reads of a plain file match its contents.
+bool BlockCachedFileMatchesFile() noexcept;
+
+/// Returns true if concurrent readers of a file with a cache much smaller than the file read its contents.
+bool BlockCachedFileSupportsConcurrentReads() noexcept;
+
+/// Returns true if blocks read ahead are not evicted before blocks used earlier.
+bool BlockCachedFileKeepsPrefetchedBlocks() noexcept;
+
+/// Returns true if invalid configurations and reads of a closed file are rejected.
+bool BlockCachedFileRejectsInvalidUse() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,22 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if small writes are coalesced into batches and the file contains every packet in order.
+bool BufferedPacketWriterCoalescesWrites() noexcept;
+
+/// Returns true if batches written because the storage is full end on the packet alignment and non-contiguous and
+/// oversized writes are handled.
+bool BufferedPacketWriterAlignsBatches() noexcept;
+
+/// Returns true if the latency of packets remaining after an aligned batch is measured from the batch.
+bool BufferedPacketWriterMeasuresRemainingLatency() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,23 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if sparse and dense matrices mix the same samples as a reference implementation for each combination
+/// of input and output interleaving.
+bool ChannelMatrixMixerMatchesReference() noexcept;
+
+/// Returns true if mixing in place, with output buffers beginning at the input buffers, produces the same samples as
+/// mixing into separate buffers, and partially overlapping buffers are rejected.
+bool ChannelMatrixMixerMixesInPlace() noexcept;
+
+/// Returns true if the mixer rejects unsupported formats, matrices of the wrong size, and unsuitable buffer lists.
+bool ChannelMatrixMixerRejectsInvalidArguments() noexcept;
+
+} /* namespace test_support */
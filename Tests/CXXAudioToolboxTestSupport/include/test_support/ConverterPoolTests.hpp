@@ -0,0 +1,19 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if converters checked out and checked in concurrently from several threads convert correctly and
+/// the pool's statistics account for every checkout.
+bool ConverterPoolSupportsConcurrentCheckouts() noexcept;
+
+/// Returns true if a converter whose configuration fails partway is disposed instead of being pooled.
+bool ConverterPoolDiscardsPartiallyConfiguredConverters() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,25 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if pointer and buffer list reads of PCM and AAC files match ExtAudioFileRead for several buffer sizes
+/// and counts and for interleaved and non-interleaved client formats.
+bool DecodeAheadReaderMatchesExtAudioFile() noexcept;
+
+/// Returns true if seeking restarts decoding at the requested frame.
+bool DecodeAheadReaderSeeks() noexcept;
+
+/// Returns true if no more than the requested number of buffers are decoded ahead of the consumer.
+bool DecodeAheadReaderBoundsDecodedBuffers() noexcept;
+
+/// Returns true if buffer lists whose layout does not match the client data format are rejected.
+bool DecodeAheadReaderRejectsMismatchedBuffers() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,26 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if the vector dither noise generator produces the same values and generator states as the portable
+/// implementation for a range of counts and strides.
+bool DitherStageNoiseMatchesScalar() noexcept;
+
+/// Returns true if quantizing frames in calls of varying sizes produces the same samples as a single call for each
+/// dither and noise-shaping filter.
+bool DitherStageIsIndependentOfCallSize() noexcept;
+
+/// Returns true if out of range samples, full scale, and NaN clip to the integer range for each sample width.
+bool DitherStageClipsToFullScale() noexcept;
+
+/// Returns true if samples written to a file match those quantized into buffer lists.
+bool DitherStageWritesFiles() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,354 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+#include <audio_toolbox/CAAUGraph.hpp>
+#include <audio_toolbox/CAExtAudioFile.hpp>
+
+#include <AudioToolbox/AudioToolbox.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
+
+namespace test_support {
+namespace detail {
+
+/// Throws std::system_error if result is an error.
+inline void ThrowIfError(OSStatus result, const char *operation) {
+    if (result != noErr) {
+        throw std::system_error(result, std::generic_category(), operation);
+    }
+}
+
+/// A temporary directory removed with the files it contains on destruction.
+class TemporaryDirectory final {
+  public:
+    /// Creates a temporary directory.
+    /// @throw std::system_error.
+    TemporaryDirectory() {
+        const char *base = std::getenv("TMPDIR");
+        std::string pattern = base && *base ? base : "/tmp";
+        if (pattern.back() != '/') {
+            pattern += '/';
+        }
+        pattern += "CXXAudioToolboxTests.XXXXXX";
+        if (!::mkdtemp(pattern.data())) {
+            throw std::system_error(errno, std::generic_category(), "mkdtemp");
+        }
+        path_ = std::move(pattern);
+    }
+
+    // This class is non-copyable
+    TemporaryDirectory(const TemporaryDirectory &) = delete;
+
+    // This class is non-assignable
+    TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+    /// Removes the directory and the files it contains.
+    ~TemporaryDirectory() noexcept {
+        if (auto *directory = ::opendir(path_.c_str()); directory) {
+            while (const auto *entry = ::readdir(directory)) {
+                const std::string name = entry->d_name;
+                if (name != "." && name != "..") {
+                    ::unlink((path_ + '/' + name).c_str());
+                }
+            }
+            ::closedir(directory);
+        }
+        ::rmdir(path_.c_str());
+    }
+
+    /// Returns the path of a file in the directory.
+    [[nodiscard]] std::string Path(const char *name) const { return path_ + '/' + name; }
+
+  private:
+    /// The path of the directory.
+    std::string path_;
+};
+
+/// Deleter for CoreFoundation objects.
+struct CFReleaser {
+    void operator()(CFTypeRef cf) const noexcept { CFRelease(cf); }
+};
+
+/// A file URL.
+using URL = std::unique_ptr<const __CFURL, CFReleaser>;
+
+/// Returns a file URL for a path.
+/// @throw std::system_error.
+inline URL CreateURL(const std::string &path) {
+    URL url{CFURLCreateFromFileSystemRepresentation(kCFAllocatorDefault, reinterpret_cast<const UInt8 *>(path.c_str()),
+                                                    static_cast<CFIndex>(path.size()), false)};
+    if (!url) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                "CFURLCreateFromFileSystemRepresentation");
+    }
+    return url;
+}
+
+/// Returns a native-endian interleaved 32-bit float linear PCM format.
+inline AudioStreamBasicDescription MakeFloatFormat(Float64 sampleRate, UInt32 channels) noexcept {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = sampleRate;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagsNativeFloatPacked;
+    format.mBitsPerChannel = 32;
+    format.mChannelsPerFrame = channels;
+    format.mBytesPerFrame = sizeof(float) * channels;
+    format.mFramesPerPacket = 1;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    return format;
+}
+
+/// Returns an interleaved 16-bit signed integer linear PCM format of the given byte order.
+inline AudioStreamBasicDescription MakeInt16Format(Float64 sampleRate, UInt32 channels, bool bigEndian) noexcept {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = sampleRate;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked;
+    if (bigEndian) {
+        format.mFormatFlags |= kAudioFormatFlagIsBigEndian;
+    }
+    format.mBitsPerChannel = 16;
+    format.mChannelsPerFrame = channels;
+    format.mBytesPerFrame = 2 * channels;
+    format.mFramesPerPacket = 1;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    return format;
+}
+
+/// Returns an interleaved linear PCM format with its channels in separate buffers.
+inline AudioStreamBasicDescription MakeNonInterleaved(AudioStreamBasicDescription format) noexcept {
+    format.mFormatFlags |= kAudioFormatFlagIsNonInterleaved;
+    format.mBytesPerFrame /= format.mChannelsPerFrame;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+    return format;
+}
+
+/// An AudioBufferList with storage for a given number of buffers.
+class BufferList final {
+  public:
+    /// Creates a buffer list of bufferCount empty buffers.
+    explicit BufferList(UInt32 bufferCount)
+        : storage_(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * std::max(bufferCount, 1U)) {
+        get()->mNumberBuffers = bufferCount;
+    }
+
+    /// Returns the buffer list.
+    AudioBufferList *get() noexcept { return reinterpret_cast<AudioBufferList *>(storage_.data()); }
+
+    /// Points a buffer at caller-owned memory.
+    void Set(UInt32 index, void *data, UInt32 byteSize, UInt32 channels = 1) noexcept {
+        get()->mBuffers[index] = AudioBuffer{channels, byteSize, data};
+    }
+
+  private:
+    /// The storage of the buffer list.
+    std::vector<unsigned char> storage_;
+};
+
+/// Returns a compressed format with the encoder's default packet layout.
+inline AudioStreamBasicDescription MakeCompressedFormat(AudioFormatID formatID, Float64 sampleRate,
+                                                        UInt32 channels) noexcept {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = sampleRate;
+    format.mFormatID = formatID;
+    format.mChannelsPerFrame = channels;
+    return format;
+}
+
+/// Returns the value of the test signal at a frame and channel.
+///
+/// The signal is a sum of two sines at frequencies unrelated to common buffer sizes, distinct for each channel.
+inline float TestSignal(UInt64 frame, UInt32 channel, Float64 sampleRate) noexcept {
+    constexpr double pi = 3.14159265358979323846;
+    const auto t = static_cast<double>(frame) / sampleRate;
+    return static_cast<float>(0.3 * std::sin(2 * pi * (441.3 + 97.1 * channel) * t) +
+                              0.1 * std::sin(2 * pi * (3127.9 + 13.7 * channel) * t));
+}
+
+/// Creates an audio file containing frameCount frames of the test signal.
+/// @param path The path of the file.
+/// @param fileType The type of the file.
+/// @param fileFormat The format of the audio data in the file.
+/// @param frameCount The number of frames to write.
+/// @throw std::system_error.
+inline void WriteTestFile(const std::string &path, AudioFileTypeID fileType,
+                          const AudioStreamBasicDescription &fileFormat, UInt32 frameCount) {
+    const auto url = CreateURL(path);
+    audio_toolbox::CAExtAudioFile file;
+    file.CreateWithURL(url.get(), fileType, fileFormat, nullptr, kAudioFileFlags_EraseFile);
+
+    const auto channels = fileFormat.mChannelsPerFrame;
+    const auto clientFormat = MakeFloatFormat(fileFormat.mSampleRate, channels);
+    file.SetClientDataFormat(clientFormat);
+
+    constexpr UInt32 chunkFrames = 4096;
+    std::vector<float> samples(static_cast<std::size_t>(chunkFrames) * channels);
+    for (UInt32 start = 0; start < frameCount; start += chunkFrames) {
+        const auto count = std::min(chunkFrames, frameCount - start);
+        for (UInt32 i = 0; i < count; ++i) {
+            for (UInt32 channel = 0; channel < channels; ++channel) {
+                samples[static_cast<std::size_t>(i) * channels + channel] =
+                        TestSignal(start + i, channel, fileFormat.mSampleRate);
+            }
+        }
+
+        AudioBufferList bufferList;
+        bufferList.mNumberBuffers = 1;
+        bufferList.mBuffers[0].mNumberChannels = channels;
+        bufferList.mBuffers[0].mDataByteSize = count * clientFormat.mBytesPerFrame;
+        bufferList.mBuffers[0].mData = samples.data();
+        file.Write(count, &bufferList);
+    }
+
+    file.Dispose();
+}
+
+/// Decodes an entire audio file to interleaved samples in a client format.
+/// @throw std::system_error.
+inline std::vector<unsigned char> DecodeFile(const std::string &path, const AudioStreamBasicDescription &clientFormat) {
+    const auto url = CreateURL(path);
+    audio_toolbox::CAExtAudioFile file;
+    file.OpenURL(url.get());
+    file.SetClientDataFormat(clientFormat);
+
+    constexpr UInt32 chunkFrames = 4096;
+    std::vector<unsigned char> decoded;
+    std::vector<unsigned char> chunk(static_cast<std::size_t>(chunkFrames) * clientFormat.mBytesPerFrame);
+    for (;;) {
+        AudioBufferList bufferList;
+        bufferList.mNumberBuffers = 1;
+        bufferList.mBuffers[0].mNumberChannels = clientFormat.mChannelsPerFrame;
+        bufferList.mBuffers[0].mDataByteSize = static_cast<UInt32>(chunk.size());
+        bufferList.mBuffers[0].mData = chunk.data();
+
+        auto frameCount = chunkFrames;
+        file.Read(frameCount, &bufferList);
+        if (frameCount == 0) {
+            return decoded;
+        }
+        decoded.insert(decoded.end(), chunk.begin(), chunk.begin() + frameCount * clientFormat.mBytesPerFrame);
+    }
+}
+
+/// Creates and opens a graph containing a generic output node and returns the node.
+/// @throw std::system_error.
+inline AUNode MakeGenericOutputGraph(audio_toolbox::CAAUGraph &graph) {
+    graph.New();
+
+    AudioComponentDescription description{};
+    description.componentType = kAudioUnitType_Output;
+    description.componentSubType = kAudioUnitSubType_GenericOutput;
+    description.componentManufacturer = kAudioUnitManufacturer_Apple;
+    const auto node = graph.AddNode(&description);
+
+    graph.Open();
+    return node;
+}
+
+/// An initialized generic output Audio Unit rendering silence from its input callback.
+class SilentOutput final {
+  public:
+    /// The number of frames in each slice.
+    static constexpr UInt32 kSliceFrames = 512;
+
+    /// Creates and initializes the Audio Unit.
+    /// @throw std::system_error.
+    SilentOutput() {
+        AudioComponentDescription description{};
+        description.componentType = kAudioUnitType_Output;
+        description.componentSubType = kAudioUnitSubType_GenericOutput;
+        description.componentManufacturer = kAudioUnitManufacturer_Apple;
+
+        const auto component = AudioComponentFindNext(nullptr, &description);
+        if (!component) {
+            throw std::system_error(std::make_error_code(std::errc::no_such_device), "AudioComponentFindNext");
+        }
+        ThrowIfError(AudioComponentInstanceNew(component, &audioUnit_), "AudioComponentInstanceNew");
+
+        AURenderCallbackStruct callback{&RenderSilence, nullptr};
+        ThrowIfError(AudioUnitSetProperty(audioUnit_, kAudioUnitProperty_SetRenderCallback, kAudioUnitScope_Input, 0,
+                                          &callback, sizeof callback),
+                     "AudioUnitSetProperty (kAudioUnitProperty_SetRenderCallback)");
+        ThrowIfError(AudioUnitInitialize(audioUnit_), "AudioUnitInitialize");
+    }
+
+    // This class is non-copyable
+    SilentOutput(const SilentOutput &) = delete;
+
+    // This class is non-assignable
+    SilentOutput &operator=(const SilentOutput &) = delete;
+
+    /// Uninitializes and disposes of the Audio Unit.
+    ~SilentOutput() noexcept {
+        if (audioUnit_) {
+            AudioUnitUninitialize(audioUnit_);
+            AudioComponentInstanceDispose(audioUnit_);
+        }
+    }
+
+    /// Returns the Audio Unit.
+    AudioUnit Get() const noexcept { return audioUnit_; }
+
+    /// Renders a slice of kSliceFrames frames.
+    /// @return true on success.
+    bool Render(Float64 sampleTime) noexcept {
+        // Buffers with null data are supplied by the Audio Unit
+        auto *bufferList = reinterpret_cast<AudioBufferList *>(bufferListStorage_);
+        bufferList->mNumberBuffers = kMaximumBuffers;
+        for (UInt32 i = 0; i < kMaximumBuffers; ++i) {
+            bufferList->mBuffers[i] = {1, 0, nullptr};
+        }
+
+        AudioTimeStamp timeStamp{};
+        timeStamp.mSampleTime = sampleTime;
+        timeStamp.mFlags = kAudioTimeStampSampleTimeValid;
+
+        AudioUnitRenderActionFlags actionFlags = 0;
+        return AudioUnitRender(audioUnit_, &actionFlags, &timeStamp, 0, kSliceFrames, bufferList) == noErr;
+    }
+
+  private:
+    /// The maximum number of buffers rendered, enough for the unit's default format.
+    static constexpr UInt32 kMaximumBuffers = 2;
+
+    /// Fills the input with silence.
+    static OSStatus RenderSilence(void *, AudioUnitRenderActionFlags *ioActionFlags, const AudioTimeStamp *, UInt32,
+                                  UInt32, AudioBufferList *_Nullable ioData) noexcept {
+        if (ioData) {
+            for (UInt32 i = 0; i < ioData->mNumberBuffers; ++i) {
+                if (ioData->mBuffers[i].mData) {
+                    std::memset(ioData->mBuffers[i].mData, 0, ioData->mBuffers[i].mDataByteSize);
+                }
+            }
+        }
+        *ioActionFlags |= kAudioUnitRenderAction_OutputIsSilence;
+        return noErr;
+    }
+
+    /// The Audio Unit.
+    AudioUnit _Nullable audioUnit_{nullptr};
+    /// Storage for the rendered buffer list.
+    alignas(AudioBufferList) unsigned char bufferListStorage_[offsetof(AudioBufferList, mBuffers) +
+                                                              sizeof(AudioBuffer) * kMaximumBuffers]{};
+};
+
+} /* namespace detail */
+} /* namespace test_support */
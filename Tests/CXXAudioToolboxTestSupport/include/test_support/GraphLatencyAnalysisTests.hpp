@@ -0,0 +1,24 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if the analysis of branching and merging paths, with node keys out of topological order, finds the
+/// critical path, per-node path latencies and tail times, and the delay needed on each merging connection.
+bool GraphLatencyAnalysisFindsCriticalPath() noexcept;
+
+/// Returns true if the analysis of random acyclic topologies with shuffled connections matches a longest path
+/// computed independently, and the reported delays align every input of each node.
+bool GraphLatencyAnalysisMatchesLongestPaths() noexcept;
+
+/// Returns true if cycles, self-connections, and connections to unknown nodes are rejected and an empty topology has
+/// no latency.
+bool GraphLatencyAnalysisRejectsInvalidTopologies() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,23 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if a snapshot sorts and deduplicates its nodes and groups each node's interactions, successors, and
+/// predecessors in the order reported, including self-connections and input callbacks.
+bool GraphSnapshotGroupsInteractionsByNode() noexcept;
+
+/// Returns true if a snapshot rejects connections and input callbacks referring to unknown nodes.
+bool GraphSnapshotRejectsUnknownNodes() noexcept;
+
+/// Returns true if CAAUGraph::Snapshot returns the cached snapshot until the topology version changes, and
+/// NodesAndInteractions matches the snapshot.
+bool GraphSnapshotIsCachedByVersion() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,27 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if CAAudioConverter::InputBuffer supplies packets from buffer lists and sample ranges in place and
+/// reports exhaustion as requested.
+bool InputProviderSuppliesBuffersWithoutCopying() noexcept;
+
+/// Returns true if CAAudioConverter::FillComplexBuffer converts all input supplied by an input provider across
+/// several calls and reports end of stream.
+bool InputProviderConvertsToEndOfStream() noexcept;
+
+/// Returns true if an input provider with no data yet stops CAAudioConverter::FillComplexBuffer without an error,
+/// returning the packets converted so far, and conversion resumes with later input.
+bool InputProviderStopsWhenNoDataYet() noexcept;
+
+/// Returns true if exceptions thrown by an input provider are rethrown by CAAudioConverter::FillComplexBuffer.
+bool InputProviderRethrowsExceptions() noexcept;
+
+} /* namespace test_support */
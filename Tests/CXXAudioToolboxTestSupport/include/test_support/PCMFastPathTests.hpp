@@ -0,0 +1,28 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if CAAudioConverter::ConvertBuffer's built-in kernels match AudioConverterConvertBuffer for every
+/// supported pair of interleaved formats.
+bool PCMFastPathMatchesAudioConverter() noexcept;
+
+/// Returns true if non-interleaved multichannel formats bypass the built-in kernels and ConvertBuffer writes only
+/// within the output buffer, and non-interleaved mono formats use them.
+bool PCMFastPathHandlesNonInterleavedFormats() noexcept;
+
+/// Returns true if the built-in kernels clip float samples at or beyond full scale to the integer extremes, including
+/// INT32_MAX for 32-bit samples.
+bool PCMFastPathClipsAtFullScale() noexcept;
+
+/// Returns true if CAAudioConverter::UsesPCMFastPath reports when the built-in kernels are used and that they are
+/// disabled by default.
+bool PCMFastPathReportsUsage() noexcept;
+
+} /* namespace test_support */
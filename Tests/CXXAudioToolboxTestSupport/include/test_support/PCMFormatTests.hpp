@@ -0,0 +1,30 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if format descriptors round-trip through stream descriptions and unsupported stream descriptions are
+/// rejected.
+bool PCMFormatDescriptorsRoundTrip() noexcept;
+
+/// Returns true if PCMConverter produces the same bytes as the built-in vector and scalar kernels for every pair of
+/// 32-bit float and integer formats, both when converting runs of samples and when deinterleaving.
+bool PCMConverterMatchesBuiltInKernels() noexcept;
+
+/// Returns true if PCMConverter clips float samples at or beyond full scale to the integer extremes, including
+/// INT32_MAX for 32-bit samples.
+bool PCMConverterClipsAtFullScale() noexcept;
+
+/// Returns true if PCMConverter interleaves and deinterleaves buffer lists and sets the output buffer sizes.
+bool PCMConverterConvertsBufferLists() noexcept;
+
+/// Returns true if PCMConverter rejects partial input frames, undersized outputs, and unsuitable buffer lists.
+bool PCMConverterRejectsInvalidBuffers() noexcept;
+
+} /* namespace test_support */
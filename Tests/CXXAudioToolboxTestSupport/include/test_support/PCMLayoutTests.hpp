@@ -0,0 +1,24 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if pcm_layout::Deinterleave and pcm_layout::Interleave move every sample to its position and back for
+/// each sample size and channel count from one to ten.
+bool PCMLayoutRoundTripsEveryChannelCount() noexcept;
+
+/// Returns true if pcm_layout::Convert converts buffer lists in both directions, sets the buffer sizes, and rejects
+/// undersized buffers and identical formats.
+bool PCMLayoutConvertsBufferLists() noexcept;
+
+/// Returns true if pcm_layout::IsLayoutConversion accepts only formats differing in interleaving and CAAudioConverter
+/// uses the built-in kernels for them only when enabled.
+bool PCMLayoutIdentifiesLayoutConversions() noexcept;
+
+} /* namespace test_support */
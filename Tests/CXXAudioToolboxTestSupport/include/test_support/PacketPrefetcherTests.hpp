@@ -0,0 +1,23 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if prefetched chunks of PCM and AAC files are contiguous and match the packets and descriptions
+/// returned by CAAudioFile::ReadPacketData for several chunk sizes and queue depths.
+bool PacketPrefetcherMatchesReadPacketData() noexcept;
+
+/// Returns true if restarting and stopping a prefetcher in the middle of a file discards queued chunks and resumes
+/// at the requested packet.
+bool PacketPrefetcherRestarts() noexcept;
+
+/// Returns true if invalid chunk sizes and queue depths are rejected.
+bool PacketPrefetcherRejectsInvalidArguments() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,22 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if saved and loaded indexes of PCM and AAC files match the packet tables of the files and the packet
+/// descriptions returned by CAAudioFile::ReadPacketData.
+bool PacketTableIndexRoundTrips() noexcept;
+
+/// Returns true if sidecars that are missing, truncated, stale, or written in the other byte order are rejected.
+bool PacketTableIndexRejectsInvalidSidecars() noexcept;
+
+/// Returns true if frames map to the packets containing them.
+bool PacketTableIndexMapsFramesToPackets() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,20 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if decoding PCM and AAC files segment by segment produces the same bytes as a sequential decode for a
+/// range of segment and pre-roll lengths, thread counts, and client data format layouts.
+bool ParallelDecoderMatchesSequentialDecode() noexcept;
+
+/// Returns true if the decoder rejects invalid segment and pre-roll lengths and unsuitable client data formats and
+/// buffer lists.
+bool ParallelDecoderRejectsInvalidArguments() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,30 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if scheduling more events than a node's queue holds drops and counts exactly the excess.
+bool ParameterAutomationCountsOverflows() noexcept;
+
+/// Returns true if concurrent producers filling a node's queue are accepted exactly up to its capacity.
+bool ParameterAutomationBoundsConcurrentProducers() noexcept;
+
+/// Returns true if pending events are split into due, held, and late events in order, with late and NaN sample times
+/// at offset 0 and buffer offsets clamped to the last frame of the slice.
+bool ParameterAutomationSplitsDueEvents() noexcept;
+
+/// Returns true if an event queue returns its events in order as tickets wrap around its slots, releases space only
+/// as events are drained, and never drains more events than its pending list holds.
+bool ParameterEventQueueReusesSlots() noexcept;
+
+/// Returns true if events pushed by concurrent producers while the queue is drained are each received exactly once
+/// and in the order each producer queued them.
+bool ParameterEventQueueDrainsConcurrentProducers() noexcept;
+
+} /* namespace test_support */
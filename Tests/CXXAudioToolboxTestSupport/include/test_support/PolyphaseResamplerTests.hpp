@@ -0,0 +1,31 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if resampling a sine wave between common rates at each quality reproduces the sine wave at the new
+/// rate.
+bool PolyphaseResamplerPreservesSine() noexcept;
+
+/// Returns true if the resampler produces ceil(input frames * output rate / input rate) frames for a range of ratios
+/// and input lengths, whatever the output buffer size.
+bool PolyphaseResamplerProducesExpectedLength() noexcept;
+
+/// Returns true if the resampler rejects downsampling ratios beyond its limit.
+bool PolyphaseResamplerRejectsExtremeRatios() noexcept;
+
+/// Returns true if the distortion and noise added to passband sine waves are at least as far below the signal as the
+/// stopband attenuation of each quality tier.
+bool PolyphaseResamplerMeetsTHDPlusN() noexcept;
+
+/// Returns true if sine waves above the output Nyquist frequency are attenuated by at least the stopband attenuation
+/// of each quality tier.
+bool PolyphaseResamplerMeetsStopbandAttenuation() noexcept;
+
+} /* namespace test_support */
@@ -0,0 +1,26 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if audio written concurrently with draining through a small ring reaches the sink intact and in
+/// order.
+bool RealtimeWriterStreamsToSink() noexcept;
+
+/// Returns true if writes that do not fit in the ring are truncated and counted as overruns and invalid arguments
+/// are rejected.
+bool RealtimeWriterCountsOverruns() noexcept;
+
+/// Returns true if underruns are counted when the producer falls behind real time and not while it is idle.
+bool RealtimeWriterCountsUnderruns() noexcept;
+
+/// Returns true if a sink failure is reported, identifies the first frame not written, and draining resumes there.
+bool RealtimeWriterPropagatesSinkErrors() noexcept;
+
+} /* namespace test_support */
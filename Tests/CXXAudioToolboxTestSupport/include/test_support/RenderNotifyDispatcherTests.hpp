@@ -0,0 +1,16 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if observers added and removed from several threads while an Audio Unit renders on another are
+/// called only while registered and the observer list stays consistent.
+bool RenderNotifyDispatcherSupportsConcurrentChanges() noexcept;
+
+} /* namespace test_support */
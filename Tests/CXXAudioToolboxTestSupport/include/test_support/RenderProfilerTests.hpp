@@ -0,0 +1,20 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if the time of nested render calls is attributed to each node excluding the calls nested within it,
+/// and unmatched or too deeply nested notifications are not timed.
+bool RenderProfilerAttributesSelfTime() noexcept;
+
+/// Returns true if cycles longer than their deadline are counted as misses with the slowest node noted, including
+/// cycles whose head node finishes after the graph's post-render notification.
+bool RenderProfilerDetectsDeadlineMisses() noexcept;
+
+} /* namespace test_support */
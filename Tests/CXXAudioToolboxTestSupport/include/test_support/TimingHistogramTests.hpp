@@ -0,0 +1,19 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if the histogram's buckets are contiguous, count small durations exactly, stay within the documented
+/// relative error, and count very large durations in the last bucket.
+bool TimingHistogramBucketsAreContiguous() noexcept;
+
+/// Returns true if snapshot statistics and percentiles of recorded durations are within the bucket error.
+bool TimingHistogramReportsPercentiles() noexcept;
+
+} /* namespace test_support */
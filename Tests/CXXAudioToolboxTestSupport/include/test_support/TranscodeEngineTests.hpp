@@ -0,0 +1,22 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if the engine transcodes every file with one or several threads, returns the results in the order of
+/// the jobs, and reports each job once.
+bool TranscodeEngineTranscodesFilesInOrder() noexcept;
+
+/// Returns true if a failed job's error is captured in its result without affecting other jobs.
+bool TranscodeEngineCapturesErrors() noexcept;
+
+/// Returns true if a cancel request skips the remaining jobs of the call it applies to and no later call.
+bool TranscodeEngineCancels() noexcept;
+
+} /* namespace test_support */
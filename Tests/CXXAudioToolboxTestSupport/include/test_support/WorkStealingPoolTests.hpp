@@ -0,0 +1,24 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioToolbox
+//
+
+#pragma once
+
+namespace test_support {
+
+/// Returns true if every submitted task runs exactly once on a valid worker before Wait() returns.
+bool WorkStealingPoolRunsEveryTask() noexcept;
+
+/// Returns true if tasks queued for a busy worker are stolen by the other workers.
+bool WorkStealingPoolStealsQueuedTasks() noexcept;
+
+/// Returns true if Wait() waits for tasks submitted by running tasks and exceptions escaping tasks are discarded.
+bool WorkStealingPoolWaitsForNestedTasks() noexcept;
+
+/// Returns true if destroying the pool completes the queued tasks.
+bool WorkStealingPoolCompletesTasksOnDestruction() noexcept;
+
+} /* namespace test_support */
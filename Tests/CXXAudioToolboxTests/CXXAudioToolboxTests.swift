@@ -7,6 +7,7 @@
 
 import Testing
 @testable import CXXAudioToolbox
+import CXXAudioToolboxTestSupport
 
 @Suite struct CXXCoreAudioTests {
     @Test func audioConverter() async {
@@ -14,6 +15,350 @@ import Testing
         #expect(converter.__convertToBool() == false)
     }
 
+    @Test func pcmFastPathMatchesAudioConverter() async {
+        #expect(test_support.PCMFastPathMatchesAudioConverter())
+    }
+
+    @Test func pcmFastPathHandlesNonInterleavedFormats() async {
+        #expect(test_support.PCMFastPathHandlesNonInterleavedFormats())
+    }
+
+    @Test func pcmFastPathClipsAtFullScale() async {
+        #expect(test_support.PCMFastPathClipsAtFullScale())
+    }
+
+    @Test func pcmFastPathReportsUsage() async {
+        #expect(test_support.PCMFastPathReportsUsage())
+    }
+
+    @Test func polyphaseResamplerPreservesSine() async {
+        #expect(test_support.PolyphaseResamplerPreservesSine())
+    }
+
+    @Test func polyphaseResamplerProducesExpectedLength() async {
+        #expect(test_support.PolyphaseResamplerProducesExpectedLength())
+    }
+
+    @Test func polyphaseResamplerRejectsExtremeRatios() async {
+        #expect(test_support.PolyphaseResamplerRejectsExtremeRatios())
+    }
+
+    @Test func polyphaseResamplerMeetsTHDPlusN() async {
+        #expect(test_support.PolyphaseResamplerMeetsTHDPlusN())
+    }
+
+    @Test func polyphaseResamplerMeetsStopbandAttenuation() async {
+        #expect(test_support.PolyphaseResamplerMeetsStopbandAttenuation())
+    }
+
+    @Test func converterPoolSupportsConcurrentCheckouts() async {
+        #expect(test_support.ConverterPoolSupportsConcurrentCheckouts())
+    }
+
+    @Test func converterPoolDiscardsPartiallyConfiguredConverters() async {
+        #expect(test_support.ConverterPoolDiscardsPartiallyConfiguredConverters())
+    }
+
+    @Test func parameterAutomationCountsOverflows() async {
+        #expect(test_support.ParameterAutomationCountsOverflows())
+    }
+
+    @Test func parameterAutomationBoundsConcurrentProducers() async {
+        #expect(test_support.ParameterAutomationBoundsConcurrentProducers())
+    }
+
+    @Test func renderNotifyDispatcherSupportsConcurrentChanges() async {
+        #expect(test_support.RenderNotifyDispatcherSupportsConcurrentChanges())
+    }
+
+    @Test func timingHistogramBucketsAreContiguous() async {
+        #expect(test_support.TimingHistogramBucketsAreContiguous())
+    }
+
+    @Test func timingHistogramReportsPercentiles() async {
+        #expect(test_support.TimingHistogramReportsPercentiles())
+    }
+
+    @Test func packetTableIndexRoundTrips() async {
+        #expect(test_support.PacketTableIndexRoundTrips())
+    }
+
+    @Test func packetTableIndexRejectsInvalidSidecars() async {
+        #expect(test_support.PacketTableIndexRejectsInvalidSidecars())
+    }
+
+    @Test func packetTableIndexMapsFramesToPackets() async {
+        #expect(test_support.PacketTableIndexMapsFramesToPackets())
+    }
+
+    @Test func packetPrefetcherMatchesReadPacketData() async {
+        #expect(test_support.PacketPrefetcherMatchesReadPacketData())
+    }
+
+    @Test func packetPrefetcherRestarts() async {
+        #expect(test_support.PacketPrefetcherRestarts())
+    }
+
+    @Test func packetPrefetcherRejectsInvalidArguments() async {
+        #expect(test_support.PacketPrefetcherRejectsInvalidArguments())
+    }
+
+    @Test func decodeAheadReaderMatchesExtAudioFile() async {
+        #expect(test_support.DecodeAheadReaderMatchesExtAudioFile())
+    }
+
+    @Test func decodeAheadReaderSeeks() async {
+        #expect(test_support.DecodeAheadReaderSeeks())
+    }
+
+    @Test func decodeAheadReaderBoundsDecodedBuffers() async {
+        #expect(test_support.DecodeAheadReaderBoundsDecodedBuffers())
+    }
+
+    @Test func decodeAheadReaderRejectsMismatchedBuffers() async {
+        #expect(test_support.DecodeAheadReaderRejectsMismatchedBuffers())
+    }
+
+    @Test func blockCachedFileMatchesFile() async {
+        #expect(test_support.BlockCachedFileMatchesFile())
+    }
+
+    @Test func blockCachedFileSupportsConcurrentReads() async {
+        #expect(test_support.BlockCachedFileSupportsConcurrentReads())
+    }
+
+    @Test func blockCachedFileKeepsPrefetchedBlocks() async {
+        #expect(test_support.BlockCachedFileKeepsPrefetchedBlocks())
+    }
+
+    @Test func blockCachedFileRejectsInvalidUse() async {
+        #expect(test_support.BlockCachedFileRejectsInvalidUse())
+    }
+
+    @Test func bufferedPacketWriterCoalescesWrites() async {
+        #expect(test_support.BufferedPacketWriterCoalescesWrites())
+    }
+
+    @Test func bufferedPacketWriterAlignsBatches() async {
+        #expect(test_support.BufferedPacketWriterAlignsBatches())
+    }
+
+    @Test func bufferedPacketWriterMeasuresRemainingLatency() async {
+        #expect(test_support.BufferedPacketWriterMeasuresRemainingLatency())
+    }
+
+    @Test func realtimeWriterStreamsToSink() async {
+        #expect(test_support.RealtimeWriterStreamsToSink())
+    }
+
+    @Test func realtimeWriterCountsOverruns() async {
+        #expect(test_support.RealtimeWriterCountsOverruns())
+    }
+
+    @Test func realtimeWriterCountsUnderruns() async {
+        #expect(test_support.RealtimeWriterCountsUnderruns())
+    }
+
+    @Test func realtimeWriterPropagatesSinkErrors() async {
+        #expect(test_support.RealtimeWriterPropagatesSinkErrors())
+    }
+
+    @Test func workStealingPoolRunsEveryTask() async {
+        #expect(test_support.WorkStealingPoolRunsEveryTask())
+    }
+
+    @Test func workStealingPoolStealsQueuedTasks() async {
+        #expect(test_support.WorkStealingPoolStealsQueuedTasks())
+    }
+
+    @Test func workStealingPoolWaitsForNestedTasks() async {
+        #expect(test_support.WorkStealingPoolWaitsForNestedTasks())
+    }
+
+    @Test func workStealingPoolCompletesTasksOnDestruction() async {
+        #expect(test_support.WorkStealingPoolCompletesTasksOnDestruction())
+    }
+
+    @Test func batchProbeProbesFilesInOrder() async {
+        #expect(test_support.BatchProbeProbesFilesInOrder())
+    }
+
+    @Test func batchProbeCapturesErrors() async {
+        #expect(test_support.BatchProbeCapturesErrors())
+    }
+
+    @Test func audioFileInfoCacheReturnsCachedValues() async {
+        #expect(test_support.AudioFileInfoCacheReturnsCachedValues())
+    }
+
+    @Test func audioFileInfoCacheEvictsOldestValue() async {
+        #expect(test_support.AudioFileInfoCacheEvictsOldestValue())
+    }
+
+    @Test func audioFileInfoCacheComputesWithoutLocking() async {
+        #expect(test_support.AudioFileInfoCacheComputesWithoutLocking())
+    }
+
+    @Test func audioFileInfoCacheSupportsConcurrentUse() async {
+        #expect(test_support.AudioFileInfoCacheSupportsConcurrentUse())
+    }
+
+    @Test func audioFormatPropertyCacheCachesValues() async {
+        #expect(test_support.AudioFormatPropertyCacheCachesValues())
+    }
+
+    @Test func audioFormatPropertyCacheQueriesSizesOnMisses() async {
+        #expect(test_support.AudioFormatPropertyCacheQueriesSizesOnMisses())
+    }
+
+    @Test func audioFormatPropertyCacheCopiesPartialValues() async {
+        #expect(test_support.AudioFormatPropertyCacheCopiesPartialValues())
+    }
+
+    @Test func audioFormatPropertyCacheEvictsLeastRecentlyUsed() async {
+        #expect(test_support.AudioFormatPropertyCacheEvictsLeastRecentlyUsed())
+    }
+
+    @Test func pcmLayoutRoundTripsEveryChannelCount() async {
+        #expect(test_support.PCMLayoutRoundTripsEveryChannelCount())
+    }
+
+    @Test func pcmLayoutConvertsBufferLists() async {
+        #expect(test_support.PCMLayoutConvertsBufferLists())
+    }
+
+    @Test func pcmLayoutIdentifiesLayoutConversions() async {
+        #expect(test_support.PCMLayoutIdentifiesLayoutConversions())
+    }
+
+    @Test func inputProviderSuppliesBuffersWithoutCopying() async {
+        #expect(test_support.InputProviderSuppliesBuffersWithoutCopying())
+    }
+
+    @Test func inputProviderConvertsToEndOfStream() async {
+        #expect(test_support.InputProviderConvertsToEndOfStream())
+    }
+
+    @Test func inputProviderStopsWhenNoDataYet() async {
+        #expect(test_support.InputProviderStopsWhenNoDataYet())
+    }
+
+    @Test func inputProviderRethrowsExceptions() async {
+        #expect(test_support.InputProviderRethrowsExceptions())
+    }
+
+    @Test func transcodeEngineTranscodesFilesInOrder() async {
+        #expect(test_support.TranscodeEngineTranscodesFilesInOrder())
+    }
+
+    @Test func transcodeEngineCapturesErrors() async {
+        #expect(test_support.TranscodeEngineCapturesErrors())
+    }
+
+    @Test func transcodeEngineCancels() async {
+        #expect(test_support.TranscodeEngineCancels())
+    }
+
+    @Test func parallelDecoderMatchesSequentialDecode() async {
+        #expect(test_support.ParallelDecoderMatchesSequentialDecode())
+    }
+
+    @Test func parallelDecoderRejectsInvalidArguments() async {
+        #expect(test_support.ParallelDecoderRejectsInvalidArguments())
+    }
+
+    @Test func ditherStageNoiseMatchesScalar() async {
+        #expect(test_support.DitherStageNoiseMatchesScalar())
+    }
+
+    @Test func ditherStageIsIndependentOfCallSize() async {
+        #expect(test_support.DitherStageIsIndependentOfCallSize())
+    }
+
+    @Test func ditherStageClipsToFullScale() async {
+        #expect(test_support.DitherStageClipsToFullScale())
+    }
+
+    @Test func ditherStageWritesFiles() async {
+        #expect(test_support.DitherStageWritesFiles())
+    }
+
+    @Test func channelMatrixMixerMatchesReference() async {
+        #expect(test_support.ChannelMatrixMixerMatchesReference())
+    }
+
+    @Test func channelMatrixMixerMixesInPlace() async {
+        #expect(test_support.ChannelMatrixMixerMixesInPlace())
+    }
+
+    @Test func channelMatrixMixerRejectsInvalidArguments() async {
+        #expect(test_support.ChannelMatrixMixerRejectsInvalidArguments())
+    }
+
+    @Test func pCMFormatDescriptorsRoundTrip() async {
+        #expect(test_support.PCMFormatDescriptorsRoundTrip())
+    }
+
+    @Test func pCMConverterMatchesBuiltInKernels() async {
+        #expect(test_support.PCMConverterMatchesBuiltInKernels())
+    }
+
+    @Test func pCMConverterClipsAtFullScale() async {
+        #expect(test_support.PCMConverterClipsAtFullScale())
+    }
+
+    @Test func pCMConverterConvertsBufferLists() async {
+        #expect(test_support.PCMConverterConvertsBufferLists())
+    }
+
+    @Test func pCMConverterRejectsInvalidBuffers() async {
+        #expect(test_support.PCMConverterRejectsInvalidBuffers())
+    }
+
+    @Test func graphLatencyAnalysisFindsCriticalPath() async {
+        #expect(test_support.GraphLatencyAnalysisFindsCriticalPath())
+    }
+
+    @Test func graphLatencyAnalysisMatchesLongestPaths() async {
+        #expect(test_support.GraphLatencyAnalysisMatchesLongestPaths())
+    }
+
+    @Test func graphLatencyAnalysisRejectsInvalidTopologies() async {
+        #expect(test_support.GraphLatencyAnalysisRejectsInvalidTopologies())
+    }
+
+    @Test func graphSnapshotGroupsInteractionsByNode() async {
+        #expect(test_support.GraphSnapshotGroupsInteractionsByNode())
+    }
+
+    @Test func graphSnapshotRejectsUnknownNodes() async {
+        #expect(test_support.GraphSnapshotRejectsUnknownNodes())
+    }
+
+    @Test func graphSnapshotIsCachedByVersion() async {
+        #expect(test_support.GraphSnapshotIsCachedByVersion())
+    }
+
+    @Test func parameterAutomationSplitsDueEvents() async {
+        #expect(test_support.ParameterAutomationSplitsDueEvents())
+    }
+
+    @Test func parameterEventQueueReusesSlots() async {
+        #expect(test_support.ParameterEventQueueReusesSlots())
+    }
+
+    @Test func parameterEventQueueDrainsConcurrentProducers() async {
+        #expect(test_support.ParameterEventQueueDrainsConcurrentProducers())
+    }
+
+    @Test func renderProfilerAttributesSelfTime() async {
+        #expect(test_support.RenderProfilerAttributesSelfTime())
+    }
+
+    @Test func renderProfilerDetectsDeadlineMisses() async {
+        #expect(test_support.RenderProfilerDetectsDeadlineMisses())
+    }
+
     @Test func audioFile() async {
         let af = audio_toolbox.CAAudioFile()
         #expect(af.__convertToBool() == false)
@@ -28,4 +373,15 @@ import Testing
         let graph = audio_toolbox.CAAUGraph()
         #expect(graph.__convertToBool() == false)
     }
+
+    @Test func memoryMappedFile() async {
+        let mf = audio_toolbox.MemoryMappedFile()
+        #expect(mf.__convertToBool() == false)
+    }
+
+    @Test func packetTableIndex() async {
+        let index = audio_toolbox.PacketTableIndex()
+        #expect(index.__convertToBool() == false)
+        #expect(index.PacketCount() == 0)
+    }
 }